@@ -0,0 +1,986 @@
+// Benchmark.cpp : Times the data and drawing paths of the library on synthetic data.
+//
+// Usage: Benchmark [-max points] [-seed n] [-out file]
+//
+// Every dataset is generated from a fixed seed by a generator of our own, so the
+// same sizes give the same data on every compiler and runtime. Each stage is timed
+// separately and written as one JSON object per line, a summary goes to the console.
+// No window is created, the curves are drawn into a CRasterSurface.
+
+#include "stdafx.h"
+
+#include "../../../Source/Plot/PlotInterface.h"
+#include "../../../Source/Plot/Basic/Handlers/DataProcessing.h"
+#include "../../../Source/Plot/Basic/ScreenTransform.h"
+#include "../../../Source/Plot/Basic/PlotUtility.h"
+#include "../../../Source/Plot/Basic/mytime.h"
+#ifdef _DEBUG
+#	if defined(_UNICODE) || defined(UNICODE)
+#		pragma comment(lib,"..\\..\\..\\Source\\Bin\\Plotdu.lib")
+#	else
+#		pragma comment(lib,"..\\..\\..\\Source\\Bin\\Plotd.lib")
+#	endif
+#else
+#	if defined(_UNICODE) || defined(UNICODE)
+#		pragma comment(lib,"..\\..\\..\\Source\\Bin\\Plotu.lib")
+#	else
+#		pragma comment(lib,"..\\..\\..\\Source\\Bin\\Plot.lib")
+#	endif
+#endif
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+using namespace NsCChart;
+using namespace std;
+
+// Linear congruential generator, identical everywhere unlike rand()
+class CBenchRandom
+{
+public:
+	CBenchRandom(unsigned int seed){m_nState = seed;}
+	unsigned int	Next(){m_nState = m_nState*1664525u + 1013904223u; return m_nState;}
+	double			Uniform(){return (Next()>>8) * (1.0/16777216.0);}
+protected:
+	unsigned int	m_nState;
+};
+
+class CStopWatch
+{
+public:
+	CStopWatch(){QueryPerformanceFrequency(&m_liFreq); m_liStart.QuadPart = 0;}
+	void			Start(){QueryPerformanceCounter(&m_liStart);}
+	double			Seconds()
+	{
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		return (double)(now.QuadPart - m_liStart.QuadPart)/(double)m_liFreq.QuadPart;
+	}
+protected:
+	LARGE_INTEGER	m_liFreq, m_liStart;
+};
+
+struct BenchStat
+{
+	int		nReps;
+	double	fBest, fTotal;
+	BenchStat(){nReps = 0; fBest = 0.0; fTotal = 0.0;}
+	void	Add(double s){if(nReps == 0 || s < fBest)fBest = s; fTotal += s; nReps++;}
+};
+
+const int	kBatch = 4096;
+const int	kMaxTextPoints = 4000000;
+const int	kMaxMedianPoints = 1000000;
+const int	kLookups = 1000000;
+const int	kMaxTransformPoints = 10000000;
+
+FILE		*g_pOut = 0;
+unsigned int	g_nSeed = 20191015;
+
+// Repetitions of a stage, fewer for the big sizes
+int		GetReps(int nPoints)
+{
+	int reps = 10000000 / (nPoints>0?nPoints:1);
+	if(reps < 1)reps = 1;
+	if(reps > 20)reps = 20;
+	return reps;
+}
+
+void	Report(const char *stage, int nPoints, int nCurves, const BenchStat &stat, double bytes = 0.0, int nThreads = 0)
+{
+	double mean = stat.nReps>0 ? stat.fTotal/stat.nReps : 0.0;
+	double mpts = stat.fBest>0.0 ? nPoints/stat.fBest/1e6 : 0.0;
+	double mbs = stat.fBest>0.0 ? bytes/stat.fBest/1048576.0 : 0.0;
+
+	printf("%-20s %10d pts %5d curves  best %10.6f s  mean %10.6f s  %9.2f Mpts/s", stage, nPoints, nCurves, stat.fBest, mean, mpts);
+	if(bytes>0.0)printf("  %8.2f MB/s", mbs);
+	if(nThreads>0)printf("  %2d threads", nThreads);
+	printf("\n");
+
+	if(!g_pOut)return;
+	fprintf(g_pOut, "{\"stage\":\"%s\",\"points\":%d,\"curves\":%d,\"reps\":%d,\"best_s\":%.9f,\"mean_s\":%.9f,\"mpts_per_s\":%.3f",
+		stage, nPoints, nCurves, stat.nReps, stat.fBest, mean, mpts);
+	if(bytes>0.0)fprintf(g_pOut, ",\"bytes\":%.0f,\"mb_per_s\":%.3f", bytes, mbs);
+	if(nThreads>0)fprintf(g_pOut, ",\"threads\":%d", nThreads);
+	fprintf(g_pOut, "}\n");
+	fflush(g_pOut);
+}
+
+// A random walk on evenly spaced x, continued from y
+void	FillCurve(CBenchRandom &rnd, int nStart, int nLen, double &y, double *pX, double *pY)
+{
+	int i;
+	for(i=0; i<nLen; i++)
+	{
+		y += rnd.Uniform() - 0.5;
+		pX[i] = (nStart + i) * 0.001;
+		pY[i] = y;
+	}
+}
+
+CXYPlotImpl	*BuildPlot(int nPoints, int nCurves, BenchStat &stat)
+{
+	CXYPlotImpl *pPlot = new CXYPlotImpl;
+	vector<double> vX(kBatch), vY(kBatch);
+	CStopWatch watch;
+	double elapsed = 0.0;
+
+	int perCurve = nPoints / nCurves;
+	int c, i, n, dataID;
+	for(c=0; c<nCurves; c++)
+	{
+		CBenchRandom rnd(g_nSeed + c);
+		double y = 0.0;
+
+		dataID = pPlot->AddEmpty();
+		for(i=0; i<perCurve; i+=n)
+		{
+			n = min(kBatch, perCurve - i);
+			FillCurve(rnd, i, n, y, &vX[0], &vY[0]);
+			watch.Start();
+			pPlot->AppendPoints(dataID, &vX[0], &vY[0], n);
+			elapsed += watch.Seconds();
+		}
+	}
+	stat.Add(elapsed);
+	return pPlot;
+}
+
+void	BenchDataRange(CXYPlotImpl *pPlot, int nPoints, int nCurves)
+{
+	BenchStat stat;
+	CStopWatch watch;
+	int r, i;
+	for(r=0; r<GetReps(nPoints); r++)
+	{
+		watch.Start();
+		for(i=0; i<pPlot->GetPlotDataCount(); i++)
+		{
+			pPlot->GetAbsPlotData(i)->SetDataRangeSet(false);
+			pPlot->GetAbsPlotData(i)->GetDataRange();
+		}
+		stat.Add(watch.Seconds());
+	}
+	Report("data_range", nPoints, nCurves, stat);
+}
+
+void	BenchGetIndex(CXYPlotImpl *pPlot, int nPoints, int nCurves)
+{
+	vector<int> vIDs;
+	int i;
+	for(i=0; i<pPlot->GetPlotDataCount(); i++)vIDs.push_back(pPlot->GetDataID(i));
+
+	// visit the curves in a scattered order
+	CBenchRandom rnd(g_nSeed);
+	vector<int> vOrder(kLookups);
+	for(i=0; i<kLookups; i++)vOrder[i] = vIDs[rnd.Next() % vIDs.size()];
+
+	BenchStat stat;
+	CStopWatch watch;
+	int r, sum = 0;
+	for(r=0; r<3; r++)
+	{
+		watch.Start();
+		for(i=0; i<kLookups; i++)sum += pPlot->GetIndex(vOrder[i]);
+		stat.Add(watch.Seconds());
+	}
+	if(sum == -1)printf(" ");// keep the loop
+	Report("get_index", kLookups, nCurves, stat);
+}
+
+// Moving the plot rect by a pixel forces the screen points to be computed again
+void	BenchDraw(CXYPlotImpl *pPlot, int nPoints, int nCurves)
+{
+	CRasterSurface surface(1600, 900);
+	RECT plotRect = {60, 20, 1580, 860};
+	BenchStat statPoints, statRaster, statCompact;
+	CStopWatch watch;
+	int r, i;
+
+	for(r=0; r<GetReps(nPoints); r++)
+	{
+		plotRect.right = 1580 - r%2;
+		surface.Clear(RGB(255, 255, 255));
+		watch.Start();
+		pPlot->DrawCurves(&surface, plotRect);
+		statPoints.Add(watch.Seconds());
+
+		surface.Clear(RGB(255, 255, 255));
+		watch.Start();
+		pPlot->DrawCurves(&surface, plotRect);
+		statRaster.Add(watch.Seconds());
+	}
+	Report("draw_screen_points", nPoints, nCurves, statPoints);
+	Report("draw_raster_only", nPoints, nCurves, statRaster);
+
+	for(i=0; i<pPlot->GetPlotDataCount(); i++)
+	{
+		pPlot->SetCompactDraw(pPlot->GetDataID(i), true);
+		pPlot->SetCompactMode(pPlot->GetDataID(i), kCompactM4);
+	}
+	for(r=0; r<GetReps(nPoints); r++)
+	{
+		plotRect.right = 1580 - r%2;
+		surface.Clear(RGB(255, 255, 255));
+		watch.Start();
+		pPlot->DrawCurves(&surface, plotRect);
+		statCompact.Add(watch.Seconds());
+	}
+	for(i=0; i<pPlot->GetPlotDataCount(); i++)
+	{
+		pPlot->SetCompactDraw(pPlot->GetDataID(i), false);
+	}
+	Report("draw_compact_m4", nPoints, nCurves, statCompact);
+}
+
+// A check passes when nothing differs
+bool	ReportCheck(const char *stage, int nPoints, const char *label, int nMismatch)
+{
+	printf("%-20s %10d pts %-16s %s, %d differ\n", stage, nPoints, label, nMismatch>0?"FAILED":"ok", nMismatch);
+	if(g_pOut)
+	{
+		fprintf(g_pOut, "{\"stage\":\"%s\",\"points\":%d,\"case\":\"%s\",\"mismatch\":%d}\n", stage, nPoints, label, nMismatch);
+		fflush(g_pOut);
+	}
+	return nMismatch == 0;
+}
+
+// M4 must not change a pixel of a 1 pixel line. A random walk, spikes on noise and a curve going
+// back in x are drawn with all their points and compacted, over all the data and zoomed in, and
+// the two pictures are compared
+bool	CheckCompactM4()
+{
+	const int sizes[] = {500, 100000, 2000000};
+	const char *shapes[3] = {"walk", "spikes", "back"};
+	CRasterSurface surfaceAll(1600, 900), surfaceM4(1600, 900);
+	RECT plotRect = {60, 20, 1580, 860};
+	bool bOk = true;
+	char label[32];
+	int s, shape, zoom, i, nMismatch;
+	for(s=0; s<(int)(sizeof(sizes)/sizeof(int)); s++)
+	{
+		for(shape=0; shape<3; shape++)
+		{
+			int n = sizes[s];
+			vector<double> vX(n), vY(n);
+			CBenchRandom rnd(g_nSeed + shape);
+			double y = 0.0;
+			FillCurve(rnd, 0, n, y, &vX[0], &vY[0]);
+			for(i=0; i<n; i++)
+			{
+				if(shape == 1)vY[i] = rnd.Uniform() < 0.001 ? 100.0 * (rnd.Uniform() - 0.5) : 0.1 * rnd.Uniform();
+				else if(shape == 2 && i%1000 == 999)vX[i] -= 0.5;
+			}
+
+			CXYPlotImpl plot;
+			int dataID = plot.AddCurve(&vX[0], &vY[0], n);
+			for(zoom=0; zoom<3; zoom++)
+			{
+				// all the data, a slice from the middle, and the axis running on past the end of the data
+				if(zoom == 1)plot.SetXRange(n * 0.001 * 0.4, n * 0.001 * 0.45);
+				else if(zoom == 2)plot.SetXRange(n * 0.001 * 0.9, n * 0.001 * 1.4);
+
+				plot.SetCompactDraw(dataID, false);
+				surfaceAll.Clear(RGB(255, 255, 255));
+				plot.DrawCurves(&surfaceAll, plotRect);
+				plot.SetCompactDraw(dataID, true);
+				plot.SetCompactMode(dataID, kCompactM4);
+				surfaceM4.Clear(RGB(255, 255, 255));
+				plot.DrawCurves(&surfaceM4, plotRect);
+
+				nMismatch = 0;
+				for(i=0; i<1600*900; i++)
+				{
+					if(surfaceAll.GetPixels()[i] != surfaceM4.GetPixels()[i])nMismatch++;
+				}
+				sprintf(label, "%s zoom %d", shapes[shape], zoom);
+				if(!ReportCheck("check_m4_pixels", n, label, nMismatch))bOk = false;
+			}
+		}
+	}
+	return bOk;
+}
+
+// Numbers printed with %.17g must read back bit for bit, and malformed tokens must be refused
+bool	CheckScanDouble()
+{
+	const int nValues = 1000000;
+	const TCHAR *bad[] = {_TEXT("1e"), _TEXT("1e+"), _TEXT("1-2"), _TEXT("1.2.3"), _TEXT("--1"), _TEXT("."), _TEXT("e5"), _TEXT("1e5x")};
+	CBenchRandom rnd(g_nSeed);
+	TCHAR line[64];
+	const TCHAR *p;
+	double val, parsed[2];
+	unsigned int bits[2];
+	int i, nMismatch = 0;
+	for(i=0; i<nValues; i++)
+	{
+		// random bits, the exponent kept finite
+		bits[0] = rnd.Next();
+		bits[1] = rnd.Next();
+		if((bits[1] & 0x7FF00000) == 0x7FF00000)bits[1] &= 0xBFFFFFFF;
+		memcpy(&val, bits, sizeof(double));
+		_stprintf(line, _TEXT("%.17g"), val);
+		p = line;
+		if(scan_doubles(p, p + _tcslen(p), _TEXT(""), parsed, 2) != 1 || memcmp(&val, parsed, sizeof(double)) != 0)nMismatch++;
+	}
+	for(i=0; i<(int)(sizeof(bad)/sizeof(bad[0])); i++)
+	{
+		if(scan_doubles(bad[i], bad[i] + _tcslen(bad[i]), _TEXT(""), parsed, 2) >= 0)nMismatch++;
+	}
+	return ReportCheck("check_scan_double", nValues, "17 digits", nMismatch);
+}
+
+// Values, titles and colors that differ between two curves, the values bit for bit so that NaN,
+// -0 and denormals count
+int		CountCurveMismatch(CXYPlotImpl *pPlot1, CXYPlotImpl *pPlot2, int which)
+{
+	CPlotDataImpl<DataPoint2D> *pData1 = pPlot1->GetAbsPlotData(which);
+	CPlotDataImpl<DataPoint2D> *pData2 = pPlot2->GetAbsPlotData(which);
+	int n1 = pData1->GetDataCount(), n2 = pData2->GetDataCount();
+	int i, nMismatch = abs(n1 - n2);
+	for(i=0; i<min(n1, n2); i++)
+	{
+		if(memcmp(pData1->GetDataAt(i).val, pData2->GetDataAt(i).val, 2*sizeof(double)) != 0)nMismatch++;
+	}
+	if(pPlot1->GetDataTitle(pPlot1->GetDataID(which)) != pPlot2->GetDataTitle(pPlot2->GetDataID(which)))nMismatch++;
+	if(pData1->GetDataColor() != pData2->GetDataColor())nMismatch++;
+	if(pData1->IsAutoColor() != pData2->IsAutoColor())nMismatch++;
+	return nMismatch;
+}
+
+// Curves written with WriteToBinaryFile must read back unchanged: random walks, the special
+// values of a double, a rolling curve whose ring has wrapped, and 3D curves with their z
+bool	CheckBinaryFile()
+{
+	tstring pathName = _TEXT("benchmark_check.ccb");
+	volatile double zero = 0.0;
+	double special[] = {zero/zero, 1.0/zero, -1.0/zero, -zero, 4.9406564584124654e-324, 2.2250738585072014e-308,
+		1.7976931348623157e308, 0.1, 1.0/3.0, -123456789.125};
+	const int nSpecial = sizeof(special)/sizeof(double);
+	const int nWalk = 100000;
+	bool bOk = true;
+	int i, nMismatch;
+
+	vector<double> vX(nWalk), vY(nWalk), vZ(nWalk);
+	CBenchRandom rnd(g_nSeed);
+	double y = 0.0;
+	FillCurve(rnd, 0, nWalk, y, &vX[0], &vY[0]);
+	for(i=0; i<nWalk; i++)vZ[i] = rnd.Uniform() - 0.5;
+	vector<double> vSpecialRev(special, special + nSpecial);
+	reverse(vSpecialRev.begin(), vSpecialRev.end());
+
+	CXYPlotImpl plot;
+	int dataID = plot.AddCurve(&vX[0], &vY[0], nWalk);
+	plot.SetDataTitle(dataID, _TEXT("random walk"));
+	dataID = plot.AddCurve(special, &vSpecialRev[0], nSpecial);
+	plot.SetDataTitle(dataID, _TEXT("special values, NaN and inf"));
+	plot.SetDataColor(dataID, RGB(12, 34, 56));
+	plot.SetAutoColor(dataID, false);
+	// 2500 points through a ring of 1000, the oldest point is not at the start of the storage
+	plot.SetMaxPoints(1000);
+	plot.SetMaxPointsReset(false);
+	for(i=0; i<2500; i++)plot.AddPoint(i * 0.5, sin(i * 0.01), 2);
+	plot.SetMaxPoints(-1);
+
+	CXYPlotImpl read;
+	nMismatch = 0;
+	if(!plot.WriteToBinaryFile(pathName) || !read.ReadFromFile(pathName))nMismatch++;
+	DeleteFile(pathName.c_str());
+	nMismatch += abs(plot.GetPlotDataCount() - read.GetPlotDataCount());
+	for(i=0; i<min(plot.GetPlotDataCount(), read.GetPlotDataCount()); i++)
+	{
+		nMismatch += CountCurveMismatch(&plot, &read, i);
+	}
+	if(!ReportCheck("check_binary_file", nWalk + nSpecial + 1000, "2d", nMismatch))bOk = false;
+
+	CXY3DPlotImpl plot3D;
+	plot3D.AddCurve(&vX[0], &vY[0], &vZ[0], nWalk);
+	dataID = plot3D.AddCurve(special, &vSpecialRev[0], special, nSpecial);
+	plot3D.SetDataTitle(dataID, _TEXT("special values"));
+
+	CXY3DPlotImpl read3D;
+	nMismatch = 0;
+	if(!plot3D.WriteToBinaryFile(pathName) || !read3D.ReadFromFile(pathName))nMismatch++;
+	DeleteFile(pathName.c_str());
+	nMismatch += abs(plot3D.GetPlotDataCount() - read3D.GetPlotDataCount());
+	for(i=0; i<min(plot3D.GetPlotDataCount(), read3D.GetPlotDataCount()); i++)
+	{
+		nMismatch += CountCurveMismatch(&plot3D, &read3D, i);
+
+		XY3DProp *pPP1 = (XY3DProp *)plot3D.GetAbsPlotData(i)->GetExtProp();
+		XY3DProp *pPP2 = (XY3DProp *)read3D.GetAbsPlotData(i)->GetExtProp();
+		if(!pPP1 || !pPP2 || pPP1->vfZData.size() != pPP2->vfZData.size())
+		{
+			nMismatch++;
+			continue;
+		}
+		if(pPP1->vfZData.size() > 0 && memcmp(&pPP1->vfZData[0], &pPP2->vfZData[0], pPP1->vfZData.size()*sizeof(double)) != 0)nMismatch++;
+	}
+	if(!ReportCheck("check_binary_file", nWalk + nSpecial, "3d", nMismatch))bOk = false;
+
+	return bOk;
+}
+
+// Square grids of subplots drawn into a memory DC, by one thread and by several
+void	BenchMultiDraw(int nMaxPoints)
+{
+	const int grids[] = {1, 2, 3, 4};
+	const int threads[] = {1, 2, 4, 8, 16};
+	const int nCurves = 4;
+	int nPerPlot = nMaxPoints / 16;
+	if(nPerPlot > 100000)nPerPlot = 100000;
+	if(nPerPlot < nCurves * 10)return;
+
+	BITMAPINFO bmi;
+	memset(&bmi, 0, sizeof(bmi));
+	bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+	bmi.bmiHeader.biWidth = 1600;
+	bmi.bmiHeader.biHeight = -900;
+	bmi.bmiHeader.biPlanes = 1;
+	bmi.bmiHeader.biBitCount = 32;
+	bmi.bmiHeader.biCompression = BI_RGB;
+	void *pBits = 0;
+	HDC hDC = CreateCompatibleDC(NULL);
+	HBITMAP hBmp = CreateDIBSection(hDC, &bmi, DIB_RGB_COLORS, &pBits, NULL, 0);
+	if(!hBmp)
+	{
+		DeleteDC(hDC);
+		return;
+	}
+	HBITMAP hOldBmp = (HBITMAP)SelectObject(hDC, hBmp);
+
+	RECT destRect = {0, 0, 1600, 900};
+	CStopWatch watch;
+	int g, t, i, r;
+	for(g=0; g<(int)(sizeof(grids)/sizeof(int)); g++)
+	{
+		int nPlots = grids[g] * grids[g];
+		CMultiPlotImpl multi;
+		multi.ResizePlots(kSplitNM, grids[g], grids[g]);
+		for(i=0; i<nPlots; i++)
+		{
+			BenchStat statBuild;
+			multi.SetSubPlot(BuildPlot(nPerPlot, nCurves, statBuild), 0, 0, i);
+		}
+
+		for(t=0; t<(int)(sizeof(threads)/sizeof(int)); t++)
+		{
+			multi.SetDrawThreads(threads[t]);
+			BenchStat stat;
+			for(r=0; r<5; r++)
+			{
+				// a pixel less every other frame, the screen points are computed again
+				destRect.right = 1600 - r%2;
+				watch.Start();
+				multi.FinalDraw(hDC, destRect);
+				stat.Add(watch.Seconds());
+			}
+			Report("multi_draw", nPerPlot * nPlots, nCurves * nPlots, stat, 0.0, threads[t]);
+		}
+	}
+
+	SelectObject(hDC, hOldBmp);
+	DeleteObject(hBmp);
+	DeleteDC(hDC);
+}
+
+// One producer thread a curve, pushing one point a call and timing each call
+struct IngestJob
+{
+	CXYPlotImpl		*pPlot;
+	CIngestQueue<DataPoint2D>	*pQueue;// null for the locked path
+	int				dataID, nPoints;
+	unsigned int	nSeed;
+	vector<float>	vLatency;// microseconds
+	volatile LONG	*pRunning;
+};
+
+DWORD	WINAPI	IngestProducer(LPVOID pPara)
+{
+	IngestJob *pJob = (IngestJob *)pPara;
+	CBenchRandom rnd(pJob->nSeed);
+	LARGE_INTEGER freq, t0, t1;
+	QueryPerformanceFrequency(&freq);
+	double toUs = 1e6/(double)freq.QuadPart;
+
+	DataPoint2D dp;
+	double y = 0.0;
+	int i;
+	for(i=0; i<pJob->nPoints; i++)
+	{
+		y += rnd.Uniform() - 0.5;
+		dp.val[0] = i * 0.001;
+		dp.val[1] = y;
+		QueryPerformanceCounter(&t0);
+		if(pJob->pQueue)
+			pJob->pQueue->Push(dp);
+		else
+			pJob->pPlot->AppendPoints(pJob->dataID, &dp.val[0], &dp.val[1], 1);
+		QueryPerformanceCounter(&t1);
+		pJob->vLatency[i] = (float)((t1.QuadPart - t0.QuadPart) * toUs);
+	}
+	InterlockedDecrement((LPLONG)pJob->pRunning);
+	return 0;
+}
+
+void	ReportLatency(const char *stage, int nThreads, vector<float> &vLatency, int nDropped)
+{
+	if(vLatency.size() <= 0)return;
+	int nCalls = (int)vLatency.size();
+	int n50 = nCalls / 2, n99 = (int)(nCalls * 0.99);
+	nth_element(vLatency.begin(), vLatency.begin() + n50, vLatency.end());
+	double p50 = vLatency[n50];
+	nth_element(vLatency.begin(), vLatency.begin() + n99, vLatency.end());
+	double p99 = vLatency[n99];
+	double fMax = *max_element(vLatency.begin(), vLatency.end());
+
+	printf("%-20s %10d calls %2d threads  p50 %8.3f us  p99 %8.3f us  max %10.3f us  dropped %d\n", stage, nCalls, nThreads, p50, p99, fMax, nDropped);
+
+	if(!g_pOut)return;
+	fprintf(g_pOut, "{\"stage\":\"%s\",\"calls\":%d,\"threads\":%d,\"p50_us\":%.3f,\"p99_us\":%.3f,\"max_us\":%.3f,\"dropped\":%d}\n",
+		stage, nCalls, nThreads, p50, p99, fMax, nDropped);
+	fflush(g_pOut);
+}
+
+// Producers append while this thread plays the render loop, through the data lock
+// and through the lock free ingestion queues
+void	BenchIngest(int nMaxPoints)
+{
+	const int producers[] = {1, 2, 4, 8};
+	int nPer = nMaxPoints / 8;
+	if(nPer > 1000000)nPer = 1000000;
+	if(nPer < 1000)return;
+
+	CStopWatch watch;
+	int mode, p, i;
+	for(mode=0; mode<2; mode++)
+	{
+		for(p=0; p<(int)(sizeof(producers)/sizeof(int)); p++)
+		{
+			int nProducers = producers[p];
+			CXYPlotImpl plot;
+			vector<IngestJob> vJobs(nProducers);
+			volatile LONG nRunning = nProducers;
+			for(i=0; i<nProducers; i++)
+			{
+				vJobs[i].pPlot = &plot;
+				vJobs[i].dataID = plot.AddEmpty();
+				vJobs[i].pQueue = mode==1 ? plot.OpenIngestQueue(vJobs[i].dataID, nPer) : 0;
+				vJobs[i].nPoints = nPer;
+				vJobs[i].nSeed = g_nSeed + i;
+				vJobs[i].vLatency.resize(nPer);
+				vJobs[i].pRunning = &nRunning;
+			}
+
+			vector<HANDLE> vhThreads(nProducers);
+			watch.Start();
+			for(i=0; i<nProducers; i++)
+			{
+				DWORD dwID;
+				vhThreads[i] = CreateThread(NULL, 0, IngestProducer, &vJobs[i], 0, &dwID);
+			}
+			// about a frame a millisecond, the locked path holds the lock while it reads the ranges
+			while(nRunning > 0)
+			{
+				if(mode==1)
+					plot.DrainIngestQueues();
+				else
+					plot.MyLock();
+				for(i=0; i<plot.GetPlotDataCount(); i++)
+					plot.GetAbsPlotData(i)->GetDataRange();
+				if(mode==0)
+					plot.MyUnlock();
+				Sleep(1);
+			}
+			WaitForMultipleObjects(nProducers, &vhThreads[0], TRUE, INFINITE);
+			if(mode==1)plot.DrainIngestQueues();
+			BenchStat stat;
+			stat.Add(watch.Seconds());
+
+			vector<float> vLatency;
+			int nDropped = 0;
+			for(i=0; i<nProducers; i++)
+			{
+				CloseHandle(vhThreads[i]);
+				vLatency.insert(vLatency.end(), vJobs[i].vLatency.begin(), vJobs[i].vLatency.end());
+				if(vJobs[i].pQueue)
+				{
+					nDropped += vJobs[i].pQueue->GetDropped();
+					plot.CloseIngestQueue(vJobs[i].dataID);
+				}
+			}
+
+			Report(mode==1?"ingest_queue":"ingest_lock", nPer * nProducers, nProducers, stat, 0.0, nProducers);
+			ReportLatency(mode==1?"ingest_queue_latency":"ingest_lock_latency", nProducers, vLatency, nDropped);
+		}
+	}
+}
+
+void	BenchMedian(CXYPlotImpl *pPlot, int nPoints, int nCurves)
+{
+	if(nPoints > kMaxMedianPoints)return;
+
+	BenchStat stat;
+	CStopWatch watch;
+	watch.Start();
+	ProcMedianFilterData(pPlot, 0, 5, false);
+	stat.Add(watch.Seconds());
+	Report("median_filter", nPoints, nCurves, stat);
+}
+
+void	BenchBinaryFile(CXYPlotImpl *pPlot, int nPoints, int nCurves)
+{
+	tstring pathName = _TEXT("benchmark.ccb");
+	BenchStat statWrite, statRead;
+	CStopWatch watch;
+
+	watch.Start();
+	if(!pPlot->WriteToBinaryFile(pathName))return;
+	statWrite.Add(watch.Seconds());
+
+	double bytes = 0.0;
+	HANDLE hFile = CreateFile(pathName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+	if(hFile != INVALID_HANDLE_VALUE)
+	{
+		DWORD high = 0;
+		DWORD low = GetFileSize(hFile, &high);
+		bytes = (double)high * 4294967296.0 + low;
+		CloseHandle(hFile);
+	}
+
+	CXYPlotImpl *pRead = new CXYPlotImpl;
+	watch.Start();
+	pRead->ReadFromFile(pathName);
+	statRead.Add(watch.Seconds());
+	delete pRead;
+	DeleteFile(pathName.c_str());
+
+	Report("binary_write", nPoints, nCurves, statWrite, bytes);
+	Report("binary_read", nPoints, nCurves, statRead, bytes);
+}
+
+// Counts what the text writer passes on, without storing it
+bool	CountTextSink(const TCHAR *pText, int nLen, void *pPara)
+{
+	*(double *)pPara += nLen * sizeof(TCHAR);
+	return true;
+}
+
+// The text export to a file with the default precision, and to a sink with round trip precision
+void	BenchTextWrite(CXYPlotImpl *pPlot, int nPoints, int nCurves)
+{
+	if(nPoints > kMaxTextPoints)return;
+
+	tstring pathName = _TEXT("benchmark.txt");
+	BenchStat statFile, statSink;
+	CStopWatch watch;
+	double bytesFile = 0.0, bytesSink = 0.0;
+
+	pPlot->SetTextPrecision(6);
+	if(!pPlot->WriteToSink(CountTextSink, &bytesFile))return;
+	watch.Start();
+	if(!pPlot->WriteToFile(pathName))return;
+	statFile.Add(watch.Seconds());
+	DeleteFile(pathName.c_str());
+
+	pPlot->SetTextPrecision(17);
+	for(int r=0; r<GetReps(nPoints); r++)
+	{
+		bytesSink = 0.0;
+		watch.Start();
+		pPlot->WriteToSink(CountTextSink, &bytesSink);
+		statSink.Add(watch.Seconds());
+	}
+	pPlot->SetTextPrecision(6);
+
+	Report("text_write", nPoints, nCurves, statFile, bytesFile);
+	Report("text_write_sink", nPoints, nCurves, statSink, bytesSink);
+}
+
+// ReadFromBuff as it was, a regex match and a string stream for every line
+int		ReadBuffRegex(const tstring &buff, vector<DataPoint2D> &vData)
+{
+	CRegexpT<TCHAR> dataline(_TEXT("^(-?\\d+(\\.\\d*)?([eE][+-]?\\d*)?\\s*){2}$"));
+	tstring aline;
+	tstring::size_type curpos = 0;
+	DataPoint2D dp;
+	do
+	{
+		aline = readline(buff, curpos);
+		if(aline.length()==0)break;
+		trimspace(aline);
+		if(dataline.MatchExact(aline.c_str()).IsMatched())
+		{
+			tistringstream istr(aline);
+			istr>>dp.val[0]>>dp.val[1];
+			vData.push_back(dp);
+		}
+	}while(curpos != tstring::npos);
+	return (int)vData.size();
+}
+
+// The text parser against the regex path it replaced, on the same buffer
+void	BenchReadBuff(int nPoints)
+{
+	if(nPoints > kMaxTextPoints)return;
+
+	CBenchRandom rnd(g_nSeed);
+	vector<double> vX(nPoints), vY(nPoints);
+	double y = 0.0;
+	FillCurve(rnd, 0, nPoints, y, &vX[0], &vY[0]);
+
+	tstring buff;
+	buff.reserve(nPoints * 32);
+	TCHAR line[64];
+	int i, r;
+	for(i=0; i<nPoints; i++)
+	{
+		_stprintf(line, _TEXT("%.6f\t\t%.9g\n"), vX[i], vY[i]);
+		buff += line;
+	}
+	double bytes = (double)buff.length() * sizeof(TCHAR);
+
+	BenchStat stat, statRegex;
+	CStopWatch watch;
+	for(r=0; r<GetReps(nPoints); r++)
+	{
+		CPlotData<DataPoint2D> data;
+		watch.Start();
+		data.ReadFromBuff(buff);
+		stat.Add(watch.Seconds());
+		if(data.GetDataCount() != nPoints)printf("read_buff: %d of %d points\n", data.GetDataCount(), nPoints);
+	}
+	Report("read_buff", nPoints, 1, stat, bytes);
+
+	for(r=0; r<GetReps(nPoints); r++)
+	{
+		vector<DataPoint2D> vData;
+		watch.Start();
+		ReadBuffRegex(buff, vData);
+		statRegex.Add(watch.Seconds());
+		if((int)vData.size() != nPoints)printf("read_buff_regex: %d of %d points\n", (int)vData.size(), nPoints);
+	}
+	Report("read_buff_regex", nPoints, 1, statRegex, bytes);
+}
+
+// Time strings a tenth of a second apart, through strptime and mktime as before and
+// through the batch parser, in a user format and in ISO-8601 with an offset
+void	BenchTimeParse(int nPoints)
+{
+	if(nPoints > kMaxTextPoints)return;
+
+	const TCHAR *fmt = _TEXT("%Y-%m-%d %H:%M:%S");
+	vector<tstring> vLocal(nPoints), vISO(nPoints);
+	vector<double> vTime(nPoints);
+	TCHAR line[64];
+	double bytesLocal = 0.0, bytesISO = 0.0;
+	int i, r, sec, ms;
+	for(i=0; i<nPoints; i++)
+	{
+		sec = i / 10;
+		ms = (i % 10) * 100;
+		_stprintf(line, _TEXT("2019-10-%02d %02d:%02d:%02d.%03d"), 15 + sec/86400, sec/3600%24, sec/60%60, sec%60, ms);
+		vLocal[i] = line;
+		bytesLocal += vLocal[i].length() * sizeof(TCHAR);
+		_stprintf(line, _TEXT("2019-10-%02dT%02d:%02d:%02d.%03d+08:00"), 15 + sec/86400, sec/3600%24, sec/60%60, sec%60, ms);
+		vISO[i] = line;
+		bytesISO += vISO[i].length() * sizeof(TCHAR);
+	}
+
+	BenchStat statSlow, statFast, statISO;
+	CStopWatch watch;
+	for(r=0; r<GetReps(nPoints); r++)
+	{
+		watch.Start();
+		for(i=0; i<nPoints; i++)
+		{
+			struct tm myTm = {0};
+			if(!_tcsptime(vLocal[i].c_str(), fmt, &myTm))break;
+			vTime[i] = (double)mktime(&myTm);
+		}
+		statSlow.Add(watch.Seconds());
+
+		watch.Start();
+		if(MyStr2TimeBatch(&vLocal[0], nPoints, fmt, &vTime[0]) < nPoints)printf("time_parse: failed\n");
+		statFast.Add(watch.Seconds());
+
+		watch.Start();
+		if(MyStr2TimeBatch(&vISO[0], nPoints, _TEXT(""), &vTime[0]) < nPoints)printf("time_parse_iso: failed\n");
+		statISO.Add(watch.Seconds());
+	}
+	Report("time_parse_strptime", nPoints, 1, statSlow, bytesLocal);
+	Report("time_parse", nPoints, 1, statFast, bytesLocal);
+	Report("time_parse_iso", nPoints, 1, statISO, bytesISO);
+}
+
+// The screen transform kernels alone, on interleaved points as stored by the curves
+void	BenchTransform(int nPoints)
+{
+	if(nPoints > kMaxTransformPoints)return;
+
+	const char *stages[3] = {"transform_linear", "transform_log", "transform_time"};
+	vector<double> vData(2 * nPoints);
+	vector<POINT> vPoints(nPoints);
+	ScreenAxisMap xMap, yMap;
+	BenchStat stat;
+	CStopWatch watch;
+	int mode, i, r;
+	for(mode=0; mode<3; mode++)
+	{
+		CBenchRandom rnd(g_nSeed);
+		for(i=0; i<nPoints; i++)
+		{
+			switch(mode)
+			{
+			case 0:
+				vData[2*i] = i * 0.001;
+				break;
+			case 1:
+				vData[2*i] = 1.0 + i;
+				break;
+			default:
+				// one second apart from a date, in days
+				vData[2*i] = 43754.0 + i / 86400.0;
+				break;
+			}
+			vData[2*i+1] = mode==1 ? 1.0 + 1000.0 * rnd.Uniform() : rnd.Uniform() - 0.5;
+		}
+		switch(mode)
+		{
+		case 0:
+			xMap = MakeScreenAxisMap(60, 1520.0 / (nPoints * 0.001), 0.0, false, false, true);
+			yMap = MakeScreenAxisMap(860, 840.0, -0.5, true, false, true);
+			break;
+		case 1:
+			xMap = MakeScreenAxisMap(60, 1520.0 / log10(1.0 + nPoints), 0.0, false, true, true);
+			yMap = MakeScreenAxisMap(860, 280.0, 0.0, true, true, true);
+			break;
+		default:
+			xMap = MakeScreenAxisMap(60, 1520.0 / (nPoints / 86400.0), 43754.0, false, false, true);
+			yMap = MakeScreenAxisMap(860, 840.0, -0.5, true, false, true);
+			break;
+		}
+
+		stat = BenchStat();
+		for(r=0; r<GetReps(nPoints); r++)
+		{
+			watch.Start();
+			DataToScreen(xMap, &vData[0], 2, &vPoints[0].x, sizeof(POINT)/sizeof(long), nPoints);
+			DataToScreen(yMap, &vData[1], 2, &vPoints[0].y, sizeof(POINT)/sizeof(long), nPoints);
+			stat.Add(watch.Seconds());
+		}
+		Report(stages[mode], nPoints, 1, stat);
+	}
+}
+
+double	BenchField(double x, double y)
+{
+	return sin(x)*cos(y) + 0.1*x;
+}
+
+class CBenchContour : public CContour
+{
+public:
+	CBenchContour(){m_nSegments = 0;}
+	int		m_nSegments;
+	void	Run(){m_nSegments = 0; Generate();}
+protected:
+	void	ExportLine(int iPlane, int x1, int y1, int x2, int y2){m_nSegments++;}
+};
+
+void	BenchContour(int nGrid)
+{
+	CBenchContour contour;
+	double limits[4] = {-5.0, 5.0, -5.0, 5.0};
+	contour.SetLimits(limits);
+	contour.SetFieldFcn(BenchField);
+	contour.SetFirstGrid(32, 32);
+	contour.SetSecondaryGrid(nGrid, nGrid);
+	contour.SetPlanes(20);
+
+	BenchStat stat;
+	CStopWatch watch;
+	int r;
+	for(r=0; r<3; r++)
+	{
+		watch.Start();
+		contour.Run();
+		stat.Add(watch.Seconds());
+	}
+	Report("contour", nGrid*nGrid, 20, stat);
+}
+
+int		_tmain(int argc, TCHAR *argv[])
+{
+	int nMaxPoints = 10000000;
+	tstring outName = _TEXT("benchmark.json");
+
+	int i;
+	for(i=1; i<argc; i++)
+	{
+		if(_tcscmp(argv[i], _TEXT("-max")) == 0 && i+1<argc)nMaxPoints = _ttoi(argv[++i]);
+		else if(_tcscmp(argv[i], _TEXT("-seed")) == 0 && i+1<argc)g_nSeed = (unsigned int)_ttoi(argv[++i]);
+		else if(_tcscmp(argv[i], _TEXT("-out")) == 0 && i+1<argc)outName = argv[++i];
+		else
+		{
+			printf("Usage: Benchmark [-max points] [-seed n] [-out file]\n");
+			return 1;
+		}
+	}
+
+	g_pOut = _tfopen(outName.c_str(), _TEXT("w"));
+	if(!g_pOut)
+	{
+		printf("Can not open the output file\n");
+		return 1;
+	}
+
+	// the checks first, a failed one sets the exit code
+	int nFailed = 0;
+	if(!CheckCompactM4())nFailed++;
+	if(!CheckBinaryFile())nFailed++;
+	if(!CheckScanDouble())nFailed++;
+
+	const int sizes[] = {1000, 10000, 100000, 1000000, 10000000, 100000000};
+	const int curves[] = {1, 100, 5000};
+	int s, c;
+	for(s=0; s<(int)(sizeof(sizes)/sizeof(int)) && sizes[s]<=nMaxPoints; s++)
+	{
+		for(c=0; c<(int)(sizeof(curves)/sizeof(int)); c++)
+		{
+			// at least ten points a curve
+			if(sizes[s] / curves[c] < 10)continue;
+
+			BenchStat statAppend;
+			CXYPlotImpl *pPlot = BuildPlot(sizes[s], curves[c], statAppend);
+			Report("append", sizes[s], curves[c], statAppend);
+
+			BenchDataRange(pPlot, sizes[s], curves[c]);
+			if(curves[c]>1)BenchGetIndex(pPlot, sizes[s], curves[c]);
+			BenchDraw(pPlot, sizes[s], curves[c]);
+			BenchBinaryFile(pPlot, sizes[s], curves[c]);
+			BenchTextWrite(pPlot, sizes[s], curves[c]);
+			if(curves[c]==1)BenchMedian(pPlot, sizes[s], curves[c]);
+
+			delete pPlot;
+		}
+		BenchReadBuff(sizes[s]);
+		BenchTimeParse(sizes[s]);
+		BenchTransform(sizes[s]);
+	}
+
+	BenchMultiDraw(nMaxPoints);
+	BenchIngest(nMaxPoints);
+
+	const int grids[] = {128, 256, 512, 1024};
+	for(s=0; s<(int)(sizeof(grids)/sizeof(int)); s++)
+	{
+		BenchContour(grids[s]);
+	}
+
+	fclose(g_pOut);
+	return nFailed>0 ? 2 : 0;
+}
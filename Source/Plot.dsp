@@ -272,6 +272,10 @@ SOURCE=.\Plot\Basic\Canvas.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\Plot\Basic\BinaryDataFile.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\Plot\Basic\CanvasImpl.cpp
 # End Source File
 # Begin Source File
@@ -492,6 +496,34 @@ SOURCE=.\Plot\Basic\DragStatus.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\Plot\Basic\DrawSurface.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\DrawWorkerPool.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\DrawStats.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\TimeParser.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\TextDataWriter.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\TextFileReader.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\NumberFormat.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\Plot\Accessary\Numerical\libf2c\endfile.c
 # End Source File
 # Begin Source File
@@ -604,6 +636,10 @@ SOURCE=.\Plot\Extended\HugePlot\HugePlotImpl.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\Plot\Extended\HugePlot\HugePyramid.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\Plot\Basic\Handlers\ContextMenu\ImagePopup.cpp
 # End Source File
 # Begin Source File
@@ -916,6 +952,10 @@ SOURCE=.\Plot\Extended\PlotWnd\PlotWnd.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\Plot\Extended\PlotWnd\RedrawScheduler.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\Plot\Extended\PolarPlot\PolarPlot.cpp
 # End Source File
 # Begin Source File
@@ -1004,6 +1044,14 @@ SOURCE=.\Plot\Instruments\Ruler\RulerImpl.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\Plot\Basic\ScreenHitGrid.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\ScreenTransform.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\Plot\Instruments\ScrollBar\ScrollBar.cpp
 # End Source File
 # Begin Source File
@@ -1400,6 +1448,10 @@ SOURCE=.\Plot\Basic\Canvas.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\Plot\Basic\BinaryDataFile.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\Plot\Basic\CanvasImpl.h
 # End Source File
 # Begin Source File
@@ -1616,6 +1668,38 @@ SOURCE=.\Plot\Basic\DragStatus.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\Plot\Basic\DrawSurface.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\DrawWorkerPool.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\DrawStats.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\TimeParser.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\TextDataWriter.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\TextFileReader.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\NumberFormat.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\IngestQueue.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\Plot\Basic\Handlers\Dialogs\DefPlotSettingDialogs\ExtraFunctionDlg.h
 # End Source File
 # Begin Source File
@@ -1708,6 +1792,10 @@ SOURCE=.\Plot\Extended\HugePlot\HugePlotImpl.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\Plot\Extended\HugePlot\HugePyramid.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\Plot\Basic\Handlers\ContextMenu\ImagePopup.h
 # End Source File
 # Begin Source File
@@ -2036,6 +2124,10 @@ SOURCE=.\Plot\Extended\PlotWnd\PlotWnd.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\Plot\Extended\PlotWnd\RedrawScheduler.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\Plot\Extended\PolarPlot\PolarPlot.h
 # End Source File
 # Begin Source File
@@ -2128,6 +2220,14 @@ SOURCE=.\Plot\Instruments\Ruler\RulerImpl.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\Plot\Basic\ScreenHitGrid.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Plot\Basic\ScreenTransform.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\Plot\Instruments\ScrollBar\ScrollBar.h
 # End Source File
 # Begin Source File
@@ -34,10 +34,13 @@ public:
 protected:
 	CAxisImpl	*NewAxis( );
 	RECT		AdjustByAxes(HDC hDC, RECT destRect, RECT plotRect);
+	// Room of the axes only, the labels are not padded
+	RECT		AdjustByAxes(CDrawSurface *pSurface, RECT destRect, RECT plotRect);
 	RECT		AdjustByPadding(HDC hDC, RECT destRect, RECT plotRect);
 
 public:
 	virtual	void	DrawAxes(HDC hDC);
+	void		DrawAxes(CDrawSurface *pSurface);
 
 public:
 	SIZE		GetAxisSize( HDC hDC, int location );
@@ -67,6 +70,16 @@ CAxisImpl *CAxesImpl<PlotImplT>::NewAxis()
 
 template<class PlotImplT>
 RECT	CAxesImpl<PlotImplT>::AdjustByAxes(HDC hDC, RECT destRect, RECT plotRect)
+{
+	CGdiSurface surface(hDC);
+	plotRect = AdjustByAxes(&surface, destRect, plotRect);
+	plotRect = AdjustByPadding(hDC, destRect, plotRect);
+	
+	return plotRect;
+}
+
+template<class PlotImplT>
+RECT	CAxesImpl<PlotImplT>::AdjustByAxes(CDrawSurface *pSurface, RECT destRect, RECT plotRect)
 {
 	PlotImplT* pT = static_cast<PlotImplT*>(this);
 	CAxisImpl *axis;
@@ -79,7 +92,7 @@ RECT	CAxesImpl<PlotImplT>::AdjustByAxes(HDC hDC, RECT destRect, RECT plotRect)
 		axis = (m_vpAxis[i]);
 		if(!axis->IsVisible())continue;
 		
-		minSize = axis->GetMinDisplaySize(hDC);
+		minSize = axis->GetMinDisplaySize(pSurface);
 		switch(axis->GetLocation())
 		{
 		case kLocationLeft:
@@ -96,8 +109,6 @@ RECT	CAxesImpl<PlotImplT>::AdjustByAxes(HDC hDC, RECT destRect, RECT plotRect)
 			break;
 		}
 	}
-
-	plotRect = AdjustByPadding(hDC, destRect, plotRect);
 	
 	return plotRect;
 }
@@ -159,6 +170,16 @@ void	CAxesImpl<PlotImplT>::DrawAxes(HDC hDC)
 	}
 }
 
+template<class PlotImplT>
+void	CAxesImpl<PlotImplT>::DrawAxes(CDrawSurface *pSurface)
+{
+	unsigned int i;
+	for(i=0; i<m_vpAxis.size(); i++)
+	{
+		m_vpAxis[i]->OnDraw(pSurface);
+	}
+}
+
 template<class PlotImplT>
 SIZE	CAxesImpl<PlotImplT>::GetAxisSize(HDC hDC, int location)
 {
@@ -350,6 +350,12 @@ int	CAxisImpl::GetMaxTickLength()
 
 
 SIZE CAxisImpl::GetRealTickLabelDimension(HDC hDC)//, RECT chartRect)
+{
+	CGdiSurface surface(hDC);
+	return GetRealTickLabelDimension(&surface);
+}
+
+SIZE CAxisImpl::GetRealTickLabelDimension(CDrawSurface *pSurface)
 {
 	RECT chartRect = GetPlot()->GetLastPlotRect();
 
@@ -372,11 +378,12 @@ SIZE CAxisImpl::GetRealTickLabelDimension(HDC hDC)//, RECT chartRect)
 	while( keepGoing == true )
 	{
 		nMaxLabelWidth=0;
+		pSurface->SetFont(logFont);
 		for(i=0; i<nTicks+2; i++)
 		{
 			tickLabel=GetMajorTickLabel(i);
 			//GetTextExtentPoint(hDC, tickLabel.c_str(),tickLabel.length(),&labelExtent );
-			MyGetTextExtentPoint(hDC, &logFont, tickLabel, 0, &labelExtent );
+			labelExtent = pSurface->MeasureString(tickLabel.c_str(), (int)tickLabel.length());
 			if(labelExtent.cx>nMaxLabelWidth)nMaxLabelWidth=labelExtent.cx;
 		}
 		if(IsXAxis())
@@ -702,6 +709,23 @@ void CAxisImpl::OnDraw(HDC hDC)//, RECT clientRect, RECT chartRect)
 	DrawSNPower(hDC);//, clientRect, chartRect);
 }
 
+// Without a device only the line, the ticks and the labels are drawn
+void CAxisImpl::OnDraw(CDrawSurface *pSurface)
+{
+	if(!m_bVisible) return;
+
+	if(m_bIndependent)
+	{
+		m_pPlotIndep->SetLastClientRect(m_pPlotDep->GetLastClientRect());
+		m_pPlotIndep->SetLastPlotRect(m_pPlotDep->GetLastPlotRect());
+	}
+
+	DrawAxisLine(pSurface);
+	DrawMajorTicks(pSurface);
+	DrawMinorTicks(pSurface);
+	DrawTickLabels(pSurface);
+}
+
 
 void	CAxisImpl::DrawFrame(HDC hDC)//, RECT clientRect, RECT chartRect)
 {
@@ -853,6 +877,12 @@ void CAxisImpl::DrawTitle(HDC hDC)//, RECT clientRect, RECT chartRect)
 
 
 void CAxisImpl::DrawAxisLine(HDC hDC)//, RECT clientRect, RECT chartRect)
+{
+	CGdiSurface surface(hDC);
+	DrawAxisLine(&surface);
+}
+
+void CAxisImpl::DrawAxisLine(CDrawSurface *pSurface)
 {
 	if(!m_bShowAxisLine)return;
 	
@@ -867,41 +897,30 @@ void CAxisImpl::DrawAxisLine(HDC hDC)//, RECT clientRect, RECT chartRect)
 	if(m_bColorBar)
 		chartRect = GetPseudoChartRect( );//chartRect);
 
-	HPEN		hPen,hOldPen;
-
-	hPen = CreatePen( m_nLineStyle, m_nLineSize, m_crAxisColor );
-	hOldPen = (HPEN)SelectObject(hDC,hPen);
+	pSurface->SetPen( m_crAxisColor, m_nLineSize, m_nLineStyle );
 	//firstly, draw the axis line
 	switch( GetLocation() )
 	{
 	case kLocationLeft:
-		MoveToEx(hDC,chartRect.left - m_nAxisGap, chartRect.bottom,NULL);
-		LineTo(hDC,chartRect.left - m_nAxisGap, chartRect.top);
+		pSurface->DrawLine(chartRect.left - m_nAxisGap, chartRect.bottom, chartRect.left - m_nAxisGap, chartRect.top);
 		break;
 	case kLocationRight:
-		MoveToEx(hDC,chartRect.right + m_nAxisGap, chartRect.bottom,NULL);
-		LineTo(hDC,chartRect.right + m_nAxisGap, chartRect.top);
+		pSurface->DrawLine(chartRect.right + m_nAxisGap, chartRect.bottom, chartRect.right + m_nAxisGap, chartRect.top);
 		break;
 	case kLocationBottom:
-		MoveToEx(hDC,chartRect.left, chartRect.bottom + m_nAxisGap,NULL);
-		LineTo(hDC,chartRect.right, chartRect.bottom + m_nAxisGap);
+		pSurface->DrawLine(chartRect.left, chartRect.bottom + m_nAxisGap, chartRect.right, chartRect.bottom + m_nAxisGap);
 		break;
 	case kLocationTop:
-		MoveToEx(hDC,chartRect.left, chartRect.top - m_nAxisGap, NULL);
-		LineTo(hDC,chartRect.right, chartRect.top - m_nAxisGap );
+		pSurface->DrawLine(chartRect.left, chartRect.top - m_nAxisGap, chartRect.right, chartRect.top - m_nAxisGap);
 		break;
 	case kLocationCenterVL:
 	case kLocationCenterVR:
-		MoveToEx(hDC,(chartRect.left+chartRect.right)/2,chartRect.bottom,NULL);
-		LineTo(hDC,(chartRect.left+chartRect.right)/2,chartRect.top);
+		pSurface->DrawLine((chartRect.left+chartRect.right)/2, chartRect.bottom, (chartRect.left+chartRect.right)/2, chartRect.top);
 	case kLocationCenterHB:
 	case kLocationCenterHT:
-		MoveToEx(hDC,chartRect.left,(chartRect.top+chartRect.bottom)/2,NULL);
-		LineTo(hDC,chartRect.right,(chartRect.top+chartRect.bottom)/2);
+		pSurface->DrawLine(chartRect.left, (chartRect.top+chartRect.bottom)/2, chartRect.right, (chartRect.top+chartRect.bottom)/2);
 		break;
 	}
-	SelectObject(hDC,hOldPen);
-	DeleteObject(hPen);
 }
 
 
@@ -1110,6 +1129,12 @@ xEnd:
 
 
 void CAxisImpl::DrawMajorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
+{
+	CGdiSurface surface(hDC);
+	DrawMajorTicks(&surface);
+}
+
+void CAxisImpl::DrawMajorTicks(CDrawSurface *pSurface)
 {
 	RECT chartRect = GetPlot()->GetLastPlotRect();
 
@@ -1122,7 +1147,6 @@ void CAxisImpl::DrawMajorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
 
 	double position, range;
 
-	HPEN		hPen,hOldPen;
 	double		scale, interval, tickScale;
 	int			i;
 	long		startPoint;
@@ -1139,8 +1163,7 @@ void CAxisImpl::DrawMajorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
 		tickcolor = m_crTickColor;
 	}
 
-	hPen = CreatePen( PS_SOLID, m_nTickSize, tickcolor );
-	hOldPen = (HPEN)SelectObject(hDC,hPen);
+	pSurface->SetPen( tickcolor, m_nTickSize, PS_SOLID );
 
 	double pfRange[2];
 	if(bX) m_pPlot->GetXRange(pfRange);
@@ -1194,7 +1217,7 @@ void CAxisImpl::DrawMajorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
 			switch(m_nTickPosition)
 			{
 			case kTickPositionNone:
-				goto NoMajorTick;
+				return;
 			case kTickPositionOuter:
 				switch( GetLocation() )
 				{
@@ -1224,9 +1247,7 @@ void CAxisImpl::DrawMajorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
 				tickPoint.x = chartRect.left + (long)((position-pfRange[0]) * scale);
 			else
 				tickPoint.x = chartRect.right - (long)((position-pfRange[0]) * scale);
-			MoveToEx(hDC, tickPoint.x, tickPoint.y, NULL );
-			tickPoint.y += tickMarkLength;
-			LineTo(hDC, tickPoint.x, tickPoint.y );
+			pSurface->DrawLine(tickPoint.x, tickPoint.y, tickPoint.x, tickPoint.y + tickMarkLength);
 		}
 		else
 		{
@@ -1247,7 +1268,7 @@ void CAxisImpl::DrawMajorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
 			switch( m_nTickPosition )
 			{
 			case kTickPositionNone:
-				goto NoMajorTick;
+				return;
 			case kTickPositionOuter:
 				switch( GetLocation() )
 				{
@@ -1273,20 +1294,20 @@ void CAxisImpl::DrawMajorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
 			default:
 				tickPoint.x = startPoint - tickMarkLength/2;
 			}
-			MoveToEx(hDC, tickPoint.x, tickPoint.y, NULL );
-			tickPoint.x += tickMarkLength;
-			LineTo( hDC, tickPoint.x, tickPoint.y );
+			pSurface->DrawLine(tickPoint.x, tickPoint.y, tickPoint.x + tickMarkLength, tickPoint.y);
 		}
 
 	}
-	
-NoMajorTick:		
-	SelectObject(hDC,hOldPen);
-	DeleteObject(hPen);
 }
 
 
 void CAxisImpl::DrawMinorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
+{
+	CGdiSurface surface(hDC);
+	DrawMinorTicks(&surface);
+}
+
+void CAxisImpl::DrawMinorTicks(CDrawSurface *pSurface)
 {
 	RECT chartRect = GetPlot()->GetLastPlotRect();
 
@@ -1297,7 +1318,6 @@ void CAxisImpl::DrawMinorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
 
 	double position, range;
 	
-	HPEN		hPen,hOldPen;
 	double		scale, interval,tickScale;
 	int			i,j;
 	long		startPoint;
@@ -1315,8 +1335,7 @@ void CAxisImpl::DrawMinorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
 		minortickcolor = m_crTickColor;
 	}
 	
-	hPen = CreatePen( PS_SOLID, m_nMinorTickSize, minortickcolor );
-	hOldPen = (HPEN)SelectObject(hDC,hPen);
+	pSurface->SetPen( minortickcolor, m_nMinorTickSize, PS_SOLID );
 
 	bool bX = IsXAxis() ;
 	bool bFloat = (bX?m_pPlot->IsFloatXTicks():m_pPlot->IsFloatYTicks());
@@ -1435,9 +1454,7 @@ void CAxisImpl::DrawMinorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
 				default:
 					tickPoint.y = startPoint - minorTickMarkLength/2;
 				}
-				MoveToEx(hDC, tickPoint.x, tickPoint.y, NULL );
-				tickPoint.y += minorTickMarkLength;
-				LineTo(hDC, tickPoint.x, tickPoint.y );
+				pSurface->DrawLine(tickPoint.x, tickPoint.y, tickPoint.x, tickPoint.y + minorTickMarkLength);
 			}
 			//delete []minorPos;
 		}
@@ -1494,21 +1511,23 @@ void CAxisImpl::DrawMinorTicks(HDC hDC)//, RECT clientRect, RECT chartRect)
 				default:
 					tickPoint.x = startPoint - minorTickMarkLength/2;
 				}
-				MoveToEx(hDC, tickPoint.x, tickPoint.y, NULL );
-				tickPoint.x += minorTickMarkLength;
-				LineTo(hDC, tickPoint.x, tickPoint.y );
+				pSurface->DrawLine(tickPoint.x, tickPoint.y, tickPoint.x + minorTickMarkLength, tickPoint.y);
 			}
 			//delete []minorPos;
 		}
 	}
-	delete []minorPos;
 NoMinorTick:
-	SelectObject(hDC,hOldPen);
-	DeleteObject(hPen);
+	delete []minorPos;
 }
 
 
 void CAxisImpl::DrawTickLabels(HDC hDC)//, RECT clientRect, RECT chartRect)
+{
+	CGdiSurface surface(hDC);
+	DrawTickLabels(&surface);
+}
+
+void CAxisImpl::DrawTickLabels(CDrawSurface *pSurface)
 {
 	RECT chartRect = GetPlot()->GetLastPlotRect();
 
@@ -1521,11 +1540,8 @@ void CAxisImpl::DrawTickLabels(HDC hDC)//, RECT clientRect, RECT chartRect)
 
 	double position, range;
 	
-	HFONT		hFont,hOldFont;
 	LOGFONT		logFont;
 	RECT			textRect;
-	SIZE			tmSize={0,0};
-	unsigned int	textMode;
 	int				maxTickLength;
 	double		scale, interval,tickScale;
 	int			i,sign;
@@ -1548,14 +1564,13 @@ void CAxisImpl::DrawTickLabels(HDC hDC)//, RECT clientRect, RECT chartRect)
 	// the following functin is called in GetTitleRect
 	// when no title, the following function do not execute, we cannot get a good ticklabelheight
 	if(m_strTitle==_TEXT(""))
-		GetRealTickLabelDimension(hDC);//, chartRect);
+		GetRealTickLabelDimension(pSurface);//, chartRect);
 	
 	// now ready
 	logFont = m_lfLabelFont;
 	logFont.lfHeight = m_nRealTickLabelHeight;
 
-	hFont = CreateFontIndirect( &logFont );
-	hOldFont = (HFONT)SelectObject(hDC,hFont);
+	pSurface->SetFont( logFont );
 
 	bool bX = IsXAxis() ;
 	bool bFloat = (bX?m_pPlot->IsFloatXTicks():m_pPlot->IsFloatYTicks());
@@ -1581,27 +1596,7 @@ void CAxisImpl::DrawTickLabels(HDC hDC)//, RECT clientRect, RECT chartRect)
 	tickMarkLength = GetMaxTickLength();//m_nTickLength;
 	
 	// Setup of ranges, pens
-	int nOldBkMode = SetBkMode(hDC, TRANSPARENT );
-	COLORREF crOldColor = SetTextColor(hDC, ticklabelcolor );
-
-	if(IsXAxis())
-	{
-		textMode = DT_NOCLIP | DT_CENTER ;
-		if(GetLocation() == kLocationBottom || GetLocation() == kLocationCenterHB)
-			textMode |= DT_TOP;
-		else
-			textMode |= DT_BOTTOM;
-	}
-	else
-	{
-		textMode = DT_NOCLIP | DT_VCENTER;
-		//if(GetLocation() == kLocationRight || GetLocation() == kLocationCenterVR)
-		//	textMode |= DT_LEFT;
-		//else
-		//	textMode |= DT_RIGHT;
-		textMode |= DT_CENTER;
-		// Don't calculate tickHeight here because it is calculated later
-	}
+	pSurface->SetTextColor( ticklabelcolor );
 	
 	// For moving our labels and titles, we need to be away
 	// from the longest tick mark
@@ -1658,7 +1653,7 @@ void CAxisImpl::DrawTickLabels(HDC hDC)//, RECT clientRect, RECT chartRect)
 			
 			tickLabel = GetMajorTickLabel( i );
 			//
-			MyGetTextExtentPoint(hDC, &logFont, tickLabel, 0, &labelExtent);
+			labelExtent = pSurface->MeasureString(tickLabel.c_str(), (int)tickLabel.length());
 			textRect.left = tickPoint.x - labelExtent.cx/2;
 			textRect.right = tickPoint.x + labelExtent.cx/2;
 			
@@ -1681,7 +1676,7 @@ void CAxisImpl::DrawTickLabels(HDC hDC)//, RECT clientRect, RECT chartRect)
 			OffsetRect(&textRect, m_sizeLabelOffset.cx, m_sizeLabelOffset.cy);// Adding offset
 			
 			//
-			DrawText(hDC, tickLabel.c_str(), (int)tickLabel.length(), (LPRECT)&textRect, textMode );
+			pSurface->DrawString(textRect.left, textRect.top, tickLabel.c_str(), (int)tickLabel.length());
 
 		}
 		else
@@ -1705,10 +1700,8 @@ void CAxisImpl::DrawTickLabels(HDC hDC)//, RECT clientRect, RECT chartRect)
 			//tickPoint.x = startPoint - sign*tickMarkLength/2;
 			tickPoint.x = startPoint - sign*(tickMarkLength + m_nLabelGap);
 			tickLabel = GetMajorTickLabel( i );
-			//TEST
-			TCHAR *str = (TCHAR *)tickLabel.c_str();
 			//
-			MyGetTextExtentPoint(hDC, &logFont, tickLabel, 0, &labelExtent);
+			labelExtent = pSurface->MeasureString(tickLabel.c_str(), (int)tickLabel.length());
 			textRect.top = tickPoint.y - labelExtent.cy/2;
 			textRect.bottom = tickPoint.y + labelExtent.cy/2;
 			
@@ -1723,11 +1716,12 @@ void CAxisImpl::DrawTickLabels(HDC hDC)//, RECT clientRect, RECT chartRect)
 				textRect.right = textRect.left + labelExtent.cx;
 			}
 
-			if(m_bSciNotation && GetPowerMag()!=0)
+			// the power is drawn by GDI only
+			if(m_bSciNotation && GetPowerMag()!=0 && pSurface->GetDC())
 			{
 				if(m_nLocation == kLocationLeft || m_nLocation == kLocationCenterVL)
 				{
-					SIZE sizeSN = GetSizeSN(hDC);
+					SIZE sizeSN = GetSizeSN(pSurface->GetDC());
 					OffsetRect(&textRect, -sizeSN.cx, 0);
 				}
 				
@@ -1735,15 +1729,10 @@ void CAxisImpl::DrawTickLabels(HDC hDC)//, RECT clientRect, RECT chartRect)
 
 			OffsetRect(&textRect, m_sizeLabelOffset.cx, m_sizeLabelOffset.cy);// Adding offset
 			
-			DrawText(hDC, tickLabel.c_str(), (int)tickLabel.length(), (LPRECT)&textRect, textMode );
+			pSurface->DrawString(textRect.left, textRect.top, tickLabel.c_str(), (int)tickLabel.length());
 
 		}
 	}
-	
-	SetBkMode(hDC, nOldBkMode);
-	SetTextColor(hDC, crOldColor);
-	SelectObject( hDC, hOldFont);
-	DeleteObject( hFont );
 }
 
 
@@ -1902,11 +1891,9 @@ void	CAxisImpl::DrawSNPower(HDC hDC)//, RECT clientRect, RECT chartRect)
 	hFont = CreateFontIndirect( &logFont );
 	SelectObject(hDC, hFont);
 
-	tostringstream tostr;
-	tstring strSP;
-	tostr<<GetPowerMag();
-	strSP = tostr.str();
-	DrawText(hDC, strSP.c_str(), (int)strSP.length(), (LPRECT)&spRect, textMode );
+	TCHAR strSP[CNumberFormat::kMinBuffSize];
+	int nLenSP = CNumberFormat::FormatG(strSP, GetPowerMag(), 17);
+	DrawText(hDC, strSP, nLenSP, (LPRECT)&spRect, textMode );
 
 	SelectObject(hDC, hOldFont);
 	DeleteObject(hFont);
@@ -1946,6 +1933,12 @@ tstring	CAxisImpl::GetTimeString(time_t theTime)
 // of the main chart when an axis is near.
 
 SIZE	CAxisImpl::GetMinDisplaySize( HDC hDC )
+{
+	CGdiSurface surface(hDC);
+	return GetMinDisplaySize(&surface);
+}
+
+SIZE	CAxisImpl::GetMinDisplaySize( CDrawSurface *pSurface )
 {
 	SIZE		minSize={0,0};
 	int			i;
@@ -1955,7 +1948,8 @@ SIZE	CAxisImpl::GetMinDisplaySize( HDC hDC )
 	//if( m_strTitle != "" )
 	if( m_bShowTitle && m_strTitle != _TEXT("") )//  && m_nTitlePosition==0)
 	{
-		MyGetTextExtentPoint(hDC, &m_lfTitleFont, m_strTitle, 0, &minSize);
+		pSurface->SetFont(m_lfTitleFont);
+		minSize = pSurface->MeasureString(m_strTitle.c_str(), (int)m_strTitle.length());
 
 		// for y and title not verticle
 		if(!IsXAxis() && !m_bYTitleVerticle)
@@ -1980,11 +1974,12 @@ SIZE	CAxisImpl::GetMinDisplaySize( HDC hDC )
 			while( keepGoing == true )
 			{
 				int nMaxLabelWidth=0;
+				pSurface->SetFont(logFont);
 				for(i=0; i<nTicks+2; i++)
 				{
 					tickLabel=GetMajorTickLabel(i);
 					//GetTextExtentPoint(hDC, tickLabel.c_str(),tickLabel.length(),&labelExtent );
-					MyGetTextExtentPoint(hDC, &logFont, tickLabel, 0, &labelExtent );
+					labelExtent = pSurface->MeasureString(tickLabel.c_str(), (int)tickLabel.length());
 					if(labelExtent.cx>nMaxLabelWidth)nMaxLabelWidth=labelExtent.cx;
 				}
 				if(bX)
@@ -2008,11 +2003,12 @@ SIZE	CAxisImpl::GetMinDisplaySize( HDC hDC )
 
 		SIZE		temp={0,0}, temp2={0,0};
 		tstring strLabel;
+		pSurface->SetFont(logFont);
 		for( i = 0; i <= nTicks+1; i++ )
 		{
 			strLabel = GetMajorTickLabel(i);
 			//MyGetTextExtentPoint(hDC, &m_lfLabelFont, strLabel, 0,&temp);
-			MyGetTextExtentPoint(hDC, &logFont, strLabel, 0,&temp);
+			temp = pSurface->MeasureString(strLabel.c_str(), (int)strLabel.length());
 			
 			// special
 			if(bX && IsTwoStoreyX())temp.cy*=2;
@@ -2027,11 +2023,11 @@ SIZE	CAxisImpl::GetMinDisplaySize( HDC hDC )
 		else
 		{ minSize.cx += temp2.cx + m_nMarginHorizontal; minSize.cy += temp2.cy + m_nMarginHorizontal; }
 
-		if(m_bSciNotation && GetPowerMag()!=0)
+		if(m_bSciNotation && GetPowerMag()!=0 && pSurface->GetDC())
 		{
 			if(!bX)
 			{
-				SIZE sizeSN = GetSizeSN(hDC);
+				SIZE sizeSN = GetSizeSN(pSurface->GetDC());
 				minSize.cy += sizeSN.cx;
 			}
 		}
@@ -2278,30 +2274,33 @@ tstring		CAxisImpl::GetMajorTickLabel( int whichTick )
 		if(!m_bTime)
 		{
 			TCHAR tstr[64];
+			m_fmtLabel.SetFormat(m_strLabelFormat);
 			if(!bLog)
 			{
-#if defined(_MSC_VER) && (_MSC_VER>=1300)
-				_stprintf_s(tstr, 64, m_strLabelFormat.c_str(), value);
-#else
-				_stprintf(tstr, m_strLabelFormat.c_str(), value);
-#endif
+				m_fmtLabel.Format(tstr, 64, value);
 			}
 			else
 			{
-#if defined(_MSC_VER) && (_MSC_VER>=1300)
-				_stprintf_s(tstr, 64, m_strLabelFormat.c_str(), pow(10.0, value));
-#else
-				_stprintf(tstr, m_strLabelFormat.c_str(), pow(10.0, value));
-#endif
+				m_fmtLabel.Format(tstr, 64, pow(10.0, value));
 			}
 			tickLabel = tstr;
 		}
 		else
 		{
-			//for safety
-			if(value<0.0)value=0.0;
+			// seconds from the time origin, the step gives the digits of the second
+			__int64 nOrigin = bX?m_pPlot->GetXTimeOrigin():m_pPlot->GetYTimeOrigin();
+			__int64 nStep = bX?m_pPlot->GetXTimeStep():m_pPlot->GetYTimeStep();
+			if(nStep <= 0)
+			{
+				// no time ticks, take the spacing of the ticks to three significant digits
+				double fSpacing = fabs(m_pPlot->GetMajorTickPosValue( bX?0:1, 1 ) - m_pPlot->GetMajorTickPosValue( bX?0:1, 0 ));
+				nStep = (__int64)floor(fSpacing*1.0e9 + 0.5);
+				__int64 nRound = 1;
+				while(nStep/nRound >= 1000)nRound *= 10;
+				nStep = (nStep + nRound/2)/nRound*nRound;
+			}
 			//tickLabel = GetTimeString((time_t)value);
-			MyTime2Str((time_t)value, tickLabel, m_strTimeFormat);
+			MyTimeNs2Str(nOrigin + (__int64)floor(value*1.0e9 + 0.5), nStep, tickLabel, m_strTimeFormat);
 		}
 	}
 	else
@@ -2347,12 +2346,12 @@ SIZE		CAxisImpl::GetSizePower(HDC hDC)
 	logFont.lfHeight = m_nRealTickLabelHeight;
 	
 	
-	tostringstream	tostr;
+	TCHAR			strPowerBuff[CNumberFormat::kMinBuffSize];
 	tstring			strPower;
 	SIZE			sizePower={0,0};
 	
-	tostr<<GetPowerMag();
-	strPower = tostr.str();
+	CNumberFormat::FormatG(strPowerBuff, GetPowerMag(), 17);
+	strPower = strPowerBuff;
 	logFont.lfHeight = long(logFont.lfHeight*m_fSnFontRatio);
 	MyGetTextExtentPoint(hDC, &logFont, strPower, 0, &sizePower );
 	
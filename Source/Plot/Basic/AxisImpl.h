@@ -22,6 +22,8 @@
 #include "Axis.h"
 
 #include "Global.h"
+#include "NumberFormat.h"
+#include "DrawSurface.h"
 #include "../Resources/PlotResources.h"
 #include <time.h>
 
@@ -42,6 +44,9 @@ protected:
 	bool		m_bIndependent;
 	CPlotImpl	*m_pPlotDep, *m_pPlotIndep;
 
+	// the label format parsed once, until it changes
+	CNumberFormat	m_fmtLabel;
+
 public:
 	bool		IsIndependent();
 	void		SetIndependent(bool indep);
@@ -53,6 +58,7 @@ public:
 	CPlotImpl	*GetPlotIndep(){return m_pPlotIndep;}
 	
 	void		OnDraw( HDC hDC );
+	void		OnDraw( CDrawSurface *pSurface );
 		
 	tstring		GetMajorTickLabel( int whichTick );
 	
@@ -61,6 +67,7 @@ public:
 	RECT		GetBarRect( HDC hDC );
 	
 	SIZE		GetMinDisplaySize( HDC hDC );
+	SIZE		GetMinDisplaySize( CDrawSurface *pSurface );
 	SIZE		GetPaddingSize( HDC hDC, RECT chartRect );
 	SIZE		GetPaddingSize( HDC hDC );
 	SIZE		GetPaddingSizeForFloatTicks( HDC hDC, RECT chartRect );
@@ -73,6 +80,7 @@ public:
 protected:
 	int			GetMaxTickLength();
 	SIZE		GetRealTickLabelDimension(HDC hDC);
+	SIZE		GetRealTickLabelDimension(CDrawSurface *pSurface);
 	int			GetRealTitleHeight(HDC hDC);
 	RECT		GetTitleRect(HDC hDC);
 	RECT		GetPseudoChartRect( );
@@ -80,10 +88,14 @@ protected:
 	void		DrawFrame(HDC hDC);
 	void		DrawTitle(HDC hDC);
 	void		DrawAxisLine(HDC hDC);
+	void		DrawAxisLine(CDrawSurface *pSurface);
 	void		DrawAxisArrows(HDC hDC);
 	void		DrawMajorTicks(HDC hDC);
 	void		DrawMinorTicks(HDC hDC);
 	void		DrawTickLabels(HDC hDC);
+	void		DrawMajorTicks(CDrawSurface *pSurface);
+	void		DrawMinorTicks(CDrawSurface *pSurface);
+	void		DrawTickLabels(CDrawSurface *pSurface);
 	void		DrawColorBar(HDC hDC);
 	void		DrawArrow(HDC hDC, POINT point, bool bHor, HPEN hPen, HBRUSH hBrush, bool bEnd);
 	void		DrawSNPower(HDC hDC);
@@ -0,0 +1,292 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+//#include "StdAfx.h"
+#include "BinaryDataFile.h"
+
+using namespace NsCChart;
+
+static __int64	GetCurveBytes(int nTitleLen, __int64 nCount, int nDims)
+{
+	__int64 nTitleBytes = ((__int64)nTitleLen * 2 + 7) / 8 * 8;
+	return nTitleBytes + nCount * nDims * sizeof(double);
+}
+
+CBinaryDataFile::CBinaryDataFile()
+{
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_hMapping = NULL;
+	m_nSize = 0;
+	memset(&m_header, 0, sizeof(CCBinHeader));
+	m_pView = 0;
+	m_nMapped = -1;
+	m_pColumns = 0;
+}
+
+CBinaryDataFile::~CBinaryDataFile()
+{
+	Close();
+}
+
+bool	CBinaryDataFile::IsBinaryFile(tstring pathName)
+{
+	HANDLE hFile = CreateFile(pathName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(hFile == INVALID_HANDLE_VALUE)return false;
+	
+	char magic[8];
+	DWORD nRead = 0;
+	bool ret = ReadFile(hFile, magic, 8, &nRead, NULL) && nRead == 8 && memcmp(magic, kCCBinMagic, 8) == 0;
+	CloseHandle(hFile);
+	return ret;
+}
+
+bool	CBinaryDataFile::Write(tstring pathName, std::vector<CPlotData<DataPoint2D> *> &vpData, std::vector<std::vector<double> *> *pvpZ)
+{
+	int nCurves = (int)vpData.size();
+	if(nCurves <= 0)return false;
+	if(pvpZ && (int)pvpZ->size() != nCurves)return false;
+	
+	CCBinHeader header;
+	memset(&header, 0, sizeof(CCBinHeader));
+	memcpy(header.magic, kCCBinMagic, 8);
+	header.nVersion = kCCBinVersion;
+	header.nDims = pvpZ ? 3 : 2;
+	header.nCurves = nCurves;
+	
+	std::vector<CCBinCurve> vCurves(nCurves);
+	std::vector<wstring> vTitles(nCurves);
+	__int64 nOffset = sizeof(CCBinHeader) + nCurves * sizeof(CCBinCurve);
+	int i, j, k, dim;
+	for(i=0; i<nCurves; i++)
+	{
+#if defined(_UNICODE) || defined(UNICODE)
+		vTitles[i] = vpData[i]->GetTitle();
+#else
+		mymbs2wcs(vpData[i]->GetTitle(), vTitles[i]);
+#endif
+		CCBinCurve &curve = vCurves[i];
+		memset(&curve, 0, sizeof(CCBinCurve));
+		curve.nDataID = vpData[i]->GetDataID();
+		curve.nFlags = vpData[i]->IsAutoColor() ? kCCBinAutoColor : 0;
+		curve.crColor = vpData[i]->GetDataColor();
+		curve.nTitleLen = (int)vTitles[i].length();
+		curve.nCount = vpData[i]->GetDataCount();
+		curve.nOffset = nOffset;
+		nOffset += GetCurveBytes(curve.nTitleLen, curve.nCount, header.nDims);
+	}
+	
+	ofstream ofs;
+#if defined(_UNICODE) || defined(UNICODE)
+	string name;
+	if(!mywcs2mbs(pathName, name))return false;
+	ofs.open(name.c_str(), ios::out | ios::binary);
+#else
+	ofs.open(pathName.c_str(), ios::out | ios::binary);
+#endif
+	if(!ofs.is_open())return false;
+	
+	ofs.write((const char *)&header, sizeof(CCBinHeader));
+	ofs.write((const char *)&vCurves[0], nCurves * sizeof(CCBinCurve));
+	
+	// the columns are written through a small buffer
+	const int nBuff = 4096;
+	double pBuff[nBuff];
+	unsigned short ch;
+	char pad[8] = {0};
+	for(i=0; i<nCurves; i++)
+	{
+		for(j=0; j<vCurves[i].nTitleLen; j++)
+		{
+			ch = (unsigned short)vTitles[i][j];
+			ofs.write((const char *)&ch, 2);
+		}
+		ofs.write(pad, (8 - vCurves[i].nTitleLen * 2 % 8) % 8);
+		
+		int nCount = (int)vCurves[i].nCount;
+		std::vector<double> *pvZ = pvpZ ? (*pvpZ)[i] : 0;
+		for(dim=0; dim<header.nDims; dim++)
+		{
+			for(j=0; j<nCount; j+=nBuff)
+			{
+				int nLen = (nCount - j < nBuff) ? nCount - j : nBuff;
+				for(k=0; k<nLen; k++)
+				{
+					if(dim < 2)pBuff[k] = vpData[i]->GetDataAt(j+k).val[dim];
+					else pBuff[k] = (pvZ && j+k < (int)pvZ->size()) ? (*pvZ)[j+k] : 0.0;
+				}
+				ofs.write((const char *)pBuff, nLen * sizeof(double));
+			}
+		}
+	}
+	
+	bool ret = ofs.good();
+	ofs.close();
+	return ret;
+}
+
+bool	CBinaryDataFile::Open(tstring pathName)
+{
+	Close();
+	
+	m_hFile = CreateFile(pathName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(m_hFile == INVALID_HANDLE_VALUE)return false;
+	
+	DWORD nHigh = 0, nRead = 0;
+	DWORD nLow = GetFileSize(m_hFile, &nHigh);
+	m_nSize = ((__int64)nHigh << 32) | nLow;
+	
+	// the headers are small, read them directly
+	if( !ReadFile(m_hFile, &m_header, sizeof(CCBinHeader), &nRead, NULL) || nRead != sizeof(CCBinHeader) ||
+		memcmp(m_header.magic, kCCBinMagic, 8) != 0 || m_header.nVersion < 1 || m_header.nVersion > kCCBinVersion ||
+		m_header.nDims < 2 || m_header.nDims > 3 || m_header.nCurves <= 0 ||
+		sizeof(CCBinHeader) + (__int64)m_header.nCurves * sizeof(CCBinCurve) > m_nSize )
+	{
+		Close();
+		return false;
+	}
+	m_vCurves.resize(m_header.nCurves);
+	if( !ReadFile(m_hFile, &m_vCurves[0], m_header.nCurves * sizeof(CCBinCurve), &nRead, NULL) || nRead != m_header.nCurves * sizeof(CCBinCurve) )
+	{
+		Close();
+		return false;
+	}
+	
+	int i;
+	for(i=0; i<m_header.nCurves; i++)
+	{
+		CCBinCurve &curve = m_vCurves[i];
+		if( curve.nTitleLen < 0 || curve.nCount < 0 || curve.nCount > 0x7FFFFFFF || curve.nOffset % 8 != 0 ||
+			curve.nOffset < 0 || curve.nOffset + GetCurveBytes(curve.nTitleLen, curve.nCount, m_header.nDims) > m_nSize )
+		{
+			Close();
+			return false;
+		}
+	}
+	
+	m_hMapping = CreateFileMapping(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if(!m_hMapping)
+	{
+		Close();
+		return false;
+	}
+	
+	return true;
+}
+
+void	CBinaryDataFile::Close()
+{
+	UnmapCurve();
+	if(m_hMapping)
+	{
+		CloseHandle(m_hMapping);
+		m_hMapping = NULL;
+	}
+	if(m_hFile != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_hFile);
+		m_hFile = INVALID_HANDLE_VALUE;
+	}
+	m_nSize = 0;
+	memset(&m_header, 0, sizeof(CCBinHeader));
+	m_vCurves.clear();
+}
+
+bool	CBinaryDataFile::MapCurve(int which)
+{
+	if(which < 0 || which >= GetCurveCount())return false;
+	if(which == m_nMapped)return true;
+	UnmapCurve();
+	
+	CCBinCurve &curve = m_vCurves[which];
+	__int64 nBytes = GetCurveBytes(curve.nTitleLen, curve.nCount, m_header.nDims);
+	
+	// a view must start at a multiple of the allocation granularity
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	__int64 nStart = curve.nOffset / si.dwAllocationGranularity * si.dwAllocationGranularity;
+	__int64 nLen = curve.nOffset - nStart + nBytes;
+	
+	m_pView = MapViewOfFile(m_hMapping, FILE_MAP_READ, (DWORD)(nStart >> 32), (DWORD)(nStart & 0xFFFFFFFF), nLen > 0xFFFFFFFF ? 0 : (DWORD)nLen);
+	if(!m_pView)return false;
+	m_nMapped = which;
+	
+	const char *pCurve = (const char *)m_pView + (curve.nOffset - nStart);
+	const unsigned short *pTitle = (const unsigned short *)pCurve;
+	wstring title;
+	int i;
+	for(i=0; i<curve.nTitleLen; i++)
+	{
+		title += (wchar_t)pTitle[i];
+	}
+#if defined(_UNICODE) || defined(UNICODE)
+	m_strTitle = title;
+#else
+	mywcs2mbs(title, m_strTitle);
+#endif
+	m_pColumns = (const double *)(pCurve + ((__int64)curve.nTitleLen * 2 + 7) / 8 * 8);
+	
+	return true;
+}
+
+void	CBinaryDataFile::UnmapCurve()
+{
+	if(m_pView)
+	{
+		UnmapViewOfFile(m_pView);
+		m_pView = 0;
+	}
+	m_nMapped = -1;
+	m_pColumns = 0;
+	m_strTitle = _TEXT("");
+}
+
+int		CBinaryDataFile::GetDataID()
+{
+	if(m_nMapped < 0)return -1;
+	return m_vCurves[m_nMapped].nDataID;
+}
+
+int		CBinaryDataFile::GetFlags()
+{
+	if(m_nMapped < 0)return 0;
+	return m_vCurves[m_nMapped].nFlags;
+}
+
+COLORREF	CBinaryDataFile::GetColor()
+{
+	if(m_nMapped < 0)return RGB(0, 0, 0);
+	return m_vCurves[m_nMapped].crColor;
+}
+
+int		CBinaryDataFile::GetPointCount()
+{
+	if(m_nMapped < 0)return 0;
+	return (int)m_vCurves[m_nMapped].nCount;
+}
+
+tstring	CBinaryDataFile::GetTitle()
+{
+	return m_strTitle;
+}
+
+const double	*CBinaryDataFile::GetColumn(int dim)
+{
+	if(m_nMapped < 0 || dim < 0 || dim >= m_header.nDims)return 0;
+	return m_pColumns + (__int64)dim * m_vCurves[m_nMapped].nCount;
+}
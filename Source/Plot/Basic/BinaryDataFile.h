@@ -0,0 +1,99 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#pragma warning(disable:4786)
+
+#include "PlotData.h"
+
+Declare_Namespace_CChart
+
+// Binary data file, little-endian
+//   CCBinHeader
+//   CCBinCurve[nCurves]
+//   for each curve, at nOffset: title in UTF-16, padded to 8 bytes, then nDims columns of nCount doubles
+const char	kCCBinMagic[8] = {'C', 'C', 'H', 'A', 'R', 'T', 'B', 0x1A};
+const int	kCCBinVersion = 1;
+
+enum
+{
+	kCCBinAutoColor = 1
+};
+
+typedef struct stCCBinHeader
+{
+	char	magic[8];
+	int		nVersion;
+	int		nDims;// 2 or 3
+	int		nCurves;
+	int		nReserved;
+}CCBinHeader;
+
+typedef struct stCCBinCurve
+{
+	int		nDataID;
+	int		nFlags;
+	COLORREF	crColor;
+	int		nTitleLen;// in UTF-16 units
+	__int64	nCount;
+	__int64	nOffset;
+}CCBinCurve;
+
+// Reads the file through a mapped view of one curve at a time, the columns are not copied
+class CBinaryDataFile
+{
+public:
+	CBinaryDataFile();
+	virtual ~CBinaryDataFile();
+
+protected:
+	HANDLE		m_hFile;
+	HANDLE		m_hMapping;
+	__int64		m_nSize;
+	CCBinHeader	m_header;
+	std::vector<CCBinCurve>	m_vCurves;
+
+	void		*m_pView;
+	int			m_nMapped;
+	const double	*m_pColumns;
+	tstring		m_strTitle;
+
+public:
+	static	bool	IsBinaryFile(tstring pathName);
+	static	bool	Write(tstring pathName, std::vector<CPlotData<DataPoint2D> *> &vpData, std::vector<std::vector<double> *> *pvpZ = 0);
+
+	bool		Open(tstring pathName);
+	void		Close();
+
+	inline	int		GetDims(){return m_header.nDims;}
+	inline	int		GetCurveCount(){return (int)m_vCurves.size();}
+
+	// the data of curve which, valid until the next MapCurve or Close
+	bool		MapCurve(int which);
+	void		UnmapCurve();
+	int			GetDataID();
+	int			GetFlags();
+	COLORREF	GetColor();
+	int			GetPointCount();
+	tstring		GetTitle();
+	const double	*GetColumn(int dim);
+};
+
+Declare_Namespace_End
@@ -19,6 +19,7 @@
 
 #pragma once
 #include "Canvas.h"
+#include "DrawSurface.h"
 
 Declare_Namespace_CChart
 
@@ -31,11 +32,14 @@ public:
 
 public:
 	void	DrawCanvas( HDC hDC );
+	// Solid colors only, images, gradients and patterns need GDI
+	void	DrawCanvas( CDrawSurface *pSurface );
 
 protected:
 	void	DrawBkgnd( HDC hDC );
 	void	DrawPlotEdge( HDC hDC );
 	virtual	void	DrawFrame( HDC hDC );
+	void	DrawFrame( CDrawSurface *pSurface );
 };
 
 template <class PlotImplT>
@@ -78,6 +82,32 @@ void	CCanvasImpl<PlotImplT>::DrawCanvas(HDC hDC)
 	DrawFrame(hDC);
 }
 
+template <class PlotImplT>
+void	CCanvasImpl<PlotImplT>::DrawCanvas(CDrawSurface *pSurface)
+{
+	PlotImplT* pT = static_cast<PlotImplT*>(this);
+
+	RECT destRect = pT->GetLastClientRect();
+	RECT plotRect = pT->GetLastPlotRect();
+
+	if(!pT->IsNothingElse() && m_bEraseBkgnd)
+	{
+		pSurface->FillRectangle(destRect, m_crBkgndColor);
+		if(m_bUseDataRegionBrush)
+			pSurface->FillRectangle(plotRect, m_crDataRegionColor);
+	}
+
+	if(m_bEdgeShow && !m_bEdgeButton && m_nEdgeSize > 0)
+	{
+		COLORREF edgecolor = pT->ChooseLineColor(m_crEdgeColor, pT->IsPlotLighted(), pT->IsPlotSelected());
+		int edgesize = pT->ChooseLineWidth(m_nEdgeSize, pT->IsPlotLighted(), pT->IsPlotSelected());
+		pSurface->SetPen(edgecolor, edgesize, m_nEdgeStyle);
+		pSurface->DrawRectangle(destRect);
+	}
+
+	DrawFrame(pSurface);
+}
+
 template <class PlotImplT>
 void	CCanvasImpl<PlotImplT>::DrawBkgnd( HDC hDC )
 {
@@ -263,6 +293,13 @@ void	CCanvasImpl<PlotImplT>::DrawPlotEdge( HDC hDC )
 
 template <class PlotImplT>
 void	CCanvasImpl<PlotImplT>::DrawFrame( HDC hDC )
+{
+	CGdiSurface surface(hDC);
+	DrawFrame(&surface);
+}
+
+template <class PlotImplT>
+void	CCanvasImpl<PlotImplT>::DrawFrame( CDrawSurface *pSurface )
 {
 	PlotImplT* pT = static_cast<PlotImplT*>(this);
 
@@ -274,20 +311,8 @@ void	CCanvasImpl<PlotImplT>::DrawFrame( HDC hDC )
 	COLORREF bordercolor = m_bLightDataRegion?pT->GetLightColor():m_crBorderColor;
 	int bordersize = m_bLightDataRegion?pT->GetLightLineSize():m_nBorderSize;
 	
-	HPEN	hPen,hOldPen;
-	HBRUSH hBrush,hOldBrush;
-	hPen = CreatePen( m_nBorderStyle, bordersize, bordercolor );
-	hBrush=(HBRUSH)GetStockObject(NULL_BRUSH);
-	
-	hOldPen = (HPEN)SelectObject(hDC, hPen);
-	hOldBrush = (HBRUSH)SelectObject(hDC,hBrush);
-	
-	Rectangle(hDC,plotRect.left,plotRect.top,plotRect.right,plotRect.bottom);
-	
-	SelectObject(hDC, hOldBrush);
-	DeleteObject(hBrush);
-	SelectObject(hDC, hOldPen );
-	DeleteObject(hPen);
+	pSurface->SetPen( bordercolor, bordersize, m_nBorderStyle );
+	pSurface->DrawRectangle( plotRect );
 }
 
 Declare_Namespace_End
\ No newline at end of file
@@ -38,6 +38,9 @@ protected:
 protected:
 	std::vector<CPlotDataImpl<DataT>* >	m_vpPlotData;
 	int					m_nCurDataID;
+	mutable std::vector<int>	m_vIndexOfID;// direct-address table from dataID to index, checked on every use
+	mutable bool		m_bIndexDirty;// the curves were changed behind the table, it is rebuilt on the next lookup
+	mutable bool		m_bIDsOffTable;// some curve has an ID the table does not hold, misses are searched
 
 	bool				m_bMultiSelect;
 
@@ -61,6 +64,7 @@ protected:
 
 	tstring				m_strFileSeparator;
 	tstring				m_strDataSeparator;
+	int					m_nTextPrecision;
 
 public:
 
@@ -93,6 +97,10 @@ public:
 public:
 	int					GetDataID( int index) const;
 	int					GetIndex( int dataID ) const;
+protected:
+	void				RebuildIndexOfID() const;
+	void				SetIndexOfID( int index ) const;
+public:
 
 	int					GetSelectedID();
 	int					GetLightedID();
@@ -112,7 +120,7 @@ public:
 
 public:
 
-	std::vector<CPlotDataImpl<DataT>* >	&GetVPlotData(){return m_vpPlotData;}
+	std::vector<CPlotDataImpl<DataT>* >	&GetVPlotData(){m_bIndexDirty = true; return m_vpPlotData;}
 	CPlotDataImpl<DataT>	*GetPlotData(int dataID);
 	CPlotDataImpl<DataT>	*GetAbsPlotData(int nIndex);
 
@@ -133,7 +141,7 @@ public:
 
 	bool				MovePlotData( int dataID, double offsetx, double offsety);
 
-	double				GetValueFromX(double x, int which);
+	double				GetValueFromX(double x, int which, bool bInterpolate = true);
 
 	int					GetDataIDByTitle(tstring title);
 	int					GetIndexByTitle(tstring title);
@@ -147,8 +155,12 @@ public:
 	inline	int			GetIndexOfSelected(){for(int i=0;i<GetPlotDataCount();i++)if(m_vpPlotData[i]->IsSelected())return i;return -1;}
 	inline	bool		IsCompactDraw(int dataID){ int i = GetIndex(dataID); if( i < 0 ) return 0; else return m_vpPlotData[i]->bCompactDraw; }
 	inline	void		SetCompactDraw(int dataID, bool compact){ int i = GetIndex(dataID); if( i < 0 ) return; else m_vpPlotData[i]->bCompactDraw = compact; }
+	inline	int			GetCompactMode(int dataID){ int i = GetIndex(dataID); if( i < 0 ) return -1; else return m_vpPlotData[i]->GetCompactMode(); }
+	inline	void		SetCompactMode(int dataID, int mode){ int i = GetIndex(dataID); if( i < 0 ) return; else m_vpPlotData[i]->SetCompactMode(mode); }
 	inline	bool		IsDrawDataChanged(int dataID){ int i = GetIndex(dataID); if( i < 0 ) return 0; else return m_vpPlotData[i]->bDrawDataChanged; }
 	inline	void		SetDrawDataChanged(int dataID, bool changed){ int i = GetIndex(dataID); if( i < 0 ) return; else m_vpPlotData[i]->bDrawDataChanged = changed; }
+	inline	bool		IsColumnarData(int dataID){ int i = GetIndex(dataID); if( i < 0 ) return false; else return m_vpPlotData[i]->IsColumnar(); }
+	inline	void		SetColumnarData(int dataID, bool columnar){ int i = GetIndex(dataID); if( i < 0 ) return; else m_vpPlotData[i]->SetColumnar(columnar); }
 public:
 	inline int			GetReservedDataLength(){return m_nReservedDataLength;}
 	inline void			SetReservedDataLength(int length){m_nReservedDataLength = length;}
@@ -194,7 +206,7 @@ public:
 	inline bool			IsDataDragMode( int dataID ) { int i = GetIndex(dataID); if( i < 0 ) return 0; else return m_vpPlotData[i]->bDragMode; }
 	inline void			SetDataDragMode( int dataID, bool drag ) { int i = GetIndex(dataID); if( i < 0 ) return; else m_vpPlotData[i]->bDragMode = drag; }
 public:
-	inline void			SetDataID( int dataID, int newID){int i = GetIndex(dataID); if( i < 0 ) return; else m_vpPlotData[i]->SetDataID(newID);}
+	inline void			SetDataID( int dataID, int newID){int i = GetIndex(dataID); if( i < 0 ) return; else {m_vpPlotData[i]->SetDataID(newID); SetIndexOfID(i);}}
 	
 	inline void			SetDataColor( int dataID, COLORREF color ){int i = GetIndex(dataID); if( i < 0 ) return; else m_vpPlotData[i]->SetDataColor(color);}
 	inline COLORREF		GetDataColor( int dataID ) { int i = GetIndex(dataID); if( i < 0 ) return RGB( 0, 0, 0); else return m_vpPlotData[i]->GetDataColor(); }
@@ -223,6 +235,9 @@ public:
 	inline void			SetFileSeparator(tstring sep){m_strFileSeparator = sep;}
 	inline tstring&		GetDataSeparator(){return m_strDataSeparator;}
 	inline void			SetDataSeparator(tstring sep){m_strDataSeparator = sep;}
+	// significant digits of the numbers in text files, 0 for the shortest exact text
+	inline int			GetTextPrecision(){return m_nTextPrecision;}
+	inline void			SetTextPrecision(int nPrecision){m_nTextPrecision = nPrecision;}
 
 public:
 	inline void			SetMarkerShow( int dataID, bool show ){int index = GetIndex( dataID );if( index < 0 ) return;m_vpPlotData[index]->SetMarkerShow(show);}
@@ -280,6 +295,8 @@ template<class DataT>
 CDataSet<DataT>::CDataSet()
 {
 	InitializeCriticalSection(&m_csData);
+	m_bIndexDirty = false;
+	m_bIDsOffTable = false;
 	SetDefaults();
 }
 
@@ -313,6 +330,7 @@ void	CDataSet<DataT>::SetDefaults()
 	m_nShowPlotDataInfoDataPointStep = 32;
 	m_strFileSeparator = _TEXT("\r\n//##$$%%//\r\n");
 	m_strDataSeparator = _TEXT("\t\t");
+	m_nTextPrecision = 6;
 }
 
 // Deletes a data set, and moves all the settings
@@ -338,6 +356,12 @@ bool	CDataSet<DataT>::DeleteData( int dataID )
 			// Delete this XYDataInfo
 			delete m_vpPlotData[i];
 			m_vpPlotData.erase(m_vpPlotData.begin()+i);
+			if( dataID >= 0 && dataID < (int)m_vIndexOfID.size() )m_vIndexOfID[dataID] = -1;
+			// the following curves move down by one
+			for( ; i < count - 1; i++ )
+			{
+				SetIndexOfID(i);
+			}
 			
 			MyUnlock();
 			
@@ -365,12 +389,25 @@ bool	CDataSet<DataT>::EmptyData( int dataID )
 template<class DataT>
 void	CDataSet<DataT>::DeleteAllData( void )
 {
-	bool		keepGoing = true;
+	int			i;
 	
-	while( keepGoing == true && GetPlotDataCount() > 0 )
+	MyLock();
+	// one pass, deleting from the front one by one would shift the rest every time
+	for( i = 0; i < GetPlotDataCount(); i++ )
 	{
-		keepGoing = DeleteData( GetDataID(0) );
+		m_vpPlotData[i]->DeleteData();
+		if(m_vpPlotData[i]->pPointsGdi)
+		{
+			delete []m_vpPlotData[i]->pPointsGdi;
+			m_vpPlotData[i]->pPointsGdi = 0;
+		}
+		delete m_vpPlotData[i];
 	}
+	m_vpPlotData.clear();
+	m_vIndexOfID.clear();
+	m_bIndexDirty = false;
+	m_bIDsOffTable = false;
+	MyUnlock();
 	//SetXAutoRange();
 	//SetYAutoRange();
 }
@@ -417,7 +454,7 @@ int		CDataSet<DataT>::GetMaxPlotDataLength()
 	int len = 0;
 	for(int i = 0; i < GetPlotDataCount(); i++)
 	{
-		if((int)GetAbsData(i).size()>len)len = (int)GetAbsData(i).size();
+		if(m_vpPlotData[i]->GetDataCount()>len)len = m_vpPlotData[i]->GetDataCount();
 	}
 	return len;
 }
@@ -449,6 +486,28 @@ int		CDataSet<DataT>::GetIndex( int dataID ) const
 {
 	int			i;
 	
+	// the table is rebuilt only after the curves were changed behind its back, a lookup takes no lock
+	if( m_bIndexDirty )
+	{
+		EnterCriticalSection((LPCRITICAL_SECTION)&m_csData);
+		if( m_bIndexDirty )RebuildIndexOfID();
+		LeaveCriticalSection((LPCRITICAL_SECTION)&m_csData);
+	}
+	// the entry is checked against the curve itself, a stale one means a rebuild
+	if( dataID >= 0 && dataID < (int)m_vIndexOfID.size() )
+	{
+		i = m_vIndexOfID[dataID];
+		if( i >= 0 && !(i < GetPlotDataCount() && m_vpPlotData[i]->GetDataID() == dataID) )
+		{
+			EnterCriticalSection((LPCRITICAL_SECTION)&m_csData);
+			RebuildIndexOfID();
+			i = (dataID < (int)m_vIndexOfID.size())?m_vIndexOfID[dataID]:-1;
+			LeaveCriticalSection((LPCRITICAL_SECTION)&m_csData);
+		}
+		if( i >= 0 )return i;
+	}
+	// a miss, only the IDs out of the table are searched
+	if( !m_bIDsOffTable )return -1;
 	for( i = 0; i < GetPlotDataCount(); i++ )
 	{
 		if( m_vpPlotData[i]->GetDataID() == dataID )
@@ -460,6 +519,49 @@ int		CDataSet<DataT>::GetIndex( int dataID ) const
 	return -1;
 }
 
+template<class DataT>
+void	CDataSet<DataT>::RebuildIndexOfID() const
+{
+	int			i, id, maxID = -1;
+	// keep the table bounded if someone sets a huge ID
+	int			limit = 4*GetPlotDataCount() + 1024;
+
+	m_bIDsOffTable = false;
+	for( i = 0; i < GetPlotDataCount(); i++ )
+	{
+		id = m_vpPlotData[i]->GetDataID();
+		if( id > maxID && id < limit )maxID = id;
+		if( id < 0 || id >= limit )m_bIDsOffTable = true;
+	}
+	m_vIndexOfID.assign( maxID + 1, -1 );
+	// backwards, so that the first curve wins if two share an ID
+	for( i = GetPlotDataCount() - 1; i >= 0; i-- )
+	{
+		id = m_vpPlotData[i]->GetDataID();
+		if( id >= 0 && id <= maxID )m_vIndexOfID[id] = i;
+	}
+	m_bIndexDirty = false;
+}
+
+template<class DataT>
+void	CDataSet<DataT>::SetIndexOfID( int index ) const
+{
+	if( index < 0 || index >= GetPlotDataCount() )return;
+	int id = m_vpPlotData[index]->GetDataID();
+
+	EnterCriticalSection((LPCRITICAL_SECTION)&m_csData);
+	if( id < 0 || id >= 4*GetPlotDataCount() + 1024 )
+	{
+		m_bIDsOffTable = true;
+	}
+	else
+	{
+		if( id >= (int)m_vIndexOfID.size() )m_vIndexOfID.resize( id + 1, -1 );
+		m_vIndexOfID[id] = index;
+	}
+	LeaveCriticalSection((LPCRITICAL_SECTION)&m_csData);
+}
+
 template<class DataT>
 int		CDataSet<DataT>::GetSelectedID()
 {
@@ -574,33 +676,25 @@ template<class DataT>
 void	CDataSet<DataT>::UpdateXDataRange(double val, int nWhich)
 {
 	if(nWhich<0 || nWhich>=GetPlotDataCount())return;
-	if(!m_vpPlotData[nWhich]->IsDataRangeSet())
-	{
-		m_vpPlotData[nWhich]->GetDataRange();
-		m_vpPlotData[nWhich]->SetDataRangeSet(true);
-	}
-	if(val < m_vpPlotData[nWhich]->GetDataRange1D(0)[0] )m_vpPlotData[nWhich]->GetDataRange1D(0)[0] = val;
-	if(val > m_vpPlotData[nWhich]->GetDataRange1D(0)[1] )m_vpPlotData[nWhich]->GetDataRange1D(0)[1] = val;
+	// an unset range is found when the plot range is next asked for, not under the append lock
+	if(!m_vpPlotData[nWhich]->IsDataRangeSet())return;
+	m_vpPlotData[nWhich]->ExtendDataRange(0, val);
 }
 
 template<class DataT>
 void	CDataSet<DataT>::UpdateYDataRange(double val, int nWhich)
 {
 	if(nWhich<0 || nWhich>=GetPlotDataCount())return;
-	if(!m_vpPlotData[nWhich]->IsDataRangeSet())
-	{
-		m_vpPlotData[nWhich]->GetDataRange();
-		m_vpPlotData[nWhich]->SetDataRangeSet(true);
-	}
-	if(val < m_vpPlotData[nWhich]->GetDataRange1D(1)[0] )m_vpPlotData[nWhich]->GetDataRange1D(1)[0] = val;
-	if(val > m_vpPlotData[nWhich]->GetDataRange1D(1)[1] )m_vpPlotData[nWhich]->GetDataRange1D(1)[1] = val;
+	// an unset range is found when the plot range is next asked for, not under the append lock
+	if(!m_vpPlotData[nWhich]->IsDataRangeSet())return;
+	m_vpPlotData[nWhich]->ExtendDataRange(1, val);
 }
 
 template<class DataT>
 void	CDataSet<DataT>::UpdateDataRanges(DataT dtVal, int nWhich)
 {
 	if(nWhich<0 || nWhich>=GetPlotDataCount())return;
-	if(GetAbsData(nWhich).size()<=1)
+	if(m_vpPlotData[nWhich]->GetDataCount()<=1)
 	{
 		m_vpPlotData[nWhich]->SetDataRangeSet(false);
 	}
@@ -755,26 +849,39 @@ bool	CDataSet<DataT>::MovePlotData(int dataID, double offsetx, double offsety)
 }
 
 template<class DataT>
-double		CDataSet<DataT>::GetValueFromX(double x, int which)
+double		CDataSet<DataT>::GetValueFromX(double x, int which, bool bInterpolate)
 {
 	if(which<0 || which>=GetPlotDataCount())return 0.0;
 	
-	if(x < GetAbsData(which)[0].val[0])return GetAbsData(which)[0].val[1];
+	CPlotDataImpl<DataT> *pData = GetAbsPlotData(which);
+	int nCount = pData->GetDataCount();
+	if(nCount<=0)return 0.0;
+	if(x < pData->GetDataAt(0).val[0])return pData->GetDataAt(0).val[1];
+
+	// find the segment [i, i+1] holding x, by binary search if x is monotonic
 	int i;
-	for(i=0; i<(int)GetAbsData(which).size(); i++)
+	if(pData->IsXMonotonic())
 	{
-		if(x>=GetAbsData(which)[i].val[0] && x<=GetAbsData(which)[i+1].val[0])
+		i = pData->LowerBound(0, x) - 1;
+		if(i<0)i = 0;
+	}
+	else
+	{
+		for(i=0; i<nCount-1; i++)
 		{
-			double x1, x2, y1, y2;
-			x1 = GetAbsData(which)[i].val[0];
-			x2 = GetAbsData(which)[i+1].val[0];
-			y1 = GetAbsData(which)[i].val[1];
-			y2 = GetAbsData(which)[i+1].val[1];
-			if(x1==x2)return y1;
-			return y1+(x-x1)*(y2-y1)/(x2-x1);
+			if(x>=pData->GetDataAt(i).val[0] && x<=pData->GetDataAt(i+1).val[0])break;
 		}
 	}
-	return GetAbsData(which)[GetAbsData(which).size()-1].val[1];
+	if(i >= nCount-1)return pData->GetDataAt(nCount-1).val[1];
+
+	double x1, x2, y1, y2;
+	x1 = pData->GetDataAt(i).val[0];
+	x2 = pData->GetDataAt(i+1).val[0];
+	y1 = pData->GetDataAt(i).val[1];
+	y2 = pData->GetDataAt(i+1).val[1];
+	if(!bInterpolate)return (x-x1 <= x2-x)?y1:y2;
+	if(x1==x2)return y1;
+	return y1+(x-x1)*(y2-y1)/(x2-x1);
 }
 
 template<class DataT>
@@ -22,11 +22,31 @@
 
 #include "../Accessary/grid_lib/grid_lib.h"
 #include "InterConnectImpl.h"
+#include "BinaryDataFile.h"
+#include "TextDataWriter.h"
+#include "TextFileReader.h"
 
 Declare_Namespace_CChart
 
 #define  AddSeries AddCurve
 
+// a window of one curve parsed by the load thread, nCurve counts the curves in the file.
+// A curve of a binary file comes whole in vData, with its z column, title and color
+struct LoadWindow
+{
+	int				nCurve;
+	vector<double>	vX, vY;
+
+	bool			bBinary;
+	MyVData2D		vData;
+	vector<double>	vZ;
+	tstring			strTitle;
+	COLORREF		crColor;
+	bool			bAutoColor;
+
+	LoadWindow() : nCurve(0), bBinary(false), crColor(0), bAutoColor(true){}
+};
+
 template<class PlotImplT>
 class CDataSetImpl : public CDataSet<DataPoint2D>,
 					 public CInterConnectImpl<CDataSetImpl<PlotImplT> >
@@ -47,6 +67,8 @@ public:
 	void				DrawDataSet(HDC hDC, double *xRange, double *yRange);
 	virtual	void		DrawPlotDataEach(HDC hDC, double *xRange, double *yRange);
 	virtual	void		DrawSinglePlotData(int which, HDC hDC, double *xRange, double *yRange);
+	// The same on a surface, a surface without a device context gets the curve alone
+	virtual	void		DrawSinglePlotData(int which, CDrawSurface *pSurface, double *xRange, double *yRange);
 
 public:
 	void				SetDataDragMode( int dataID, bool bDrag, POINT pointStart );
@@ -235,8 +257,9 @@ public:
 		}
 		else
 		{
-			double x;
-			x = GetAbsData(0)[GetAbsData(0).size()-1].val[0] + 1;
+			// the last point through the ring, GetAbsData would unwrap a rolling curve
+			int nCount = GetAbsPlotData(0)->GetDataCount();
+			double x = nCount>0 ? GetAbsPlotData(0)->GetDataAt(nCount-1).val[0] + 1 : 1;
 			return AddPoint(x, y);
 		}
 	}
@@ -275,6 +298,24 @@ public:
 	int					AddPointByID( tstring strTime, tstring fmt, double y, int dataID );
 	int					AddPointFinalByID( DataPoint2D dp2d, int dataID );
 
+	// append a batch of points to an existing curve, lock and caches are handled once per batch
+	int					AppendPoints( int dataID, double *pX, double *pY, int nLen );
+	int					AppendPoints( int dataID, tstring *pStrTime, tstring fmt, double *pY, int nLen )
+	{
+		return AppendPointsByStrTime(dataID, pStrTime, fmt, pY, nLen);
+	}
+	int					AppendPointsByStrTime( int dataID, tstring *pStrTime, tstring fmt, double *pY, int nLen );
+
+	// Lock free ingestion, one producer thread per curve pushes into the returned queue without
+	// taking the data lock, the queued points are appended at the start of each draw.
+	// Close the queue, or stop the producer, before the curve is deleted
+	CIngestQueue<DataPoint2D>	*OpenIngestQueue( int dataID, int nCapacity = 65536 );
+	void				CloseIngestQueue( int dataID );
+	// appends the queued points of every curve, returns the count appended
+	int					DrainIngestQueues();
+protected:
+	int					DrainIngestQueue( int nIndex );
+
 public:
 	void				SwapXY(int dataID);
 	void				SortData(int dataID, int nSortType);
@@ -287,12 +328,60 @@ public:
 	virtual	bool		WriteToFile( tstring pathName );
 	virtual	bool		WriteToFile( int which, tstring pathName );
 	virtual	bool		WriteToBuff( tstring &buff );
+	// the same text as WriteToFile, in chunks of a fixed buffer
+	bool				WriteToSink( FcnTextSink fcnSink, void *pPara );
 	virtual	bool		ReadFromFile( tstring pathName );
 	virtual	bool		ReadFromFile( int which, tstring pathName );
 	virtual	bool		ReadFromBuff( tstring buff );
 	int					GetNumsInStr( tstring buff);
+	// binary columns, see BinaryDataFile.h, ReadFromFile detects them by the magic bytes
+	virtual	bool		WriteToBinaryFile( tstring pathName );
+	virtual	bool		ReadFromBinaryFile( tstring pathName );
+
+public:
+	// ReadFromFile with a text file read window by window, each window is appended to the curves
+	// before the next is read. Cancelled loads keep what was read and return false
+	bool				LoadFromFile( tstring pathName, FcnLoadProgress fcnProgress, void *pPara );
+	// the same on a thread of its own, the progress is called on that thread.
+	// The thread only parses, its windows are queued and added to the curves on this thread
+	// at the start of each draw, and by IsLoading and WaitLoad
+	bool				StartLoadFromFile( tstring pathName, FcnLoadProgress fcnProgress, void *pPara );
+	// adds the windows read so far, then tells whether the thread still runs
+	bool				IsLoading();
+	void				WaitLoad();
+	// not from the progress function, return false there instead
+	void				CancelLoad();
 
 protected:
+	HANDLE				m_hLoadThread;
+	volatile bool		m_bCancelLoad;
+	tstring				m_strLoadPath;
+	FcnLoadProgress		m_fcnLoadProgress;
+	void				*m_pLoadPara;
+	// windows from the load thread to this one, null for a load on this thread
+	CIngestQueue<LoadWindow *>	*m_pLoadQueue;
+	// the curves of the file being loaded, created when their first window is added
+	vector<int>			m_vLoadDataID;
+
+	static	DWORD	WINAPI	LoadThreadProc( LPVOID pPara );
+	bool				DoLoadFromFile( tstring pathName, FcnLoadProgress fcnProgress, void *pPara );
+	bool				PutLoadWindow( int nCurve, vector<double> &vX, vector<double> &vY );
+	bool				PushLoadWindow( LoadWindow *pWindow );
+	void				AddLoadWindow( int nCurve, double *pX, double *pY, int nLen );
+	int					CommitLoadWindow( LoadWindow *pWindow );
+	bool				LoadBinary( tstring pathName, FcnLoadProgress fcnProgress, void *pPara );
+	int					DrainLoadQueue();
+	void				ClearLoadQueue();
+	bool				LoadSequence( CTextFileReader &reader, FcnLoadProgress fcnProgress, void *pPara, bool &bCancel );
+	bool				LoadColumns( CTextFileReader &reader, FcnLoadProgress fcnProgress, void *pPara, bool &bCancel );
+	bool				ParseColumns( const TCHAR *pBegin, const TCHAR *pEnd, int nRows, int &fstCols, vector<vector<double> > &vvX, vector<vector<double> > &vvY );
+	bool				ReportLoad( double fDone, FcnLoadProgress fcnProgress, void *pPara );
+
+protected:
+	bool				WriteText( CTextDataWriter &writer );
+	// parsing only, the plot is not touched, so the load thread may call it
+	static	bool		ReadBinaryCurve( CBinaryDataFile &file, int which, LoadWindow &curve );
+	virtual	int			AddBinaryCurve( LoadWindow &curve );
 	virtual	int			AddData( MyVData2D vData );
 	virtual	int			SetData( int dataID, MyVData2D vData );
 	virtual	int			SetData( int dataID, MyVData2D *pvData );
@@ -302,12 +391,28 @@ template<class PlotImplT>
 CDataSetImpl<PlotImplT>::CDataSetImpl()
 {
 	PlotImplT* pT = static_cast<PlotImplT*>(this);
+
+	m_hLoadThread = NULL;
+	m_bCancelLoad = false;
+	m_fcnLoadProgress = 0;
+	m_pLoadPara = 0;
+	m_pLoadQueue = 0;
 }
 
 template<class PlotImplT>
 CDataSetImpl<PlotImplT>::~CDataSetImpl()
 {
 	PlotImplT* pT = static_cast<PlotImplT*>(this);
+
+	// the plot is going, the queued windows are dropped
+	m_bCancelLoad = true;
+	if(m_hLoadThread != NULL)
+	{
+		WaitForSingleObject(m_hLoadThread, INFINITE);
+		CloseHandle(m_hLoadThread);
+		m_hLoadThread = NULL;
+	}
+	ClearLoadQueue();
 }
 
 template<class PlotImplT>
@@ -437,6 +542,25 @@ void	CDataSetImpl<PlotImplT>::DrawSinglePlotData(int which, HDC hDC, double *xRa
 	m_vpPlotData[which]->DrawPlotData(hDC, plotRect, xRange, yRange);
 }
 
+template<class PlotImplT>
+void	CDataSetImpl<PlotImplT>::DrawSinglePlotData(int which, CDrawSurface *pSurface, double *xRange, double *yRange)
+{
+	if(which<0 || which>=GetPlotDataCount())return;
+
+	HDC hDC = pSurface->GetDC();
+	if(hDC)
+	{
+		DrawSinglePlotData(which, hDC, xRange, yRange);
+		return;
+	}
+
+	PlotImplT* pT = static_cast<PlotImplT*>(this);
+
+	RECT plotRect = pT->GetLastPlotRect();
+
+	m_vpPlotData[which]->DrawCurve(pSurface, plotRect, xRange, yRange);
+}
+
 template<class PlotImplT>
 void	CDataSetImpl<PlotImplT>::SetDataDragMode( int dataID, bool bDrag, POINT pointStart )
 {
@@ -489,6 +613,7 @@ int	CDataSetImpl<PlotImplT>::AddData( MyVData2D vData )
 	plotData->SetDataSet(this);
 	
 	m_vpPlotData.push_back(plotData);
+	SetIndexOfID(GetPlotDataCount()-1);
 	//GetDataRanges();
 	plotData->GetDataRange();
 	
@@ -647,13 +772,10 @@ int		CDataSetImpl<PlotImplT>::AddCurveByStrTime(tstring *pStrTime, tstring fmt,
 	int dataID;
 	
 	double *pTime = new double[nLen];
-	for(int i=0; i<nLen; i++)
+	if(MyStr2TimeBatch(pStrTime, nLen, fmt, pTime) < nLen)
 	{
-		if(!MyStr2Time(pStrTime[i], fmt, pTime[i]))
-		{
-			delete []pTime;
-			return -1;
-		}
+		delete []pTime;
+		return -1;
 	}
 	
 	dataID = AddCurve(pTime, pY, nLen);
@@ -692,28 +814,32 @@ int		CDataSetImpl<PlotImplT>::AddPointFinal(DataPoint2D dp2d, int nWhich)
 	}
 	
 	MyLock();
-	if(m_nMaxPoints>0)
+	int nOldCount = GetAbsPlotData(nWhich)->GetDataCount();
+	bool bCleared = false;
+	if(m_nMaxPoints>0 && !m_bMaxPointsReset)
 	{
-		if(m_bMaxPointsReset)
-		{
-			if((int)GetAbsData(nWhich).size()>=m_nMaxPoints)
-			{
-				GetAbsPlotData(nWhich)->GetData().clear();
-			}
-		}
-		else
+		// rolling curve, the storage works as a ring buffer
+		GetAbsPlotData(nWhich)->PushRingData(dp2d, m_nMaxPoints);
+	}
+	else
+	{
+		if(m_nMaxPoints>0 && GetAbsPlotData(nWhich)->GetDataCount()>=m_nMaxPoints)
 		{
-			while((int)GetAbsData(nWhich).size()>=m_nMaxPoints)
-			{
-				GetAbsPlotData(nWhich)->GetData().erase(GetAbsPlotData(nWhich)->GetData().begin());
-			}
+			GetAbsPlotData(nWhich)->GetData().clear();
+			bCleared = true;
 		}
+		GetAbsPlotData(nWhich)->AppendData(dp2d);
 	}
-	GetAbsPlotData(nWhich)->GetData().push_back(dp2d);
 	UpdateDataRanges(dp2d, nWhich);
 	pT->SetNewDataComming( true );
-	GetAbsPlotData(nWhich)->SetSorted(false);
-	GetAbsPlotData(nWhich)->bForceUpdate = true;
+	// points appended in order keep the curve sorted, see CPlotData::SortData(int)
+	if(bCleared)
+	{
+		GetAbsPlotData(nWhich)->SetSorted(false);
+		GetAbsPlotData(nWhich)->bForceUpdate = true;
+	}
+	else
+		GetAbsPlotData(nWhich)->SetTailAppended(1, nOldCount + 1 - GetAbsPlotData(nWhich)->GetDataCount());
 	pT->SetXRangeSet(false);
 	pT->SetYRangeSet(false);
 	
@@ -775,7 +901,9 @@ int		CDataSetImpl<PlotImplT>::InsertPointFinal( DataPoint2D dp2d, int nPos, int
 		{
 			while((int)GetAbsData(nWhich).size()>=m_nMaxPoints)
 			{
+				DataPoint2D dropped = GetAbsPlotData(nWhich)->GetDataAt(0);
 				GetAbsPlotData(nWhich)->GetData().erase(GetAbsPlotData(nWhich)->GetData().begin());
+				GetAbsPlotData(nWhich)->DropFromDataRange(dropped);
 			}
 		}
 	}
@@ -800,11 +928,12 @@ int		CDataSetImpl<PlotImplT>::RemovePoint( int dataID, int nPointIndex )
 	if(nPointIndex<0 || nPointIndex>= (int)GetAbsData(nIndex).size())return -1;
 	
 	MyLock();
+	DataPoint2D dropped = GetAbsPlotData(nIndex)->GetDataAt(nPointIndex);
 	GetAbsPlotData(nIndex)->GetData().erase(GetAbsPlotData(nIndex)->GetData().begin()+nPointIndex);
+	// the range is only found again, when next drawn, if the point was the last on an extreme
+	GetAbsPlotData(nIndex)->DropFromDataRange(dropped);
 	MyUnlock();
 	
-	GetAbsPlotData(nIndex)->SetDataRangeSet(false);
-	GetDataRange(dataID);
 	pT->SetNewDataComming(true);
 	GetAbsPlotData(nIndex)->bForceUpdate = true;
 	
@@ -837,15 +966,15 @@ int		CDataSetImpl<PlotImplT>::RemovePointAndShift( int dataID, int nPointIndex )
 	if(nPointIndex<0 || nPointIndex>= (int)GetAbsData(nIndex).size())return -1;
 	
 	MyLock();
+	DataPoint2D dropped = GetAbsPlotData(nIndex)->GetDataAt(nPointIndex);
 	for(int i=nPointIndex; i<(int)GetAbsPlotData(nIndex)->GetData().size()-1; i++)
 	{
 		GetAbsPlotData(nIndex)->GetData()[i] = GetAbsPlotData(nIndex)->GetData()[i+1];
 	}
 	GetAbsPlotData(nIndex)->GetData().pop_back();
+	GetAbsPlotData(nIndex)->DropFromDataRange(dropped);
 	MyUnlock();
 	
-	GetAbsPlotData(nIndex)->SetDataRangeSet(false);
-	GetDataRange(dataID);
 	pT->SetNewDataComming(true);
 	GetAbsPlotData(nIndex)->bForceUpdate = true;
 	
@@ -991,6 +1120,162 @@ int		CDataSetImpl<PlotImplT>::AddPointFinalByID( DataPoint2D dp2d, int dataID )
 	return AddPointFinal(dp2d, GetIndex(dataID));
 }
 
+template<class PlotImplT>
+int		CDataSetImpl<PlotImplT>::AppendPoints( int dataID, double *pX, double *pY, int nLen )
+{
+	PlotImplT* pT = static_cast<PlotImplT*>(this);
+
+	int nIndex = GetIndex(dataID);
+	if(nIndex < 0)return -1;
+	if(!pX || !pY || nLen<=0)return -1;
+
+	CPlotDataImpl<DataPoint2D> *pPlotData = GetAbsPlotData(nIndex);
+	DataPoint2D dp2d;
+	int i, nStart = 0;
+	bool bCleared = false;
+
+	MyLock();
+	int nOldCount = pPlotData->GetDataCount();
+	if(m_nMaxPoints>0 && !m_bMaxPointsReset)
+	{
+		// rolling curve, only the newest m_nMaxPoints points of the batch can survive
+		if(nLen > m_nMaxPoints)nStart = nLen - m_nMaxPoints;
+		for(i=nStart; i<nLen; i++)
+		{
+			dp2d.val[0] = pX[i];
+			dp2d.val[1] = pY[i];
+			pPlotData->PushRingData(dp2d, m_nMaxPoints);
+			UpdateDataRanges(dp2d, nIndex);
+		}
+	}
+	else
+	{
+		if(m_nMaxPoints<=0)
+		{
+			pPlotData->ReserveData(pPlotData->GetDataCount() + nLen);
+		}
+		for(i=0; i<nLen; i++)
+		{
+			if(m_nMaxPoints>0 && pPlotData->GetDataCount()>=m_nMaxPoints)
+			{
+				pPlotData->GetData().clear();
+				bCleared = true;
+			}
+			dp2d.val[0] = pX[i];
+			dp2d.val[1] = pY[i];
+			pPlotData->AppendData(dp2d);
+			UpdateDataRanges(dp2d, nIndex);
+		}
+	}
+	pT->SetNewDataComming( true );
+	// the screen points of the kept points are reused at the next draw
+	if(bCleared)
+	{
+		pPlotData->SetSorted(false);
+		pPlotData->bForceUpdate = true;
+	}
+	else
+		pPlotData->SetTailAppended(nLen - nStart, nOldCount + nLen - nStart - pPlotData->GetDataCount());
+	pT->SetXRangeSet(false);
+	pT->SetYRangeSet(false);
+
+	MyUnlock();
+
+	return dataID;
+}
+
+template<class PlotImplT>
+int		CDataSetImpl<PlotImplT>::AppendPointsByStrTime( int dataID, tstring *pStrTime, tstring fmt, double *pY, int nLen )
+{
+	if(!pStrTime || !pY || nLen<=0)return -1;
+
+	double *pTime = new double[nLen];
+	if(MyStr2TimeBatch(pStrTime, nLen, fmt, pTime) < nLen)
+	{
+		delete []pTime;
+		return -1;
+	}
+
+	int ret = AppendPoints(dataID, pTime, pY, nLen);
+
+	delete []pTime;
+	return ret;
+}
+
+template<class PlotImplT>
+CIngestQueue<DataPoint2D>	*CDataSetImpl<PlotImplT>::OpenIngestQueue( int dataID, int nCapacity )
+{
+	int nIndex = GetIndex(dataID);
+	if(nIndex < 0)return 0;
+
+	MyLock();
+	CPlotDataImpl<DataPoint2D> *pPlotData = GetAbsPlotData(nIndex);
+	if(!pPlotData->GetIngestQueue())
+		pPlotData->SetIngestQueue(new CIngestQueue<DataPoint2D>(nCapacity));
+	CIngestQueue<DataPoint2D> *pQueue = pPlotData->GetIngestQueue();
+	MyUnlock();
+
+	return pQueue;
+}
+
+template<class PlotImplT>
+void		CDataSetImpl<PlotImplT>::CloseIngestQueue( int dataID )
+{
+	int nIndex = GetIndex(dataID);
+	if(nIndex < 0)return;
+
+	// keep what the producer has pushed so far
+	DrainIngestQueue(nIndex);
+
+	MyLock();
+	CPlotDataImpl<DataPoint2D> *pPlotData = GetAbsPlotData(nIndex);
+	if(pPlotData->GetIngestQueue())
+	{
+		delete pPlotData->GetIngestQueue();
+		pPlotData->SetIngestQueue(0);
+	}
+	MyUnlock();
+}
+
+template<class PlotImplT>
+int		CDataSetImpl<PlotImplT>::DrainIngestQueues()
+{
+	int nTotal = DrainLoadQueue();
+	for(int i=0; i<GetPlotDataCount(); i++)
+	{
+		nTotal += DrainIngestQueue(i);
+	}
+	return nTotal;
+}
+
+template<class PlotImplT>
+int		CDataSetImpl<PlotImplT>::DrainIngestQueue( int nIndex )
+{
+	CIngestQueue<DataPoint2D> *pQueue = GetAbsPlotData(nIndex)->GetIngestQueue();
+	if(!pQueue || pQueue->IsEmpty())return 0;
+
+	// only what is queued now, a busy producer can not hold the draw
+	int nCount = pQueue->GetCount();
+	const int nBatch = 1024;
+	DataPoint2D pBuff[nBatch];
+	double pX[nBatch], pY[nBatch];
+	int dataID = GetDataID(nIndex);
+	int i, nPop, nDone = 0;
+	while(nDone < nCount)
+	{
+		nPop = pQueue->Pop(pBuff, min(nBatch, nCount - nDone));
+		if(nPop <= 0)break;
+		for(i=0; i<nPop; i++)
+		{
+			pX[i] = pBuff[i].val[0];
+			pY[i] = pBuff[i].val[1];
+		}
+		AppendPoints(dataID, pX, pY, nPop);
+		nDone += nPop;
+	}
+	return nDone;
+}
+
 template<class PlotImplT>
 void		CDataSetImpl<PlotImplT>::SwapXY(int dataID)
 {
@@ -1027,26 +1312,12 @@ void		CDataSetImpl<PlotImplT>::SortData(int dataID, int nSortType)
 template<class PlotImplT>
 bool		CDataSetImpl<PlotImplT>::WriteToFile( tstring pathName )
 {
-	tofstream			ofs;
-	
 	if( GetPlotDataCount() <= 0 ) return false;
 
-	tstring buff;
-	if(!WriteToBuff(buff))return false;
-	
-#if defined(_UNICODE) || defined(UNICODE)
-	string name;
-	if(!mywcs2mbs(pathName, name))return false;
-	ofs.open(name.c_str(), tios::out);
-#else
-	ofs.open(pathName.c_str(),tios::out);
-#endif
-	
-	if(!ofs.is_open())return false;
-	ofs.write(buff.c_str(), buff.length());
-	ofs.close();
-	
-	return true;
+	CTextDataWriter writer;
+	if(!writer.Open(pathName))return false;
+	bool ret = WriteText(writer);
+	return writer.Close() && ret;
 }
 
 template<class PlotImplT>
@@ -1066,149 +1337,505 @@ bool		CDataSetImpl<PlotImplT>::WriteToFile( int which, tstring pathName )
 template<class PlotImplT>
 bool		CDataSetImpl<PlotImplT>::WriteToBuff( tstring &buff )
 {
-	int					whichDataSet;
-	CPlotData<DataPoint2D>		*dataSet;
+	buff = _TEXT("");
+	return WriteToSink(CTextDataWriter::AppendToString, &buff);
+}
+
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::WriteToSink( FcnTextSink fcnSink, void *pPara )
+{
+	if( GetPlotDataCount() <= 0 || !fcnSink ) return false;
+
+	CTextDataWriter writer;
+	writer.SetSink(fcnSink, pPara);
+	bool ret = WriteText(writer);
+	return writer.Close() && ret;
+}
+
+// Rows go straight from the curves to the writer, nothing is formatted twice
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::WriteText( CTextDataWriter &writer )
+{
+	std::vector<CPlotData<DataPoint2D> *> vpData;
+	int i;
+	for(i=0; i<GetPlotDataCount(); i++)
+	{
+		if(GetAbsPlotData(i))vpData.push_back(GetAbsPlotData(i));
+	}
+	int nLayout = m_bSequence ? kTextLayoutSequence : (m_bShareX ? kTextLayoutSharedX : kTextLayoutSeparateX);
 	
+	writer.SetPrecision(m_nTextPrecision);
+	MyLock();
+	bool ret = writer.WriteCurves(vpData, nLayout, m_strDataSeparator, m_strFileSeparator);
+	MyUnlock();
+	return ret;
+}
+
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::WriteToBinaryFile( tstring pathName )
+{
 	if( GetPlotDataCount() <= 0 ) return false;
-	int nCount = GetPlotDataCount();
 	
-	buff = _TEXT("");
-	if(m_bSequence)
+	std::vector<CPlotData<DataPoint2D> *> vpData;
+	int i;
+	for(i=0; i<GetPlotDataCount(); i++)
 	{
-		for( whichDataSet = 0; whichDataSet < nCount; whichDataSet++ )
+		vpData.push_back(GetAbsPlotData(i));
+	}
+	
+	MyLock();
+	bool ret = CBinaryDataFile::Write(pathName, vpData);
+	MyUnlock();
+	return ret;
+}
+
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::ReadFromBinaryFile( tstring pathName )
+{
+	CBinaryDataFile file;
+	if(!file.Open(pathName))return false;
+	
+	int i, count = 0;
+	for(i=0; i<file.GetCurveCount(); i++)
+	{
+		LoadWindow curve;
+		if(!ReadBinaryCurve(file, i, curve))continue;
+		if(AddBinaryCurve(curve) >= 0)count++;
+	}
+	return count>0;
+}
+
+// The columns are copied from the mapped view, z stays empty when the file holds 2D data
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::ReadBinaryCurve( CBinaryDataFile &file, int which, LoadWindow &curve )
+{
+	if(!file.MapCurve(which))return false;
+	
+	int i, nLen = file.GetPointCount();
+	const double *pX = file.GetColumn(0);
+	const double *pY = file.GetColumn(1);
+	curve.vData.resize(nLen);
+	for(i=0; i<nLen; i++)
+	{
+		curve.vData[i].val[0] = pX[i];
+		curve.vData[i].val[1] = pY[i];
+	}
+	const double *pZ = file.GetColumn(2);
+	if(pZ)curve.vZ.assign(pZ, pZ + nLen);
+	
+	curve.nCurve = which;
+	curve.bBinary = true;
+	curve.strTitle = file.GetTitle();
+	curve.crColor = file.GetColor();
+	curve.bAutoColor = (file.GetFlags() & kCCBinAutoColor) != 0;
+	return true;
+}
+
+// The parsed points are swapped into a new curve, the data ID is assigned anew
+template<class PlotImplT>
+int			CDataSetImpl<PlotImplT>::AddBinaryCurve( LoadWindow &curve )
+{
+	PlotImplT* pT = static_cast<PlotImplT*>(this);
+
+	int dataID = AddEmpty();
+	int index = GetIndex(dataID);
+	if(index < 0)return -1;
+	
+	MyLock();
+	m_vpPlotData[index]->GetData().swap(curve.vData);
+	m_vpPlotData[index]->SetDataRangeSet(false);
+	m_vpPlotData[index]->GetDataRange();
+	m_vpPlotData[index]->SetDataColor(curve.crColor);
+	m_vpPlotData[index]->SetAutoColor(curve.bAutoColor);
+	m_vpPlotData[index]->bForceUpdate = true;
+	pT->SetNewDataComming(true);
+	MyUnlock();
+	
+	SetDataTitle(dataID, curve.strTitle);
+	
+	return dataID;
+}
+
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::ReadFromFile( tstring pathName )
+{
+	return LoadFromFile(pathName, 0, 0);
+}
+
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::LoadFromFile( tstring pathName, FcnLoadProgress fcnProgress, void *pPara )
+{
+	if(IsLoading())return false;
+
+	m_bCancelLoad = false;
+	m_vLoadDataID.clear();
+	return DoLoadFromFile(pathName, fcnProgress, pPara);
+}
+
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::DoLoadFromFile( tstring pathName, FcnLoadProgress fcnProgress, void *pPara )
+{
+	if(CBinaryDataFile::IsBinaryFile(pathName))
+	{
+		if(!LoadBinary(pathName, fcnProgress, pPara))return false;
+		return ReportLoad(1.0, fcnProgress, pPara);
+	}
+
+	CTextFileReader reader;
+	if(!reader.Open(pathName))return false;
+
+	bool bCancel = false;
+	bool bRead = m_bSequence ? LoadSequence(reader, fcnProgress, pPara, bCancel) : LoadColumns(reader, fcnProgress, pPara, bCancel);
+	if(bCancel)return false;
+	// stopped before the end of the file
+	if(reader.GetProgress() < 1.0 && !ReportLoad(1.0, fcnProgress, pPara))return false;
+	return bRead;
+}
+
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::ReportLoad( double fDone, FcnLoadProgress fcnProgress, void *pPara )
+{
+	if(m_bCancelLoad)return false;
+	if(fcnProgress && !fcnProgress(fDone, pPara))return false;
+	return true;
+}
+
+// Each block between the file separators is a curve, a line of two numbers is a point
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::LoadSequence( CTextFileReader &reader, FcnLoadProgress fcnProgress, void *pPara, bool &bCancel )
+{
+	tstring strSep = m_strFileSeparator;
+	trimspace(strSep);
+	const TCHAR *pSepBegin = strSep.c_str(), *pSepEnd = pSepBegin + strSep.length();
+	tstring strSpace = CPlotData<DataPoint2D>().GetStrSpaceSeparator();
+
+	const TCHAR *pBegin, *pEnd, *p, *pLine, *pSeg, *pSep;
+	double val[2];
+	vector<double> vX, vY;
+	int nCurve = 0;
+	bool bStarted = false, bRead = false;
+	while(reader.ReadLines(pBegin, pEnd))
+	{
+		for(pLine = pBegin; pLine < pEnd; pLine = p + 1)
 		{
-			dataSet = GetAbsPlotData(whichDataSet);
-			
-			if( dataSet == NULL ) continue;
-			if(!dataSet->AppendToBuff(buff))
+			for(p = pLine; p < pEnd && *p != _TEXT('\n'); p++);
+			for(pSeg = pLine; ; pSeg = pSep + strSep.length())
 			{
-				return false;
+				pSep = strSep.empty() ? p : std::search(pSeg, p, pSepBegin, pSepEnd);
+				if(scan_doubles(pSeg, pSep, strSpace.c_str(), val, 2) == 2)
+				{
+					vX.push_back(val[0]);
+					vY.push_back(val[1]);
+				}
+				if(pSep == p)break;
+
+				// the curve ends at the separator
+				if(vX.size() > 0)
+				{
+					if(!PutLoadWindow(nCurve, vX, vY))
+					{
+						bCancel = true;
+						return bRead;
+					}
+					bStarted = bRead = true;
+				}
+				if(bStarted)nCurve++;
+				bStarted = false;
 			}
-			if( whichDataSet != nCount - 1 )
+		}
+		if(vX.size() > 0)
+		{
+			if(!PutLoadWindow(nCurve, vX, vY))
 			{
-				buff += _TEXT("\r\n");
-				buff += m_strFileSeparator;
-				buff += _TEXT("\r\n");
+				bCancel = true;
+				break;
 			}
+			bStarted = bRead = true;
+		}
+		if(!ReportLoad(reader.GetProgress(), fcnProgress, pPara))
+		{
+			bCancel = true;
+			break;
 		}
-		return true;
 	}
-	else
-	{
-		tstring *buffs = new tstring[nCount];
-		tstring::size_type *pPos = new tstring::size_type[nCount];
-		int lines, maxlines = 0;
+	return bRead;
+}
 
-		for( whichDataSet = 0; whichDataSet < nCount; whichDataSet++ )
+// The lines of a column text are appended to the curves of vvX and vvY. The first line with two
+// numbers or more sets fstCols and the curves, nRows of each are reserved then. Returns false at a
+// line with another count, the lines before it are kept. The plot is not touched
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::ParseColumns( const TCHAR *pBegin, const TCHAR *pEnd, int nRows, int &fstCols, vector<vector<double> > &vvX, vector<vector<double> > &vvY )
+{
+	const TCHAR *seps = m_strDataSeparator.c_str();
+	const TCHAR *p, *pLine;
+	int cols, nCurves, i;
+	vector<double> vVal(fstCols>0 ? fstCols : 0);
+
+	for(pLine = pBegin; pLine < pEnd; pLine = p + 1)
+	{
+		for(p = pLine; p < pEnd && *p != _TEXT('\n'); p++);
+		
+		if(fstCols <= 0)
 		{
-			dataSet = GetAbsPlotData(whichDataSet);
+			cols = scan_doubles(pLine, p, seps, 0, 0);
+			if(cols < 2)continue;
 			
-			if( dataSet == NULL )
+			fstCols = cols;
+			if(m_bShareX)
+			{
+				nCurves = cols-1;
+			}
+			else
 			{
-				delete []buffs;
-				delete []pPos;
-				return false;
+				nCurves = cols/2;
 			}
-			if(!dataSet->WriteToBuff(buffs[whichDataSet]))
+			
+			vVal.resize(fstCols);
+			vvX.resize(nCurves);
+			vvY.resize(nCurves);
+			for(i=0; i<nCurves && nRows>0; i++)
 			{
-				delete []buffs;
-				delete []pPos;
-				return false;
+				vvX[i].reserve(nRows);
+				vvY[i].reserve(nRows);
 			}
-			lines = get_line_count(buffs[whichDataSet]);
-			if(lines > maxlines)maxlines = lines;
-
-			pPos[whichDataSet] = 0;
 		}
-
-		tostringstream ostr;
-		tstring line, lbuf;
-		double x, y;
-		int i, j;
-		for( i=0; i<maxlines; i++)
+		
+		cols = scan_doubles(pLine, p, seps, &vVal[0], fstCols);
+		if(cols < 2)continue;
+		if(cols != fstCols)return false;
+		
+		nCurves = (int)vvX.size();
+		for(i=0; i<nCurves; i++)
 		{
-			line = _TEXT("");
-			
-			for(j=0; j<nCount; j++)
+			if(m_bShareX)
 			{
-				lbuf = readline(buffs[j], pPos[j]);
-				if(!m_bShareX)
-				{
-					if(lbuf.empty())
-					{
-						ostr.str(_TEXT(""));
-						ostr<<0<<m_strDataSeparator.c_str()<<0<<_TEXT("\n");
-						lbuf = ostr.str();
-					}
-					
-					trimspace(lbuf);
-					
-					if(j > 0)
-					{
-						lbuf = m_strDataSeparator + lbuf;
-					}
-				}
-				else
-				{
-					if(lbuf.empty())
-					{
-						x = 0.0;
-						y = 0.0;
-					}
-					else
-					{
-						tistringstream istr(lbuf);
-						istr>>x>>y;
-					} 
+				vvX[i].push_back(vVal[0]);
+				vvY[i].push_back(vVal[i+1]);
+			}
+			else
+			{
+				vvX[i].push_back(vVal[2*i]);
+				vvY[i].push_back(vVal[2*i+1]);
+			}
+		}
+	}
+	return true;
+}
 
-					ostr.str(_TEXT(""));
-					if(j == 0)
-					{
-						ostr << x << m_strDataSeparator.c_str() << y;
-					}
-					else
-					{
-						ostr << m_strDataSeparator.c_str() << y;
-					}
-					lbuf = ostr.str();
-				}
-				
-				line += lbuf;
+// The first line with two numbers or more sets the columns, reading stops at a line with another count
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::LoadColumns( CTextFileReader &reader, FcnLoadProgress fcnProgress, void *pPara, bool &bCancel )
+{
+	const TCHAR *pBegin, *pEnd;
+	int fstCols = 0, i;
+	vector<vector<double> > vvX, vvY;
+	bool bRead = false, bStop = false;
+
+	while(!bStop && reader.ReadLines(pBegin, pEnd))
+	{
+		bStop = !ParseColumns(pBegin, pEnd, 0, fstCols, vvX, vvY);
+
+		// the window goes to the curves, so a drawing shows it
+		for(i=0; i<(int)vvX.size(); i++)
+		{
+			if(vvX[i].size() <= 0)continue;
+			if(!PutLoadWindow(i, vvX[i], vvY[i]))
+			{
+				bCancel = true;
+				return bRead;
 			}
-			
-			line += _TEXT("\n");
-			buff += line;
+			bRead = true;
 		}
+		if(!ReportLoad(reader.GetProgress(), fcnProgress, pPara))
+		{
+			bCancel = true;
+			break;
+		}
+	}
+	return bRead;
+}
 
-		delete []buffs;
-		delete []pPos;
+// Adds the window at once on this thread, or queues it for the thread that owns the plot
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::PutLoadWindow( int nCurve, vector<double> &vX, vector<double> &vY )
+{
+	if(vX.size() <= 0)return true;
+	if(!m_pLoadQueue)
+	{
+		AddLoadWindow(nCurve, &vX[0], &vY[0], (int)vX.size());
+		vX.clear();
+		vY.clear();
 		return true;
 	}
+
+	LoadWindow *pWindow = new LoadWindow;
+	pWindow->nCurve = nCurve;
+	pWindow->vX.swap(vX);
+	pWindow->vY.swap(vY);
+	return PushLoadWindow(pWindow);
 }
 
+// Takes the window, it is added at once without a load thread
 template<class PlotImplT>
-bool		CDataSetImpl<PlotImplT>::ReadFromFile( tstring pathName )
+bool		CDataSetImpl<PlotImplT>::PushLoadWindow( LoadWindow *pWindow )
 {
-	tifstream			ifs;
-#if defined(_UNICODE) || defined(UNICODE)
-	string name;
-	if(!mywcs2mbs(pathName, name))return false;
-	ifs.open(name.c_str());
-#else
-	ifs.open(pathName.c_str());
-#endif
-	if(!ifs.is_open())return false;
-	
-	tstring content;
-	int filesize=get_file_size(pathName.c_str());
-	TCHAR *pBuff=new TCHAR[filesize+1];
-	memset(pBuff, 0, (filesize+1)*sizeof(TCHAR));
-	ifs.read(pBuff, filesize);
-	content=pBuff;
-	delete []pBuff;
-	ifs.close();
-	
-	return ReadFromBuff(content);
+	if(!m_pLoadQueue)
+	{
+		CommitLoadWindow(pWindow);
+		return true;
+	}
+
+	// a full queue waits for the next draw or WaitLoad
+	while(m_pLoadQueue->GetCount() >= m_pLoadQueue->GetCapacity())
+	{
+		if(m_bCancelLoad)
+		{
+			delete pWindow;
+			return false;
+		}
+		Sleep(1);
+	}
+	m_pLoadQueue->Push(pWindow);
+	return true;
+}
+
+template<class PlotImplT>
+void		CDataSetImpl<PlotImplT>::AddLoadWindow( int nCurve, double *pX, double *pY, int nLen )
+{
+	while((int)m_vLoadDataID.size() <= nCurve)
+	{
+		m_vLoadDataID.push_back(AddEmpty());
+	}
+	AppendPoints(m_vLoadDataID[nCurve], pX, pY, nLen);
+}
+
+// On the thread that owns the plot, returns the points added
+template<class PlotImplT>
+int		CDataSetImpl<PlotImplT>::CommitLoadWindow( LoadWindow *pWindow )
+{
+	int nLen;
+	if(pWindow->bBinary)
+	{
+		nLen = (int)pWindow->vData.size();
+		AddBinaryCurve(*pWindow);
+	}
+	else
+	{
+		nLen = (int)pWindow->vX.size();
+		AddLoadWindow(pWindow->nCurve, &pWindow->vX[0], &pWindow->vY[0], nLen);
+	}
+	delete pWindow;
+	return nLen;
+}
+
+// Each curve of a binary file is parsed whole, then added or queued as the text windows are
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::LoadBinary( tstring pathName, FcnLoadProgress fcnProgress, void *pPara )
+{
+	CBinaryDataFile file;
+	if(!file.Open(pathName))return false;
+
+	int i, count = 0, nCurves = file.GetCurveCount();
+	for(i=0; i<nCurves; i++)
+	{
+		LoadWindow *pCurve = new LoadWindow;
+		if(!ReadBinaryCurve(file, i, *pCurve))
+		{
+			delete pCurve;
+			continue;
+		}
+		if(!PushLoadWindow(pCurve))return false;
+		count++;
+		if(!ReportLoad(double(i+1)/nCurves, fcnProgress, pPara))return false;
+	}
+	return count>0;
+}
+
+template<class PlotImplT>
+int		CDataSetImpl<PlotImplT>::DrainLoadQueue()
+{
+	if(!m_pLoadQueue)return 0;
+
+	LoadWindow *pWindow;
+	int nTotal = 0;
+	while(m_pLoadQueue->Pop(&pWindow, 1) == 1)
+	{
+		nTotal += CommitLoadWindow(pWindow);
+	}
+	return nTotal;
+}
+
+template<class PlotImplT>
+void		CDataSetImpl<PlotImplT>::ClearLoadQueue()
+{
+	if(!m_pLoadQueue)return;
+
+	LoadWindow *pWindow;
+	while(m_pLoadQueue->Pop(&pWindow, 1) == 1)
+	{
+		delete pWindow;
+	}
+	delete m_pLoadQueue;
+	m_pLoadQueue = 0;
+}
+
+template<class PlotImplT>
+DWORD	WINAPI	CDataSetImpl<PlotImplT>::LoadThreadProc( LPVOID pPara )
+{
+	CDataSetImpl<PlotImplT> *pThis = (CDataSetImpl<PlotImplT> *)pPara;
+	pThis->DoLoadFromFile(pThis->m_strLoadPath, pThis->m_fcnLoadProgress, pThis->m_pLoadPara);
+	return 0;
+}
+
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::StartLoadFromFile( tstring pathName, FcnLoadProgress fcnProgress, void *pPara )
+{
+	if(IsLoading())return false;
+	WaitLoad();
+
+	m_bCancelLoad = false;
+	m_strLoadPath = pathName;
+	m_fcnLoadProgress = fcnProgress;
+	m_pLoadPara = pPara;
+	m_vLoadDataID.clear();
+	m_pLoadQueue = new CIngestQueue<LoadWindow *>(64);
+	m_hLoadThread = CreateThread(NULL, 0, LoadThreadProc, this, 0, NULL);
+	if(m_hLoadThread == NULL)ClearLoadQueue();
+	return m_hLoadThread != NULL;
+}
+
+template<class PlotImplT>
+bool		CDataSetImpl<PlotImplT>::IsLoading()
+{
+	if(m_hLoadThread == NULL)return false;
+
+	DrainLoadQueue();
+	if(WaitForSingleObject(m_hLoadThread, 0) == WAIT_TIMEOUT)return true;
+	WaitLoad();
+	return false;
+}
+
+template<class PlotImplT>
+void		CDataSetImpl<PlotImplT>::WaitLoad()
+{
+	if(m_hLoadThread == NULL)return;
+	// the thread may be waiting for room in the queue
+	while(WaitForSingleObject(m_hLoadThread, 10) == WAIT_TIMEOUT)
+	{
+		DrainLoadQueue();
+	}
+	CloseHandle(m_hLoadThread);
+	m_hLoadThread = NULL;
+	DrainLoadQueue();
+	ClearLoadQueue();
+}
+
+template<class PlotImplT>
+void		CDataSetImpl<PlotImplT>::CancelLoad()
+{
+	m_bCancelLoad = true;
+	WaitLoad();
 }
 
 template<class PlotImplT>
@@ -1264,166 +1891,63 @@ int		CDataSetImpl<PlotImplT>::GetNumsInStr(tstring buff)
 template<class PlotImplT>
 bool		CDataSetImpl<PlotImplT>::ReadFromBuff( tstring buff )
 {
-	tstring strSep = m_strFileSeparator;
-	tstring::size_type pos;
+	const TCHAR *pBegin = buff.c_str();
+	const TCHAR *pEnd = pBegin + buff.length();
 	
 	if(m_bSequence)
 	{
+		tstring strSep = m_strFileSeparator;
 		trimspace(strSep);
 		
-		tstring buffUsed, buffLeft;
-		
-		//pos = buff.find_first_of(strSep);
-		pos = find_first_matchstring(buff, strSep);
-		if(pos == tstring::npos)
-		{
-			buffUsed = buff;
-			buffLeft = _TEXT("");
-		}
-		else
-		{
-			buffUsed = buff.substr(0, pos);
-			buffLeft = buff.substr(pos + m_strFileSeparator.length());
-		}
-		
-		CPlotData<DataPoint2D> dataSet;
+		// each block between the file separators is a curve
+		tstring::size_type pos, curpos = 0;
 		int count = 0;
-		while(buffUsed != _TEXT(""))
+		while(curpos < buff.length())
 		{
-			if( !dataSet.ReadFromBuff( buffUsed ) )continue;
-			int dataID = AddData(dataSet.GetData());
-			if(!dataSet.GetTitle().empty() && dataSet.GetTitle()!=CGlobal::GetStrUntitle())
-			{
-				SetDataTitle( dataID, dataSet.GetTitle() );
-			}
-			count ++;
+			pos = strSep.empty() ? tstring::npos : buff.find(strSep, curpos);
+			if(pos == tstring::npos)pos = buff.length();
 			
-			//pos = buffLeft.find_first_of(strSep);
-			pos = find_first_matchstring(buffLeft, strSep);
-			if(pos == tstring::npos)
+			CPlotData<DataPoint2D> dataSet;
+			if( dataSet.ReadFromBuff( pBegin + curpos, pBegin + pos ) )
 			{
-				buffUsed = buffLeft;
-				buffLeft = _TEXT("");
-			}
-			else
-			{
-				buffUsed = buffLeft.substr(0, pos);
-				buffLeft = buffLeft.substr(pos + strSep.length());
+				int dataID = AddData(dataSet.GetData());
+				if(!dataSet.GetTitle().empty() && dataSet.GetTitle()!=CGlobal::GetStrUntitle())
+				{
+					SetDataTitle( dataID, dataSet.GetTitle() );
+				}
+				count ++;
 			}
+			
+			curpos = pos + strSep.length();
 		}
 		return count>0;
 	}
 	else
 	{
-		tstring	pattern;
-		pattern = _TEXT("^(-?\\d+(\\.\\d*)?([eE][+-]?\\d*)?\\s*){2,}$");
-
-		tstring aline, aline1, subline;
-		CRegexpT <TCHAR> datalineReg(pattern.c_str());
-		MatchResult rst1;
-		int match1;
-		int pos1, pos2;
-
-		tstring	numpatt;
-		numpatt = _TEXT("-?\\d+(\\.\\d*)?([eE][+-]?\\d*)?");
-		CRegexpT <TCHAR> numReg(numpatt.c_str());
-		MatchResult rstnum;
-		int matchnum;
-
-		tstring::size_type curpos;
-
-		double x, y, val;
-		int cols, fstCols;;
-		bool bFirstLine = true;
-		int nCurves, i;
-
-		int *pIndex = 0;
+		const TCHAR *p;
+		int nLines = 1;
+		for(p = pBegin; p < pEnd; p++)
+		{
+			if(*p == _TEXT('\n'))nLines++;
+		}
+		
+		int fstCols = 0, i;
+		vector<vector<double> > vvX, vvY;
+		ParseColumns(pBegin, pEnd, nLines, fstCols, vvX, vvY);
+		if(fstCols <= 0)return false;
+		
 		int dataID;
-
-		curpos=0;
-		do
+		bool bRead = false;
+		for(i=0; i<(int)vvX.size(); i++)
 		{
-			aline=readline(buff,curpos);
-			aline1 = aline;
-			trimspace(aline1);
-
-			rst1=datalineReg.MatchExact(aline1.c_str());
-			match1=rst1.IsMatched();
-			if(match1)
+			dataID = AddEmpty();
+			if(vvX[i].size() > 0)
 			{
-				cols = GetNumsInStr(aline1);
-				if(bFirstLine)
-				{
-					fstCols = cols;
-
-					if(cols < 2)
-					{
-						return false;
-					}
-
-					if(m_bShareX)
-					{
-						nCurves = cols-1;
-					}
-					else
-					{
-						nCurves = cols/2;
-					}
-
-					pIndex = new int[nCurves];
-					for(i=0; i<nCurves; i++)
-					{
-						dataID = AddEmpty();
-						pIndex[i] = GetIndex(dataID);
-					}
-					bFirstLine = false;
-				}
-				if(cols != fstCols)break;
-
-				for(i=0; i<cols; i++)
-				{
-					rstnum = numReg.Match(aline1.c_str());
-					matchnum = rstnum.IsMatched();
-					if(matchnum)
-					{
-						pos1 = rstnum.GetStart();
-						pos2 = rstnum.GetEnd();
-						subline = aline1.substr(pos1, pos2);
-						aline1 = aline1.substr(pos2);
-						
-						tistringstream istr(subline);
-						istr>>val;
-					}
-					if(m_bShareX)
-					{
-						if(i == 0)
-						{
-							x = val;
-						}
-						else
-						{
-							y = val;
-							AddPoint(x, y, pIndex[i-1]);
-						}
-					}
-					else
-					{
-						if(i%2 == 0)
-						{
-							x = val;
-						}
-						else
-						{
-							y = val;
-							AddPoint(x, y, pIndex[i/2]);
-						}
-					}
-				}
+				AppendPoints(dataID, &vvX[i][0], &vvY[i][0], (int)vvX[i].size());
+				bRead = true;
 			}
-		}while(curpos != tstring::npos);
-
-		if(pIndex)delete []pIndex;
-		return false;
+		}
+		return bRead;
 	}
 }
 
@@ -0,0 +1,153 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#include "DrawStats.h"
+#include <stdio.h>
+#include <tchar.h>
+
+using namespace NsCChart;
+
+CDrawStats::CDrawStats()
+{
+	m_nDepth = 0;
+	Reset();
+}
+
+CDrawStats::~CDrawStats()
+{
+
+}
+
+void	CDrawStats::Reset()
+{
+	int i;
+	for(i=0; i<kDrawPhaseCount; i++)
+	{
+		m_pfStart[i] = 0.0;
+		m_pfFrameTime[i] = m_pfLastTime[i] = m_pfTotalTime[i] = 0.0;
+	}
+	for(i=0; i<kDrawCountCount; i++)
+	{
+		m_pnFrameCount[i] = m_pnLastCount[i] = m_pnTotalCount[i] = 0;
+	}
+	m_nFrames = 0;
+}
+
+double	CDrawStats::Now()
+{
+	static double fToMs = 0.0;
+	LARGE_INTEGER li;
+	if(fToMs == 0.0)
+	{
+		QueryPerformanceFrequency(&li);
+		fToMs = li.QuadPart>0 ? 1000.0/(double)li.QuadPart : 1.0;
+	}
+	QueryPerformanceCounter(&li);
+	return (double)li.QuadPart * fToMs;
+}
+
+void	CDrawStats::BeginFrame()
+{
+	if(m_nDepth++ > 0)return;
+
+	int i;
+	for(i=0; i<kDrawPhaseCount; i++)m_pfFrameTime[i] = 0.0;
+	for(i=0; i<kDrawCountCount; i++)m_pnFrameCount[i] = 0;
+	m_pfStart[kDrawPhaseTotal] = Now();
+}
+
+void	CDrawStats::EndFrame()
+{
+	if(m_nDepth <= 0 || --m_nDepth > 0)return;
+
+	m_pfFrameTime[kDrawPhaseTotal] = Now() - m_pfStart[kDrawPhaseTotal];
+	int i;
+	for(i=0; i<kDrawPhaseCount; i++)
+	{
+		m_pfLastTime[i] = m_pfFrameTime[i];
+		m_pfTotalTime[i] += m_pfFrameTime[i];
+	}
+	for(i=0; i<kDrawCountCount; i++)
+	{
+		m_pnLastCount[i] = m_pnFrameCount[i];
+		m_pnTotalCount[i] += m_pnFrameCount[i];
+	}
+	m_nFrames++;
+}
+
+void	CDrawStats::BeginPhase(int nPhase)
+{
+	if(m_nDepth <= 0)return;
+	m_pfStart[nPhase] = Now();
+}
+
+void	CDrawStats::EndPhase(int nPhase)
+{
+	if(m_nDepth <= 0)return;
+	m_pfFrameTime[nPhase] += Now() - m_pfStart[nPhase];
+}
+
+const TCHAR	*CDrawStats::GetPhaseName(int nPhase)
+{
+	static const TCHAR *names[kDrawPhaseCount] =
+	{
+		_TEXT("total"), _TEXT("plot_range"), _TEXT("axes"), _TEXT("screen_points"),
+		_TEXT("curves"), _TEXT("markers"), _TEXT("legend"), _TEXT("blit")
+	};
+	if(nPhase<0 || nPhase>=kDrawPhaseCount)return _TEXT("");
+	return names[nPhase];
+}
+
+const TCHAR	*CDrawStats::GetCountName(int nWhich)
+{
+	static const TCHAR *names[kDrawCountCount] =
+	{
+		_TEXT("points"), _TEXT("screen_hits"), _TEXT("screen_extends"), _TEXT("screen_misses"),
+		_TEXT("range_hits"), _TEXT("range_misses"), _TEXT("allocations")
+	};
+	if(nWhich<0 || nWhich>=kDrawCountCount)return _TEXT("");
+	return names[nWhich];
+}
+
+tstring	CDrawStats::ToJson()
+{
+	TCHAR buf[64];
+	tstring json;
+	int i, k;
+
+	_stprintf(buf, _TEXT("{\"frames\":%d"), m_nFrames);
+	json = buf;
+	for(k=0; k<2; k++)
+	{
+		json += k==0 ? _TEXT(",\"last\":{") : _TEXT(",\"sum\":{");
+		for(i=0; i<kDrawPhaseCount; i++)
+		{
+			_stprintf(buf, _TEXT("%s\"%s_ms\":%.3f"), i>0?_TEXT(","):_TEXT(""), GetPhaseName(i), k==0?m_pfLastTime[i]:m_pfTotalTime[i]);
+			json += buf;
+		}
+		for(i=0; i<kDrawCountCount; i++)
+		{
+			_stprintf(buf, _TEXT(",\"%s\":%I64d"), GetCountName(i), k==0?m_pnLastCount[i]:m_pnTotalCount[i]);
+			json += buf;
+		}
+		json += _TEXT("}");
+	}
+	json += _TEXT("}");
+	return json;
+}
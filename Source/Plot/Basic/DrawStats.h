@@ -0,0 +1,110 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#include <windows.h>
+#include "MyString.h"
+#include "CChartNameSpace.h"
+
+Declare_Namespace_CChart
+
+// Define NO_DRAW_STATS to compile the recording away, the queries then return zeros
+#ifndef NO_DRAW_STATS
+#	define DRAW_STATS_FRAME_BEGIN(pStats)		(pStats)->BeginFrame()
+#	define DRAW_STATS_FRAME_END(pStats)			(pStats)->EndFrame()
+#	define DRAW_STATS_BEGIN(pStats, phase)		(pStats)->BeginPhase(phase)
+#	define DRAW_STATS_END(pStats, phase)			(pStats)->EndPhase(phase)
+#	define DRAW_STATS_COUNT(pStats, which, n)	(pStats)->AddCount(which, n)
+#else
+#	define DRAW_STATS_FRAME_BEGIN(pStats)		((void)0)
+#	define DRAW_STATS_FRAME_END(pStats)			((void)0)
+#	define DRAW_STATS_BEGIN(pStats, phase)		((void)0)
+#	define DRAW_STATS_END(pStats, phase)			((void)0)
+#	define DRAW_STATS_COUNT(pStats, which, n)	((void)0)
+#endif
+
+// Phases of a frame, the time of a phase is summed over the curves
+enum
+{
+	kDrawPhaseTotal,
+	kDrawPhasePlotRange,	// GetPlotRange
+	kDrawPhaseAxes,			// plot rect layout, grids, axes and tick labels
+	kDrawPhaseScreenPoints,	// compaction and screen points
+	kDrawPhaseCurves,		// DrawCurveOnly
+	kDrawPhaseMarkers,
+	kDrawPhaseLegend,
+	kDrawPhaseBlit,			// memory DC to the target
+
+	kDrawPhaseCount
+};
+
+enum
+{
+	kDrawCountPoints,			// data points of the visible curves
+	kDrawCountScreenHits,		// curves drawn from the cached screen points
+	kDrawCountScreenExtends,	// curves with only appended points transformed
+	kDrawCountScreenMisses,		// curves with all screen points computed again
+	kDrawCountRangeHits,		// data range of the plot taken from the cache
+	kDrawCountRangeMisses,
+	kDrawCountAllocations,		// screen point buffers and memory DCs created
+
+	kDrawCountCount
+};
+
+// Wall time and counters of the frames drawn by a plot, the last frame and the sum since Reset.
+// A frame is the outermost FinalDraw, nested FinalDraw calls belong to it
+class CDrawStats
+{
+public:
+	CDrawStats();
+	virtual	~CDrawStats();
+
+	void	BeginFrame();
+	void	EndFrame();
+	void	BeginPhase(int nPhase);
+	void	EndPhase(int nPhase);
+	inline	void	AddCount(int nWhich, int n){if(m_nDepth>0)m_pnFrameCount[nWhich] += n;}
+
+	void	Reset();
+	inline	int		GetFrames(){return m_nFrames;}
+	// milliseconds
+	inline	double	GetLastTime(int nPhase){return m_pfLastTime[nPhase];}
+	inline	double	GetTotalTime(int nPhase){return m_pfTotalTime[nPhase];}
+	// the point counts add up over the curves and frames, so the counters are 64 bit
+	inline	__int64	GetLastCount(int nWhich){return m_pnLastCount[nWhich];}
+	inline	__int64	GetTotalCount(int nWhich){return m_pnTotalCount[nWhich];}
+
+	static	const TCHAR	*GetPhaseName(int nPhase);
+	static	const TCHAR	*GetCountName(int nWhich);
+
+	// {"frames":n,"last":{"total_ms":...,"points":...},"sum":{...}}
+	tstring	ToJson();
+
+protected:
+	double	Now();
+
+	int		m_nDepth;
+	int		m_nFrames;
+	double	m_pfStart[kDrawPhaseCount];
+	double	m_pfFrameTime[kDrawPhaseCount], m_pfLastTime[kDrawPhaseCount], m_pfTotalTime[kDrawPhaseCount];
+	__int64	m_pnFrameCount[kDrawCountCount], m_pnLastCount[kDrawCountCount], m_pnTotalCount[kDrawCountCount];
+};
+
+Declare_Namespace_End
@@ -0,0 +1,754 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#include "DrawSurface.h"
+#include <math.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <fstream>
+
+using namespace NsCChart;
+using namespace std;
+
+static inline unsigned int	ToPixel(COLORREF color)
+{
+	return 0xFF000000 | (GetRValue(color)<<16) | (GetGValue(color)<<8) | GetBValue(color);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// CGdiSurface
+
+CGdiSurface::CGdiSurface(HDC hDC)
+{
+	m_hDC = hDC;
+	m_hPen = m_hOldPen = 0;
+	m_hBrush = m_hOldBrush = 0;
+	m_hFont = m_hOldFont = 0;
+	m_crOldText = 0;
+	m_bTextColorSaved = false;
+	m_hOldClip = 0;
+	m_bClipSaved = false;
+}
+
+CGdiSurface::~CGdiSurface()
+{
+	if(m_hOldPen)SelectObject(m_hDC, m_hOldPen);
+	if(m_hOldBrush)SelectObject(m_hDC, m_hOldBrush);
+	if(m_hOldFont)SelectObject(m_hDC, m_hOldFont);
+	if(m_hPen)DeleteObject(m_hPen);
+	if(m_hBrush)DeleteObject(m_hBrush);
+	if(m_hFont)DeleteObject(m_hFont);
+	if(m_bTextColorSaved)::SetTextColor(m_hDC, m_crOldText);
+	if(m_bClipSaved)
+	{
+		SelectClipRgn(m_hDC, m_hOldClip);
+		if(m_hOldClip)DeleteObject(m_hOldClip);
+	}
+}
+
+void	CGdiSurface::SetPen(COLORREF color, int nWidth, int nStyle)
+{
+	HPEN hPen = CreatePen(nStyle, nWidth, color);
+	HPEN hOld = (HPEN)SelectObject(m_hDC, hPen);
+	if(!m_hOldPen)m_hOldPen = hOld;
+	if(m_hPen)DeleteObject(m_hPen);
+	m_hPen = hPen;
+}
+
+void	CGdiSurface::SetBrush(COLORREF color)
+{
+	HBRUSH hBrush = CreateSolidBrush(color);
+	HBRUSH hOld = (HBRUSH)SelectObject(m_hDC, hBrush);
+	if(!m_hOldBrush)m_hOldBrush = hOld;
+	if(m_hBrush)DeleteObject(m_hBrush);
+	m_hBrush = hBrush;
+}
+
+void	CGdiSurface::SetNullBrush()
+{
+	HBRUSH hOld = (HBRUSH)SelectObject(m_hDC, (HBRUSH)GetStockObject(NULL_BRUSH));
+	if(!m_hOldBrush)m_hOldBrush = hOld;
+	if(m_hBrush)DeleteObject(m_hBrush);
+	m_hBrush = 0;
+}
+
+void	CGdiSurface::SetFont(const LOGFONT &logFont)
+{
+	HFONT hFont = CreateFontIndirect(&logFont);
+	HFONT hOld = (HFONT)SelectObject(m_hDC, hFont);
+	if(!m_hOldFont)m_hOldFont = hOld;
+	if(m_hFont)DeleteObject(m_hFont);
+	m_hFont = hFont;
+}
+
+void	CGdiSurface::SetTextColor(COLORREF color)
+{
+	COLORREF crOld = ::SetTextColor(m_hDC, color);
+	if(!m_bTextColorSaved)
+	{
+		m_crOldText = crOld;
+		m_bTextColorSaved = true;
+	}
+}
+
+void	CGdiSurface::SetClip(const RECT *pRect)
+{
+	if(!m_bClipSaved)
+	{
+		m_hOldClip = CreateRectRgn(0, 0, 0, 0);
+		if(GetClipRgn(m_hDC, m_hOldClip) != 1)
+		{
+			DeleteObject(m_hOldClip);
+			m_hOldClip = 0;
+		}
+		m_bClipSaved = true;
+	}
+	if(!pRect)
+	{
+		SelectClipRgn(m_hDC, NULL);
+		return;
+	}
+
+	RECT rect = *pRect;
+	LPtoDP(m_hDC, (LPPOINT)&rect, 2);
+	HRGN hRgn = CreateRectRgn(rect.left, rect.top, rect.right, rect.bottom);
+	SelectClipRgn(m_hDC, hRgn);
+	DeleteObject(hRgn);
+}
+
+void	CGdiSurface::DrawPolyline(const POINT *pPts, int nPts)
+{
+	if(nPts>1)::Polyline(m_hDC, pPts, nPts);
+}
+
+void	CGdiSurface::DrawPolyPolyline(const POINT *pPts, const DWORD *pCounts, int nPolys)
+{
+	if(nPolys>0)::PolyPolyline(m_hDC, pPts, pCounts, nPolys);
+}
+
+void	CGdiSurface::DrawBeziers(const POINT *pPts, int nPts)
+{
+	if(nPts>=4)::PolyBezier(m_hDC, pPts, nPts);
+}
+
+void	CGdiSurface::FillPolygon(const POINT *pPts, int nPts)
+{
+	if(nPts>2)::Polygon(m_hDC, pPts, nPts);
+}
+
+void	CGdiSurface::FillRectangle(const RECT &rect, COLORREF color)
+{
+	HBRUSH hBrush = CreateSolidBrush(color);
+	::FillRect(m_hDC, &rect, hBrush);
+	DeleteObject(hBrush);
+}
+
+// Transparent, the lines of a multiline string are centred as DT_CENTER
+void	CGdiSurface::DrawString(int x, int y, const TCHAR *str, int nLen)
+{
+	SIZE size = MeasureString(str, nLen);
+	RECT rect = {x, y, x + size.cx, y + size.cy};
+	int nOldBkMode = SetBkMode(m_hDC, TRANSPARENT);
+	DrawText(m_hDC, str, nLen, &rect, DT_NOCLIP | DT_CENTER);
+	SetBkMode(m_hDC, nOldBkMode);
+}
+
+// Measured as DrawText lays it out, so line breaks count
+SIZE	CGdiSurface::MeasureString(const TCHAR *str, int nLen)
+{
+	SIZE size = {0, 0};
+	RECT rect = {0, 0, 0, 0};
+	DrawText(m_hDC, str, nLen, &rect, DT_CALCRECT);
+	size.cx = rect.right - rect.left;
+	size.cy = rect.bottom - rect.top;
+	return size;
+}
+
+void	CGdiSurface::BlitPixels(int x, int y, int nWidth, int nHeight, const unsigned int *pPixels, int nStride)
+{
+	if(nWidth<=0 || nHeight<=0)return;
+
+	BITMAPINFO bmi;
+	memset(&bmi, 0, sizeof(BITMAPINFO));
+	bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+	bmi.bmiHeader.biWidth = nStride;
+	bmi.bmiHeader.biHeight = -nHeight;// top-down
+	bmi.bmiHeader.biPlanes = 1;
+	bmi.bmiHeader.biBitCount = 32;
+	bmi.bmiHeader.biCompression = BI_RGB;
+
+	SetDIBitsToDevice(m_hDC, x, y, nWidth, nHeight, 0, 0, 0, nHeight, pPixels, &bmi, DIB_RGB_COLORS);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// CRasterSurface
+
+// 5x8 glyphs of ASCII 0x20 to 0x7E, one byte per column, the lowest bit on top
+static const unsigned char	gFont5x8[95*5] =
+{
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x00, 0x00, 0x00, 0x07, 0x00, 0x07, 0x00, 0x14, 0x7F, 0x14, 0x7F, 0x14,
+	0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x23, 0x13, 0x08, 0x64, 0x62, 0x36, 0x49, 0x56, 0x20, 0x50, 0x00, 0x08, 0x07, 0x03, 0x00,
+	0x00, 0x1C, 0x22, 0x41, 0x00, 0x00, 0x41, 0x22, 0x1C, 0x00, 0x2A, 0x1C, 0x7F, 0x1C, 0x2A, 0x08, 0x08, 0x3E, 0x08, 0x08,
+	0x00, 0x80, 0x70, 0x30, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x60, 0x60, 0x00, 0x20, 0x10, 0x08, 0x04, 0x02,
+	0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00, 0x42, 0x7F, 0x40, 0x00, 0x72, 0x49, 0x49, 0x49, 0x46, 0x21, 0x41, 0x49, 0x4D, 0x33,
+	0x18, 0x14, 0x12, 0x7F, 0x10, 0x27, 0x45, 0x45, 0x45, 0x39, 0x3C, 0x4A, 0x49, 0x49, 0x31, 0x41, 0x21, 0x11, 0x09, 0x07,
+	0x36, 0x49, 0x49, 0x49, 0x36, 0x46, 0x49, 0x49, 0x29, 0x1E, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x40, 0x34, 0x00, 0x00,
+	0x00, 0x08, 0x14, 0x22, 0x41, 0x14, 0x14, 0x14, 0x14, 0x14, 0x00, 0x41, 0x22, 0x14, 0x08, 0x02, 0x01, 0x59, 0x09, 0x06,
+	0x3E, 0x41, 0x5D, 0x59, 0x4E, 0x7C, 0x12, 0x11, 0x12, 0x7C, 0x7F, 0x49, 0x49, 0x49, 0x36, 0x3E, 0x41, 0x41, 0x41, 0x22,
+	0x7F, 0x41, 0x41, 0x41, 0x3E, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x7F, 0x09, 0x09, 0x09, 0x01, 0x3E, 0x41, 0x41, 0x51, 0x73,
+	0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00, 0x41, 0x7F, 0x41, 0x00, 0x20, 0x40, 0x41, 0x3F, 0x01, 0x7F, 0x08, 0x14, 0x22, 0x41,
+	0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x02, 0x1C, 0x02, 0x7F, 0x7F, 0x04, 0x08, 0x10, 0x7F, 0x3E, 0x41, 0x41, 0x41, 0x3E,
+	0x7F, 0x09, 0x09, 0x09, 0x06, 0x3E, 0x41, 0x51, 0x21, 0x5E, 0x7F, 0x09, 0x19, 0x29, 0x46, 0x26, 0x49, 0x49, 0x49, 0x32,
+	0x03, 0x01, 0x7F, 0x01, 0x03, 0x3F, 0x40, 0x40, 0x40, 0x3F, 0x1F, 0x20, 0x40, 0x20, 0x1F, 0x3F, 0x40, 0x38, 0x40, 0x3F,
+	0x63, 0x14, 0x08, 0x14, 0x63, 0x03, 0x04, 0x78, 0x04, 0x03, 0x61, 0x59, 0x49, 0x4D, 0x43, 0x00, 0x7F, 0x41, 0x41, 0x41,
+	0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x41, 0x41, 0x41, 0x7F, 0x04, 0x02, 0x01, 0x02, 0x04, 0x40, 0x40, 0x40, 0x40, 0x40,
+	0x00, 0x01, 0x02, 0x04, 0x00, 0x20, 0x54, 0x54, 0x78, 0x40, 0x7F, 0x28, 0x44, 0x44, 0x38, 0x38, 0x44, 0x44, 0x44, 0x28,
+	0x38, 0x44, 0x44, 0x28, 0x7F, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x08, 0x7E, 0x09, 0x02, 0x18, 0xA4, 0xA4, 0x9C, 0x78,
+	0x7F, 0x08, 0x04, 0x04, 0x78, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x20, 0x40, 0x40, 0x3D, 0x00, 0x7F, 0x10, 0x28, 0x44, 0x00,
+	0x00, 0x41, 0x7F, 0x40, 0x00, 0x7C, 0x04, 0x78, 0x04, 0x78, 0x7C, 0x08, 0x04, 0x04, 0x78, 0x38, 0x44, 0x44, 0x44, 0x38,
+	0xFC, 0x24, 0x24, 0x24, 0x18, 0x18, 0x24, 0x24, 0x24, 0xFC, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x48, 0x54, 0x54, 0x54, 0x24,
+	0x04, 0x04, 0x3F, 0x44, 0x24, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x1C, 0x20, 0x40, 0x20, 0x1C, 0x3C, 0x40, 0x30, 0x40, 0x3C,
+	0x44, 0x28, 0x10, 0x28, 0x44, 0x4C, 0x90, 0x90, 0x90, 0x7C, 0x44, 0x64, 0x54, 0x4C, 0x44, 0x00, 0x08, 0x36, 0x41, 0x00,
+	0x00, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x41, 0x36, 0x08, 0x00, 0x02, 0x01, 0x02, 0x04, 0x02,
+};
+
+const int	kGlyphWidth = 5;
+const int	kGlyphHeight = 8;
+
+// Dash patterns of PS_DASH to PS_DASHDOTDOT in pixels of a one pixel pen, on and off alternately
+static const int	gDashPattern[4][7] =
+{
+	{18, 6, 0},
+	{3, 3, 0},
+	{9, 6, 3, 6, 0},
+	{9, 3, 3, 3, 3, 3, 0}
+};
+
+CRasterSurface::CRasterSurface(int nWidth, int nHeight, COLORREF crBkgnd)
+{
+	m_nWidth = 0;
+	m_nHeight = 0;
+
+	m_nPenColor = ToPixel(RGB(0, 0, 0));
+	m_nPenWidth = 1;
+	m_nPenStyle = PS_SOLID;
+	m_nBrushColor = ToPixel(RGB(255, 255, 255));
+	m_bNullBrush = false;
+	m_nTextColor = ToPixel(RGB(0, 0, 0));
+	m_nFontScale = 1;
+	m_nDashPos = 0;
+
+	Resize(nWidth, nHeight);
+	Clear(crBkgnd);
+}
+
+CRasterSurface::~CRasterSurface()
+{
+
+}
+
+void	CRasterSurface::Resize(int nWidth, int nHeight)
+{
+	if(nWidth<0)nWidth = 0;
+	if(nHeight<0)nHeight = 0;
+	m_nWidth = nWidth;
+	m_nHeight = nHeight;
+	m_vPixels.resize(nWidth * nHeight);
+	SetClip(0);
+}
+
+void	CRasterSurface::Clear(COLORREF color)
+{
+	std::fill(m_vPixels.begin(), m_vPixels.end(), ToPixel(color));
+}
+
+void	CRasterSurface::SetPen(COLORREF color, int nWidth, int nStyle)
+{
+	m_nPenColor = ToPixel(color);
+	m_nPenWidth = nWidth<1?1:nWidth;
+	m_nPenStyle = nStyle;
+	m_nDashPos = 0;
+}
+
+void	CRasterSurface::SetBrush(COLORREF color)
+{
+	m_nBrushColor = ToPixel(color);
+	m_bNullBrush = false;
+}
+
+void	CRasterSurface::SetNullBrush()
+{
+	m_bNullBrush = true;
+}
+
+void	CRasterSurface::SetFont(const LOGFONT &logFont)
+{
+	int h = abs(logFont.lfHeight);
+	m_nFontScale = (h + kGlyphHeight/2) / kGlyphHeight;
+	if(m_nFontScale<1)m_nFontScale = 1;
+}
+
+void	CRasterSurface::SetTextColor(COLORREF color)
+{
+	m_nTextColor = ToPixel(color);
+}
+
+void	CRasterSurface::SetClip(const RECT *pRect)
+{
+	m_rctClip.left = 0;
+	m_rctClip.top = 0;
+	m_rctClip.right = m_nWidth;
+	m_rctClip.bottom = m_nHeight;
+	if(!pRect)return;
+
+	if(pRect->left > m_rctClip.left)m_rctClip.left = pRect->left;
+	if(pRect->top > m_rctClip.top)m_rctClip.top = pRect->top;
+	if(pRect->right < m_rctClip.right)m_rctClip.right = pRect->right;
+	if(pRect->bottom < m_rctClip.bottom)m_rctClip.bottom = pRect->bottom;
+}
+
+void	CRasterSurface::FillSpan(int y, int x1, int x2, unsigned int color)
+{
+	if(y<m_rctClip.top || y>=m_rctClip.bottom)return;
+	if(x1<m_rctClip.left)x1 = m_rctClip.left;
+	if(x2>=m_rctClip.right)x2 = m_rctClip.right-1;
+	if(x1>x2)return;
+	std::fill(m_vPixels.begin() + y*m_nWidth + x1, m_vPixels.begin() + y*m_nWidth + x2 + 1, color);
+}
+
+int		CRasterSurface::GetDashLength()
+{
+	if(m_nPenStyle<PS_DASH || m_nPenStyle>PS_DASHDOTDOT)return 0;
+
+	const int *pattern = gDashPattern[m_nPenStyle - PS_DASH];
+	int i, len = 0;
+	for(i=0; pattern[i]>0; i++)len += pattern[i] * m_nPenWidth;
+	return len;
+}
+
+bool	CRasterSurface::IsDashOn()
+{
+	int len = GetDashLength();
+	if(len<=0)return true;
+
+	const int *pattern = gDashPattern[m_nPenStyle - PS_DASH];
+	int i, pos = m_nDashPos % len;
+	for(i=0; pattern[i]>0; i++)
+	{
+		pos -= pattern[i] * m_nPenWidth;
+		if(pos<0)return i%2 == 0;
+	}
+	return true;
+}
+
+void	CRasterSurface::DrawDot(int x, int y)
+{
+	if(m_nPenWidth==1)
+	{
+		PutPixel(x, y, m_nPenColor);
+		return;
+	}
+
+	int i, lo = -(m_nPenWidth-1)/2;
+	for(i=0; i<m_nPenWidth; i++)
+	{
+		FillSpan(y+lo+i, x+lo, x+lo+m_nPenWidth-1, m_nPenColor);
+	}
+}
+
+// Steps of the segment from a0 by da per step that are within [lo, hi]
+static	void	ClipSteps(double a0, double da, double lo, double hi, double &s0, double &s1)
+{
+	if(da == 0.0)
+	{
+		if(a0 < lo || a0 > hi)s1 = s0 - 1.0;
+		return;
+	}
+	double t0 = (lo - a0)/da, t1 = (hi - a0)/da;
+	if(t0 > t1)std::swap(t0, t1);
+	if(t0 > s0)s0 = t0;
+	if(t1 < s1)s1 = t1;
+}
+
+// Bresenham along the major axis, the end point is not drawn, as LineTo.
+// The steps out of the clip are skipped, only counted in the dash position
+void	CRasterSurface::DrawSegment(int x1, int y1, int x2, int y2)
+{
+	int dx = abs(x2-x1), dy = abs(y2-y1);
+	int sx = x1<x2?1:-1, sy = y1<y2?1:-1;
+	bool bXMajor = dx >= dy;
+	int nSteps = bXMajor ? dx : dy;
+	int nMinor = bXMajor ? dy : dx;
+	if(nSteps <= 0)return;
+
+	int nDashStart = m_nDashPos;
+	int margin = m_nPenWidth;
+
+	// the steps whose dots may meet the clip, the minor axis is off the line by half a pixel at most
+	double s0 = 0.0, s1 = nSteps - 1.0;
+	double fSlope = (double)nMinor / nSteps;
+	if(bXMajor)
+	{
+		ClipSteps(x1, sx, m_rctClip.left - margin, m_rctClip.right - 1 + margin, s0, s1);
+		ClipSteps(y1, sy*fSlope, m_rctClip.top - margin - 1, m_rctClip.bottom + margin, s0, s1);
+	}
+	else
+	{
+		ClipSteps(y1, sy, m_rctClip.top - margin, m_rctClip.bottom - 1 + margin, s0, s1);
+		ClipSteps(x1, sx*fSlope, m_rctClip.left - margin - 1, m_rctClip.right + margin, s0, s1);
+	}
+	int s = (int)ceil(s0), sLast = (int)floor(s1);
+	if(s < 0)s = 0;
+	if(sLast > nSteps - 1)sLast = nSteps - 1;
+
+	// the minor offset at step s is s*nMinor/nSteps rounded, kept as a quotient and a remainder
+	__int64 nDen = 2*(__int64)nSteps;
+	__int64 nNum = 2*(__int64)s*nMinor + nSteps;
+	int m = (int)(nNum / nDen);
+	__int64 nRem = nNum % nDen;
+	int x, y;
+	for(; s<=sLast; s++)
+	{
+		m_nDashPos = nDashStart + s;
+		x = bXMajor ? x1 + sx*s : x1 + sx*m;
+		y = bXMajor ? y1 + sy*m : y1 + sy*s;
+		if(IsDashOn())DrawDot(x, y);
+		nRem += 2*nMinor;
+		if(nRem >= nDen)
+		{
+			nRem -= nDen;
+			m++;
+		}
+	}
+	// kept within the pattern, long segments would overflow it
+	int len = GetDashLength();
+	m_nDashPos = len > 0 ? (int)(((__int64)nDashStart + nSteps) % len) : 0;
+}
+
+void	CRasterSurface::DrawPolyline(const POINT *pPts, int nPts)
+{
+	if(m_nPenStyle == PS_NULL)return;
+	if(nPts<2)return;
+
+	m_nDashPos = 0;
+	int i;
+	for(i=1; i<nPts; i++)
+	{
+		DrawSegment(pPts[i-1].x, pPts[i-1].y, pPts[i].x, pPts[i].y);
+	}
+}
+
+void	CRasterSurface::DrawPolyPolyline(const POINT *pPts, const DWORD *pCounts, int nPolys)
+{
+	int i;
+	for(i=0; i<nPolys; i++)
+	{
+		DrawPolyline(pPts, (int)pCounts[i]);
+		pPts += pCounts[i];
+	}
+}
+
+// Each cubic segment is flattened into a fixed number of lines
+void	CRasterSurface::DrawBeziers(const POINT *pPts, int nPts)
+{
+	if(nPts<4)return;
+
+	const int nSteps = 16;
+	vector<POINT> vPts;
+	vPts.reserve((nPts-1)/3*nSteps + 1);
+	vPts.push_back(pPts[0]);
+
+	int i, j;
+	double t, u, b0, b1, b2, b3;
+	POINT pt;
+	for(i=0; i+3<nPts; i+=3)
+	{
+		for(j=1; j<=nSteps; j++)
+		{
+			t = (double)j/nSteps;
+			u = 1.0 - t;
+			b0 = u*u*u;
+			b1 = 3*u*u*t;
+			b2 = 3*u*t*t;
+			b3 = t*t*t;
+			pt.x = (long)floor(b0*pPts[i].x + b1*pPts[i+1].x + b2*pPts[i+2].x + b3*pPts[i+3].x + 0.5);
+			pt.y = (long)floor(b0*pPts[i].y + b1*pPts[i+1].y + b2*pPts[i+2].y + b3*pPts[i+3].y + 0.5);
+			vPts.push_back(pt);
+		}
+	}
+	DrawPolyline(&vPts[0], (int)vPts.size());
+}
+
+// Scanline fill with the alternate rule, as GDI's default polygon fill mode
+void	CRasterSurface::FillPolygon(const POINT *pPts, int nPts)
+{
+	if(nPts<3)return;
+
+	if(!m_bNullBrush)
+	{
+		int i, j, y;
+		long top = pPts[0].y, bottom = pPts[0].y;
+		for(i=1; i<nPts; i++)
+		{
+			if(pPts[i].y<top)top = pPts[i].y;
+			if(pPts[i].y>bottom)bottom = pPts[i].y;
+		}
+		if(top<m_rctClip.top)top = m_rctClip.top;
+		if(bottom>m_rctClip.bottom)bottom = m_rctClip.bottom;
+
+		vector<double> vX;
+		double yc;
+		for(y=top; y<bottom; y++)
+		{
+			yc = y + 0.5;
+			vX.clear();
+			for(i=0, j=nPts-1; i<nPts; j=i++)
+			{
+				const POINT &p1 = pPts[j], &p2 = pPts[i];
+				if(p1.y == p2.y)continue;
+				if( (yc >= p1.y && yc < p2.y) || (yc >= p2.y && yc < p1.y) )
+				{
+					vX.push_back(p1.x + (yc - p1.y) * (p2.x - p1.x) / (p2.y - p1.y));
+				}
+			}
+			std::sort(vX.begin(), vX.end());
+			for(i=0; i+1<(int)vX.size(); i+=2)
+			{
+				FillSpan(y, (int)ceil(vX[i]-0.5), (int)ceil(vX[i+1]-0.5)-1, m_nBrushColor);
+			}
+		}
+	}
+
+	DrawPolyline(pPts, nPts);
+	if(m_nPenStyle != PS_NULL)DrawSegment(pPts[nPts-1].x, pPts[nPts-1].y, pPts[0].x, pPts[0].y);
+}
+
+void	CRasterSurface::FillRectangle(const RECT &rect, COLORREF color)
+{
+	int y;
+	unsigned int pixel = ToPixel(color);
+	for(y=rect.top; y<rect.bottom; y++)
+	{
+		FillSpan(y, rect.left, rect.right-1, pixel);
+	}
+}
+
+// The point is the top left of the text, as TA_TOP|TA_LEFT of GDI
+void	CRasterSurface::DrawString(int x, int y, const TCHAR *str, int nLen)
+{
+	int i, col, row, ch;
+	unsigned char bits;
+	for(i=0; i<nLen; i++)
+	{
+		ch = (int)str[i];
+		if(ch<0x20 || ch>0x7E)ch = '?';
+		for(col=0; col<kGlyphWidth; col++)
+		{
+			bits = gFont5x8[(ch-0x20)*kGlyphWidth + col];
+			for(row=0; row<kGlyphHeight; row++)
+			{
+				if(!(bits & (1<<row)))continue;
+				RECT rt;
+				rt.left = x + col*m_nFontScale;
+				rt.top = y + row*m_nFontScale;
+				rt.right = rt.left + m_nFontScale;
+				rt.bottom = rt.top + m_nFontScale;
+				for(int yy=rt.top; yy<rt.bottom; yy++)FillSpan(yy, rt.left, rt.right-1, m_nTextColor);
+			}
+		}
+		x += (kGlyphWidth+1)*m_nFontScale;
+	}
+}
+
+SIZE	CRasterSurface::MeasureString(const TCHAR *str, int nLen)
+{
+	SIZE size;
+	size.cx = nLen * (kGlyphWidth+1) * m_nFontScale;
+	size.cy = kGlyphHeight * m_nFontScale;
+	return size;
+}
+
+// The pixels are taken as opaque, a DIB filled by GDI leaves the alpha byte zero
+void	CRasterSurface::BlitPixels(int x, int y, int nWidth, int nHeight, const unsigned int *pPixels, int nStride)
+{
+	int i, j, px, py;
+	for(j=0; j<nHeight; j++)
+	{
+		py = y + j;
+		if(py<m_rctClip.top || py>=m_rctClip.bottom)continue;
+		for(i=0; i<nWidth; i++)
+		{
+			px = x + i;
+			if(px<m_rctClip.left || px>=m_rctClip.right)continue;
+			m_vPixels[py*m_nWidth + px] = 0xFF000000 | pPixels[j*nStride + i];
+		}
+	}
+}
+
+void	CRasterSurface::GetRGBA(vector<unsigned char> &vRGBA)
+{
+	vRGBA.resize(m_vPixels.size()*4);
+	size_t i;
+	unsigned int p;
+	for(i=0; i<m_vPixels.size(); i++)
+	{
+		p = m_vPixels[i];
+		vRGBA[4*i] = (unsigned char)(p>>16);
+		vRGBA[4*i+1] = (unsigned char)(p>>8);
+		vRGBA[4*i+2] = (unsigned char)p;
+		vRGBA[4*i+3] = (unsigned char)(p>>24);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// PNG output, the image data is deflated with stored blocks so no compressor is needed
+
+static unsigned int	PngCrc(const unsigned char *pBuf, size_t nLen, unsigned int crc = 0)
+{
+	static unsigned int table[256];
+	static bool bTable = false;
+	unsigned int c;
+	int n, k;
+	if(!bTable)
+	{
+		for(n=0; n<256; n++)
+		{
+			c = (unsigned int)n;
+			for(k=0; k<8; k++)c = (c&1) ? 0xEDB88320 ^ (c>>1) : c>>1;
+			table[n] = c;
+		}
+		bTable = true;
+	}
+
+	c = crc ^ 0xFFFFFFFF;
+	size_t i;
+	for(i=0; i<nLen; i++)c = table[(c ^ pBuf[i]) & 0xFF] ^ (c>>8);
+	return c ^ 0xFFFFFFFF;
+}
+
+static void	PngPutU32(vector<unsigned char> &vBuf, unsigned int val)
+{
+	vBuf.push_back((unsigned char)(val>>24));
+	vBuf.push_back((unsigned char)(val>>16));
+	vBuf.push_back((unsigned char)(val>>8));
+	vBuf.push_back((unsigned char)val);
+}
+
+static void	PngPutChunk(vector<unsigned char> &vPng, const char *type, const vector<unsigned char> &vData)
+{
+	PngPutU32(vPng, (unsigned int)vData.size());
+	size_t start = vPng.size();
+	vPng.insert(vPng.end(), type, type+4);
+	vPng.insert(vPng.end(), vData.begin(), vData.end());
+	PngPutU32(vPng, PngCrc(&vPng[start], vPng.size() - start));
+}
+
+bool	CRasterSurface::EncodePng(vector<unsigned char> &vPng)
+{
+	vPng.clear();
+	if(m_nWidth<=0 || m_nHeight<=0)return false;
+
+	static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	vPng.insert(vPng.end(), signature, signature+8);
+
+	vector<unsigned char> vChunk;
+	PngPutU32(vChunk, m_nWidth);
+	PngPutU32(vChunk, m_nHeight);
+	vChunk.push_back(8);// bit depth
+	vChunk.push_back(6);// RGBA
+	vChunk.push_back(0);
+	vChunk.push_back(0);
+	vChunk.push_back(0);
+	PngPutChunk(vPng, "IHDR", vChunk);
+
+	// raw scanlines, each preceded by filter type 0
+	vector<unsigned char> vRGBA, vRaw;
+	GetRGBA(vRGBA);
+	size_t nRow = m_nWidth*4;
+	vRaw.reserve((nRow+1)*m_nHeight);
+	int y;
+	for(y=0; y<m_nHeight; y++)
+	{
+		vRaw.push_back(0);
+		vRaw.insert(vRaw.end(), vRGBA.begin() + y*nRow, vRGBA.begin() + (y+1)*nRow);
+	}
+
+	// zlib stream of stored blocks
+	vChunk.clear();
+	vChunk.reserve(vRaw.size() + vRaw.size()/65535*5 + 16);
+	vChunk.push_back(0x78);
+	vChunk.push_back(0x01);
+	size_t pos = 0, len;
+	do
+	{
+		len = vRaw.size() - pos;
+		if(len>65535)len = 65535;
+		vChunk.push_back(pos+len == vRaw.size() ? 1 : 0);
+		vChunk.push_back((unsigned char)len);
+		vChunk.push_back((unsigned char)(len>>8));
+		vChunk.push_back((unsigned char)~len);
+		vChunk.push_back((unsigned char)(~len>>8));
+		vChunk.insert(vChunk.end(), vRaw.begin()+pos, vRaw.begin()+pos+len);
+		pos += len;
+	}while(pos<vRaw.size());
+
+	// adler32, reduced every 5552 bytes as zlib does
+	unsigned int a = 1, b = 0;
+	size_t i;
+	for(pos=0; pos<vRaw.size(); pos+=5552)
+	{
+		len = vRaw.size() - pos;
+		if(len>5552)len = 5552;
+		for(i=pos; i<pos+len; i++)
+		{
+			a += vRaw[i];
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+	}
+	PngPutU32(vChunk, (b<<16) | a);
+	PngPutChunk(vPng, "IDAT", vChunk);
+
+	vChunk.clear();
+	PngPutChunk(vPng, "IEND", vChunk);
+
+	return true;
+}
+
+bool	CRasterSurface::WritePng(tstring pathName)
+{
+	vector<unsigned char> vPng;
+	if(!EncodePng(vPng))return false;
+
+	ofstream ofs;
+#if defined(_UNICODE) || defined(UNICODE)
+	string name;
+	if(!mywcs2mbs(pathName, name))return false;
+	ofs.open(name.c_str(), ios::out | ios::binary);
+#else
+	ofs.open(pathName.c_str(), ios::out | ios::binary);
+#endif
+	if(!ofs.is_open())return false;
+
+	ofs.write((const char *)&vPng[0], vPng.size());
+	bool ret = ofs.good();
+	ofs.close();
+	return ret;
+}
@@ -0,0 +1,188 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#pragma warning(disable:4786)
+
+#include <windows.h>
+#include <vector>
+#include "CChartNameSpace.h"
+#include "MyString.h"
+
+Declare_Namespace_CChart
+
+// Drawing target of the plot code, in logical coordinates
+// Colors of BlitPixels are 0xAARRGGBB, the layout of a 32 bit top-down DIB
+class CDrawSurface
+{
+public:
+	virtual ~CDrawSurface(){}
+
+public:
+	// The device context behind the surface, 0 if there is none
+	virtual	HDC		GetDC() = 0;
+
+	virtual	void	SetPen(COLORREF color, int nWidth, int nStyle) = 0;
+	virtual	void	SetBrush(COLORREF color) = 0;
+	virtual	void	SetNullBrush() = 0;
+	virtual	void	SetFont(const LOGFONT &logFont) = 0;
+	virtual	void	SetTextColor(COLORREF color) = 0;
+	// Clip all drawing to the rect, 0 removes the clip
+	virtual	void	SetClip(const RECT *pRect) = 0;
+
+	virtual	void	DrawPolyline(const POINT *pPts, int nPts) = 0;
+	virtual	void	DrawPolyPolyline(const POINT *pPts, const DWORD *pCounts, int nPolys) = 0;
+	virtual	void	DrawBeziers(const POINT *pPts, int nPts) = 0;
+	// Filled by the brush, outlined by the pen
+	virtual	void	FillPolygon(const POINT *pPts, int nPts) = 0;
+	virtual	void	FillRectangle(const RECT &rect, COLORREF color) = 0;
+	virtual	void	DrawString(int x, int y, const TCHAR *str, int nLen) = 0;
+	virtual	SIZE	MeasureString(const TCHAR *str, int nLen) = 0;
+	virtual	void	BlitPixels(int x, int y, int nWidth, int nHeight, const unsigned int *pPixels, int nStride) = 0;
+
+public:
+	// The end point is not drawn, as LineTo
+	void	DrawLine(int x1, int y1, int x2, int y2)
+	{
+		POINT pts[2];
+		pts[0].x = x1; pts[0].y = y1;
+		pts[1].x = x2; pts[1].y = y2;
+		DrawPolyline(pts, 2);
+	}
+	// Outline of the rect, right and bottom excluded as Rectangle
+	void	DrawRectangle(const RECT &rect)
+	{
+		POINT pts[5];
+		pts[0].x = rect.left; pts[0].y = rect.top;
+		pts[1].x = rect.right-1; pts[1].y = rect.top;
+		pts[2].x = rect.right-1; pts[2].y = rect.bottom-1;
+		pts[3].x = rect.left; pts[3].y = rect.bottom-1;
+		pts[4] = pts[0];
+		DrawPolyline(pts, 5);
+	}
+};
+
+// GDI implementation, the objects selected are restored on destruction
+class CGdiSurface : public CDrawSurface
+{
+public:
+	CGdiSurface(HDC hDC);
+	virtual ~CGdiSurface();
+
+protected:
+	HDC			m_hDC;
+	HPEN		m_hPen, m_hOldPen;
+	HBRUSH		m_hBrush, m_hOldBrush;
+	HFONT		m_hFont, m_hOldFont;
+	COLORREF	m_crOldText;
+	bool		m_bTextColorSaved;
+	HRGN		m_hOldClip;
+	bool		m_bClipSaved;
+
+public:
+	HDC			GetDC(){return m_hDC;}
+
+	void		SetPen(COLORREF color, int nWidth, int nStyle);
+	void		SetBrush(COLORREF color);
+	void		SetNullBrush();
+	void		SetFont(const LOGFONT &logFont);
+	void		SetTextColor(COLORREF color);
+	void		SetClip(const RECT *pRect);
+
+	void		DrawPolyline(const POINT *pPts, int nPts);
+	void		DrawPolyPolyline(const POINT *pPts, const DWORD *pCounts, int nPolys);
+	void		DrawBeziers(const POINT *pPts, int nPts);
+	void		FillPolygon(const POINT *pPts, int nPts);
+	void		FillRectangle(const RECT &rect, COLORREF color);
+	void		DrawString(int x, int y, const TCHAR *str, int nLen);
+	SIZE		MeasureString(const TCHAR *str, int nLen);
+	void		BlitPixels(int x, int y, int nWidth, int nHeight, const unsigned int *pPixels, int nStride);
+};
+
+// Software RGBA rasteriser, needs no device and no window
+// Lines are not antialiased, text uses a built-in 5x8 font scaled to the font height
+class CRasterSurface : public CDrawSurface
+{
+public:
+	CRasterSurface(int nWidth, int nHeight, COLORREF crBkgnd = RGB(255, 255, 255));
+	virtual ~CRasterSurface();
+
+protected:
+	int			m_nWidth, m_nHeight;
+	std::vector<unsigned int>	m_vPixels;
+
+	unsigned int	m_nPenColor;
+	int			m_nPenWidth, m_nPenStyle;
+	unsigned int	m_nBrushColor;
+	bool		m_bNullBrush;
+	unsigned int	m_nTextColor;
+	int			m_nFontScale;
+	RECT		m_rctClip;
+
+	// position in the dash pattern, carried over the vertices of a polyline
+	int			m_nDashPos;
+
+public:
+	HDC			GetDC(){return 0;}
+
+	void		SetPen(COLORREF color, int nWidth, int nStyle);
+	void		SetBrush(COLORREF color);
+	void		SetNullBrush();
+	void		SetFont(const LOGFONT &logFont);
+	void		SetTextColor(COLORREF color);
+	void		SetClip(const RECT *pRect);
+
+	void		DrawPolyline(const POINT *pPts, int nPts);
+	void		DrawPolyPolyline(const POINT *pPts, const DWORD *pCounts, int nPolys);
+	void		DrawBeziers(const POINT *pPts, int nPts);
+	void		FillPolygon(const POINT *pPts, int nPts);
+	void		FillRectangle(const RECT &rect, COLORREF color);
+	void		DrawString(int x, int y, const TCHAR *str, int nLen);
+	SIZE		MeasureString(const TCHAR *str, int nLen);
+	void		BlitPixels(int x, int y, int nWidth, int nHeight, const unsigned int *pPixels, int nStride);
+
+public:
+	inline	int		GetWidth(){return m_nWidth;}
+	inline	int		GetHeight(){return m_nHeight;}
+	inline	unsigned int	*GetPixels(){return m_vPixels.size()>0?&m_vPixels[0]:0;}
+	inline	unsigned int	GetPixelAt(int x, int y){return m_vPixels[y*m_nWidth+x];}
+
+	void		Resize(int nWidth, int nHeight);
+	void		Clear(COLORREF color);
+
+	// Pixels as R,G,B,A bytes, row by row
+	void		GetRGBA(std::vector<unsigned char> &vRGBA);
+	bool		EncodePng(std::vector<unsigned char> &vPng);
+	bool		WritePng(tstring pathName);
+
+protected:
+	inline	void	PutPixel(int x, int y, unsigned int color)
+	{
+		if(x<m_rctClip.left || x>=m_rctClip.right || y<m_rctClip.top || y>=m_rctClip.bottom)return;
+		m_vPixels[y*m_nWidth+x] = color;
+	}
+	void		FillSpan(int y, int x1, int x2, unsigned int color);
+	void		DrawDot(int x, int y);
+	void		DrawSegment(int x1, int y1, int x2, int y2);
+	int			GetDashLength();
+	bool		IsDashOn();
+};
+
+Declare_Namespace_End
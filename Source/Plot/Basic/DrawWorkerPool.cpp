@@ -0,0 +1,129 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#include "DrawWorkerPool.h"
+
+Declare_Namespace_CChart
+
+// The waits are on single handles, but keep the count within what a wait can take
+const int	kMaxDrawWorkers = MAXIMUM_WAIT_OBJECTS;
+
+CDrawWorkerPool::CDrawWorkerPool()
+{
+	InitializeCriticalSection(&m_csRun);
+	m_hStart = CreateSemaphore(NULL, 0, kMaxDrawWorkers, NULL);
+	m_hDone = CreateEvent(NULL, FALSE, FALSE, NULL);
+	m_bQuit = false;
+
+	m_fcnJob = 0;
+	m_pPara = 0;
+	m_nJobs = 0;
+	m_nNextJob = 0;
+	m_nBusy = 0;
+}
+
+CDrawWorkerPool::~CDrawWorkerPool()
+{
+	int i;
+	m_bQuit = true;
+	if(m_vhThreads.size() > 0)ReleaseSemaphore(m_hStart, (LONG)m_vhThreads.size(), NULL);
+	for(i=0; i<(int)m_vhThreads.size(); i++)
+	{
+		WaitForSingleObject(m_vhThreads[i], INFINITE);
+		CloseHandle(m_vhThreads[i]);
+	}
+	m_vhThreads.clear();
+
+	if(m_hStart)CloseHandle(m_hStart);
+	if(m_hDone)CloseHandle(m_hDone);
+	DeleteCriticalSection(&m_csRun);
+}
+
+int		CDrawWorkerPool::GetProcessorCount()
+{
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	return si.dwNumberOfProcessors>0?(int)si.dwNumberOfProcessors:1;
+}
+
+DWORD	WINAPI	CDrawWorkerPool::WorkerProc(LPVOID pPara)
+{
+	CDrawWorkerPool *pPool = (CDrawWorkerPool *)pPara;
+	while(true)
+	{
+		WaitForSingleObject(pPool->m_hStart, INFINITE);
+		if(pPool->m_bQuit)break;
+
+		pPool->RunJobs();
+		if(InterlockedDecrement((LPLONG)&pPool->m_nBusy) == 0)SetEvent(pPool->m_hDone);
+	}
+	return 0;
+}
+
+void	CDrawWorkerPool::RunJobs()
+{
+	LONG nJob;
+	while((nJob = InterlockedIncrement((LPLONG)&m_nNextJob) - 1) < m_nJobs)
+	{
+		m_fcnJob(m_pPara, (int)nJob);
+	}
+}
+
+void	CDrawWorkerPool::AddWorkers(int nWorkers)
+{
+	if(nWorkers > kMaxDrawWorkers)nWorkers = kMaxDrawWorkers;
+	while((int)m_vhThreads.size() < nWorkers)
+	{
+		HANDLE hThread = CreateThread(NULL, 0, WorkerProc, this, 0, NULL);
+		if(!hThread)break;
+		m_vhThreads.push_back(hThread);
+	}
+}
+
+void	CDrawWorkerPool::Run(FcnPoolJob fcnJob, void *pPara, int nJobs, int nThreads)
+{
+	int i;
+	if(!fcnJob || nJobs <= 0)return;
+	if(nThreads > nJobs)nThreads = nJobs;
+
+	EnterCriticalSection(&m_csRun);
+	if(nThreads > 1 && m_hStart && m_hDone)AddWorkers(nThreads - 1);
+	// fewer threads if some could not be created
+	if(nThreads - 1 > (int)m_vhThreads.size())nThreads = (int)m_vhThreads.size() + 1;
+
+	if(nThreads <= 1)
+	{
+		for(i=0; i<nJobs; i++)fcnJob(pPara, i);
+		LeaveCriticalSection(&m_csRun);
+		return;
+	}
+
+	m_fcnJob = fcnJob;
+	m_pPara = pPara;
+	m_nJobs = nJobs;
+	m_nNextJob = 0;
+	m_nBusy = nThreads - 1;
+	ReleaseSemaphore(m_hStart, nThreads - 1, NULL);
+
+	RunJobs();
+	WaitForSingleObject(m_hDone, INFINITE);
+	LeaveCriticalSection(&m_csRun);
+}
+
+Declare_Namespace_End
@@ -0,0 +1,63 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#include <windows.h>
+#include <vector>
+#include "CChartNameSpace.h"
+
+Declare_Namespace_CChart
+
+// One job of a batch, nJob runs from 0 to the job count less one
+typedef void	(*FcnPoolJob)(void *pPara, int nJob);
+
+// A few persistent threads running batches of jobs, such as the subplots of a frame.
+// The calling thread takes part in the batch, Run returns when every job is done
+class CDrawWorkerPool
+{
+public:
+	CDrawWorkerPool();
+	virtual	~CDrawWorkerPool();
+
+	// At most nThreads threads including the caller, nThreads <= 1 runs the jobs in turn
+	void	Run(FcnPoolJob fcnJob, void *pPara, int nJobs, int nThreads);
+	inline	int		GetWorkerCount(){return (int)m_vhThreads.size();}
+
+	static	int		GetProcessorCount();
+
+protected:
+	static	DWORD	WINAPI	WorkerProc(LPVOID pPara);
+	void	RunJobs();
+	void	AddWorkers(int nWorkers);
+
+	CRITICAL_SECTION	m_csRun;// one batch at a time
+	HANDLE		m_hStart;// semaphore, one count wakes one worker for the batch
+	HANDLE		m_hDone;// set by the last worker leaving the batch
+	std::vector<HANDLE>	m_vhThreads;
+	volatile bool	m_bQuit;
+
+	FcnPoolJob	m_fcnJob;
+	void		*m_pPara;
+	LONG		m_nJobs;
+	volatile LONG	m_nNextJob;
+	volatile LONG	m_nBusy;
+};
+
+Declare_Namespace_End
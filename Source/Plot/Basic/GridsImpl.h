@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Grids.h"
+#include "DrawSurface.h"
 #include <math.h>
 
 Declare_Namespace_CChart
@@ -32,6 +33,7 @@ public:
 	virtual ~CGridsImpl();
 public:
 	virtual	void	DrawGrids( HDC hDC );
+	void	DrawGrids( CDrawSurface *pSurface );
 };
 
 template <class PlotImplT>
@@ -48,6 +50,18 @@ CGridsImpl<PlotImplT>::~CGridsImpl()
 
 template <class PlotImplT>
 void	CGridsImpl<PlotImplT>::DrawGrids( HDC hDC )
+{
+	PlotImplT* pT = static_cast<PlotImplT*>(this);
+
+	SetBkColor(hDC, pT->GetBkgndColor() );
+	SetBkMode(hDC, TRANSPARENT );
+
+	CGdiSurface surface(hDC);
+	DrawGrids(&surface);
+}
+
+template <class PlotImplT>
+void	CGridsImpl<PlotImplT>::DrawGrids( CDrawSurface *pSurface )
 {
 	PlotImplT* pT = static_cast<PlotImplT*>(this);
 	RECT plotRect = pT->GetLastPlotRect();
@@ -56,18 +70,8 @@ void	CGridsImpl<PlotImplT>::DrawGrids( HDC hDC )
 	POINT		point, tickPoint;
 	int			j, k;
 	double		position;
-	HPEN		hPen;
-	HPEN		hOldPen, hMinorPen;
 	int			startIdx, endIdx;
 
-	hPen = CreatePen( m_nMajorGridLineStyle, m_nMajorGridLineSize, m_crMajorGridColor );
-	hMinorPen = CreatePen( m_nMinorGridLineStyle, m_nMinorGridLineSize, m_crMinorGridColor );
-
-	hOldPen = (HPEN)SelectObject( hDC, hPen );
-
-	SetBkColor(hDC, pT->GetBkgndColor() );
-	SetBkMode(hDC, TRANSPARENT );
-
 	pT->GetYRange( theRange );
 	range = theRange[1] - theRange[0];
 	
@@ -100,18 +104,15 @@ void	CGridsImpl<PlotImplT>::DrawGrids( HDC hDC )
 					endIdx = pT->GetYTickCount()+1;
 				}
 			}
+			pSurface->SetPen( m_crMajorGridColor, m_nMajorGridLineSize, m_nMajorGridLineStyle );
 			for( j = startIdx; j <= endIdx; j++ )
 			{
 				position = pT->GetMajorTickPosValue( 1, j );
-				SelectObject( hDC, hPen );
 				if(!pT->IsYOpposite())
 					point.y = (long)(plotRect.bottom - scale * (position - theRange[0]));
 				else
 					point.y = (long)(plotRect.top + scale * (position - theRange[0]));
-				point.x = plotRect.left;
-				MoveToEx(hDC, point.x,point.y, NULL );
-				point.x = plotRect.right;
-				LineTo( hDC,point.x,point.y );
+				pSurface->DrawLine( plotRect.left, point.y, plotRect.right, point.y );
 			}
 		}
 		if( m_bMinorHGrids == true )
@@ -141,12 +142,12 @@ void	CGridsImpl<PlotImplT>::DrawGrids( HDC hDC )
 					endIdx = pT->GetYTickCount()+1;
 				}
 			}
+			pSurface->SetPen( m_crMinorGridColor, m_nMinorGridLineSize, m_nMinorGridLineStyle );
 			for( j = startIdx; j <= endIdx; j++ )
 			{				
 				double *minorPos = new double[pT->GetYMinorTickCount()+1];
 				pT->GetMinorTickPosValue(1, j, minorPos);
 				
-				SelectObject(hDC, hMinorPen );
 				for( k = 1; k < pT->GetYMinorTickCount(); k++ )
 				{
 					if(minorPos[k]<theRange[0] || minorPos[k]>theRange[1])continue;
@@ -154,10 +155,7 @@ void	CGridsImpl<PlotImplT>::DrawGrids( HDC hDC )
 						tickPoint.y = plotRect.bottom - (long)((minorPos[k] - theRange[0]) * scale);
 					else
 						tickPoint.y = plotRect.top + (long)((minorPos[k] - theRange[0]) * scale);
-					tickPoint.x = plotRect.left;
-					MoveToEx( hDC,tickPoint.x,tickPoint.y,NULL );
-					tickPoint.x = plotRect.right;
-					LineTo( hDC,tickPoint.x,tickPoint.y );
+					pSurface->DrawLine( plotRect.left, tickPoint.y, plotRect.right, tickPoint.y );
 				}
 				
 				delete []minorPos;
@@ -196,19 +194,16 @@ void	CGridsImpl<PlotImplT>::DrawGrids( HDC hDC )
 					endIdx = pT->GetXTickCount()+1;
 				}
 			}
+			pSurface->SetPen( m_crMajorGridColor, m_nMajorGridLineSize, m_nMajorGridLineStyle );
 			for( j = startIdx; j <= endIdx; j++ )
 			{
 				position = pT->GetMajorTickPosValue( 0, j );
-				SelectObject( hDC, hPen );
 				
 				if(!pT->IsXOpposite())
 					point.x = (long)(plotRect.left + scale * (position - theRange[0]) );
 				else
 					point.x = (long)(plotRect.right - scale * (position - theRange[0]) );
-				point.y = plotRect.bottom;
-				MoveToEx(hDC, point.x, point.y, NULL );
-				point.y = plotRect.top;
-				LineTo( hDC, point.x, point.y );
+				pSurface->DrawLine( point.x, plotRect.bottom, point.x, plotRect.top );
 			}
 		}
 		if( m_bMinorVGrids == true )
@@ -237,12 +232,12 @@ void	CGridsImpl<PlotImplT>::DrawGrids( HDC hDC )
 					endIdx = pT->GetXTickCount()+1;
 				}
 			}
+			pSurface->SetPen( m_crMinorGridColor, m_nMinorGridLineSize, m_nMinorGridLineStyle );
 			for( j = startIdx; j <= endIdx; j++ )
 			{
 				double *minorPos = new double[pT->GetXMinorTickCount()+1];
 				pT->GetMinorTickPosValue(0, j, minorPos);
 				
-				SelectObject( hDC,hMinorPen );
 				for( k = 1; k < pT->GetXMinorTickCount(); k++ )
 				{
 					if(minorPos[k]<theRange[0] || minorPos[k]>theRange[1])continue;
@@ -251,20 +246,13 @@ void	CGridsImpl<PlotImplT>::DrawGrids( HDC hDC )
 						tickPoint.x = plotRect.left + (long)((minorPos[k]-theRange[0]) * scale);
 					else
 						tickPoint.x = plotRect.right - (long)((minorPos[k]-theRange[0]) * scale);
-					tickPoint.y = plotRect.bottom;
-					MoveToEx( hDC, tickPoint.x,tickPoint.y, NULL );
-					tickPoint.y = plotRect.top;
-					LineTo( hDC,tickPoint.x,tickPoint.y );
+					pSurface->DrawLine( tickPoint.x, plotRect.bottom, tickPoint.x, plotRect.top );
 				}
 				
 				delete []minorPos;
 			}
 		}
 	}
-
-	SelectObject( hDC, hOldPen );
-	DeleteObject( hPen );
-	DeleteObject( hMinorPen );
 }
 
 Declare_Namespace_End
\ No newline at end of file
@@ -36,6 +36,7 @@ bool	ShowDiffentialDataDlg(CXYPlotBasicImpl *plot, HWND hWnd, int nWhich);
 bool	ShowIntegratialDataDlg(CXYPlotBasicImpl *plot, HWND hWnd, int nWhich);
 
 bool	ShowMedianFilterDataDlg(CXYPlotBasicImpl *plot, HWND hWnd, int nWhich);
+bool	ProcMedianFilterData(CXYPlotBasicImpl *plot, int nWhich, int order, bool reserve);
 bool	ShowAverageFilterDataDlg(CXYPlotBasicImpl *plot, HWND hWnd, int nWhich);
 
 bool	ShowFittingPolynomialDataDlg(CXYPlotBasicImpl *plot, HWND hWnd, int nWhich);
@@ -0,0 +1,112 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#include <windows.h>
+#include "CChartNameSpace.h"
+
+Declare_Namespace_CChart
+
+// Bounded single producer, single consumer queue of samples, no lock on either side.
+// The producer owns m_nTail and the consumer owns m_nHead, each index is published
+// with an interlocked exchange after the slots it covers are written or read.
+// Push fails instead of blocking when the queue is full, the dropped samples are counted
+template<typename DataT>
+class CIngestQueue
+{
+public:
+	// the capacity is rounded up to a power of two
+	CIngestQueue(int nCapacity)
+	{
+		m_nCapacity = 16;
+		while(m_nCapacity < nCapacity && m_nCapacity < (1<<30))m_nCapacity <<= 1;
+		m_nMask = m_nCapacity - 1;
+		m_pBuff = new DataT[m_nCapacity];
+		m_nHead = 0;
+		m_nTail = 0;
+		m_nDropped = 0;
+	}
+	virtual	~CIngestQueue()
+	{
+		delete []m_pBuff;
+	}
+
+	// producer side
+	bool	Push(const DataT &data)
+	{
+		LONG nTail = m_nTail;
+		if(Distance(m_nHead, nTail) >= m_nCapacity)
+		{
+			InterlockedIncrement((LPLONG)&m_nDropped);
+			return false;
+		}
+		m_pBuff[nTail & m_nMask] = data;
+		InterlockedExchange((LPLONG)&m_nTail, Advance(nTail, 1));
+		return true;
+	}
+	// pushes as many as fit, returns the count pushed
+	int		Push(const DataT *pData, int nLen)
+	{
+		LONG nTail = m_nTail;
+		int nFree = m_nCapacity - Distance(m_nHead, nTail);
+		int nPush = nLen < nFree ? nLen : nFree;
+		if(nPush < 0)nPush = 0;
+		for(int i=0; i<nPush; i++)
+			m_pBuff[Advance(nTail, i) & m_nMask] = pData[i];
+		if(nPush > 0)InterlockedExchange((LPLONG)&m_nTail, Advance(nTail, nPush));
+		if(nPush < nLen)InterlockedExchangeAdd((LPLONG)&m_nDropped, nLen - nPush);
+		return nPush;
+	}
+
+	// consumer side, returns the count popped
+	int		Pop(DataT *pData, int nMax)
+	{
+		LONG nHead = m_nHead;
+		int nPop = Distance(nHead, m_nTail);
+		if(nPop > nMax)nPop = nMax;
+		if(nPop <= 0)return 0;
+		for(int i=0; i<nPop; i++)
+			pData[i] = m_pBuff[Advance(nHead, i) & m_nMask];
+		InterlockedExchange((LPLONG)&m_nHead, Advance(nHead, nPop));
+		return nPop;
+	}
+
+	inline	int		GetCount(){return Distance(m_nHead, m_nTail);}
+	inline	int		GetCapacity(){return m_nCapacity;}
+	inline	bool	IsEmpty(){return m_nTail == m_nHead;}
+	inline	LONG	GetDropped(){return m_nDropped;}
+	inline	void	ResetDropped(){InterlockedExchange((LPLONG)&m_nDropped, 0);}
+
+protected:
+	DataT		*m_pBuff;
+	LONG		m_nCapacity, m_nMask;
+	// the indices only grow and wrap around, only their distance is used
+	static	int		Distance(LONG nFrom, LONG nTo){return (int)((unsigned long)nTo - (unsigned long)nFrom);}
+	static	LONG	Advance(LONG nIdx, int nStep){return (LONG)((unsigned long)nIdx + (unsigned long)nStep);}
+	volatile LONG	m_nHead;
+	volatile LONG	m_nTail;
+	volatile LONG	m_nDropped;
+
+private:
+	CIngestQueue(const CIngestQueue &);
+	CIngestQueue &operator=(const CIngestQueue &);
+};
+
+Declare_Namespace_End
@@ -36,6 +36,7 @@ void	MyDrawInterConnect(HDC hDC, int alpha, COLORREF lineColor, int lineSize, in
 	int i;
 	for(i=0; i<nDatas; i++)
 	{
+		if(IsScreenGap(pPoints1[i]) || IsScreenGap(pPoints2[i]))continue;
 		pt1.X = pPoints1[i].x;
 		pt1.Y = pPoints1[i].y;
 		pt2.X = pPoints2[i].x;
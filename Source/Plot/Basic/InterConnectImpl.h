@@ -19,6 +19,7 @@
 
 #pragma once
 #include "InterConnect.h"
+#include "ScreenTransform.h"
 
 Declare_Namespace_CChart
 
@@ -88,6 +89,7 @@ void	CInterConnectImpl<DataSetT>::DrawInterConnection( HDC hDC, RECT plotRect, d
 			
 			for(i=0; i<nDatas; i++)
 			{
+				if(IsScreenGap(pPoints1[i]) || IsScreenGap(pPoints2[i]))continue;
 				MoveToEx(hDC, pPoints1[i].x, pPoints1[i].y, NULL);
 				LineTo(hDC, pPoints2[i].x, pPoints2[i].y);
 			}
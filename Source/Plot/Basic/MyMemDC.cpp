@@ -40,11 +40,21 @@ CMyMemDC::CMyMemDC(HDC hDC, HBITMAP hBitmap, RECT *lpRect)
 
 CMyMemDC::~CMyMemDC()
 {
+	Flush();
+}
+
+void		CMyMemDC::Flush()
+{
+	if(!m_hDC)return;
+
 	Update();
 
 	SelectObject(m_hDC, m_hOldBmp);
 	DeleteObject(m_hBmp);
 	DeleteDC(m_hDC);
+	m_hDC = 0;
+	m_hBmp = 0;
+	m_hOldBmp = 0;
 }
 
 CMyMemDC::operator HDC()
@@ -34,6 +34,8 @@ public:
 
 public:
 	void			Update();
+	// Copies to the origin DC now and frees the memory DC, the destructor then does nothing
+	void			Flush();
 	bool			CheckCompatibility(HBITMAP hBitmap);
 
 public:
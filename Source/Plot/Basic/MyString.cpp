@@ -209,6 +209,156 @@ int	get_line_count(const tstring &buff, const tstring symbol/* =_TEXT */)
 	return count;
 }
 
+static const double pfPow10[] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+//һʽΪ[+-]digits[.digits][(e|E)[+-]digits]޹أpƵ֮
+//β2^53ָڡ22ʱֱཻ_tcstodȷ
+bool scan_double(const TCHAR *&p, const TCHAR *pEnd, double &val)
+{
+	const TCHAR *s = p, *pDigits;
+	bool	bNeg = false, bDigit = false, bExact = true;
+	__int64	mant = 0;
+	int		nDigits = 0, exp10 = 0;
+	
+	if(s < pEnd && (*s == _TEXT('-') || *s == _TEXT('+')))
+	{
+		bNeg = (*s == _TEXT('-'));
+		s++;
+	}
+	pDigits = s;
+	for(; s < pEnd && *s >= _TEXT('0') && *s <= _TEXT('9'); s++)
+	{
+		bDigit = true;
+		if(nDigits < 18)
+		{
+			mant = mant * 10 + (*s - _TEXT('0'));
+			if(mant != 0)nDigits++;
+		}
+		else
+		{
+			exp10++;
+			if(*s != _TEXT('0'))bExact = false;
+		}
+	}
+	if(s < pEnd && *s == _TEXT('.'))
+	{
+		for(s++; s < pEnd && *s >= _TEXT('0') && *s <= _TEXT('9'); s++)
+		{
+			bDigit = true;
+			if(nDigits < 18)
+			{
+				mant = mant * 10 + (*s - _TEXT('0'));
+				if(mant != 0)nDigits++;
+				exp10--;
+			}
+			else if(*s != _TEXT('0'))
+			{
+				bExact = false;
+			}
+		}
+	}
+	if(!bDigit)return false;
+	
+	if(s < pEnd && (*s == _TEXT('e') || *s == _TEXT('E')))
+	{
+		bool bExpNeg = false;
+		int e = 0;
+		s++;
+		if(s < pEnd && (*s == _TEXT('-') || *s == _TEXT('+')))
+		{
+			bExpNeg = (*s == _TEXT('-'));
+			s++;
+		}
+		//"1e""1e+"
+		if(s >= pEnd || *s < _TEXT('0') || *s > _TEXT('9'))return false;
+		for(; s < pEnd && *s >= _TEXT('0') && *s <= _TEXT('9'); s++)
+		{
+			if(e < 10000)e = e * 10 + (*s - _TEXT('0'));
+		}
+		exp10 += bExpNeg ? -e : e;
+	}
+	
+	double v = 0.0;
+	bool bDone = (mant == 0);
+	if(!bDone && bExact && mant <= ((__int64)1 << 53) && exp10 >= -22 && exp10 <= 22)
+	{
+		//β10ݶǾȷģֻһ
+		v = (double)mant;
+		if(exp10 > 0)v *= pfPow10[exp10];
+		else if(exp10 < 0)v /= pfPow10[-exp10];
+		bDone = true;
+	}
+	if(!bDone)
+	{
+		//γ˳룬_tcstod̵÷ڴ
+		TCHAR szNum[64], *pNumEnd;
+		int nLen = (int)(s - pDigits);
+		if(nLen < 64)
+		{
+			memcpy(szNum, pDigits, nLen * sizeof(TCHAR));
+			szNum[nLen] = 0;
+			v = _tcstod(szNum, &pNumEnd);
+			bDone = (pNumEnd == szNum + nLen);
+		}
+		else
+		{
+			tstring strNum(pDigits, nLen);
+			v = _tcstod(strNum.c_str(), &pNumEnd);
+			bDone = (pNumEnd == strNum.c_str() + nLen);
+		}
+	}
+	if(!bDone)
+	{
+		//Сòʱ_tcstodֻ꣬γ˳
+		v = (double)mant;
+		for(; exp10 > 22; exp10 -= 22)v *= 1e22;
+		for(; exp10 < -22; exp10 += 22)v /= 1e22;
+		if(exp10 > 0)v *= pfPow10[exp10];
+		else if(exp10 < 0)v /= pfPow10[-exp10];
+	}
+	val = bNeg ? -v : v;
+	p = s;
+	return true;
+}
+
+//հ׻sepsеַ
+static inline bool is_separator(TCHAR c, const TCHAR *seps)
+{
+	if(c == _TEXT(' ') || c == _TEXT('\t') || c == _TEXT('\r') || c == _TEXT('\n'))return true;
+	for(; seps && *seps; seps++)
+	{
+		if(*seps == c)return true;
+	}
+	return false;
+}
+
+//һеԿհ׻sepsеַָnMaxĸʱ-1
+int	scan_doubles(const TCHAR *p, const TCHAR *pEnd, const TCHAR *seps, double *pVal, int nMax)
+{
+	int count = 0;
+	double val;
+	
+	while(p < pEnd)
+	{
+		if(is_separator(*p, seps))
+		{
+			p++;
+			continue;
+		}
+		
+		if(!scan_double(p, pEnd, val))return -1;
+		//Ƿָ"1-2"
+		if(p < pEnd && !is_separator(*p, seps))return -1;
+		if(count < nMax)pVal[count] = val;
+		count++;
+	}
+	return count;
+}
+
 bool mywcs2mbs(const wstring wstr, string &buf)
 {
 	int len = WideCharToMultiByte(CP_ACP, 0, wstr.c_str(), -1, NULL, 0, NULL, NULL);
@@ -60,6 +60,10 @@ void trimspace(tstring &str);
 tstring readline(const tstring &buffer,tstring::size_type &curpos, const tstring symbol=_TEXT("\n"));
 int	get_line_count(const tstring &buff, const tstring symbol=_TEXT("\n"));
 
+//number parsing, locale independent and without allocation
+bool scan_double(const TCHAR *&p, const TCHAR *pEnd, double &val);
+int	scan_doubles(const TCHAR *p, const TCHAR *pEnd, const TCHAR *seps, double *pVal, int nMax);
+
 bool mywcs2mbs(const wstring wstr, string &buf);
 bool mymbs2wcs(const string str, wstring &buf);
 string mywcs2mbs(const wstring wstr);
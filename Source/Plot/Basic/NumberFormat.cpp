@@ -0,0 +1,293 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+//#include "StdAfx.h"
+#include "NumberFormat.h"
+#include <math.h>
+#include <float.h>
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tchar.h>
+
+using namespace NsCChart;
+
+static const double	s_pfPow10[] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+	1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const double	s_pfPow10Neg[] = {1e-1, 1e-2, 1e-3, 1e-4};
+
+static int	FormatUInt(TCHAR *pBuff, unsigned __int64 n)
+{
+	TCHAR digits[24];
+	int len = 0, i;
+	do
+	{
+		digits[len++] = TCHAR(_TEXT('0') + (int)(n % 10));
+		n /= 10;
+	}while(n);
+	for(i=0; i<len; i++)pBuff[i] = digits[len-1-i];
+	return len;
+}
+
+// _stprintf cut to the buffer, returns the length
+static int	PrintCut(TCHAR *pBuff, int nSize, const TCHAR *fmt, int nPrecision, double val)
+{
+	if(nSize <= 0)return 0;
+#if defined(_MSC_VER) && (_MSC_VER>=1300)
+	int len = _sntprintf_s(pBuff, nSize, _TRUNCATE, fmt, nPrecision, val);
+#else
+	int len = _sntprintf(pBuff, nSize, fmt, nPrecision, val);
+#endif
+	if(len < 0 || len >= nSize)len = nSize - 1;
+	pBuff[len] = 0;
+	return len;
+}
+
+CNumberFormat::CNumberFormat()
+{
+	m_cConv = 0;
+	m_nPrecision = 6;
+}
+
+CNumberFormat::~CNumberFormat()
+{
+
+}
+
+void	CNumberFormat::SetFormat(const tstring &fmt)
+{
+	if(fmt == m_strFormat)return;
+	m_strFormat = fmt;
+	if(!ParseFormat())m_cConv = 0;
+}
+
+// Only %g and %f with a precision are done here, flags, widths and the rest go to _stprintf
+bool	CNumberFormat::ParseFormat()
+{
+	m_strPrefix.erase();
+	m_strSuffix.erase();
+	m_cConv = 0;
+	m_nPrecision = 6;
+
+	const TCHAR *p = m_strFormat.c_str();
+	tstring *pText = &m_strPrefix;
+	int nPrecision;
+	while(*p)
+	{
+		if(*p != _TEXT('%'))
+		{
+			*pText += *p++;
+			continue;
+		}
+		if(p[1] == _TEXT('%'))
+		{
+			*pText += _TEXT('%');
+			p += 2;
+			continue;
+		}
+		// one conversion only
+		if(m_cConv != 0)return false;
+
+		p++;
+		nPrecision = 6;
+		if(*p == _TEXT('.'))
+		{
+			p++;
+			for(nPrecision = 0; *p >= _TEXT('0') && *p <= _TEXT('9'); p++)
+			{
+				nPrecision = nPrecision * 10 + (*p - _TEXT('0'));
+				if(nPrecision > 17)return false;
+			}
+		}
+		if(*p == _TEXT('l'))p++;
+		if(*p == _TEXT('g'))
+		{
+			m_nPrecision = nPrecision < 1 ? 1 : nPrecision;
+		}
+		else if(*p == _TEXT('f'))
+		{
+			m_nPrecision = nPrecision;
+		}
+		else
+		{
+			return false;
+		}
+		m_cConv = *p++;
+		pText = &m_strSuffix;
+	}
+	return m_cConv != 0;
+}
+
+int		CNumberFormat::Format(TCHAR *pBuff, int nSize, double val)
+{
+	int nPrefix = (int)m_strPrefix.length(), nSuffix = (int)m_strSuffix.length();
+	if(m_cConv == 0 || nSize < nPrefix + nSuffix + kMinBuffSize)
+	{
+		if(nSize <= 0)return 0;
+#if defined(_MSC_VER) && (_MSC_VER>=1300)
+		int len = _sntprintf_s(pBuff, nSize, _TRUNCATE, m_strFormat.c_str(), val);
+#else
+		int len = _sntprintf(pBuff, nSize, m_strFormat.c_str(), val);
+#endif
+		if(len < 0 || len >= nSize)len = nSize - 1;
+		pBuff[len] = 0;
+		return len;
+	}
+
+	TCHAR *p = pBuff;
+	memcpy(p, m_strPrefix.c_str(), nPrefix * sizeof(TCHAR));
+	p += nPrefix;
+	if(m_cConv == _TEXT('g'))
+		p += FormatG(p, val, m_nPrecision);
+	else
+		p += FormatFixed(p, nSize - nPrefix - nSuffix, val, m_nPrecision);
+	memcpy(p, m_strSuffix.c_str(), nSuffix * sizeof(TCHAR));
+	p += nSuffix;
+	*p = 0;
+	return int(p - pBuff);
+}
+
+int		CNumberFormat::FormatG(TCHAR *pBuff, double val, int nPrecision)
+{
+	double a = fabs(val);
+	TCHAR *p = pBuff;
+
+	if(nPrecision < 1)nPrecision = 1;
+	if(nPrecision > 17)nPrecision = 17;
+
+	if(val == 0.0 && 1.0/val > 0.0)
+	{
+		*p++ = _TEXT('0');
+		*p = 0;
+		return 1;
+	}
+	// integers below 10^precision print as they are
+	if(val != 0.0 && a < s_pfPow10[nPrecision] && a == floor(a))
+	{
+		if(val < 0.0)*p++ = _TEXT('-');
+		p += FormatUInt(p, (unsigned __int64)a);
+		*p = 0;
+		return int(p - pBuff);
+	}
+	// fixed notation from 1e-4 on, as %g does, when the rounding is certain
+	if(a >= 1e-4 && a < s_pfPow10[nPrecision])
+	{
+		int nExp, nDecimals;
+		if(a >= 1.0)
+		{
+			for(nExp=0; nExp<nPrecision-1 && a>=s_pfPow10[nExp+1]; nExp++);
+		}
+		else
+		{
+			for(nExp=-1; nExp>-4 && a<s_pfPow10Neg[-nExp-1]; nExp--);
+		}
+		nDecimals = nPrecision - 1 - nExp;
+		double scaled = a * s_pfPow10[nDecimals];
+		double rounded = floor(scaled + 0.5);
+		double frac = scaled - floor(scaled);
+		// a tie within the error of the product, or a carry into the next decade, goes to sprintf
+		if(nDecimals < 20 && fabs(frac - 0.5) > scaled * 4.5e-16 && rounded < s_pfPow10[nPrecision])
+		{
+			unsigned __int64 n = (unsigned __int64)rounded;
+			unsigned __int64 unit = (unsigned __int64)s_pfPow10[nDecimals];
+			unsigned __int64 nInt = n / unit, nFrac = n % unit;
+			if(val < 0.0)*p++ = _TEXT('-');
+			p += FormatUInt(p, nInt);
+			if(nFrac)
+			{
+				*p++ = _TEXT('.');
+				while(nFrac % 10 == 0)
+				{
+					nFrac /= 10;
+					nDecimals--;
+				}
+				TCHAR digits[24];
+				int len = FormatUInt(digits, nFrac), i;
+				for(i=len; i<nDecimals; i++)*p++ = _TEXT('0');
+				for(i=0; i<len; i++)*p++ = digits[i];
+			}
+			*p = 0;
+			return int(p - pBuff);
+		}
+	}
+	return PrintCut(pBuff, kMinBuffSize, _TEXT("%.*g"), nPrecision, val);
+}
+
+int		CNumberFormat::FormatFixed(TCHAR *pBuff, int nSize, double val, int nDecimals)
+{
+	double a = fabs(val);
+
+	// the product holds 15 digits exactly, a tie within its error goes to sprintf
+	if(nDecimals >= 0 && nDecimals <= 17 && nSize >= kMinBuffSize && a < 1e15)
+	{
+		double scaled = a * s_pfPow10[nDecimals];
+		double rounded = floor(scaled + 0.5);
+		double frac = scaled - floor(scaled);
+		if(scaled < 1e15 && fabs(frac - 0.5) > scaled * 4.5e-16)
+		{
+			unsigned __int64 n = (unsigned __int64)rounded;
+			unsigned __int64 unit = (unsigned __int64)s_pfPow10[nDecimals];
+			TCHAR *p = pBuff;
+			// -0.001 is -0.00 with sprintf too
+			if(val < 0.0 || (val == 0.0 && 1.0/val < 0.0))*p++ = _TEXT('-');
+			p += FormatUInt(p, n / unit);
+			if(nDecimals > 0)
+			{
+				*p++ = _TEXT('.');
+				TCHAR digits[24];
+				int len = FormatUInt(digits, n % unit), i;
+				for(i=len; i<nDecimals; i++)*p++ = _TEXT('0');
+				for(i=0; i<len; i++)*p++ = digits[i];
+			}
+			*p = 0;
+			return int(p - pBuff);
+		}
+	}
+	return PrintCut(pBuff, nSize, _TEXT("%.*f"), nDecimals, val);
+}
+
+// _tcstod takes the decimal point of the current locale, the fast paths always write '.'
+static bool	ReadsBackTo(const TCHAR *pText, int nLen, double val)
+{
+	TCHAR buf[CNumberFormat::kMinBuffSize];
+	TCHAR cPoint = (TCHAR)(unsigned char)localeconv()->decimal_point[0];
+	int i;
+	for(i=0; i<nLen && i<CNumberFormat::kMinBuffSize-1; i++)
+		buf[i] = (pText[i] == _TEXT('.')) ? cPoint : pText[i];
+	buf[i] = 0;
+	double back = _tcstod(buf, 0);
+	return memcmp(&back, &val, sizeof(double)) == 0;
+}
+
+// The precision goes up from 1 until the text reads back to the same bits, 17 digits always do
+int		CNumberFormat::FormatShortest(TCHAR *pBuff, double val)
+{
+	int len, nPrecision;
+	if(!(fabs(val) <= DBL_MAX))return FormatG(pBuff, val, 17);
+	for(nPrecision=1; nPrecision<17; nPrecision++)
+	{
+		len = FormatG(pBuff, val, nPrecision);
+		if(ReadsBackTo(pBuff, len, val))return len;
+	}
+	return FormatG(pBuff, val, 17);
+}
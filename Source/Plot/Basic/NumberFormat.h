@@ -0,0 +1,65 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#pragma warning(disable:4786)
+
+#include "MyString.h"
+#include "CChartNameSpace.h"
+
+Declare_Namespace_CChart
+
+// Formats numbers into a buffer of the caller, with no stream or allocation. The text is what
+// _stprintf gives for the format, the common cases are done without it
+class CNumberFormat
+{
+public:
+	CNumberFormat();
+	virtual ~CNumberFormat();
+
+	// the static functions need this many characters
+	enum{kMinBuffSize = 32};
+
+protected:
+	tstring		m_strFormat;
+	// the text around the conversion, %% already turned into %
+	tstring		m_strPrefix, m_strSuffix;
+	// 'g' or 'f', 0 when _stprintf does the whole format
+	TCHAR		m_cConv;
+	int			m_nPrecision;
+
+	bool		ParseFormat();
+
+public:
+	// parses a printf format of one double, the same format again costs a compare
+	void		SetFormat(const tstring &fmt);
+	inline	const tstring	&GetFormat(){return m_strFormat;}
+	// returns the length, the text is cut to nSize-1 characters
+	int			Format(TCHAR *pBuff, int nSize, double val);
+
+	// "%.*g"
+	static	int		FormatG(TCHAR *pBuff, double val, int nPrecision);
+	// "%.*f", falls back to _stprintf for numbers of more than 15 digits
+	static	int		FormatFixed(TCHAR *pBuff, int nSize, double val, int nDecimals);
+	// the fewest significant digits that read back to the same double
+	static	int		FormatShortest(TCHAR *pBuff, double val);
+};
+
+Declare_Namespace_End
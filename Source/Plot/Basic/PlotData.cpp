@@ -32,41 +32,11 @@ void	ClearAdjoinCoincide(MyVData2D& vData)
 	}
 }
 
-// The following function is to instance the templated functions
-// when there is a templated function, it muat be instanced
-
-//ҪVC6бȻӴδⲿ
-//ڸ߰汾ҪɾȥȻֱ󣺷Ƿʹʽģ
-#if defined(_MSC_VER) && (_MSC_VER<=1200)
-	bool vLess<DataPoint2D>(const DataPoint2D &d1, const DataPoint2D &d2)
-	{
-		return d1.val[nWhichDimCmp] < d2.val[nWhichDimCmp];
-	}
-	bool vGreat<DataPoint2D>(const DataPoint2D &d1, const DataPoint2D &d2)
-	{
-		return d1.val[nWhichDimCmp] > d2.val[nWhichDimCmp];
-	}
-#endif
-
-void	InstanceTemplatedDataFunctions()
+// Shared by all the curves, so that a stamp is never seen again on another curve
+unsigned int	NewDataRangeStamp()
 {
-/*	DataPoint2D d1, d2;
-	memset(&d1, 0, sizeof(DataPoint2D));
-	memset(&d2, 0, sizeof(DataPoint2D));
-	Less<DataPoint2D, 0>(d1, d2);
-	Less<DataPoint2D, 1>(d1, d2);
-	Great<DataPoint2D, 0>(d1, d2);
-	Great<DataPoint2D, 1>(d1, d2);*/
-	DataPoint2D d1, d2;
-	memset(&d1, 0, sizeof(DataPoint2D));
-	memset(&d2, 0, sizeof(DataPoint2D));
-	bool bret;
-	nWhichDimCmp = 0;
-	bret = vLess<DataPoint2D>(d1, d2);
-	bret = vGreat<DataPoint2D>(d1, d2);
-	nWhichDimCmp = 1;
-	bret = vLess<DataPoint2D>(d1, d2);
-	bret = vGreat<DataPoint2D>(d1, d2);
+	static LONG nStamp = 0;
+	return (unsigned int)InterlockedIncrement(&nStamp);
 }
 
 Declare_Namespace_End
\ No newline at end of file
@@ -21,6 +21,7 @@
 
 #include "../Accessary/Deelx/deelx.h"
 #include "MyString.h"
+#include "NumberFormat.h"
 #include "Global.h"
 #include "CChartNameSpace.h"
 #include <vector>
@@ -63,6 +64,13 @@ typedef struct stDataPoint3D
 typedef vector<DataPoint2D> MyVData2D;
 typedef vector<DataPoint3D> MyVData3D;
 
+// Columnar view of a data set, each dimension is a contiguous array in logical order
+typedef struct stDataColumns
+{
+	const double	*pCol[3];// x, y, z; z is null for 2D data
+	int				nCount;
+}DataColumns, *pDataColumns;
+
 enum
 {
 	kSortXInc,
@@ -75,6 +83,16 @@ enum
 	kSortTypeCount
 };
 
+// Order of the x values, kept up to date on appends
+enum
+{
+	kXOrderUnknown,
+	kXOrderMonotonic,// non-decreasing x
+	kXOrderNone,
+	
+	kXOrderCount
+};
+
 // Plot type
 enum
 {
@@ -90,6 +108,16 @@ enum
 	kPlotTypeCount
 };
 
+// How compact draw reduces the points that share a pixel column
+enum
+{
+	kCompactM4 = 0,// first, min, max and last of each column, keeps spikes
+	kCompactLTTB = 1,// largest triangle three buckets
+	kCompactAverage = 2,// average of each column
+	
+	kCompactModeCount
+};
+
 enum
 {
 	kBarFromBottom,
@@ -125,41 +153,41 @@ void ClearAdjoinCoincide(MyVData2D& vData);
 template<typename DataT>
 void GetDataPoint(tstring aline, DataT &result, int dim)
 {
-	tistringstream istr(aline);
-	int i;
-	for(i=0; i<dim; i++)
-	{
-		istr>>result.val[i];
-	}
+	scan_doubles(aline.c_str(), aline.c_str() + aline.length(), _TEXT(""), result.val, dim);
 }
+// The numbers as a stream writes them, %g, into the space that result already has
 template<typename DataT>
 void GetDataLine(DataT datapoint, int dim, tstring space, tstring &result)
 {
-	tostringstream ostr;
+	TCHAR str[CNumberFormat::kMinBuffSize];
 	int i;
+	result.erase();
 	for(i=0; i<dim; i++)
 	{
-		ostr<<datapoint.val[i];
-		if(i<dim-1)	ostr<<space.c_str();
-		else	ostr<<_TEXT("\n");
+		result.append(str, CNumberFormat::FormatG(str, datapoint.val[i], 6));
+		if(i<dim-1)	result += space;
+		else	result += _TEXT("\n");
 	}
-	result = ostr.str();
 }
 
-static int nWhichDimCmp = 0;
-
+// The compared dimension is carried by the comparator, so sorts in several threads do not interfere
 template<typename DataT>
-bool vLess(const DataT &d1, const DataT &d2)
+struct DimLess
 {
-	return d1.val[nWhichDimCmp] < d2.val[nWhichDimCmp];
-}
+	int		nDim;
+	DimLess(int dim) : nDim(dim) {}
+	bool	operator()(const DataT &d1, const DataT &d2) const {return d1.val[nDim] < d2.val[nDim];}
+};
 template<typename DataT>
-bool vGreat(const DataT &d1, const DataT &d2)
+struct DimGreater
 {
-	return d1.val[nWhichDimCmp] > d2.val[nWhichDimCmp];
-}
+	int		nDim;
+	DimGreater(int dim) : nDim(dim) {}
+	bool	operator()(const DataT &d1, const DataT &d2) const {return d1.val[nDim] > d2.val[nDim];}
+};
 
-//void	InstanceTemplatedDataFunctions();
+// A new value each call, for telling whether a data range has changed since it was read
+unsigned int	NewDataRangeStamp();
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -176,6 +204,15 @@ public:
 protected:
 	std::vector<DataT>	*m_pvData;
 	std::vector<DataT>	*m_pvDataSaved;
+	mutable int			m_nRingHead;// physical index of the first point, when m_pvData works as a ring buffer
+	// renewed by every change of the data other than appending at the end or dropping at the front,
+	// the points dropped at the front are counted apart, so that an index of the data can follow both
+	unsigned int		m_nEditGeneration;
+	unsigned int		m_nFrontDrops;
+	bool				m_bColumnar;// keep a columnar copy, x[], y[] (and z[]) each contiguous
+	mutable bool		m_bColumnValid;
+	mutable int			m_nXOrder;// see above enum, kXOrderUnknown means it is scanned on the next query
+	mutable std::vector<double>	m_pvColumn[sizeof(DataT)/sizeof(double)];
 	std::vector<int>	m_vSegHide;
 	bool				m_bSegHideMode;
 
@@ -218,6 +255,8 @@ protected:
 //	double		m_pfZDataRange[2];
 	double		m_ppfDataRange[sizeof(DataT)/sizeof(double)][2];
 	bool		m_bDataRangeSet;
+	unsigned int	m_nDataRangeStamp;// renewed whenever m_ppfDataRange is changed
+	int			m_ppnExtremeCount[sizeof(DataT)/sizeof(double)][2];// points on each end of the range, 0 if unknown
 
 	// for the line property
 	int			m_nDataLineSize;
@@ -239,7 +278,10 @@ protected:
 	bool		m_bForceGdiPlus;
 
 	bool		m_pbClipData[sizeof(DataT)/sizeof(double)];
-	bool		m_bSorted;
+	// the sort type the data is known to follow, -1 when unknown, and how many leading points follow it,
+	// points appended after them are merged in by the next sort
+	int			m_nSortedType;
+	int			m_nSortedCount;
 
 	// for extended properties
 	void		*m_pExtProp;
@@ -253,13 +295,19 @@ public:
 	// for redraw
 	int			nDatas, nPts, nPts4Fill;
 	POINT		*pPointsGdi;
+	int			nPtsCapacity;// allocated size of pPointsGdi
+	int			nScreenDatas;// data points held in pPointsGdi, -1 if they can not be extended
+	int			nAppendPending, nDropPending;
+	int			nOldAxisFlags;
 	double		xScale, yScale;
 	int			nOldType;
 	//double		fOldXRange[2], fOldYRange[2], fOldZRange[2];
 	double		pfOldRange[sizeof(DataT)/sizeof(double)][2];
 	RECT		rctOldPlot;
 	bool		bCompactDraw;
+	int			nCompactMode;
 	MyVData2D	vDrawData;
+	bool		bDrawDataExternal;// vDrawData is filled by the plot, CreateCompactData is skipped
 	bool		bDrawDataChanged;
 	int			nDrawDataOldSize;
 	bool		bForceUpdate;
@@ -276,15 +324,44 @@ public:
 	bool		bFlag;
 
 public:
-	inline	const vector<DataT>		&GetDataConst() const {return *m_pvData;}
-	inline	vector<DataT>			&GetData() {return *m_pvData;}
-	inline	vector<DataT>			*GetPData() {return m_pvData;}
+	inline	const vector<DataT>		&GetDataConst() const {if(m_nRingHead>0)UnwrapData(); return *m_pvData;}
+	inline	vector<DataT>			&GetData() {if(m_nRingHead>0)UnwrapData(); m_bColumnValid = false; m_nXOrder = kXOrderUnknown; m_nEditGeneration++; return *m_pvData;}
+	inline	vector<DataT>			*GetPData() {if(m_nRingHead>0)UnwrapData(); m_bColumnValid = false; m_nXOrder = kXOrderUnknown; m_nEditGeneration++; return m_pvData;}
 	inline	vector<DataT>			&GetDataSaved() {return *m_pvDataSaved;}
 	inline	vector<DataT>			*GetPDataSaved() {return m_pvDataSaved;}
 	inline	int						GetDataCount() {return (int)m_pvData->size();}
 	inline	vector<int>				&GetSegHide(){return m_vSegHide;}
 
-	inline	void		ReplacePoint(DataT data, int nPointIndex){if(nPointIndex<0 || nPointIndex>=GetDataCount())return; (*m_pvData)[nPointIndex]=data;}
+	// Access by logical index, valid whether the ring buffer is wrapped or not
+	inline	DataT		&GetDataAt(int nPointIndex){nPointIndex += m_nRingHead; if(nPointIndex >= (int)m_pvData->size())nPointIndex -= (int)m_pvData->size(); return (*m_pvData)[nPointIndex];}
+	inline	const DataT	&GetDataAt(int nPointIndex) const {nPointIndex += m_nRingHead; if(nPointIndex >= (int)m_pvData->size())nPointIndex -= (int)m_pvData->size(); return (*m_pvData)[nPointIndex];}
+	inline	bool		IsDataWrapped() const {return m_nRingHead>0;}
+	// Writing through GetDataAt must be followed by MarkDataEdited
+	inline	unsigned int	GetEditGeneration() const {return m_nEditGeneration;}
+	inline	unsigned int	GetFrontDrops() const {return m_nFrontDrops;}
+	inline	void		MarkDataEdited(){m_nEditGeneration++;}
+	// The points stored contiguously from a logical index, nLen is cut at the wrap of the ring buffer
+	inline	const DataT	*GetDataRun(int nPointIndex, int &nLen) const {int nSize = (int)m_pvData->size(); nPointIndex += m_nRingHead; if(nPointIndex >= nSize)nPointIndex -= nSize; int nEnd = nPointIndex<m_nRingHead ? m_nRingHead : nSize; if(nLen > nEnd - nPointIndex)nLen = nEnd - nPointIndex; return &(*m_pvData)[nPointIndex];}
+	void				UnwrapData() const;
+	void				PushRingData(const DataT &data, int nCapacity);
+	void				AppendData(const DataT &data);
+	inline	void		ReserveData(int nCount){m_pvData->reserve(nCount); if(m_bColumnValid){for(int i=0; i<sizeof(DataT)/sizeof(double); i++)m_pvColumn[i].reserve(nCount);}}
+
+	// Columnar storage, built on demand and kept in step with appends
+	// Writing through the non-const GetData() or GetPData() drops it, it is rebuilt on the next access
+	inline	bool		IsColumnar() const {return m_bColumnar;}
+	void				SetColumnar(bool columnar);
+	inline	void		InvalidateColumns() const {m_bColumnValid = false;}
+	DataColumns			GetColumns() const;
+	const vector<double>	&GetColumn(int whichDim) const;
+
+	inline	void		ReplacePoint(DataT data, int nPointIndex){if(nPointIndex<0 || nPointIndex>=GetDataCount())return; GetDataAt(nPointIndex)=data; m_nXOrder = kXOrderUnknown; m_nEditGeneration++; if(m_bColumnValid){for(int i=0; i<sizeof(DataT)/sizeof(double); i++)m_pvColumn[i][nPointIndex] = data.val[i];}}
+
+	// Lookups in logical index, the binary searches need the dimension to be sorted ascending
+	bool				IsXMonotonic() const;
+	int					LowerBound(int whichDim, double val) const;// first point with value >= val
+	int					UpperBound(int whichDim, double val) const;// first point with value > val
+	void				GetXSegmentWindow(double x, int &nFirst, int &nLast) const;
 
 	void				DeleteData();
 	//virtual	void		GetDataRange();
@@ -350,15 +427,21 @@ public:
 	inline	double		GetYDataRangeHigh(){return m_ppfDataRange[1][1];}
 	inline	double		GetZDataRangeLow(){return m_ppfDataRange[2][0];}
 	inline	double		GetZDataRangeHigh(){return m_ppfDataRange[2][1];}
-	inline	void		SetXDataRange(double low, double high) { m_ppfDataRange[0][0] = low; m_ppfDataRange[0][1] = high; }
-	inline	void		SetYDataRange(double low, double high) { m_ppfDataRange[1][0] = low; m_ppfDataRange[1][1] = high; }
-	inline	void		SetZDataRange(double low, double high) { m_ppfDataRange[2][0] = low; m_ppfDataRange[2][1] = high; }
-	inline	void		SetXDataRange(double *range) { memcpy(m_ppfDataRange[0], range, 2*sizeof(double)); }
-	inline	void		SetYDataRange(double *range) { memcpy(m_ppfDataRange[1], range, 2*sizeof(double)); }
-	inline	void		SetZDataRange(double *range) { memcpy(m_ppfDataRange[2], range, 2*sizeof(double)); }
+	inline	void		SetXDataRange(double low, double high) { m_ppfDataRange[0][0] = low; m_ppfDataRange[0][1] = high; ForgetExtremes(0); m_nDataRangeStamp = NewDataRangeStamp(); }
+	inline	void		SetYDataRange(double low, double high) { m_ppfDataRange[1][0] = low; m_ppfDataRange[1][1] = high; ForgetExtremes(1); m_nDataRangeStamp = NewDataRangeStamp(); }
+	inline	void		SetZDataRange(double low, double high) { m_ppfDataRange[2][0] = low; m_ppfDataRange[2][1] = high; ForgetExtremes(2); m_nDataRangeStamp = NewDataRangeStamp(); }
+	inline	void		SetXDataRange(double *range) { memcpy(m_ppfDataRange[0], range, 2*sizeof(double)); ForgetExtremes(0); m_nDataRangeStamp = NewDataRangeStamp(); }
+	inline	void		SetYDataRange(double *range) { memcpy(m_ppfDataRange[1], range, 2*sizeof(double)); ForgetExtremes(1); m_nDataRangeStamp = NewDataRangeStamp(); }
+	inline	void		SetZDataRange(double *range) { memcpy(m_ppfDataRange[2], range, 2*sizeof(double)); ForgetExtremes(2); m_nDataRangeStamp = NewDataRangeStamp(); }
 	inline	void		SetDataRange(double *xRange, double *yRange) {SetXDataRange(xRange); SetYDataRange(yRange); }
 	inline	bool		IsDataRangeSet(){ return m_bDataRangeSet; }
 	inline	void		SetDataRangeSet(bool set){ m_bDataRangeSet = set; }
+	inline	unsigned int	GetDataRangeStamp(){ return m_nDataRangeStamp; }
+	// Running range, a new value widens it, a removed one only forces a recompute if it was the last
+	// point on an extreme. Points on each extreme are counted, a range set from outside has no count
+	void				ExtendDataRange(int whichDim, double val);
+	void				DropFromDataRange(const DataT &data);
+	inline	void		ForgetExtremes(int whichDim) { m_ppnExtremeCount[whichDim][0] = m_ppnExtremeCount[whichDim][1] = 0; }
 	inline	int			GetDataLineSize() {return m_nDataLineSize;}
 	inline	void		SetDataLineSize(int size) { m_nDataLineSize = size; }
 	inline	int			GetPlotLineSize() {return m_nPlotLineSize;}
@@ -396,8 +479,9 @@ public:
 	inline	bool		IsClipZData(){ return m_pbClipData[2]; }
 	inline	void		SetClipZData(bool clip){ m_pbClipData[2] = clip; }
 	inline	bool		IsClipData(){int i; for(i=0; i<sizeof(DataT)/sizeof(double); i++){if(m_pbClipData[i])return true;} return false;}
-	inline	bool		IsSorted(){ return m_bSorted; }
-	inline	void		SetSorted(bool sorted){ m_bSorted = sorted; }
+	inline	bool		IsSorted(){ return m_nSortedType>=0 && m_nSortedCount>=GetDataCount(); }
+	inline	void		SetSorted(bool sorted){ if(sorted){m_nSortedType = m_nSortType; m_nSortedCount = GetDataCount();}else{m_nSortedType = -1; m_nSortedCount = 0;} }
+	inline	int			GetSortedType(){ return m_nSortedType; }
 
 	//	inline	SIZE		&GetTitleOffset(){ return m_sizeTitleOffset;}
 //	inline	void		SetTitleOffset(SIZE offset){ m_sizeTitleOffset = offset;}
@@ -410,6 +494,11 @@ public:
 public:
 	inline	bool		IsCompactDraw() {return bCompactDraw; }
 	inline	void		SetCompactDraw(bool bCD) { bCompactDraw = bCD; }
+	inline	int			GetCompactMode() {return nCompactMode; }
+	inline	void		SetCompactMode(int mode) { if(mode>=0 && mode<kCompactModeCount)nCompactMode = mode; bDrawDataChanged = true; bForceUpdate = true; }
+	// nAdded points were appended at the tail and nDropped points left the head of a ring buffer,
+	// the screen points of the other points can be kept
+	inline	void		SetTailAppended(int nAdded, int nDropped) { nAppendPending += nAdded; nDropPending += nDropped; }
 
 	inline	int			GetSLMode() {return nSLMode; }
 	inline	void		SetSLMode(int mode) { nSLMode = mode; }
@@ -424,8 +513,11 @@ public:
 
 	void				SortData(vector<DataT> &vData, int nSortType);
 	void				SortData();
+	// Sorts only when the order is unknown, points appended in order since the last sort cost O(k)
+	void				SortData(int nSortType);
 
-	bool				ReadFromBuff(tstring buff);
+	bool				ReadFromBuff(const tstring &buff);
+	bool				ReadFromBuff(const TCHAR *pBegin, const TCHAR *pEnd);
 	bool				ReadFromFile(tstring filename);
 	bool				WriteToFile(tofstream &ofs);
 	bool				WriteToFile(tstring filename);
@@ -442,8 +534,15 @@ CPlotData<DataT>::CPlotData()
 {
 	m_pvData = new std::vector<DataT>;
 	m_pvDataSaved = new std::vector<DataT>;
+	m_nRingHead = 0;
+	m_nEditGeneration = 0;
+	m_nFrontDrops = 0;
+	m_bColumnar = false;
+	m_bColumnValid = false;
+	m_nXOrder = kXOrderUnknown;
 	SetDefaults();
 	pPointsGdi = 0;
+	nPtsCapacity = 0;
 
 	m_pExtProp = 0;
 }
@@ -506,6 +605,8 @@ void CPlotData<DataT>::SetDefaults()
 	m_bAutoColor = true;
   
 	m_bDataRangeSet = false;
+	m_nDataRangeStamp = NewDataRangeStamp();
+	memset(m_ppnExtremeCount, 0, sizeof(m_ppnExtremeCount));
 
 	m_nPlotType = kXYPlotConnect;
 
@@ -533,7 +634,8 @@ void CPlotData<DataT>::SetDefaults()
 	{
 		m_pbClipData[i] = false;
 	}
-	m_bSorted = false;
+	m_nSortedType = -1;
+	m_nSortedCount = 0;
 	pnClipRange[0] = pnClipRange[1] = -1;
 
 	bDragMode = false;
@@ -541,6 +643,11 @@ void CPlotData<DataT>::SetDefaults()
 	fOffsetY = 0.0;
 
 	pPointsGdi = 0;
+	nPtsCapacity = 0;
+	nScreenDatas = -1;
+	nAppendPending = 0;
+	nDropPending = 0;
+	nOldAxisFlags = 0;
 	nDatas = 0;
 	nPts = 0;
 	nPts4Fill = 0;
@@ -554,8 +661,10 @@ void CPlotData<DataT>::SetDefaults()
 		memset(pfOldRange, 0, 2*sizeof(double));
 	}
 	bCompactDraw = false;
+	nCompactMode = kCompactM4;
 	SetRectEmpty(&rctOldPlot);
 	vDrawData.clear();
+	bDrawDataExternal = false;
 	bDrawDataChanged = true;
 	nDrawDataOldSize = 0;
 	bForceUpdate = true;
@@ -574,6 +683,10 @@ void CPlotData<DataT>::DeleteData(void)
 	// Check if valid data. If so, delete it
 	m_strTitle = _TEXT("");
 	m_pvData->clear();
+	m_nRingHead = 0;
+	m_bColumnValid = false;
+	m_nXOrder = kXOrderUnknown;
+	m_nEditGeneration++;
 }
 
 template<typename DataT>
@@ -581,6 +694,10 @@ bool CPlotData<DataT>::SetData(vector<DataT> vData)
 {
 	m_pvData->clear();
 	*m_pvData = vData;
+	m_nRingHead = 0;
+	m_bColumnValid = false;
+	m_nXOrder = kXOrderUnknown;
+	m_nEditGeneration++;
 	return true;
 }
 
@@ -589,9 +706,194 @@ bool CPlotData<DataT>::SetData(vector<DataT> *pvData)
 {
 	m_pvData->clear();
 	m_pvData = pvData;
+	m_nRingHead = 0;
+	m_bColumnValid = false;
+	m_nXOrder = kXOrderUnknown;
+	m_nEditGeneration++;
 	return true;
 }
 
+// Rotate the ring buffer back to a linear layout, so that the vector can be used directly
+template<typename DataT>
+void CPlotData<DataT>::UnwrapData() const
+{
+	if(m_nRingHead <= 0)return;
+	if(m_nRingHead < (int)m_pvData->size())
+	{
+		std::rotate(m_pvData->begin(), m_pvData->begin()+m_nRingHead, m_pvData->end());
+	}
+	m_nRingHead = 0;
+}
+
+// Append a point, when the count reaches nCapacity, the oldest point is overwritten in place
+// instead of erasing the front of the vector, so it is O(1)
+template<typename DataT>
+void CPlotData<DataT>::PushRingData(const DataT &data, int nCapacity)
+{
+	int nSize = (int)m_pvData->size();
+	if(nCapacity <= 0 || nSize < nCapacity)
+	{
+		AppendData(data);
+		return;
+	}
+	// the logical order shifts, the columns are rebuilt when needed
+	m_bColumnValid = false;
+	SetSorted(false);
+	if(nSize > nCapacity)
+	{
+		// the capacity has been reduced, drop the extra oldest points at once
+		if(m_nRingHead>0)UnwrapData();
+		m_pvData->erase(m_pvData->begin(), m_pvData->begin() + (nSize - nCapacity));
+		m_nFrontDrops += nSize - nCapacity;
+		nSize = nCapacity;
+		m_bDataRangeSet = false;
+	}
+	DataT dropped = (*m_pvData)[m_nRingHead];
+	// dropping the oldest point may make the rest monotonic again
+	if(m_nXOrder == kXOrderNone)
+		m_nXOrder = kXOrderUnknown;
+	else if(m_nXOrder == kXOrderMonotonic && !(data.val[0] >= (*m_pvData)[(m_nRingHead+nSize-1)%nSize].val[0]))
+		m_nXOrder = kXOrderNone;
+	(*m_pvData)[m_nRingHead] = data;
+	m_nFrontDrops++;
+	m_nRingHead++;
+	if(m_nRingHead >= nSize)m_nRingHead = 0;
+	DropFromDataRange(dropped);
+}
+
+template<typename DataT>
+void CPlotData<DataT>::ExtendDataRange(int whichDim, double val)
+{
+	if(val < m_ppfDataRange[whichDim][0])
+	{
+		m_ppfDataRange[whichDim][0] = val;
+		m_ppnExtremeCount[whichDim][0] = 1;
+		m_nDataRangeStamp = NewDataRangeStamp();
+	}
+	else if(val == m_ppfDataRange[whichDim][0] && m_ppnExtremeCount[whichDim][0] > 0)
+	{
+		m_ppnExtremeCount[whichDim][0]++;
+	}
+	if(val > m_ppfDataRange[whichDim][1])
+	{
+		m_ppfDataRange[whichDim][1] = val;
+		m_ppnExtremeCount[whichDim][1] = 1;
+		m_nDataRangeStamp = NewDataRangeStamp();
+	}
+	else if(val == m_ppfDataRange[whichDim][1] && m_ppnExtremeCount[whichDim][1] > 0)
+	{
+		m_ppnExtremeCount[whichDim][1]++;
+	}
+}
+
+// Called after the point has left the data. The x of a monotonic curve starts at the first point,
+// so that a rolling time axis never scans the data again
+template<typename DataT>
+void CPlotData<DataT>::DropFromDataRange(const DataT &data)
+{
+	if(!m_bDataRangeSet)return;
+
+	int i, nDataDim = sizeof(DataT)/sizeof(double);
+	bool bXFirst = (m_nXOrder == kXOrderMonotonic && m_pvData->size() > 0);
+	bool bLow, bHigh;
+	for(i = bXFirst?1:0; i<nDataDim; i++)
+	{
+		if(data.val[i] > m_ppfDataRange[i][0] && data.val[i] < m_ppfDataRange[i][1])continue;
+
+		// the extreme stays while another point is on it, a NaN is never on it
+		bLow = (data.val[i] == m_ppfDataRange[i][0]);
+		bHigh = (data.val[i] == m_ppfDataRange[i][1]);
+		if((!bLow && !bHigh) || (bLow && m_ppnExtremeCount[i][0] <= 1) || (bHigh && m_ppnExtremeCount[i][1] <= 1))
+		{
+			m_bDataRangeSet = false;
+			return;
+		}
+		if(bLow)m_ppnExtremeCount[i][0]--;
+		if(bHigh)m_ppnExtremeCount[i][1]--;
+	}
+	if(bXFirst && m_ppfDataRange[0][0] != GetDataAt(0).val[0])
+	{
+		m_ppfDataRange[0][0] = GetDataAt(0).val[0];
+		m_ppnExtremeCount[0][0] = 0;
+		m_nDataRangeStamp = NewDataRangeStamp();
+	}
+}
+
+// Append a point at the logical end, the columns follow if they are valid
+template<typename DataT>
+void CPlotData<DataT>::AppendData(const DataT &data)
+{
+	if(m_nRingHead>0)UnwrapData();
+	if(m_nXOrder == kXOrderMonotonic && m_pvData->size()>0 && !(data.val[0] >= m_pvData->back().val[0]))
+		m_nXOrder = kXOrderNone;
+	m_pvData->push_back(data);
+	if(m_bColumnValid)
+	{
+		int i;
+		for(i=0; i<sizeof(DataT)/sizeof(double); i++)
+		{
+			m_pvColumn[i].push_back(data.val[i]);
+		}
+	}
+}
+
+template<typename DataT>
+void CPlotData<DataT>::SetColumnar(bool columnar)
+{
+	m_bColumnar = columnar;
+	m_bColumnValid = false;
+	if(!columnar)
+	{
+		int i;
+		for(i=0; i<sizeof(DataT)/sizeof(double); i++)
+		{
+			vector<double>().swap(m_pvColumn[i]);
+		}
+	}
+}
+
+// Get one dimension as a contiguous array, the columns are (re)built here if needed
+template<typename DataT>
+const vector<double> &CPlotData<DataT>::GetColumn(int whichDim) const
+{
+	int nDataDim = sizeof(DataT)/sizeof(double);
+	if(whichDim<0 || whichDim>=nDataDim)whichDim = 0;
+
+	if(!m_bColumnValid)
+	{
+		int i, j, nCount = (int)m_pvData->size();
+		for(i=0; i<nDataDim; i++)
+		{
+			m_pvColumn[i].resize(nCount);
+		}
+		for(j=0; j<nCount; j++)
+		{
+			const DataT &data = GetDataAt(j);
+			for(i=0; i<nDataDim; i++)
+			{
+				m_pvColumn[i][j] = data.val[i];
+			}
+		}
+		m_bColumnValid = true;
+	}
+	return m_pvColumn[whichDim];
+}
+
+template<typename DataT>
+DataColumns CPlotData<DataT>::GetColumns() const
+{
+	DataColumns cols;
+	int i, nDataDim = sizeof(DataT)/sizeof(double);
+
+	GetColumn(0);
+	cols.nCount = (int)m_pvData->size();
+	for(i=0; i<3; i++)
+	{
+		cols.pCol[i] = (i<nDataDim && cols.nCount>0)?&m_pvColumn[i][0]:0;
+	}
+	return cols;
+}
+
 template<typename DataT>
 void CPlotData<DataT>::SortData(vector<DataT> &vData, int nSortType)
 {
@@ -601,28 +903,22 @@ void CPlotData<DataT>::SortData(vector<DataT> &vData, int nSortType)
 	switch(nSortType)
 	{
 	case kSortXInc:
-		nWhichDimCmp = 0;
-		sort(vData.begin(), vData.end(), vLess<DataT>);
+		sort(vData.begin(), vData.end(), DimLess<DataT>(0));
 		break;
 	case kSortXDec:
-		nWhichDimCmp = 0;
-		sort(vData.begin(), vData.end(), vGreat<DataT>);
+		sort(vData.begin(), vData.end(), DimGreater<DataT>(0));
 		break;
 	case kSortYInc:
-		nWhichDimCmp = 1;
-		sort(vData.begin(), vData.end(), vLess<DataT>);
+		sort(vData.begin(), vData.end(), DimLess<DataT>(1));
 		break;
 	case kSortYDec:
-		nWhichDimCmp = 1;
-		sort(vData.begin(), vData.end(), vGreat<DataT>);
+		sort(vData.begin(), vData.end(), DimGreater<DataT>(1));
 		break;
 	case kSortZInc:
-		nWhichDimCmp = 2;
-		sort(vData.begin(), vData.end(), vLess<DataT>);
+		sort(vData.begin(), vData.end(), DimLess<DataT>(2));
 		break;
 	case kSortZDec:
-		nWhichDimCmp = 2;
-		sort(vData.begin(), vData.end(), vGreat<DataT>);
+		sort(vData.begin(), vData.end(), DimGreater<DataT>(2));
 		break;
 	}
 }
@@ -630,7 +926,139 @@ void CPlotData<DataT>::SortData(vector<DataT> &vData, int nSortType)
 template<typename DataT>
 void CPlotData<DataT>::SortData()
 {
-	SortData(*m_pvData, m_nSortType);
+	SortData(GetData(), m_nSortType);
+	if(m_nSortType == kSortXInc)m_nXOrder = kXOrderMonotonic;
+	SetSorted(true);
+}
+
+// Sort the points from nFirst on, then merge them into the sorted points before nFirst
+template<typename DataT, typename CompareT>
+void	MergeSortedTail(vector<DataT> &vData, int nFirst, CompareT cmp)
+{
+	typename vector<DataT>::iterator itFirst = vData.begin() + nFirst;
+	typename vector<DataT>::iterator it;
+	for(it = itFirst + 1; it < vData.end(); it++)
+	{
+		if(cmp(*it, *(it - 1)))
+		{
+			sort(itFirst, vData.end(), cmp);
+			break;
+		}
+	}
+	if(nFirst > 0 && cmp(*itFirst, *(itFirst - 1)))
+		inplace_merge(vData.begin(), itFirst, vData.end(), cmp);
+}
+
+// Returns the index of the first point that breaks the order, from nFirst on
+template<typename DataT, typename CompareT>
+int		FindUnsorted(CPlotData<DataT> *pPlotData, int nFirst, CompareT cmp)
+{
+	int i, nSize = pPlotData->GetDataCount();
+	for(i = nFirst>0?nFirst:1; i<nSize; i++)
+	{
+		if(cmp(pPlotData->GetDataAt(i), pPlotData->GetDataAt(i-1)))return i;
+	}
+	return nSize;
+}
+
+template<typename DataT>
+void CPlotData<DataT>::SortData(int nSortType)
+{
+	if(nSortType<0 || nSortType>=kSortTypeCount)return;
+	if(nSortType/2 >= (int)(sizeof(DataT)/sizeof(double)))return;
+	m_nSortType = nSortType;
+
+	int nSize = GetDataCount();
+	// x order is tracked by the appends already
+	if(nSortType == kSortXInc && IsXMonotonic())
+	{
+		SetSorted(true);
+		return;
+	}
+	if(m_nSortedType != nSortType || m_nSortedCount > nSize)
+	{
+		SortData();
+		return;
+	}
+	if(m_nSortedCount == nSize)return;
+
+	// only the appended points are looked at, when they follow the order nothing moves
+	int nDim = nSortType/2;
+	bool bInc = (nSortType%2 == 0);
+	int nFirst = bInc ? FindUnsorted(this, m_nSortedCount, DimLess<DataT>(nDim)) : FindUnsorted(this, m_nSortedCount, DimGreater<DataT>(nDim));
+	if(nFirst < nSize)
+	{
+		if(bInc)
+			MergeSortedTail(GetData(), m_nSortedCount, DimLess<DataT>(nDim));
+		else
+			MergeSortedTail(GetData(), m_nSortedCount, DimGreater<DataT>(nDim));
+		if(nSortType == kSortXInc)m_nXOrder = kXOrderMonotonic;
+	}
+	SetSorted(true);
+}
+
+// Scan the x values once, later appends keep the result up to date
+template<typename DataT>
+bool CPlotData<DataT>::IsXMonotonic() const
+{
+	if(m_nXOrder == kXOrderUnknown)
+	{
+		int i, nCount = (int)m_pvData->size();
+		m_nXOrder = kXOrderMonotonic;
+		for(i=1; i<nCount; i++)
+		{
+			// written so that a NaN breaks the order
+			if(!(GetDataAt(i).val[0] >= GetDataAt(i-1).val[0]))
+			{
+				m_nXOrder = kXOrderNone;
+				break;
+			}
+		}
+	}
+	return m_nXOrder == kXOrderMonotonic;
+}
+
+template<typename DataT>
+int CPlotData<DataT>::LowerBound(int whichDim, double val) const
+{
+	int lo = 0, hi = (int)m_pvData->size(), mid;
+	while(lo < hi)
+	{
+		mid = lo + (hi - lo)/2;
+		if(GetDataAt(mid).val[whichDim] < val)lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+template<typename DataT>
+int CPlotData<DataT>::UpperBound(int whichDim, double val) const
+{
+	int lo = 0, hi = (int)m_pvData->size(), mid;
+	while(lo < hi)
+	{
+		mid = lo + (hi - lo)/2;
+		if(GetDataAt(mid).val[whichDim] <= val)lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+// The segments [i-1, i] that may hold x are those with nFirst <= i <= nLast,
+// all of them if x is not monotonic. One more segment is kept on each side
+// so that callers comparing in log space are not cut by rounding
+template<typename DataT>
+void CPlotData<DataT>::GetXSegmentWindow(double x, int &nFirst, int &nLast) const
+{
+	int nCount = (int)m_pvData->size();
+	nFirst = 1;
+	nLast = nCount - 1;
+	if(nCount < 2 || !IsXMonotonic())return;
+
+	int lb = LowerBound(0, x) - 1;
+	int ub = UpperBound(0, x) + 1;
+	if(lb > nFirst)nFirst = lb;
+	if(ub < nLast)nLast = ub;
 }
 /*
 template<typename DataT>
@@ -664,51 +1092,37 @@ void	CPlotData<DataT>::GetDataRange(  )
 }*/
 
 template<typename DataT>
-bool CPlotData<DataT>::ReadFromBuff(tstring buff)
+bool CPlotData<DataT>::ReadFromBuff(const tstring &buff)
+{
+	return ReadFromBuff(buff.c_str(), buff.c_str() + buff.length());
+}
+
+// A line holding exactly dim numbers is a point, other lines are skipped
+template<typename DataT>
+bool CPlotData<DataT>::ReadFromBuff(const TCHAR *pBegin, const TCHAR *pEnd)
 {
 	int	dim = sizeof(DataT)/sizeof(double);
 	if(dim<=0 || dim>3)return false;
 	
-	tstring	pattern;
-	if(dim==1)
+	const TCHAR *p, *pLine;
+	int nLines = 1;
+	for(p = pBegin; p < pEnd; p++)
 	{
-		pattern = _TEXT("^-?\\d+(\\.\\d*)?([eE][+-]?\\d*)?\\s*$");
+		if(*p == _TEXT('\n'))nLines++;
 	}
-	else if(dim==2)
-	{
-		pattern = _TEXT("^(-?\\d+(\\.\\d*)?([eE][+-]?\\d*)?\\s*){2}$");
-	}
-	else if(dim==3)
-	{
-		pattern = _TEXT("^(-?\\d+(\\.\\d*)?([eE][+-]?\\d*)?\\s*){3}$");
-	}
-
-	tstring aline;
-	CRegexpT <TCHAR> dataline(pattern.c_str());
-	MatchResult rst1;
-	int match1;
 	
 	DataT datapoint;
-
 	vector<DataT> vData;
-	tstring value;
-	tstring::size_type curpos;
+	vData.reserve(nLines);
 	
-	curpos=0;
-	do
+	for(pLine = pBegin; pLine < pEnd; pLine = p + 1)
 	{
-		aline=readline(buff,curpos);
-		if(aline.length()==0)
-			break;
-		trimspace(aline);
-		rst1=dataline.MatchExact(aline.c_str());
-		match1=rst1.IsMatched();
-		if(match1)
+		for(p = pLine; p < pEnd && *p != _TEXT('\n'); p++);
+		if(scan_doubles(pLine, p, m_strSpaceSeparator.c_str(), datapoint.val, dim) == dim)
 		{
-			GetDataPoint(aline, datapoint, dim);
 			vData.push_back(datapoint);
 		}
-	}while(curpos != tstring::npos);
+	}
 
 	if(vData.size()<=0)
 	{
@@ -716,8 +1130,11 @@ bool CPlotData<DataT>::ReadFromBuff(tstring buff)
 	}
 	else
 	{
-		m_pvData->clear();
-		*m_pvData = vData;
+		m_pvData->swap(vData);
+		m_nRingHead = 0;
+		m_bColumnValid = false;
+		m_nXOrder = kXOrderUnknown;
+		m_nEditGeneration++;
 		return true;
 	}
 }
@@ -825,7 +1242,7 @@ bool	CPlotData<DataT>::AppendToBuff(tstring &buff)
 
 	for(i=0; i<(int)m_pvData->size(); i++)
 	{
-		GetDataLine((*m_pvData)[i], dim, m_strSpaceSeparator, aline);
+		GetDataLine(GetDataAt(i), dim, m_strSpaceSeparator, aline);
 		buff += aline;
 	}
 	
@@ -76,9 +76,9 @@ void	CPlotDataBarImpl<PlotDataT>::DrawDataBars( HDC hDC, RECT plotRect, double *
 
 	for( j = 0; j < nDatas; j++)
 	{
-		myX = pT->GetData()[j].val[0];
+		myX = pT->GetDataAt(j).val[0];
 		if(bXLog)myX = log10(myX);
-		myY = pT->GetData()[j].val[1];
+		myY = pT->GetDataAt(j).val[1];
 		if(bYLog)myY = log10(myY);
 
 		if(!((CPlotImpl*)pT->GetPlot())->IsXOpposite())
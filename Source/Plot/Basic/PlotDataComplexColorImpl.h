@@ -52,6 +52,7 @@ bool	CPlotDataComplexColorImpl<PlotDataT>::CheckSegColors()
 	PlotDataT* pT = static_cast<PlotDataT*>(this);
 
 	double xmin, xmax;
+	pT->GetDataRange();
 	switch(m_nMultiColorInputType)
 	{
 	case kInputColorByPointRatio:
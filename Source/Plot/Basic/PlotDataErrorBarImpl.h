@@ -19,6 +19,7 @@
 
 #pragma once
 #include "PlotDataErrorBar.h"
+#include "ScreenTransform.h"
 #include <windows.h>
 #include <vector>
 using namespace std;
@@ -87,65 +88,55 @@ void	CPlotDataErrorBarImpl<PlotDataT>::DrawErrorBars( HDC hDC, RECT plotRect, do
 	if(!pT->IsVisible())return;
 	if(!m_bErrorBarMode)return;
 	
-	double xScale, yScale;
-	xScale = pT->xScale;
-	yScale = pT->yScale;
+	ScreenAxisMap	xMap, yMap;
+	pT->GetScreenAxisMaps(plotRect, xRange, yRange, false, xMap, yMap);
 	
-	int			j, nDatas;
-	double		myX, myY;
-	bool		bXLog, bYLog;
+	int			i, j, nLen, nDatas;
 	
+	// points without both bounds are skipped
 	nDatas = pT->GetDataCount();
-	
-	bXLog = ((CPlotImpl*)pT->GetPlot())->IsXLogarithm();
-	bYLog = ((CPlotImpl*)pT->GetPlot())->IsYLogarithm();
+	if((int)m_vfLBound.size() < nDatas)nDatas = (int)m_vfLBound.size();
+	if((int)m_vfUBound.size() < nDatas)nDatas = (int)m_vfUBound.size();
 	
 	HPEN hBarPen, hOldBarPen;
 	hBarPen = CreatePen(m_nErrorBarLineStyle, m_nErrorBarLineSize, m_bErrorBarSameColor?pT->GetPlotColor():m_crErrorBarLineColor);
 	hOldBarPen = (HPEN)SelectObject(hDC, hBarPen);
 	
 	POINT pt1, pt2;
-	double lb, ub;
 	int	hl = m_nErrorBarHeadHalfLen;
-	for( j = 0; j < nDatas; j++ )
+	
+	// the ends of the bars are gathered and transformed a block at a time
+	const int	nBlock = 256;
+	double		pX[nBlock], pLow[nBlock], pHigh[nBlock];
+	long		pScrX[nBlock], pScrLow[nBlock], pScrHigh[nBlock];
+	for( j = 0; j < nDatas; j += nBlock )
 	{
-		if((int)m_vfLBound.size()<=j || (int)m_vfUBound.size()<=j)
-			continue;
-		
-		lb = m_vfLBound[j];
-		ub = m_vfUBound[j];
-		
-		myX = pT->GetData()[j].val[0];
-		if(bXLog)myX = log10(myX);
-		myY = pT->GetData()[j].val[1] - lb;
-		if(bYLog)myY = log10(myY);
-		if(!((CPlotImpl*)pT->GetPlot())->IsXOpposite())
-			pt1.x = (long)(plotRect.left + xScale * (myX-xRange[0]));
-		else
-			pt1.x = (long)(plotRect.right - xScale * (myX-xRange[0]));
-		if(!((CPlotImpl*)pT->GetPlot())->IsYOpposite())
-			pt1.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]));
-		else
-			pt1.y = (long)(plotRect.top + yScale * (myY-yRange[0]));
-
-		myY = pT->GetData()[j].val[1] + ub;
-		if(bYLog)myY = log10(myY);
-		if(!((CPlotImpl*)pT->GetPlot())->IsXOpposite())
-			pt2.x = (long)(plotRect.left + xScale * (myX-xRange[0]));
-		else
-			pt2.x = (long)(plotRect.right - xScale * (myX-xRange[0]));
-		if(!((CPlotImpl*)pT->GetPlot())->IsYOpposite())
-			pt2.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]));
-		else
-			pt2.y = (long)(plotRect.top + yScale * (myY-yRange[0]));
-		MoveToEx(hDC, pt1.x, pt1.y, NULL);
-		LineTo(hDC, pt2.x, pt2.y);
-		
-		MoveToEx(hDC, pt1.x - hl, pt1.y, NULL);
-		LineTo(hDC, pt1.x + hl, pt1.y);
+		nLen = (nDatas - j < nBlock) ? nDatas - j : nBlock;
+		for( i = 0; i < nLen; i++ )
+		{
+			pX[i] = pT->GetDataAt(j+i).val[0];
+			pLow[i] = pT->GetDataAt(j+i).val[1] - m_vfLBound[j+i];
+			pHigh[i] = pT->GetDataAt(j+i).val[1] + m_vfUBound[j+i];
+		}
+		DataToScreen(xMap, pX, 1, pScrX, 1, nLen);
+		DataToScreen(yMap, pLow, 1, pScrLow, 1, nLen);
+		DataToScreen(yMap, pHigh, 1, pScrHigh, 1, nLen);
 		
-		MoveToEx(hDC, pt2.x - hl, pt2.y, NULL);
-		LineTo(hDC, pt2.x + hl, pt2.y);
+		for( i = 0; i < nLen; i++ )
+		{
+			if(pScrX[i] == kScreenGap || pScrLow[i] == kScreenGap || pScrHigh[i] == kScreenGap)continue;
+			pt1.x = pt2.x = pScrX[i];
+			pt1.y = pScrLow[i];
+			pt2.y = pScrHigh[i];
+			MoveToEx(hDC, pt1.x, pt1.y, NULL);
+			LineTo(hDC, pt2.x, pt2.y);
+			
+			MoveToEx(hDC, pt1.x - hl, pt1.y, NULL);
+			LineTo(hDC, pt1.x + hl, pt1.y);
+			
+			MoveToEx(hDC, pt2.x - hl, pt2.y, NULL);
+			LineTo(hDC, pt2.x + hl, pt2.y);
+		}
 	}
 	SelectObject(hDC, hOldBarPen);
 	DeleteObject(hBarPen);
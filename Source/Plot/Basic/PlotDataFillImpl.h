@@ -20,6 +20,7 @@
 #pragma once
 #include "PlotDataFill.h"
 #include "PlotData.h"
+#include "ScreenTransform.h"
 
 Declare_Namespace_CChart
 
@@ -32,6 +33,7 @@ public:
 
 protected:
 	bool	AppendFillPoints( HDC hDC, RECT plotRect, double *xRange, double *yRange );
+	void	AddFillRuns( HDC hDC, POINT *myPoints, int nPts, int nPts4Fill, int plottype );
 public:
 	void	DrawFillArea( HDC hDC, RECT plotRect, double *xRange, double *yRange );
 };
@@ -57,26 +59,20 @@ bool	CPlotDataFillImpl<PlotDataT>::AppendFillPoints( HDC hDC, RECT plotRect, dou
 	if(!pT->IsVisible())return false;
 	if(!m_bDataFill)return false;
 	
-	double xScale, yScale;
 	POINT *myPoints;
 	int nPts4Fill;
-	xScale = pT->xScale;
-	yScale = pT->yScale;
 	myPoints = pT->pPointsGdi;
 	nPts4Fill = pT->nPts4Fill;
 
 	int bordersize = ((CPlotImpl*)pT->GetPlot())->IsLightDataRegion()?((CPlotImpl*)pT->GetPlot())->GetLightLineSize():((CPlotImpl*)pT->GetPlot())->GetBorderSize();
 	
 	int			nDatas;
-	double		myX, myY;
-	bool		bXLog, bYLog;
-	
 	POINT		point;
 	
 	nDatas = pT->GetDataCount();
 	
-	bXLog = ((CPlotImpl*)pT->GetPlot())->IsXLogarithm();
-	bYLog = ((CPlotImpl*)pT->GetPlot())->IsYLogarithm();
+	ScreenAxisMap	xMap, yMap;
+	pT->GetScreenAxisMaps(plotRect, xRange, yRange, true, xMap, yMap);
 	
 	int plottype = pT->GetPlotType();
 	
@@ -86,12 +82,7 @@ bool	CPlotDataFillImpl<PlotDataT>::AppendFillPoints( HDC hDC, RECT plotRect, dou
 		break;
 	case kDataFillFromBottomAxis:
 	case kDataFillFromTopAxis:
-		myX = pT->GetData()[nDatas-1].val[0];
-		if(bXLog)myX = log10(myX);
-		if(!((CPlotImpl*)pT->GetPlot())->IsXOpposite())
-			point.x = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-		else
-			point.x = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
+		DataToScreen(xMap, &pT->GetDataAt(nDatas-1).val[0], 1, &point.x, 1, 1);
 
 		if(m_nDataFillMode == kDataFillFromBottomAxis)
 			point.y = plotRect.bottom-bordersize/2.0;
@@ -99,22 +90,12 @@ bool	CPlotDataFillImpl<PlotDataT>::AppendFillPoints( HDC hDC, RECT plotRect, dou
 			point.y = plotRect.top+bordersize/2.0;
 		myPoints[nPts4Fill - 2] = point;
 		
-		myX = pT->GetData()[0].val[0];
-		if(bXLog)myX = log10(myX);
-		if(!((CPlotImpl*)pT->GetPlot())->IsXOpposite())
-			point.x = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-		else
-			point.x = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
+		DataToScreen(xMap, &pT->GetDataAt(0).val[0], 1, &point.x, 1, 1);
 		myPoints[nPts4Fill - 1] = point;
 		break;
 	case kDataFillFromLeftAxis:
 	case kDataFillFromRightAxis:
-		myY = pT->GetData()[nDatas-1].val[1];
-		if(bYLog)myY = log10(myY);
-		if(!((CPlotImpl*)pT->GetPlot())->IsYOpposite())
-			point.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]) + 0.5);
-		else
-			point.y = (long)(plotRect.top + yScale * (myY-yRange[0]) + 0.5);
+		DataToScreen(yMap, &pT->GetDataAt(nDatas-1).val[1], 1, &point.y, 1, 1);
 
 		if(m_nDataFillMode == kDataFillFromLeftAxis)
 			point.x = plotRect.left+bordersize/2.0;
@@ -122,12 +103,7 @@ bool	CPlotDataFillImpl<PlotDataT>::AppendFillPoints( HDC hDC, RECT plotRect, dou
 			point.x = plotRect.right-bordersize/2.0;
 		myPoints[nPts4Fill - 2] = point;
 		
-		myY = pT->GetData()[0].val[1];
-		if(bYLog)myY = log10(myY);
-		if(!((CPlotImpl*)pT->GetPlot())->IsYOpposite())
-			point.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]) + 0.5);
-		else
-			point.y = (long)(plotRect.top + yScale * (myY-yRange[0]) + 0.5);
+		DataToScreen(yMap, &pT->GetDataAt(0).val[1], 1, &point.y, 1, 1);
 		myPoints[nPts4Fill - 1] = point;
 		break;
 	default:
@@ -136,6 +112,38 @@ bool	CPlotDataFillImpl<PlotDataT>::AppendFillPoints( HDC hDC, RECT plotRect, dou
 	return true;
 }
 
+// Each run of points between the gaps is a figure of its own, an axis fill closes it with the
+// points of AppendFillPoints moved to the ends of the run
+template<class PlotDataT>
+void	CPlotDataFillImpl<PlotDataT>::AddFillRuns( HDC hDC, POINT *myPoints, int nPts, int nPts4Fill, int plottype )
+{
+	bool bAxis = nPts4Fill > nPts;
+	bool bHorz = ( m_nDataFillMode == kDataFillFromBottomAxis || m_nDataFillMode == kDataFillFromTopAxis );
+	POINT ptClose[2];
+	int nStart, nLen, nBezier;
+	for(nStart = 0; (nLen = NextScreenRun(myPoints, nPts, nStart)) > 0; nStart += nLen)
+	{
+		nBezier = (plottype == kXYPlotBezier && nLen >= 4) ? (nLen-1)/3*3+1 : 1;
+		MoveToEx(hDC, myPoints[nStart].x, myPoints[nStart].y, NULL);
+		if(nBezier > 1)PolyBezierTo(hDC, myPoints + nStart + 1, nBezier - 1);
+		if(nBezier < nLen)PolylineTo(hDC, myPoints + nStart + nBezier, nLen - nBezier);
+		if(!bAxis)continue;
+
+		ptClose[0] = ptClose[1] = myPoints[nPts4Fill - 2];
+		if(bHorz)
+		{
+			ptClose[0].x = myPoints[nStart + nLen - 1].x;
+			ptClose[1].x = myPoints[nStart].x;
+		}
+		else
+		{
+			ptClose[0].y = myPoints[nStart + nLen - 1].y;
+			ptClose[1].y = myPoints[nStart].y;
+		}
+		PolylineTo(hDC, ptClose, 2);
+	}
+}
+
 //void	MyDrawFill(HDC hDC, COLORREF color, int alpha);
 
 template<class PlotDataT>
@@ -181,7 +189,11 @@ void	CPlotDataFillImpl<PlotDataT>::DrawFillArea( HDC hDC, RECT plotRect, double
 	hOldBrush = (HBRUSH)SelectObject( hDC,hBrush );
 	
 	BeginPath(hDC);
-	switch(plottype)
+	if(!IsScreenRunWhole(myPoints, pT->nPts))
+	{
+		AddFillRuns(hDC, myPoints, pT->nPts, nPts4Fill, plottype);
+	}
+	else switch(plottype)
 	{
 	case kXYPlotConnect:
 	case kXYPlotStepHV:
@@ -33,6 +33,7 @@ void	MyDrawLineCrPtByPt(HDC hDC, int plottype, std::vector<COLORREF> vColor, int
 	for(i=0; i<nPts-1; i++)
 	{
 		if(mypoints[i].x == mypoints[i+1].x && mypoints[i].y == mypoints[i+1].y)continue;
+		if(IsScreenGap(mypoints[i]) || IsScreenGap(mypoints[i+1]))continue;
 		
 		Point *points = new Point[2];
 		points[0].X = mypoints[i].x;
@@ -88,6 +89,7 @@ void	MyDrawLineCrMulti(HDC hDC, CPlotImpl *pPlot, RECT plotRect, int xScale, int
 	for(i=0; i<nPts-1; i++)
 	{
 		if(mypoints[i].x == mypoints[i+1].x && mypoints[i].y == mypoints[i+1].y)continue;
+		if(IsScreenGap(mypoints[i]) || IsScreenGap(mypoints[i+1]))continue;
 		
 		for(k=0; k<2; k++)
 		{
@@ -180,6 +182,7 @@ void	MyDrawLineCrBi(HDC hDC, CPlotImpl *pPlot, RECT plotRect, int xScale, int yS
 	for(i=0; i<nPts-1; i++)
 	{
 		if(mypoints[i].x == mypoints[i+1].x && mypoints[i].y == mypoints[i+1].y)continue;
+		if(IsScreenGap(mypoints[i]) || IsScreenGap(mypoints[i+1]))continue;
 		
 		for(k=0; k<2; k++)
 		{
@@ -292,48 +295,228 @@ int	CPlotDataImpl<DataPoint2D>::CreateCompactData(RECT plotRect, double *xRange,
 	if(GetDataCount()<=0)return 0;
 	if(!m_bVisible)return 0;
 	
-	double		myX, myY;
-	
 	if(bCompactDraw)
 	{
-		DataPoint2D dp;
-		
-		long X0, X1;
-		
 		vDrawData.clear();
 		
-		int step, count = 0;
-		while(count<GetDataCount())
+		// only the points in the plot and one on each side of it
+		int iStart = 0, iEnd = GetDataCount() - 1;
+		if(IsXMonotonic())
+		{
+			iStart = FindCompactEdge(plotRect, xRange, true);
+			iEnd = FindCompactEdge(plotRect, xRange, false);
+			// all of them beyond the same side
+			if(iStart > iEnd)iStart = iEnd;
+		}
+		
+		switch(nCompactMode)
+		{
+		case kCompactLTTB:
+			CreateCompactDataLTTB(plotRect, xRange, yRange, iStart, iEnd);
+			break;
+		case kCompactAverage:
+			CreateCompactDataAverage(plotRect, xRange, iStart, iEnd);
+			break;
+		default:
+			CreateCompactDataM4(plotRect, xRange, iStart, iEnd);
+			break;
+		}
+	}
+	
+	return (int)vDrawData.size();
+}
+
+// The screen column of a point, computed exactly as in CreateScreenPoints
+// Columns far outside the plot are merged into one on each side, they are clipped anyway
+long	CPlotDataImpl<DataPoint2D>::GetCompactColumn(double x, RECT plotRect, double *xRange)
+{
+	double	X;
+	long	margin = 2*m_nPlotLineSize + 2;
+	
+	if(((CPlotImpl*)m_pPlot)->IsXLogarithm())x = log10(x);
+	
+	if(!((CPlotImpl*)m_pPlot)->IsXOpposite())
+		X = plotRect.left + xScale * (x-xRange[0]) + 0.5;
+	else
+		X = plotRect.right - xScale * (x-xRange[0]) + 0.5;
+	
+	if(X < plotRect.left - margin)return plotRect.left - margin - 1;
+	if(X > plotRect.right + margin)return plotRect.right + margin + 1;
+	return (long)X;
+}
+
+// With monotonic x the columns go one way along the data, so the points merged into the column
+// beyond one side of the plot are found by binary search. Returns the one of them next to the plot,
+// it starts or ends the segment that crosses the border
+int		CPlotDataImpl<DataPoint2D>::FindCompactEdge(RECT plotRect, double *xRange, bool bStart)
+{
+	int		n = GetDataCount();
+	int		lo = 0, hi = n - 1, mid;
+	long	margin = 2*m_nPlotLineSize + 2;
+	long	X = GetCompactColumn(GetDataAt(bStart?lo:hi).val[0], plotRect, xRange);
+	
+	if(X >= plotRect.left - margin && X <= plotRect.right + margin)return bStart?lo:hi;
+	if(bStart)
+	{
+		// the last point in column X
+		while(lo < hi)
 		{
-			dp.val[0] = dp.val[1] = 0;
+			mid = lo + (hi - lo + 1)/2;
+			if(GetCompactColumn(GetDataAt(mid).val[0], plotRect, xRange) == X)lo = mid;
+			else hi = mid - 1;
+		}
+		return lo;
+	}
+	else
+	{
+		// the first point in column X
+		while(lo < hi)
+		{
+			mid = lo + (hi - lo)/2;
+			if(GetCompactColumn(GetDataAt(mid).val[0], plotRect, xRange) == X)hi = mid;
+			else lo = mid + 1;
+		}
+		return hi;
+	}
+}
+
+// M4 decimation, one pass in data order, no sorting
+// For every run of consecutive points in the same column, the first, min, max and last points are kept.
+// A 1 pixel polyline covers in that column exactly the span between min and max, and the segments
+// to the neighbour columns start from the first and end at the last point, so the rasterised result
+// is the same as drawing all the points
+void	CPlotDataImpl<DataPoint2D>::CreateCompactDataM4(RECT plotRect, double *xRange, int iStart, int iEnd)
+{
+	int		i, n = iEnd + 1;
+	int		iFirst, iMin, iMax, iLast, iLo, iHi;
+	long	X, X0;
+	double	y;
+	
+	X = GetCompactColumn(GetDataAt(iStart).val[0], plotRect, xRange);
+	i = iStart;
+	while(i < n)
+	{
+		X0 = X;
+		iFirst = iMin = iMax = i;
+		for(i++; i < n; i++)
+		{
+			X = GetCompactColumn(GetDataAt(i).val[0], plotRect, xRange);
+			if(X != X0)break;
 			
-			step = 0;
-			while(true)
+			y = GetDataAt(i).val[1];
+			if(y < GetDataAt(iMin).val[1])iMin = i;
+			if(y > GetDataAt(iMax).val[1])iMax = i;
+		}
+		iLast = i - 1;
+		
+		iLo = iMin < iMax ? iMin : iMax;
+		iHi = iMin < iMax ? iMax : iMin;
+		vDrawData.push_back(GetDataAt(iFirst));
+		if(iLo > iFirst)vDrawData.push_back(GetDataAt(iLo));
+		if(iHi > iLo)vDrawData.push_back(GetDataAt(iHi));
+		if(iLast > iHi)vDrawData.push_back(GetDataAt(iLast));
+	}
+}
+
+// Largest triangle three buckets, about two points for each pixel of the plot width
+void	CPlotDataImpl<DataPoint2D>::CreateCompactDataLTTB(RECT plotRect, double *xRange, double *yRange, int iStart, int iEnd)
+{
+	int		i, n = iEnd - iStart + 1;
+	int		nThreshold = 2 * Width(plotRect);
+	
+	if(nThreshold < 3)nThreshold = 3;
+	if(n <= nThreshold)
+	{
+		for(i=0; i<n; i++)
+		{
+			vDrawData.push_back(GetDataAt(iStart + i));
+		}
+		return;
+	}
+	
+	bool	bXLog = ((CPlotImpl*)m_pPlot)->IsXLogarithm();
+	bool	bYLog = ((CPlotImpl*)m_pPlot)->IsYLogarithm();
+	
+	// the areas are measured in screen units, otherwise x and y would not be comparable
+	vector<double>	vX(n), vY(n);
+	for(i=0; i<n; i++)
+	{
+		vX[i] = xScale * (bXLog?log10(GetDataAt(iStart + i).val[0]):GetDataAt(iStart + i).val[0]);
+		vY[i] = yScale * (bYLog?log10(GetDataAt(iStart + i).val[1]):GetDataAt(iStart + i).val[1]);
+	}
+	
+	double	every = (double)(n - 2) / (nThreshold - 2);
+	double	avgX, avgY, area, maxArea;
+	int		a = 0, nextA, b, k;
+	int		avgStart, avgEnd, rangeStart, rangeEnd;
+	
+	vDrawData.push_back(GetDataAt(iStart));
+	for(b=0; b<nThreshold-2; b++)
+	{
+		// average of the next bucket
+		avgStart = (int)((b + 1) * every) + 1;
+		avgEnd = (int)((b + 2) * every) + 1;
+		if(avgEnd > n)avgEnd = n;
+		if(avgStart >= avgEnd)avgStart = avgEnd - 1;
+		avgX = avgY = 0.0;
+		for(k=avgStart; k<avgEnd; k++)
+		{
+			avgX += vX[k];
+			avgY += vY[k];
+		}
+		avgX /= (avgEnd - avgStart);
+		avgY /= (avgEnd - avgStart);
+		
+		// the point of this bucket that makes the largest triangle
+		rangeStart = (int)(b * every) + 1;
+		rangeEnd = (int)((b + 1) * every) + 1;
+		if(rangeEnd > n - 1)rangeEnd = n - 1;
+		maxArea = -1.0;
+		nextA = rangeStart;
+		for(k=rangeStart; k<rangeEnd; k++)
+		{
+			area = fabs((vX[a] - avgX) * (vY[k] - vY[a]) - (vX[a] - vX[k]) * (avgY - vY[a]));
+			if(area > maxArea)
 			{
-				if(count+step > GetDataCount())break;
-				
-				myX = GetData()[count+step].val[0];
-				myY = GetData()[count+step].val[1];
-				X1 = (long)(xScale * (myX-xRange[0]) + plotRect.left);
-				if(step == 0)X0 = X1;
-				
-				step++;
-				if(X1 != X0)break;
-				
-				dp.val[0] += myX;
-				dp.val[1] += myY;
+				maxArea = area;
+				nextA = k;
 			}
-			if(step <= 1)break;// unexpected!!
-			
-			dp.val[0] /= (double)(step-1);
-			dp.val[1] /= (double)(step-1);
-			vDrawData.push_back(dp);
-			
-			count += step;
 		}
+		vDrawData.push_back(GetDataAt(iStart + nextA));
+		a = nextA;
 	}
+	vDrawData.push_back(GetDataAt(iStart + n - 1));
+}
+
+// The former behaviour, each run of points in the same column is replaced by its average
+void	CPlotDataImpl<DataPoint2D>::CreateCompactDataAverage(RECT plotRect, double *xRange, int iStart, int iEnd)
+{
+	int		i, n = iEnd + 1, count;
+	long	X, X0;
+	DataPoint2D	dp;
 	
-	return (int)vDrawData.size();
+	X = GetCompactColumn(GetDataAt(iStart).val[0], plotRect, xRange);
+	i = iStart;
+	while(i < n)
+	{
+		X0 = X;
+		dp.val[0] = dp.val[1] = 0.0;
+		count = 0;
+		for( ; i < n; i++)
+		{
+			if(count > 0)
+			{
+				X = GetCompactColumn(GetDataAt(i).val[0], plotRect, xRange);
+				if(X != X0)break;
+			}
+			dp.val[0] += GetDataAt(i).val[0];
+			dp.val[1] += GetDataAt(i).val[1];
+			count++;
+		}
+		dp.val[0] /= count;
+		dp.val[1] /= count;
+		vDrawData.push_back(dp);
+	}
 }
 
 //template<typename DataT>
@@ -356,13 +539,140 @@ bool	CPlotDataImpl<DataPoint2D>::IsDataScaleNeeded(RECT plotRect, double *xRange
 
 	if(!pPointsGdi)return true;
 	if(bDragMoved)return true;
+	if(nAppendPending>0 || nDropPending>0)return true;
+
+	// cleared when the screen points are created
+	if(bForceUpdate)return true;
+	return false;
+}
 
-	if(bForceUpdate)
+// The transforms of the axes with the current scales, the same for the curve, the markers and the fills
+void	CPlotDataImpl<DataPoint2D>::GetScreenAxisMaps( RECT plotRect, double *xRange, double *yRange, bool bRound, ScreenAxisMap &xMap, ScreenAxisMap &yMap )
+{
+	CPlotImpl *pPlot = (CPlotImpl*)m_pPlot;
+	if(!pPlot->IsXOpposite())
+		xMap = MakeScreenAxisMap(plotRect.left, xScale, xRange[0], false, pPlot->IsXLogarithm(), bRound);
+	else
+		xMap = MakeScreenAxisMap(plotRect.right, xScale, xRange[0], true, pPlot->IsXLogarithm(), bRound);
+	if(!pPlot->IsYOpposite())
+		yMap = MakeScreenAxisMap(plotRect.bottom, yScale, yRange[0], true, pPlot->IsYLogarithm(), bRound);
+	else
+		yMap = MakeScreenAxisMap(plotRect.top, yScale, yRange[0], false, pPlot->IsYLogarithm(), bRound);
+}
+
+// The points are taken run by run, a wrapped ring buffer has two runs
+void	CPlotDataImpl<DataPoint2D>::DataToScreenPoints( const ScreenAxisMap &xMap, const ScreenAxisMap &yMap, int nStart, int nCount, POINT *pPoints )
+{
+	const DataPoint2D *pData;
+	int nLen;
+	while(nCount > 0)
 	{
-		bForceUpdate = false;
-		return true;
+		nLen = nCount;
+		pData = GetDataRun(nStart, nLen);
+		DataToScreen(xMap, &pData->val[0], sizeof(DataPoint2D)/sizeof(double), &pPoints->x, sizeof(POINT)/sizeof(long), nLen);
+		DataToScreen(yMap, &pData->val[1], sizeof(DataPoint2D)/sizeof(double), &pPoints->y, sizeof(POINT)/sizeof(long), nLen);
+		nStart += nLen;
+		nCount -= nLen;
+		pPoints += nLen;
 	}
-	return false;
+}
+
+// The axis settings the screen points depend on, besides the ranges
+int		CPlotDataImpl<DataPoint2D>::GetScreenAxisFlags()
+{
+	CPlotImpl *pPlot = (CPlotImpl*)m_pPlot;
+	return (pPlot->IsXLogarithm()?1:0) | (pPlot->IsYLogarithm()?2:0) | (pPlot->IsXOpposite()?4:0) | (pPlot->IsYOpposite()?8:0);
+}
+
+// The buffer only grows, geometrically, so that appended points rarely reallocate it
+void	CPlotDataImpl<DataPoint2D>::ReserveScreenPoints( int nCount, bool bKeep )
+{
+	if(pPointsGdi && nCount <= nPtsCapacity && (bKeep || nCount >= nPtsCapacity/4))return;
+	
+	int nCapacity = nCount;
+	if(pPointsGdi && nCount > nPtsCapacity && nCapacity < nPtsCapacity + nPtsCapacity/2)
+	{
+		nCapacity = nPtsCapacity + nPtsCapacity/2;
+	}
+	POINT *pPoints = new POINT[nCapacity];
+	DRAW_STATS_COUNT(((CPlotImpl*)m_pPlot)->GetDrawStats(), kDrawCountAllocations, 1);
+	if(pPointsGdi)
+	{
+		if(bKeep)memcpy(pPoints, pPointsGdi, nPtsCapacity*sizeof(POINT));
+		delete []pPointsGdi;
+	}
+	pPointsGdi = pPoints;
+	nPtsCapacity = nCapacity;
+}
+
+// When only appends happened and the plot and the y range are unchanged, only the appended points
+// are transformed. If the x range has scrolled by a whole number of pixels, the kept points are
+// shifted instead of recomputed. Returns false if the screen points must be created again
+bool	CPlotDataImpl<DataPoint2D>::ExtendScreenPoints( RECT plotRect, double *xRange, double *yRange )
+{
+	if(bForceUpdate || bDragMoved || !pPointsGdi || nScreenDatas < 0)return false;
+	if(bCompactDraw || IsClipData())return false;
+	if(m_nPlotType != nOldType)return false;
+	if(m_nPlotType != kXYPlotScatter && m_nPlotType != kXYPlotConnect && m_nPlotType != kXYPlotBar)return false;
+	if(!EqualRect(&plotRect, &rctOldPlot))return false;
+	if(memcmp(yRange, pfOldRange[1], 2*sizeof(double)) != 0)return false;
+	if(GetScreenAxisFlags() != nOldAxisFlags)return false;
+	
+	int nCount = GetDataCount();
+	int nKept = nScreenDatas - nDropPending;
+	if(nKept < 0 || nKept + nAppendPending != nCount)return false;
+	
+	long dx = 0;
+	if(memcmp(xRange, pfOldRange[0], 2*sizeof(double)) != 0)
+	{
+		double fWidth = xRange[1] - xRange[0];
+		double fOldWidth = pfOldRange[0][1] - pfOldRange[0][0];
+		if(fabs(fWidth - fOldWidth) > 1e-12 * fabs(fOldWidth))return false;
+		
+		double fShift = xScale * (pfOldRange[0][0] - xRange[0]);
+		if(((CPlotImpl*)m_pPlot)->IsXOpposite())fShift = -fShift;
+		dx = (long)floor(fShift + 0.5);
+		if(fabs(fShift - dx) > 1e-6)return false;
+	}
+	
+	int	j;
+	int fillmode = m_nDataFillMode;
+	int nFill = ( fillmode == kDataFillFromBottomAxis || fillmode == kDataFillFromTopAxis
+		|| fillmode == kDataFillFromLeftAxis || fillmode == kDataFillFromRightAxis ) ? 2 : 0;
+	
+	if(nDropPending > 0 && nKept > 0)
+	{
+		memmove(pPointsGdi, pPointsGdi + nDropPending, nKept*sizeof(POINT));
+	}
+	ReserveScreenPoints(nCount + nFill, true);
+	
+	ScreenAxisMap	xMap, yMap;
+	GetScreenAxisMaps(plotRect, xRange, yRange, true, xMap, yMap);
+	long	x;
+	for( j = 0; dx != 0 && j < nKept; j++ )
+	{
+		x = pPointsGdi[j].x;
+		if(x == kScreenGap)continue;
+		// the rounding truncates towards zero and clamps, points crossing the screen origin or near the limits are recomputed
+		if( ((x > 0 && x + dx > 0) || (x < 0 && x + dx < 0)) && labs(x) < kScreenLimit && labs(x + dx) < kScreenLimit )
+			pPointsGdi[j].x = x + dx;
+		else
+			DataToScreenPoints(xMap, yMap, j, 1, pPointsGdi + j);
+	}
+	if(nCount > nKept)
+	{
+		DataToScreenPoints(xMap, yMap, nKept, nCount - nKept, pPointsGdi + nKept);
+	}
+	
+	nPts = nCount;
+	nPts4Fill = nCount + nFill;
+	memcpy(pfOldRange[0], xRange, 2*sizeof(double));
+	nScreenDatas = nCount;
+	nAppendPending = 0;
+	nDropPending = 0;
+	m_nScreenStamp++;
+	
+	return true;
 }
 
 //template<typename DataT>
@@ -373,10 +683,6 @@ bool	CPlotDataImpl<DataPoint2D>::CreateScreenPoints( HDC hDC, RECT plotRect, dou
 	if(!m_bVisible)return false;
 
 	int			j, nDatas;
-	POINT		point;
-	double		x1,x2, y1, y2;
-	double		myX, myY;
-	bool		bXLog, bYLog;
 
 	if(m_pbClipData[0])
 	{
@@ -408,6 +714,7 @@ bool	CPlotDataImpl<DataPoint2D>::CreateScreenPoints( HDC hDC, RECT plotRect, dou
 	{
 		nPts = nDatas = (int)vDrawData.size();
 	}
+	if(nDatas <= 0)return false;
 	int plottype = m_nPlotType;
 	if(plottype == kXYPlotBezier && GetDataCount() < 4)
 	{
@@ -438,238 +745,223 @@ bool	CPlotDataImpl<DataPoint2D>::CreateScreenPoints( HDC hDC, RECT plotRect, dou
 		nPts4Fill += 2;
 	}
 
-	if(*myPoints)
+	if(myPoints == &pPointsGdi)
 	{
-		delete [](*myPoints);
-		*myPoints = 0;
+		ReserveScreenPoints(nPts4Fill, false);
+		*myPoints = pPointsGdi;
+	}
+	else
+	{
+		if(*myPoints)
+		{
+			delete [](*myPoints);
+			*myPoints = 0;
+		}
+		*myPoints = new POINT[nPts4Fill];
 	}
-	*myPoints = new POINT[nPts4Fill];
 
-	bXLog = ((CPlotImpl*)m_pPlot)->IsXLogarithm();
-	bYLog = ((CPlotImpl*)m_pPlot)->IsYLogarithm();
+	// all the data points first, the step types are then expanded in place from the end
+	ScreenAxisMap	xMap, yMap;
+	GetScreenAxisMaps(plotRect, xRange, yRange, true, xMap, yMap);
+	if(!bCompact)
+	{
+		DataToScreenPoints(xMap, yMap, 0, nDatas, *myPoints);
+	}
+	else
+	{
+		DataToScreen(xMap, &vDrawData[0].val[0], sizeof(DataPoint2D)/sizeof(double), &(*myPoints)[0].x, sizeof(POINT)/sizeof(long), nDatas);
+		DataToScreen(yMap, &vDrawData[0].val[1], sizeof(DataPoint2D)/sizeof(double), &(*myPoints)[0].y, sizeof(POINT)/sizeof(long), nDatas);
+	}
 
+	POINT	*pPts = *myPoints;
+	POINT	pt1, pt2;
+	// a step next to a gap is a gap, so the runs of the line end there
+	POINT	ptGap;
+	ptGap.x = ptGap.y = kScreenGap;
 	switch( plottype )
 	{
 	case kXYPlotScatter:
 	case kXYPlotConnect:
-	case kXYPlotBezier:
 	case kXYPlotBar:
-		for( j = 0; j < nDatas; j++ )
-		{
-			if(!bCompact)
-			{
-				myX = GetData()[j].val[0];
-				myY = GetData()[j].val[1];
-			}
-			else
-			{
-				myX = vDrawData[j].val[0];
-				myY = vDrawData[j].val[1];
-			}
-			
-			if(bXLog)myX = log10(myX);
-			if(bYLog)myY = log10(myY);
-
-			if(!((CPlotImpl*)m_pPlot)->IsXOpposite())
-				point.x = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-			else
-				point.x = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
-
-			if(!((CPlotImpl*)m_pPlot)->IsYOpposite())
-				point.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]) + 0.5);
-			else
-				point.y = (long)(plotRect.top + yScale * (myY-yRange[0]) + 0.5);
-			(*myPoints)[j] = point;
-		}
-		if( plottype == kXYPlotBezier )
+		break;
+	case kXYPlotBezier:
+		for( j = nDatas; j < nPts; j++ )
 		{
-			for( j = nDatas; j < nPts; j++ )
-			{
-				(*myPoints)[j] = point;
-			}
+			pPts[j] = pPts[nDatas-1];
 		}
 		break;
 	case kXYPlotStepHV:
 	case kXYPlotStepVH:
-		for( j = 0; j < nDatas-1; j++ )
+		pPts[2*nDatas-2] = pPts[nDatas-1];
+		for( j = nDatas-2; j >= 0; j-- )
 		{
-			if(!bCompact)
+			pt1 = pPts[j];
+			pt2 = pPts[j+1];
+			pPts[2*j] = pt1;
+			if( IsScreenGap(pt1) || IsScreenGap(pt2) )
 			{
-				myX = GetData()[j].val[0];
-				myY = GetData()[j].val[1];
+				pPts[2*j+1] = ptGap;
+				continue;
 			}
-			else
-			{
-				myX = vDrawData[j].val[0];
-				myY = vDrawData[j].val[1];
-			}
-			if(bXLog)myX = log10(myX);
-			if(bYLog)myY = log10(myY);
-
-			if(!((CPlotImpl*)m_pPlot)->IsXOpposite())
-				point.x = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-			else
-				point.x = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
-			if(!((CPlotImpl*)m_pPlot)->IsYOpposite())
-				point.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]) + 0.5);
-			else
-				point.y = (long)(plotRect.top + yScale * (myY-yRange[0]) + 0.5);
-			(*myPoints)[2*j] = point;
-
-			if(!bCompact)
-			{
-				myX = GetData()[j+1].val[0];
-				myY = GetData()[j+1].val[1];
-			}
-			else
-			{
-				myX = vDrawData[j+1].val[0];
-				myY = vDrawData[j+1].val[1];
-			}
-			if(bXLog)myX = log10(myX);
-			if(bYLog)myY = log10(myY);
 			if( plottype == kXYPlotStepHV )
-			{
-				if(!((CPlotImpl*)m_pPlot)->IsXOpposite())
-					point.x = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-				else
-					point.x = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
-			}
-			else if( plottype == kXYPlotStepVH )
-			{
-				if(!((CPlotImpl*)m_pPlot)->IsYOpposite())
-					point.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]) + 0.5);
-				else
-					point.y = (long)(plotRect.top + yScale * (myY-yRange[0]) + 0.5);
-			}
-			(*myPoints)[2*j+1] = point;
-		}
-		if(!bCompact)
-		{
-			myX = GetData()[nDatas-1].val[0];
-			myY = GetData()[nDatas-1].val[1];
-		}
-		else
-		{
-			myX = vDrawData[nDatas-1].val[0];
-			myY = vDrawData[nDatas-1].val[1];
+				pt1.x = pt2.x;
+			else
+				pt1.y = pt2.y;
+			pPts[2*j+1] = pt1;
 		}
-		if(bXLog)myX = log10(myX);
-		if(bYLog)myY = log10(myY);
-		if(!((CPlotImpl*)m_pPlot)->IsXOpposite())
-			point.x = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-		else
-			point.x = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
-		if(!((CPlotImpl*)m_pPlot)->IsYOpposite())
-			point.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]) + 0.5);
-		else
-			point.y = (long)(plotRect.top + yScale * (myY-yRange[0]) + 0.5);
-		(*myPoints)[2*nDatas-2] = point;
 		break;
 	case kXYPlotStepHVH:
 	case kXYPlotStepVHV:
-		for( j = 0; j < nDatas-1; j++ )
+		pPts[3*nDatas-3] = pPts[nDatas-1];
+		for( j = nDatas-2; j >= 0; j-- )
 		{
-			if(!bCompact)
-			{
-				myX = GetData()[j].val[0];
-				myY = GetData()[j].val[1];
-			}
-			else
+			pt1 = pPts[j];
+			pt2 = pPts[j+1];
+			pPts[3*j] = pt1;
+			if( IsScreenGap(pt1) || IsScreenGap(pt2) )
 			{
-				myX = vDrawData[j].val[0];
-				myY = vDrawData[j].val[1];
+				pPts[3*j+1] = pPts[3*j+2] = ptGap;
+				continue;
 			}
-			if(bXLog)myX = log10(myX);
-			if(bYLog)myY = log10(myY);
-
-			if(!((CPlotImpl*)m_pPlot)->IsXOpposite())
-				point.x = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-			else
-				point.x = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
-			if(!((CPlotImpl*)m_pPlot)->IsYOpposite())
-				point.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]) + 0.5);
-			else
-				point.y = (long)(plotRect.top + yScale * (myY-yRange[0]) + 0.5);
-			(*myPoints)[3*j] = point;
-
-			if(!bCompact)
+			if( plottype == kXYPlotStepHVH )
 			{
-				myX = GetData()[j+1].val[0];
-				myY = GetData()[j+1].val[1];
+				pt1.x = long( ((double)pt1.x + pt2.x) / 2 );
+				pPts[3*j+1] = pt1;
+				pt1.y = pt2.y;
+				pPts[3*j+2] = pt1;
 			}
 			else
 			{
-				myX = vDrawData[j+1].val[0];
-				myY = vDrawData[j+1].val[1];
-			}
-			if(bXLog)myX = log10(myX);
-			if(bYLog)myY = log10(myY);
-			if( plottype == kXYPlotStepHVH )
-			{			
-				x1 = point.x;
-				if(!((CPlotImpl*)m_pPlot)->IsXOpposite())
-					x2 = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-				else
-					x2 = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
-				point.x = long( (x1 + x2) / 2);
-				(*myPoints)[3*j+1] = point;
-
-				if(!((CPlotImpl*)m_pPlot)->IsYOpposite())
-					y2 = (long)(plotRect.bottom - yScale * (myY-yRange[0]) + 0.5);
-				else
-					y2 = (long)(plotRect.top + yScale * (myY-yRange[0]) + 0.5);
-				point.y = long( y2 );
-				(*myPoints)[3*j+2] = point;
+				pt1.y = long( ((double)pt1.y + pt2.y) / 2 );
+				pPts[3*j+1] = pt1;
+				pt1.x = pt2.x;
+				pPts[3*j+2] = pt1;
 			}
-			else if( plottype == kXYPlotStepVHV )
-			{
-				y1 = point.y;
-				if(!((CPlotImpl*)m_pPlot)->IsYOpposite())
-					y2 = (long)(plotRect.bottom - yScale * (myY-yRange[0])+ 0.5);
-				else
-					y2 = (long)(plotRect.top + yScale * (myY-yRange[0])+ 0.5);
-				point.y = long( (y1 + y2) / 2  );
-				(*myPoints)[3*j+1] = point;
-
-				if(!((CPlotImpl*)m_pPlot)->IsXOpposite())
-					x2 = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-				else
-					x2 = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
-				point.x = long( x2  );
-				(*myPoints)[3*j+2] = point;
-			}
-		}
-		if(!bCompact)
-		{
-			myX = GetData()[nDatas-1].val[0];
-			myY = GetData()[nDatas-1].val[1];
 		}
-		else
-		{
-			myX = vDrawData[nDatas-1].val[0];
-			myY = vDrawData[nDatas-1].val[1];
-		}
-		if(bXLog)myX = log10(myX);
-		if(bYLog)myY = log10(myY);
-		if(!((CPlotImpl*)m_pPlot)->IsXOpposite())
-			point.x = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-		else
-			point.x = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
-		if(!((CPlotImpl*)m_pPlot)->IsYOpposite())
-			point.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]) + 0.5);
-		else
-			point.y = (long)(plotRect.top + yScale * (myY-yRange[0]) + 0.5);
-		(*myPoints)[3*nDatas-3] = point;
 		break;
 	default:
 		return false;
 	}
 
 	bDragMoved = false;
+	bForceUpdate = false;
+	nScreenDatas = (myPoints == &pPointsGdi && !bCompact && !IsClipData()) ? nDatas : -1;
+	nAppendPending = 0;
+	nDropPending = 0;
+	nOldAxisFlags = GetScreenAxisFlags();
+	if(myPoints == &pPointsGdi)m_nScreenStamp++;
+
+	return true;
+}
+
+bool	CPlotDataImpl<DataPoint2D>::UpdateHitGrid()
+{
+	if(!pPointsGdi || nPts4Fill <= 0)return false;
+	if(m_nHitGridStamp != m_nScreenStamp || !m_HitGrid.IsBuilt())
+	{
+		m_HitGrid.Build(pPointsGdi, nPts4Fill, rctOldPlot);
+		m_nHitGridStamp = m_nScreenStamp;
+	}
+	return true;
+}
+
+int		CPlotDataImpl<DataPoint2D>::GetHitStep( RECT plotRect, double *xRange, double *yRange )
+{
+	// the screen points must be those of the whole data in these ranges
+	if(nScreenDatas < 0 || bForceUpdate || bDragMoved)return 0;
+	if(m_nPlotType != nOldType || GetScreenAxisFlags() != nOldAxisFlags)return 0;
+	if(!EqualRect(&plotRect, &rctOldPlot))return 0;
+	if(memcmp(xRange, pfOldRange[0], 2*sizeof(double)) != 0 || memcmp(yRange, pfOldRange[1], 2*sizeof(double)) != 0)return 0;
+
+	// screen points drawn for each data point
+	int nStep;
+	switch(m_nPlotType)
+	{
+	case kXYPlotScatter:
+	case kXYPlotConnect:
+	case kXYPlotBar:
+		nStep = 1;
+		break;
+	case kXYPlotStepHV:
+	case kXYPlotStepVH:
+		nStep = 2;
+		break;
+	case kXYPlotStepHVH:
+	case kXYPlotStepVHV:
+		nStep = 3;
+		break;
+	default:
+		return 0;
+	}
+	if(nScreenDatas - nDropPending + nAppendPending != GetDataCount())return 0;
+	if(nPts != (nScreenDatas - 1)*nStep + 1)return 0;
+	if(!UpdateHitGrid())return 0;
+	return nStep;
+}
+
+bool	CPlotDataImpl<DataPoint2D>::GetHitSegments( RECT plotRect, double *xRange, double *yRange, POINT point, long rx, long ry, vector<int> &vSegs )
+{
+	vSegs.clear();
+	int nStep = GetHitStep(plotRect, xRange, yRange);
+	if(nStep <= 0)return false;
+	int nCount = GetDataCount();
+
+	m_HitGrid.QueryBox(point, rx, ry, vSegs);
+
+	// screen segment k is part of data segment k/nStep, the fill and closing segments are left out
+	int i, k, nOut = 0;
+	for(i=0; i<(int)vSegs.size(); i++)
+	{
+		if(vSegs[i] >= nPts - 1)break;
+		k = vSegs[i]/nStep - nDropPending;
+		if(k < 0)continue;
+		if(nOut > 0 && vSegs[nOut-1] == k)continue;
+		vSegs[nOut++] = k;
+	}
+	vSegs.resize(nOut);
+	// the points appended after the draw have no screen points yet
+	k = nScreenDatas - nDropPending - 1;
+	for(k = k<0 ? 0 : k; k < nCount-1; k++)
+	{
+		vSegs.push_back(k);
+	}
+	return true;
+}
+
+bool	CPlotDataImpl<DataPoint2D>::GetHitPoints( RECT plotRect, double *xRange, double *yRange, POINT point, long rx, long ry, vector<int> &vPoints )
+{
+	vPoints.clear();
+	int nStep = GetHitStep(plotRect, xRange, yRange);
+	if(nStep <= 0)return false;
+	int nCount = GetDataCount();
 
+	m_HitGrid.QueryPoints(point, rx, ry, vPoints);
+
+	// data point i is screen point i*nStep, the corners of the steps and the fill points are left out
+	int i, k, nOut = 0;
+	for(i=0; i<(int)vPoints.size(); i++)
+	{
+		if(vPoints[i] >= nPts)break;
+		if(vPoints[i] % nStep != 0)continue;
+		k = vPoints[i]/nStep - nDropPending;
+		if(k < 0)continue;
+		vPoints[nOut++] = k;
+	}
+	vPoints.resize(nOut);
+	// the points appended after the draw have no screen points yet
+	k = nScreenDatas - nDropPending;
+	for(k = k<0 ? 0 : k; k < nCount; k++)
+	{
+		vPoints.push_back(k);
+	}
 	return true;
 }
+
+int		CPlotDataImpl<DataPoint2D>::HitFillArea( POINT point )
+{
+	if(!UpdateHitGrid())return -1;
+	return m_HitGrid.IsInside(pPointsGdi, point) ? 1 : 0;
+}
 //void	MyDrawLineCrPtByPt(HDC hDC, int plottype, std::vector<COLORREF> vColor, int lineSize, int lineStyle, POINT *mypoints, int nPts);
 //void	MyDrawLineCrMulti(HDC hDC, CPlotImpl *pPlot, RECT plotRect, int xScale, int yScale, double *xRange, double *yRange, std::vector<SegmentColor> vSegColor, int nMultiColorInputType, int lineSize, int lineStyle, POINT *mypoints, int nPts);
 //void	MyDrawLineCrBi(HDC hDC, CPlotImpl *pPlot, RECT plotRect, int xScale, int yScale, double *xRange, double *yRange, double *xDataRange, double *yDataRange, COLORREF crDataColor1, COLORREF crDataColor2, int nMultiColorInputType, int lineSize, int lineStyle, POINT *mypoints, int nPts);
@@ -679,16 +971,21 @@ bool	CPlotDataImpl<DataPoint2D>::CreateScreenPoints( HDC hDC, RECT plotRect, dou
 //template<typename DataT>
 //void	CPlotDataImpl<DataT>::DrawCurveOnly( HDC hDC, RECT plotRect, double *xRange, double *yRange )
 void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( HDC hDC, RECT plotRect, double *xRange, double *yRange )
+{
+	CGdiSurface surface(hDC);
+	DrawCurveOnly(&surface, plotRect, xRange, yRange);
+}
+
+// The GDI+ styles are used only when the surface has a device context
+void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( CDrawSurface *pSurface, RECT plotRect, double *xRange, double *yRange )
 {
 	if(GetDataCount()<=0)return;
 	if(!m_bVisible)return;
 
-	int	i;//, j;
+	int	i, nStart, nLen, nBezier;
 
-	HPEN		hPen, hOldPen;
-
-	hPen = CreatePen( m_nPlotLineStyle, m_nPlotLineSize, m_crPlotColor );
-	hOldPen = (HPEN)SelectObject(hDC, hPen );
+	HDC hDC = pSurface->GetDC();
+	pSurface->SetPen( m_crPlotColor, m_nPlotLineSize, m_nPlotLineStyle );
 
 	// Draw the dataset
 	int plottype = m_nPlotType;
@@ -697,14 +994,14 @@ void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( HDC hDC, RECT plotRect, double *
 	{
 	case kXYPlotScatter:
 		//Only need draw markers, have already done
-		SelectObject(hDC,(HBRUSH)GetStockObject(NULL_BRUSH));
+		pSurface->SetNullBrush();
 		break;
 	case kXYPlotConnect:
 	case kXYPlotStepHV:
 	case kXYPlotStepVH:
 	case kXYPlotStepHVH:
 	case kXYPlotStepVHV:
-		if(!bCompactDraw && m_bColorPtByPt && m_vPointColors.size() == GetData().size())
+		if(hDC && !bCompactDraw && m_bColorPtByPt && (int)m_vPointColors.size() == GetDataCount())
 		{
 			MyDrawLineCrPtByPt(hDC, plottype, m_vPointColors, m_nPlotLineSize, m_nPlotLineStyle, pPointsGdi, nPts);
 /*			Graphics graph(hDC);
@@ -751,7 +1048,7 @@ void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( HDC hDC, RECT plotRect, double *
 				delete []points;
 			}*/
 		}
-		else if(!bCompactDraw && (m_bMultiColorMode && CheckSegColors()) )
+		else if(hDC && !bCompactDraw && (m_bMultiColorMode && CheckSegColors()) )
 		{
 			MyDrawLineCrMulti(hDC, ((CPlotImpl*)m_pPlot), plotRect, xScale, yScale, xRange, yRange, m_vSegColors, m_nMultiColorInputType, m_nPlotLineSize, m_nPlotLineStyle, pPointsGdi, nPts);
 /*			Graphics graph(hDC);
@@ -838,7 +1135,7 @@ void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( HDC hDC, RECT plotRect, double *
 			delete []colors;
 			delete []points;*/
 		}
-		else if(!bCompactDraw && m_bBiColorMode )
+		else if(hDC && !bCompactDraw && m_bBiColorMode )
 		{
 			MyDrawLineCrBi(hDC, ((CPlotImpl*)m_pPlot), plotRect, xScale, yScale, xRange, yRange, m_ppfDataRange[0], m_ppfDataRange[1], m_crDataColor, m_crDataColor2, m_nMultiColorInputType, m_nPlotLineSize, m_nPlotLineStyle, pPointsGdi, nPts);
 /*			Graphics graph(hDC);
@@ -915,13 +1212,19 @@ void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( HDC hDC, RECT plotRect, double *
 			delete []colors;
 			delete []points;*/
 		}
-		else if( !m_bForceGdiPlus && (m_nPlotLineSize == 1 || (m_nPlotLineSize != 1 && m_nPlotLineStyle == PS_SOLID)) ) 
+		else if( !hDC || (!m_bForceGdiPlus && (m_nPlotLineSize == 1 || (m_nPlotLineSize != 1 && m_nPlotLineStyle == PS_SOLID))) ) 
 		{
-			if(nPts>1)Polyline(hDC, pPointsGdi, nPts);
+			for(nStart = 0; (nLen = NextScreenRun(pPointsGdi, nPts, nStart)) > 0; nStart += nLen)
+			{
+				pSurface->DrawPolyline(pPointsGdi + nStart, nLen);
+			}
 		}
 		else
 		{
-			MyDrawPolyline(hDC, m_crPlotColor, m_nPlotLineSize, m_nPlotLineStyle, (Point *)pPointsGdi, nPts, m_bAutoSmooth);
+			for(nStart = 0; (nLen = NextScreenRun(pPointsGdi, nPts, nStart)) > 0; nStart += nLen)
+			{
+				MyDrawPolyline(hDC, m_crPlotColor, m_nPlotLineSize, m_nPlotLineStyle, (Point *)(pPointsGdi + nStart), nLen, m_bAutoSmooth);
+			}
 /*			Graphics graph(hDC);
 			graph.SetSmoothingMode(SmoothingModeHighQuality);
 			
@@ -950,13 +1253,25 @@ void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( HDC hDC, RECT plotRect, double *
 		
 		break;
 	case kXYPlotBezier:
-		if(m_nPlotLineSize == 1)
+		// each run takes the whole curves it holds, the points left over are joined by lines
+		for(nStart = 0; (nLen = NextScreenRun(pPointsGdi, nPts, nStart)) > 0; nStart += nLen)
 		{
-			PolyBezier(hDC, pPointsGdi, nPts);
+			nBezier = nLen >= 4 ? (nLen-1)/3*3+1 : 1;
+			if(nBezier > 1)
+			{
+				if(!hDC || m_nPlotLineSize == 1)
+					pSurface->DrawBeziers(pPointsGdi + nStart, nBezier);
+				else
+					MyDrawBeziers(hDC, m_crPlotColor, m_nPlotLineSize, m_nPlotLineStyle, (Point *)(pPointsGdi + nStart), nBezier);
+			}
+			if(nBezier < nLen)
+			{
+				if(!hDC || m_nPlotLineSize == 1)
+					pSurface->DrawPolyline(pPointsGdi + nStart + nBezier - 1, nLen - nBezier + 1);
+				else
+					MyDrawPolyline(hDC, m_crPlotColor, m_nPlotLineSize, m_nPlotLineStyle, (Point *)(pPointsGdi + nStart + nBezier - 1), nLen - nBezier + 1, false);
+			}
 		}
-		else
-		{
-			MyDrawBeziers(hDC, m_crPlotColor, m_nPlotLineSize, m_nPlotLineStyle, (Point *)pPointsGdi, nPts);
 /*			Graphics graph(hDC);
 			graph.SetSmoothingMode(SmoothingModeHighQuality);
 			
@@ -973,7 +1288,6 @@ void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( HDC hDC, RECT plotRect, double *
 			graph.DrawBeziers(&pen, points, nPts);
 			delete []points;
 			//graph.ReleaseHDC(hDC);*/
-		}
 		
 		break;
 	case kXYPlotBar:
@@ -981,32 +1295,36 @@ void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( HDC hDC, RECT plotRect, double *
 		DWORD *npts;
 		pts = new POINT[2*nPts];
 		npts = new DWORD[nPts];
+		// the bars of the gap points are left out
+		nLen = 0;
 		for(i=0; i<nPts; i++)
 		{
-			npts[i] = 2;
+			if(IsScreenGap(pPointsGdi[i]))continue;
+			npts[nLen] = 2;
 			switch(m_nBarMode)
 			{
 			case kBarFromBottom:
-				pts[2*i].x = pPointsGdi[i].x;
-				pts[2*i].y = plotRect.bottom;
+				pts[2*nLen].x = pPointsGdi[i].x;
+				pts[2*nLen].y = plotRect.bottom;
 				break;
 			case kBarFromTop:
-				pts[2*i].x = pPointsGdi[i].x;
-				pts[2*i].y = plotRect.top;
+				pts[2*nLen].x = pPointsGdi[i].x;
+				pts[2*nLen].y = plotRect.top;
 				break;
 			case kBarFromLeft:
-				pts[2*i].x = plotRect.left;
-				pts[2*i].y = pPointsGdi[i].y;
+				pts[2*nLen].x = plotRect.left;
+				pts[2*nLen].y = pPointsGdi[i].y;
 				break;
 			case kBarFromRight:
-				pts[2*i].x = plotRect.right;
-				pts[2*i].y = pPointsGdi[i].y;
+				pts[2*nLen].x = plotRect.right;
+				pts[2*nLen].y = pPointsGdi[i].y;
 				break;
 			}
-			pts[2*i+1].x = pPointsGdi[i].x;
-			pts[2*i+1].y = pPointsGdi[i].y;
+			pts[2*nLen+1].x = pPointsGdi[i].x;
+			pts[2*nLen+1].y = pPointsGdi[i].y;
+			nLen++;
 		}
-		PolyPolyline(hDC, pts, npts, nPts);
+		if(nLen > 0)pSurface->DrawPolyPolyline(pts, npts, nLen);
 		
 		delete []npts;
 		delete []pts;
@@ -1015,9 +1333,6 @@ void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( HDC hDC, RECT plotRect, double *
 	default:
 		break;
 	}
-	
-	SelectObject( hDC,hOldPen );
-	DeleteObject(hPen);
 }
 
 void	CPlotDataImpl<DataPoint2D>::DrawSegHided( HDC hDC, RECT plotRect, double *xRange, double *yRange )
@@ -1044,6 +1359,7 @@ void	CPlotDataImpl<DataPoint2D>::DrawSegHided( HDC hDC, RECT plotRect, double *x
 
 		pt1 = (pPointsGdi)[index];
 		pt2 = (pPointsGdi)[index+1];
+		if(IsScreenGap(pt1) || IsScreenGap(pt2))continue;
 		MoveToEx(hDC, pt1.x, pt1.y, NULL);
 		LineTo(hDC, pt2.x, pt2.y);
 	}
@@ -1111,9 +1427,9 @@ void	CPlotDataImpl<DataPoint2D>::DrawPlotDataInfo(HDC hDC, RECT plotRect, double
 	
 	if(idxPtInfo>=GetDataCount())idxPtInfo%=GetDataCount();
 	
-	myX = GetData()[idxPtInfo].val[0];
+	myX = GetDataAt(idxPtInfo).val[0];
 	if(bXLog)myX = log10(myX);
-	myY = GetData()[idxPtInfo].val[1];
+	myY = GetDataAt(idxPtInfo).val[1];
 	if(bYLog)myY = log10(myY);
 	
 	if(!((CPlotImpl*)m_pPlot)->IsXOpposite())
@@ -1139,44 +1455,85 @@ void	CPlotDataImpl<DataPoint2D>::DrawPlotDataInfo(HDC hDC, RECT plotRect, double
 	DeleteObject(hFont);
 }
 
-//template<typename DataT>
-//void	CPlotDataImpl<DataT>::DrawPlotData(HDC hDC, RECT plotRect, double *xRange, double *yRange)
-void	CPlotDataImpl<DataPoint2D>::DrawPlotData(HDC hDC, RECT plotRect, double *xRange, double *yRange)
+// Compact data and screen points of the ranges, shared by all draw paths
+bool	CPlotDataImpl<DataPoint2D>::PrepareScreenPoints( RECT plotRect, double *xRange, double *yRange )
 {
-	if(GetDataCount()<=0)return;
-	if(!m_bVisible)return;
-	
 	xScale = ((double)Width(plotRect))/(xRange[1] - xRange[0]);
 	yScale = ((double)Height(plotRect))/(yRange[1] - yRange[0]);
 	
-	if(bCompactDraw && !IsClipData())
+	if(bCompactDraw && !IsClipData() && !bDrawDataExternal)
 	{
 		if( vDrawData.size()<=0 ||
 			vDrawData.size()!=nDrawDataOldSize ||
 			nDatas != GetDataCount() ||
 			bDrawDataChanged ||
-			bDragMoved )
+			bDragMoved ||
+			bForceUpdate ||
+			!EqualRect(&plotRect, &rctOldPlot) ||
+			memcmp(xRange, pfOldRange[0], 2*sizeof(double)) != 0 ||
+			memcmp(yRange, pfOldRange[1], 2*sizeof(double)) != 0 )
 		{
+			// the columns depend on the ranges and the plot size
 			CreateCompactData(plotRect, xRange, yRange);
+			nDrawDataOldSize = (int)vDrawData.size();
+			bDrawDataChanged = false;
+			bForceUpdate = true;
 		}
 	}
 	
-	if(IsDataScaleNeeded(plotRect, xRange, yRange))
+	CDrawStats *pStats = ((CPlotImpl*)m_pPlot)->GetDrawStats();
+	if(!IsDataScaleNeeded(plotRect, xRange, yRange))
+	{
+		DRAW_STATS_COUNT(pStats, kDrawCountScreenHits, 1);
+	}
+	else if(ExtendScreenPoints(plotRect, xRange, yRange))
 	{
-		if(!CreateScreenPoints(hDC, plotRect, xRange, yRange, &pPointsGdi, nPts, nPts4Fill))
+		DRAW_STATS_COUNT(pStats, kDrawCountScreenExtends, 1);
+	}
+	else
+	{
+		DRAW_STATS_COUNT(pStats, kDrawCountScreenMisses, 1);
+		if(!CreateScreenPoints(0, plotRect, xRange, yRange, &pPointsGdi, nPts, nPts4Fill))
 		{
-			return;
+			return false;
 		}
 	}
 	
 	nDatas = GetDataCount();
+	return true;
+}
+
+void	CPlotDataImpl<DataPoint2D>::DrawCurve(CDrawSurface *pSurface, RECT plotRect, double *xRange, double *yRange)
+{
+	if(GetDataCount()<=0)return;
+	if(!m_bVisible)return;
+
+	if(!PrepareScreenPoints(plotRect, xRange, yRange))return;
+	DrawCurveOnly(pSurface, plotRect, xRange, yRange);
+}
+
+//template<typename DataT>
+//void	CPlotDataImpl<DataT>::DrawPlotData(HDC hDC, RECT plotRect, double *xRange, double *yRange)
+void	CPlotDataImpl<DataPoint2D>::DrawPlotData(HDC hDC, RECT plotRect, double *xRange, double *yRange)
+{
+	if(GetDataCount()<=0)return;
+	if(!m_bVisible)return;
+	
+	CDrawStats *pStats = ((CPlotImpl*)m_pPlot)->GetDrawStats();
+	DRAW_STATS_COUNT(pStats, kDrawCountPoints, GetDataCount());
+	DRAW_STATS_BEGIN(pStats, kDrawPhaseScreenPoints);
+	bool bPrepared = PrepareScreenPoints(plotRect, xRange, yRange);
+	DRAW_STATS_END(pStats, kDrawPhaseScreenPoints);
+	if(!bPrepared)return;
 	
 	int nROP2;
 	if(m_bSegHideMode)
 	{
 		nROP2 = SetROP2(hDC, R2_NOTXORPEN);
 	}
+	DRAW_STATS_BEGIN(pStats, kDrawPhaseCurves);
 	DrawCurveOnly(hDC, plotRect, xRange, yRange );
+	DRAW_STATS_END(pStats, kDrawPhaseCurves);
 	if(m_bSegHideMode)
 	{
 		DrawSegHided(hDC, plotRect, xRange, yRange);
@@ -1213,7 +1570,9 @@ void	CPlotDataImpl<DataPoint2D>::DrawPlotData(HDC hDC, RECT plotRect, double *xR
 	}
 	if(m_bMarkerShow)
 	{
+		DRAW_STATS_BEGIN(pStats, kDrawPhaseMarkers);
 		DrawMarkers(hDC, plotRect, xRange, yRange);
+		DRAW_STATS_END(pStats, kDrawPhaseMarkers);
 	}
 	if(GetDataSet()->IsPointSelectionMode())
 	{
@@ -29,6 +29,10 @@
 #include "PlotDataHistoImpl.h"
 #include "PlotDataPointInfoImpl.h"
 #include "PlotDataSpanImpl.h"
+#include "DrawSurface.h"
+#include "ScreenTransform.h"
+#include "ScreenHitGrid.h"
+#include "IngestQueue.h"
 
 //#include "DataSet.h"
 
@@ -60,7 +64,16 @@ protected:
 	CDataSet<DataT>	*m_pDataSet;
 
 	vector<AdjustDataRange*>	m_vFcnAdjustDataRange;
+
+	// The hit grid is built from the screen points on the first hit test after they change
+	CScreenHitGrid	m_HitGrid;
+	int		m_nScreenStamp, m_nHitGridStamp;
+
+	// Optional lock free staging of samples from a producer thread, drained by the data set
+	CIngestQueue<DataT>	*m_pIngestQueue;
 public:
+	inline	CIngestQueue<DataT>	*GetIngestQueue(){return m_pIngestQueue;}
+	inline	void		SetIngestQueue(CIngestQueue<DataT> *pQueue){m_pIngestQueue = pQueue;}
 	inline	CPlotBasicImpl	*GetPlot(){return m_pPlot;}
 	inline	CDataSet<DataT>	*GetDataSet(){return m_pDataSet;}
 	inline	void		SetDataSet(CDataSet<DataT> *pDataSet){m_pDataSet = pDataSet;}
@@ -75,15 +88,44 @@ protected:
 //the following functions are for 2D only
 protected:
 	int		CreateCompactData(RECT plotRect, double *xRange, double *yRange);
+	long	GetCompactColumn(double x, RECT plotRect, double *xRange);
+	int		FindCompactEdge(RECT plotRect, double *xRange, bool bStart);
+	void	CreateCompactDataM4(RECT plotRect, double *xRange, int iStart, int iEnd);
+	void	CreateCompactDataLTTB(RECT plotRect, double *xRange, double *yRange, int iStart, int iEnd);
+	void	CreateCompactDataAverage(RECT plotRect, double *xRange, int iStart, int iEnd);
 	bool	IsDataScaleNeeded(RECT plotRect, double *xRange, double *yRange);
+	int		GetScreenAxisFlags();
+	void	ReserveScreenPoints( int nCount, bool bKeep );
+	bool	ExtendScreenPoints( RECT plotRect, double *xRange, double *yRange );
 	bool	CreateScreenPoints( HDC hDC, RECT plotRect, double *xRange, double *yRange, POINT **myPoints, int &nPts, int &nPts4Fill );
+	bool	PrepareScreenPoints( RECT plotRect, double *xRange, double *yRange );
+	bool	UpdateHitGrid();
+	// Screen points drawn for each data point if the hit grid fits the data and these ranges, else 0
+	int		GetHitStep( RECT plotRect, double *xRange, double *yRange );
 
 	void	DrawCurveOnly( HDC hDC, RECT plotRect, double *xRange, double *yRange );
+	void	DrawCurveOnly( CDrawSurface *pSurface, RECT plotRect, double *xRange, double *yRange );
 	void	DrawSegHided( HDC hDC, RECT plotRect, double *xRange, double *yRange );
 	void	DrawPlotDataInfo(HDC hDC, RECT plotRect, double *xRange, double *yRange );
 
 public:
 	void	DrawPlotData(HDC hDC, RECT plotRect, double *xRange, double *yRange);
+	// The curve alone, without markers, fills or infos, needs no device context
+	void	DrawCurve(CDrawSurface *pSurface, RECT plotRect, double *xRange, double *yRange);
+
+	// bRound adds the half pixel of the curve points
+	void	GetScreenAxisMaps( RECT plotRect, double *xRange, double *yRange, bool bRound, ScreenAxisMap &xMap, ScreenAxisMap &yMap );
+	// Screen points of nCount data points from nStart, by the batch kernels
+	void	DataToScreenPoints( const ScreenAxisMap &xMap, const ScreenAxisMap &yMap, int nStart, int nCount, POINT *pPoints );
+
+	// Hit testing on the screen points of the last draw.
+	// The data segments [i, i+1] drawn within rx, ry pixels of the point, ascending, plus those appended since.
+	// Returns false if the screen points do not match the data and the ranges, all segments must be checked then
+	bool	GetHitSegments( RECT plotRect, double *xRange, double *yRange, POINT point, long rx, long ry, vector<int> &vSegs );
+	// The data points drawn within rx, ry pixels of the point, ascending, plus those appended since
+	bool	GetHitPoints( RECT plotRect, double *xRange, double *yRange, POINT point, long rx, long ry, vector<int> &vPoints );
+	// 1 if the point is in the fill area of the last draw, 0 if not, -1 if nothing is drawn
+	int		HitFillArea( POINT point );
 };
 
 template<typename DataT>
@@ -91,12 +133,15 @@ CPlotDataImpl<DataT>::CPlotDataImpl(CPlotBasicImpl *pT)
 {
 	m_pPlot = pT;
 	m_pDataSet = 0;
+	m_nScreenStamp = 0;
+	m_nHitGridStamp = -1;
+	m_pIngestQueue = 0;
 }
 
 template<typename DataT>
 CPlotDataImpl<DataT>::~CPlotDataImpl()
 {
-	
+	if(m_pIngestQueue)delete m_pIngestQueue;
 }
 
 template<typename DataT>
@@ -122,29 +167,65 @@ void	CPlotDataImpl<DataT>::GetDataRange(int whichDim)
 	int nDataDim = sizeof(DataT)/sizeof(double);
 	if(whichDim<0 || whichDim>=nDataDim)return;
 
-	int			j;
+	int			j, nMin = 0, nMax = 0;
 	double		minV, maxV;
 	double		lb = 0.0, ub = 0.0;
 	vector<double> vVal;
+	vector<double> *pvVal = &vVal;
 
 	minV = fMaxVal;
 	maxV = -fMaxVal;
 
-	for( j = 0; j < GetDataCount(); j++)
+	// the values are only gathered for the range adjusters
+	bool bAdjust = m_vFcnAdjustDataRange.size()>0 || (whichDim == 1 && IsErrorBarMode());
+	int nCount = GetDataCount();
+
+	if(whichDim == 0 && !bAdjust && nCount > 0 && IsXMonotonic())
+	{
+		minV = GetDataAt(0).val[0];
+		maxV = GetDataAt(nCount-1).val[0];
+	}
+	else if(IsColumnar())
+	{
+		// contiguous values, no stride over the other dimensions
+		GetColumn(whichDim);
+		pvVal = &m_pvColumn[whichDim];
+		nCount = (int)pvVal->size();
+		const double *pVal = nCount>0?&(*pvVal)[0]:0;
+		for( j = 0; j < nCount; j++)
+		{
+			if( pVal[j] < minV ){ minV = pVal[j]; nMin = 1; }
+			else if( pVal[j] == minV ) nMin++;
+			if( pVal[j] > maxV ){ maxV = pVal[j]; nMax = 1; }
+			else if( pVal[j] == maxV ) nMax++;
+		}
+	}
+	else
 	{
-		if( (*m_pvData)[j].val[whichDim] < minV ) minV = (*m_pvData)[j].val[whichDim];
-		if( (*m_pvData)[j].val[whichDim] > maxV ) maxV = (*m_pvData)[j].val[whichDim];
+		if(bAdjust)vVal.reserve(nCount);
+		for( j = 0; j < nCount; j++)
+		{
+			const DataT &data = GetDataAt(j);
+			if( data.val[whichDim] < minV ){ minV = data.val[whichDim]; nMin = 1; }
+			else if( data.val[whichDim] == minV ) nMin++;
+			if( data.val[whichDim] > maxV ){ maxV = data.val[whichDim]; nMax = 1; }
+			else if( data.val[whichDim] == maxV ) nMax++;
 
-		vVal.push_back((*m_pvData)[j].val[whichDim]);
+			if(bAdjust)vVal.push_back(data.val[whichDim]);
+		}
 	}
 	m_ppfDataRange[whichDim][0] = minV;
 	m_ppfDataRange[whichDim][1] = maxV;
+	// an adjusted range has no count, removing a point near its ends finds it again
+	m_ppnExtremeCount[whichDim][0] = bAdjust?0:nMin;
+	m_ppnExtremeCount[whichDim][1] = bAdjust?0:nMax;
+	m_nDataRangeStamp = NewDataRangeStamp();
 	
 	for(j=0; j<(int)m_vFcnAdjustDataRange.size(); j++)
 	{
-		if(m_vFcnAdjustDataRange[j])m_vFcnAdjustDataRange[j](whichDim, vVal, m_ppfDataRange[whichDim]);
+		if(m_vFcnAdjustDataRange[j])m_vFcnAdjustDataRange[j](whichDim, *pvVal, m_ppfDataRange[whichDim]);
 	}
-	MyAdjustDataErrorBar(whichDim, vVal, m_ppfDataRange[whichDim]);//ʱѺΪָpushȥͳ
+	MyAdjustDataErrorBar(whichDim, *pvVal, m_ppfDataRange[whichDim]);//ʱѺΪָpushȥͳ
 }
 
 template<typename DataT>
@@ -153,42 +234,63 @@ bool	CPlotDataImpl<DataT>::CreateClipData(int whichDim, double *range)
 //	int nDataDim = sizeof(DataT)/sizeof(double);
 	if(whichDim<0 || whichDim>=sizeof(DataT)/sizeof(double))return false;
 
-	if(!m_bSorted)
+	// nothing is sorted again unless the order is unknown, appended points are merged in
+	switch(whichDim)
 	{
-		switch(whichDim)
-		{
-		case 0:
-			m_nSortType = kSortXInc;
-			break;
-		case 1:
-			m_nSortType = kSortYInc;
-			break;
-		case 2:
-			m_nSortType = kSortZInc;
-			break;
-		default:
-			m_nSortType = kSortXInc;
-		}
-		SortData();
-		m_bSorted = true;
+	case 1:
+		SortData(kSortYInc);
+		break;
+	case 2:
+		SortData(kSortZInc);
+		break;
+	default:
+		SortData(kSortXInc);
 	}
 	int i, i1, i2;
 	i1 = (int)m_pvData->size();
 	i2 = -1;
-	for(i=0; i<(int)m_pvData->size(); i++)
+	if(whichDim == 0 && IsXMonotonic())
+	{
+		i1 = LowerBound(0, range[0]);
+		i2 = UpperBound(0, range[1]) - 1;
+	}
+	else if(IsColumnar())
 	{
-		if((*m_pvData)[i].val[whichDim]>=range[0])
+		const vector<double> &vCol = GetColumn(whichDim);
+		for(i=0; i<(int)vCol.size(); i++)
 		{
-			i1 = i;
-			break;
+			if(vCol[i]>=range[0])
+			{
+				i1 = i;
+				break;
+			}
+		}
+		for(i=(int)vCol.size()-1; i>=0; i--)
+		{
+			if(vCol[i]<=range[1])
+			{
+				i2 = i;
+				break;
+			}
 		}
 	}
-	for(i=(int)m_pvData->size()-1; i>=0; i--)
+	else
 	{
-		if((*m_pvData)[i].val[whichDim]<=range[1])
+		for(i=0; i<(int)m_pvData->size(); i++)
+		{
+			if(GetDataAt(i).val[whichDim]>=range[0])
+			{
+				i1 = i;
+				break;
+			}
+		}
+		for(i=(int)m_pvData->size()-1; i>=0; i--)
 		{
-			i2 = i;
-			break;
+			if(GetDataAt(i).val[whichDim]<=range[1])
+			{
+				i2 = i;
+				break;
+			}
 		}
 	}
 	if(i1 == m_pvData->size() || i2 == -1 )
@@ -210,7 +312,7 @@ bool	CPlotDataImpl<DataT>::CreateClipData(int whichDim, double *range)
 	vDrawData.clear();
 	for(i=i1; i<=i2; i++)
 	{
-		vDrawData.push_back((*m_pvData)[i]);
+		vDrawData.push_back(GetDataAt(i));
 	}
 	return true;
 }
@@ -218,14 +320,30 @@ bool	CPlotDataImpl<DataT>::CreateClipData(int whichDim, double *range)
 //template<typename DataT>
 //int	CPlotDataImpl<DataT>::CreateCompactData(RECT plotRect, double *xRange, double *yRange);
 int	CPlotDataImpl<DataPoint2D>::CreateCompactData(RECT plotRect, double *xRange, double *yRange);
+long	CPlotDataImpl<DataPoint2D>::GetCompactColumn(double x, RECT plotRect, double *xRange);
+int		CPlotDataImpl<DataPoint2D>::FindCompactEdge(RECT plotRect, double *xRange, bool bStart);
+void	CPlotDataImpl<DataPoint2D>::CreateCompactDataM4(RECT plotRect, double *xRange, int iStart, int iEnd);
+void	CPlotDataImpl<DataPoint2D>::CreateCompactDataLTTB(RECT plotRect, double *xRange, double *yRange, int iStart, int iEnd);
+void	CPlotDataImpl<DataPoint2D>::CreateCompactDataAverage(RECT plotRect, double *xRange, int iStart, int iEnd);
 
 //template<typename DataT>
 //bool	CPlotDataImpl<DataT>::IsDataScaleNeeded(RECT plotRect, double *xRange, double *yRange);
 bool	CPlotDataImpl<DataPoint2D>::IsDataScaleNeeded(RECT plotRect, double *xRange, double *yRange);
+int		CPlotDataImpl<DataPoint2D>::GetScreenAxisFlags();
+void	CPlotDataImpl<DataPoint2D>::GetScreenAxisMaps( RECT plotRect, double *xRange, double *yRange, bool bRound, ScreenAxisMap &xMap, ScreenAxisMap &yMap );
+void	CPlotDataImpl<DataPoint2D>::DataToScreenPoints( const ScreenAxisMap &xMap, const ScreenAxisMap &yMap, int nStart, int nCount, POINT *pPoints );
+void	CPlotDataImpl<DataPoint2D>::ReserveScreenPoints( int nCount, bool bKeep );
+bool	CPlotDataImpl<DataPoint2D>::ExtendScreenPoints( RECT plotRect, double *xRange, double *yRange );
+bool	CPlotDataImpl<DataPoint2D>::UpdateHitGrid();
+int		CPlotDataImpl<DataPoint2D>::GetHitStep( RECT plotRect, double *xRange, double *yRange );
+bool	CPlotDataImpl<DataPoint2D>::GetHitSegments( RECT plotRect, double *xRange, double *yRange, POINT point, long rx, long ry, vector<int> &vSegs );
+bool	CPlotDataImpl<DataPoint2D>::GetHitPoints( RECT plotRect, double *xRange, double *yRange, POINT point, long rx, long ry, vector<int> &vPoints );
+int		CPlotDataImpl<DataPoint2D>::HitFillArea( POINT point );
 
 //template<typename DataT>
 //bool	CPlotDataImpl<DataT>::CreateScreenPoints( HDC hDC, RECT plotRect, double *xRange, double *yRange, POINT **myPoints, int &nPts, int &nPts4Fill );
 bool	CPlotDataImpl<DataPoint2D>::CreateScreenPoints( HDC hDC, RECT plotRect, double *xRange, double *yRange, POINT **myPoints, int &nPts, int &nPts4Fill );
+bool	CPlotDataImpl<DataPoint2D>::PrepareScreenPoints( RECT plotRect, double *xRange, double *yRange );
 
 //void	MyDrawLineCrPtByPt(HDC hDC, int plottype, std::vector<COLORREF> vColor, int lineSize, int lineStyle, POINT *mypoints, int nPts);
 //void	MyDrawLineCrMulti(HDC hDC, CPlotImpl *pPlot, RECT plotRect, int xScale, int yScale, double *xRange, double *yRange, std::vector<SegmentColor> vSegColor, int nMultiColorInputType, int lineSize, int lineStyle, POINT *mypoints, int nPts);
@@ -236,6 +354,7 @@ bool	CPlotDataImpl<DataPoint2D>::CreateScreenPoints( HDC hDC, RECT plotRect, dou
 //template<typename DataT>
 //void	CPlotDataImpl<DataT>::DrawCurveOnly( HDC hDC, RECT plotRect, double *xRange, double *yRange );
 void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( HDC hDC, RECT plotRect, double *xRange, double *yRange );
+void	CPlotDataImpl<DataPoint2D>::DrawCurveOnly( CDrawSurface *pSurface, RECT plotRect, double *xRange, double *yRange );
 
 //template<typename DataT>
 //void	CPlotDataImpl<DataT>::DrawSegHided( HDC hDC, RECT plotRect, double *xRange, double *yRange );
@@ -248,5 +367,6 @@ void	CPlotDataImpl<DataPoint2D>::DrawPlotDataInfo(HDC hDC, RECT plotRect, double
 //template<typename DataT>
 //void	CPlotDataImpl<DataT>::DrawPlotData(HDC hDC, RECT plotRect, double *xRange, double *yRange);
 void	CPlotDataImpl<DataPoint2D>::DrawPlotData(HDC hDC, RECT plotRect, double *xRange, double *yRange);
+void	CPlotDataImpl<DataPoint2D>::DrawCurve(CDrawSurface *pSurface, RECT plotRect, double *xRange, double *yRange);
 
 Declare_Namespace_End
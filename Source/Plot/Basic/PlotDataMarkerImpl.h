@@ -20,6 +20,7 @@
 #pragma once
 
 #include "PlotDataMarker.h"
+#include "ScreenTransform.h"
 
 Declare_Namespace_CChart
 
@@ -54,36 +55,23 @@ void	CPlotDataMarkerImpl<PlotDataT>::DrawMarkers(HDC hDC, RECT plotRect, double
 {
 	PlotDataT* pT = static_cast<PlotDataT*>(this);
 
-	int j;
+	int i, j, nLen;
 
-	double		myX, myY;
-	bool		bXLog, bYLog;
-	bXLog = ((CPlotImpl*)pT->GetPlot())->IsXLogarithm();
-	bYLog = ((CPlotImpl*)pT->GetPlot())->IsYLogarithm();
+	ScreenAxisMap	xMap, yMap;
+	pT->GetScreenAxisMaps(plotRect, xRange, yRange, true, xMap, yMap);
 
-	POINT point;
-
-	//xScale = ((double)Width(plotRect))/(xRange[1] - xRange[0]);
-	//yScale = ((double)Height(plotRect))/(yRange[1] - yRange[0]);
-	double		xScale = pT->xScale;
-	double		yScale = pT->yScale;
-
-	for( j = 0; j < pT->GetDataCount(); j++ )
+	// the points are transformed a block at a time
+	const int	nBlock = 256;
+	POINT		pPoints[nBlock];
+	int			nCount = pT->GetDataCount();
+	for( j = 0; j < nCount; j += nBlock )
 	{
-		myX = pT->GetData()[j].val[0];
-		if(bXLog)myX = log10(myX);
-		myY = pT->GetData()[j].val[1];
-		if(bYLog)myY = log10(myY);
-		
-		if(!((CPlotImpl*)pT->GetPlot())->IsXOpposite())
-			point.x = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-		else
-			point.x = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
-		if(!((CPlotImpl*)pT->GetPlot())->IsYOpposite())
-			point.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]) + 0.5);
-		else
-			point.y = (long)(plotRect.top + yScale * (myY-yRange[0]) + 0.5);
-		DrawSingleMarker( hDC, point, j, false);
+		nLen = (nCount - j < nBlock) ? nCount - j : nBlock;
+		pT->DataToScreenPoints(xMap, yMap, j, nLen, pPoints);
+		for( i = 0; i < nLen; i++ )
+		{
+			DrawSingleMarker( hDC, pPoints[i], j+i, false);
+		}
 	}
 
 	if(m_bMarkFirstPoint)
@@ -135,31 +123,11 @@ void	CPlotDataMarkerImpl<PlotDataT>::DrawSolelyMarker( HDC hDC, RECT plotRect, d
 	if(!pT->IsVisible())return;
 	if(whichPoint<0 || whichPoint>=pT->GetDataCount())return;
 
-	double		myX, myY;
-	bool		bXLog, bYLog;
-	bXLog = ((CPlotImpl*)pT->GetPlot())->IsXLogarithm();
-	bYLog = ((CPlotImpl*)pT->GetPlot())->IsYLogarithm();
+	ScreenAxisMap	xMap, yMap;
+	pT->GetScreenAxisMaps(plotRect, xRange, yRange, true, xMap, yMap);
 	
 	POINT point;
-	
-	//xScale = ((double)Width(plotRect))/(xRange[1] - xRange[0]);
-	//yScale = ((double)Height(plotRect))/(yRange[1] - yRange[0]);
-	double		xScale = pT->xScale;
-	double		yScale = pT->yScale;
-	
-	myX = pT->GetData()[whichPoint].val[0];
-	if(bXLog)myX = log10(myX);
-	myY =pT->GetData()[whichPoint].val[1];
-	if(bYLog)myY = log10(myY);
-	
-	if(!((CPlotImpl*)pT->GetPlot())->IsXOpposite())
-		point.x = (long)(plotRect.left + xScale * (myX-xRange[0]) + 0.5);
-	else
-		point.x = (long)(plotRect.right - xScale * (myX-xRange[0]) + 0.5);
-	if(!((CPlotImpl*)pT->GetPlot())->IsYOpposite())
-		point.y = (long)(plotRect.bottom - yScale * (myY-yRange[0]) + 0.5);
-	else
-		point.y = (long)(plotRect.top + yScale * (myY-yRange[0]) + 0.5);
+	pT->DataToScreenPoints(xMap, yMap, whichPoint, 1, &point);
 	DrawSingleMarker( hDC, point, whichPoint, true);
 }
 
@@ -177,6 +145,7 @@ void	CPlotDataMarkerImpl<PlotDataT>::DrawSingleMarker( HDC hDC, POINT point, int
 	POINT		startPoint, startLocation;
 
 	if( m_nMarkerType == kXYMarkerNone ) return;
+	if( IsScreenGap(point) ) return;
 
 	if(bForce) goto NeedDrawMarker;
 
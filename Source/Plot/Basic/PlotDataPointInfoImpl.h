@@ -69,9 +69,9 @@ void	CPlotDataPointInfoImpl<PlotDataT>::DrawDataPointInfo( HDC hDC, RECT plotRec
 	
 	for( j = 0; j < pT->GetDataCount(); j++ )
 	{
-		myX = pT->GetData()[j].val[0];
+		myX = pT->GetDataAt(j).val[0];
 		if(bXLog)myX = log10(myX);
-		myY = pT->GetData()[j].val[1];
+		myY = pT->GetDataAt(j).val[1];
 		if(bYLog)myY = log10(myY);
 		
 		if(!((CPlotImpl*)pT->GetPlot())->IsXOpposite())
@@ -138,15 +138,15 @@ NeedDrawDataPointInfo:
 	switch(m_nDataPointInfoType)
 	{
 	case kShowDataPointInfoX:
-		tostr<<pT->GetData()[whichPoint].val[0];
+		tostr<<pT->GetDataAt(whichPoint).val[0];
 		tstr = tostr.str();
 		break;
 	case kShowDataPointInfoY:
-		tostr<<pT->GetData()[whichPoint].val[1];
+		tostr<<pT->GetDataAt(whichPoint).val[1];
 		tstr = tostr.str();
 		break;
 	case kShowDataPointInfoXY:
-		tostr<<pT->GetData()[whichPoint].val[0]<<_TEXT("/")<<pT->GetData()[whichPoint].val[1];
+		tostr<<pT->GetDataAt(whichPoint).val[0]<<_TEXT("/")<<pT->GetDataAt(whichPoint).val[1];
 		tstr = tostr.str();
 		break;
 	default:
@@ -19,6 +19,7 @@
 
 #pragma once
 #include "PlotDataSpan.h"
+#include "ScreenTransform.h"
 #include <float.h>
 
 Declare_Namespace_CChart
@@ -61,6 +62,7 @@ void	CPlotDataSpanImpl<PlotDataT>::DrawDataSpan( HDC hDC, RECT plotRect, double
 	int i;
 	for(i=0; i<pT->nPts-1; i++)
 	{
+		if(IsScreenGap(pT->pPointsGdi[i]) || IsScreenGap(pT->pPointsGdi[i+1]))continue;
 		if(!m_bSpanHorizontal)if( fabs( double(pT->pPointsGdi[i].x - pT->pPointsGdi[i+1].x) )<DBL_EPSILON )continue;
 		else if( fabs( double(pT->pPointsGdi[i].y - pT->pPointsGdi[i+1].y) )<DBL_EPSILON )continue;
 
@@ -19,6 +19,7 @@
 
 #include "PlotImpl.h"
 #include "Global.h"
+#include "ScreenTransform.h"
 #include "../Resources/PlotResources.h"
 
 using namespace NsCChart;
@@ -58,19 +59,45 @@ RECT	CPlotImpl::GetPlotRect( HDC hDC, RECT clientRect )
 
 	if(m_bNothingElse)
 	{
-		if(m_bEqualXYAxis)
-		{
-			SquareRect(plotRect);
-		}
-		else if(m_bEqualXYScale )
-		{
-			double xRange[2], yRange[2];
-			GetRange(xRange, yRange);
-			ScaleRect(plotRect, xRange[0], xRange[1], yRange[0], yRange[1]);
-		}
+		AdjustByEqualAxes(plotRect);
+		return plotRect;
+	}
+
+	plotRect = AdjustByMargins(plotRect);
+	plotRect = AdjustByTitle(hDC, plotRect);
+	plotRect = AdjustByAxes(hDC, clientRect, plotRect);
+	plotRect = AdjustPlotSizeForHeadernote(hDC, plotRect);
+	plotRect = AdjustPlotSizeForFootnote(hDC, plotRect);
+	plotRect = AddtionalPlotRectAdjust(hDC, plotRect);
+
+	// Equal XY Axis
+	AdjustByEqualAxes(plotRect);
+
+	NormalizeRect(plotRect);
+	return plotRect;
+}
+
+// The title, the notes and the legend take no room here
+RECT	CPlotImpl::GetPlotRect( CDrawSurface *pSurface, RECT clientRect )
+{
+	RECT plotRect = clientRect;
+
+	if(m_bNothingElse)
+	{
+		AdjustByEqualAxes(plotRect);
 		return plotRect;
 	}
 
+	plotRect = AdjustByMargins(plotRect);
+	plotRect = AdjustByAxes(pSurface, clientRect, plotRect);
+	AdjustByEqualAxes(plotRect);
+
+	NormalizeRect(plotRect);
+	return plotRect;
+}
+
+RECT	CPlotImpl::AdjustByMargins( RECT plotRect )
+{
 	if(IsAxesVisible())
 	{
 		plotRect.left += m_nMarginLeft;
@@ -85,14 +112,11 @@ RECT	CPlotImpl::GetPlotRect( HDC hDC, RECT clientRect )
 		plotRect.top += max(m_nMarginTop, m_nMinMargin);
 		plotRect.bottom -= max(m_nMarginBottom, m_nMinMargin);
 	}
-	
-	plotRect = AdjustByTitle(hDC, plotRect);
-	plotRect = AdjustByAxes(hDC, clientRect, plotRect);
-	plotRect = AdjustPlotSizeForHeadernote(hDC, plotRect);
-	plotRect = AdjustPlotSizeForFootnote(hDC, plotRect);
-	plotRect = AddtionalPlotRectAdjust(hDC, plotRect);
+	return plotRect;
+}
 
-	// Equal XY Axis
+void	CPlotImpl::AdjustByEqualAxes( RECT &plotRect )
+{
 	if( m_bEqualXYAxis )
 	{
 		SquareRect(plotRect);
@@ -103,9 +127,6 @@ RECT	CPlotImpl::GetPlotRect( HDC hDC, RECT clientRect )
 		GetRange(xRange, yRange);
 		ScaleRect(plotRect, xRange[0], xRange[1], yRange[0], yRange[1]);
 	}
-
-	NormalizeRect(plotRect);
-	return plotRect;
 }
 
 RECT	CPlotImpl::AdjustTitleRect(HDC hDC, RECT titleRect)
@@ -180,7 +201,9 @@ void	CPlotImpl::FinalDraw(HDC hDC, RECT destRect)
 {
 	// Save the used rectangles
 	m_rctClient = destRect;
+	DRAW_STATS_BEGIN(&m_DrawStats, kDrawPhaseAxes);
 	m_rctPlot = GetPlotRect(hDC, destRect);
+	DRAW_STATS_END(&m_DrawStats, kDrawPhaseAxes);
 
 	// For user action in CPlotBaseImpl, especially for CPlotWnd.
 	// In fact, these line is useless internally.
@@ -197,8 +220,10 @@ void	CPlotImpl::FinalDraw(HDC hDC, RECT destRect)
 
 	DrawCanvas(hDC);
 	DrawTitle(hDC);
+	DRAW_STATS_BEGIN(&m_DrawStats, kDrawPhaseAxes);
 	DrawGrids(hDC);
 	DrawAxes(hDC);
+	DRAW_STATS_END(&m_DrawStats, kDrawPhaseAxes);
 	DrawPageNotes(hDC);
 	DrawComments(hDC);
 
@@ -302,12 +327,13 @@ void	CPlotImpl::DataToLPX( double *pX, long *pPtx, int nCnt)
 	
 	if( scaleX == 0.) return;
 	
+	// the offsets are truncated before the edge is added
+	ScreenAxisMap map = MakeScreenAxisMap(0, 1.0/scaleX, xRange[0], m_bXOpposite, false, false);
+	DataToScreen(map, pX, 1, pPtx, 1, nCnt);
+	long origin = !m_bXOpposite ? plotRect.left : plotRect.right;
 	for(int i=0; i<nCnt; i++)
 	{
-		if(!m_bXOpposite)
-			pPtx[i] = plotRect.left + (long)((pX[i]-xRange[0]) / scaleX) ;
-		else
-			pPtx[i] = plotRect.right - (long)((pX[i]-xRange[0]) / scaleX) ;
+		if(pPtx[i] != kScreenGap)pPtx[i] += origin;
 	}	
 }
 
@@ -353,12 +379,12 @@ void	CPlotImpl::DataToLPY( double *pY, long *pPty, int nCnt)
 	
 	if( scaleY == 0. ) return;
 	
+	ScreenAxisMap map = MakeScreenAxisMap(0, 1.0/scaleY, yRange[0], !m_bYOpposite, false, false);
+	DataToScreen(map, pY, 1, pPty, 1, nCnt);
+	long origin = !m_bYOpposite ? plotRect.bottom : plotRect.top;
 	for(int i=0; i<nCnt; i++)
 	{
-		if(!m_bYOpposite)
-			pPty[i] = plotRect.bottom - (long)((pY[i]-yRange[0]) / scaleY) ;
-		else
-			pPty[i] = plotRect.top + (long)((pY[i]-yRange[0]) / scaleY) ;
+		if(pPty[i] != kScreenGap)pPty[i] += origin;
 	}
 	
 }
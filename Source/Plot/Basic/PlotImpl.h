@@ -32,6 +32,7 @@
 #include "PlotDataImpl.h"
 #include "More/PageNoteImpl.h"
 #include "More/CommentsImpl.h"
+#include "DrawStats.h"
 
 Declare_Namespace_CChart
 
@@ -53,6 +54,10 @@ public:
 
 protected:
 	virtual	RECT	GetPlotRect( HDC hDC, RECT clientRect );
+	// Margins and axes only, for drawing without a device
+	RECT	GetPlotRect( CDrawSurface *pSurface, RECT clientRect );
+	RECT	AdjustByMargins( RECT plotRect );
+	void	AdjustByEqualAxes( RECT &plotRect );
 	virtual	RECT	AddtionalPlotRectAdjust(HDC hDC, RECT plotRect){return plotRect;}
 public:
 	RECT	AdjustTitleRect(HDC hDC, RECT titleRect);
@@ -92,6 +97,11 @@ public:
 
 	void		ResetApperance();
 
+protected:
+	// time and counters of the frames, see DrawStats.h
+	CDrawStats	m_DrawStats;
+public:
+	inline	CDrawStats	*GetDrawStats(){return &m_DrawStats;}
 };
 
 Declare_Namespace_End
\ No newline at end of file
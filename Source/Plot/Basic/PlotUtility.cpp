@@ -24,6 +24,7 @@
 #include <time.h>
 
 #include "PlotUtility.h"
+#include "TimeParser.h"
 #include "mytime.h"
 #include "MyConst.h"
 #include "../Accessary/Dib/dib.h"
@@ -689,6 +690,109 @@ void	ComputeTicksWithGap(double dMin, double dMax, double gap, int &nTicks, int
 	nMinorTicks = 5;
 }
 
+static __int64	FloorDiv(__int64 a, __int64 b)
+{
+	__int64 q = a / b;
+	if(a % b != 0 && a < 0)q--;
+	return q;
+}
+
+enum
+{
+	kTimeUnitNs,
+	kTimeUnitUs,
+	kTimeUnitMs,
+	kTimeUnitSecond,
+	kTimeUnitMinute,
+	kTimeUnitHour,
+	kTimeUnitDay,
+	kTimeUnitCount
+};
+
+struct stTimeStep
+{
+	int		nCount;
+	int		nUnit;
+	int		nMinor;
+};
+
+// Steps longer than a few weeks are whole days, so months and years are 30 and 365 days long
+static const stTimeStep pTimeSteps[] =
+{
+	{1, kTimeUnitNs, 5}, {2, kTimeUnitNs, 4}, {5, kTimeUnitNs, 5}, {10, kTimeUnitNs, 5}, {20, kTimeUnitNs, 4}, {50, kTimeUnitNs, 5},
+	{100, kTimeUnitNs, 5}, {200, kTimeUnitNs, 4}, {500, kTimeUnitNs, 5},
+	{1, kTimeUnitUs, 5}, {2, kTimeUnitUs, 4}, {5, kTimeUnitUs, 5}, {10, kTimeUnitUs, 5}, {20, kTimeUnitUs, 4}, {50, kTimeUnitUs, 5},
+	{100, kTimeUnitUs, 5}, {200, kTimeUnitUs, 4}, {500, kTimeUnitUs, 5},
+	{1, kTimeUnitMs, 5}, {2, kTimeUnitMs, 4}, {5, kTimeUnitMs, 5}, {10, kTimeUnitMs, 5}, {20, kTimeUnitMs, 4}, {50, kTimeUnitMs, 5},
+	{100, kTimeUnitMs, 5}, {200, kTimeUnitMs, 4}, {500, kTimeUnitMs, 5},
+	{1, kTimeUnitSecond, 5}, {2, kTimeUnitSecond, 4}, {5, kTimeUnitSecond, 5}, {10, kTimeUnitSecond, 5}, {15, kTimeUnitSecond, 3}, {30, kTimeUnitSecond, 6},
+	{1, kTimeUnitMinute, 6}, {2, kTimeUnitMinute, 4}, {5, kTimeUnitMinute, 5}, {10, kTimeUnitMinute, 5}, {15, kTimeUnitMinute, 3}, {30, kTimeUnitMinute, 6},
+	{1, kTimeUnitHour, 4}, {2, kTimeUnitHour, 4}, {3, kTimeUnitHour, 3}, {6, kTimeUnitHour, 6}, {12, kTimeUnitHour, 4},
+	{1, kTimeUnitDay, 4}, {2, kTimeUnitDay, 2}, {7, kTimeUnitDay, 7}, {14, kTimeUnitDay, 2}, {30, kTimeUnitDay, 3}, {60, kTimeUnitDay, 2},
+	{90, kTimeUnitDay, 3}, {180, kTimeUnitDay, 6}, {365, kTimeUnitDay, 4}, {730, kTimeUnitDay, 2}, {1825, kTimeUnitDay, 5},
+	{3650, kTimeUnitDay, 5}, {7300, kTimeUnitDay, 4}, {18250, kTimeUnitDay, 5}, {36500, kTimeUnitDay, 5},
+};
+
+void	ComputeTimeTicks(double dMin, double dMax, __int64 nOrigin, int &nTicks, int &nMinorTicks, double &tickMin, double &tickMax, __int64 &nStep)
+{
+	if(dMin>dMax)
+	{
+		std::swap(dMin, dMax);
+	}
+
+	nStep = 0;
+	// too far from the origin to count in ns
+	if(fabs(dMin) > 4.0e9 || fabs(dMax) > 4.0e9)
+	{
+		RegulateTicks(dMin, dMax, nTicks, nMinorTicks, tickMin, tickMax);
+		return;
+	}
+
+	const __int64 nSecond = 1000000000;
+	__int64 pUnits[kTimeUnitCount];
+	pUnits[kTimeUnitNs] = 1;
+	pUnits[kTimeUnitUs] = 1000;
+	pUnits[kTimeUnitMs] = 1000000;
+	pUnits[kTimeUnitSecond] = nSecond;
+	pUnits[kTimeUnitMinute] = 60*nSecond;
+	pUnits[kTimeUnitHour] = 3600*nSecond;
+	pUnits[kTimeUnitDay] = 86400*nSecond;
+
+	__int64 nMin = nOrigin + (__int64)floor(dMin*1.0e9 + 0.5);
+	__int64 nMax = nOrigin + (__int64)floor(dMax*1.0e9 + 0.5);
+
+	// the first step giving 8 segments or less
+	int i, nSteps = sizeof(pTimeSteps)/sizeof(pTimeSteps[0]);
+	for(i=0; i<nSteps-1; i++)
+	{
+		if(nMax - nMin <= 8*pTimeSteps[i].nCount*pUnits[pTimeSteps[i].nUnit])break;
+	}
+	nStep = pTimeSteps[i].nCount*pUnits[pTimeSteps[i].nUnit];
+	nMinorTicks = pTimeSteps[i].nMinor;
+
+	// hours and days start at the local midnight, weeks on monday
+	__int64 nBase = 0;
+	if(pTimeSteps[i].nUnit >= kTimeUnitHour)
+	{
+		nBase = -GetLocalTimeOffset((time_t)FloorDiv(nMin, nSecond))*nSecond;
+		if(pTimeSteps[i].nCount == 7 || pTimeSteps[i].nCount == 14)nBase += 4*pUnits[kTimeUnitDay];
+	}
+
+	__int64 nFirst = nBase - FloorDiv(nBase - nMin, nStep)*nStep;
+	__int64 nLast = nBase + FloorDiv(nMax - nBase, nStep)*nStep;
+	if(nLast <= nFirst)
+	{
+		nTicks = 0;
+		tickMin = dMin;
+		tickMax = dMax;
+		return;
+	}
+	// from the origin in integers, so that a short span does not cancel out
+	tickMin = (double)(nFirst - nOrigin)/1.0e9;
+	tickMax = (double)(nLast - nOrigin)/1.0e9;
+	nTicks = (int)((nLast - nFirst)/nStep) - 1;// CAxis need this;
+}
+
 // This does a silly, but useful check for an optimal tick interval
 // given a known range. It tries to find the interval set with
 // the least remainder. The order is from my head, and what
@@ -1937,48 +2041,59 @@ time_t StringtoTime(TCHAR *str)
 */
 bool	MyStr2Time(tstring strTime, tstring fmt, time_t &tmTime)
 {
-	time_t myTime;
-	struct tm myTm = {0};
-	
-	tstring dest;
+	double fTime;
+	if(!MyStr2Time(strTime, fmt, fTime))return false;
 
-	if(!_tcsptime(strTime.c_str(), fmt.c_str(), &myTm))return false;
-/*	
-	int year, month, day, hour, minite, second;
-
-	if(_tcslen(strTime.c_str()) < 14)return false;
-
-#if defined(_MSC_VER) && (_MSC_VER>=1300)
-	_stscanf_s(strTime.c_str(), _T("%4d%2d%2d%2d%2d%2d"), &year, &month, &day, &hour, &minite, &second);
-#else
-	_stscanf(strTime.c_str(), _T("%4d%2d%2d%2d%2d%2d"), &year, &month, &day, &hour, &minite, &second);
-#endif
-	myTm.tm_year = year-1900;
-	myTm.tm_mon = month-1;
-	myTm.tm_mday = day;
-	myTm.tm_hour = hour;
-	myTm.tm_min = minite;
-	myTm.tm_sec = second;
-	myTm.tm_isdst = 0;
-*/	
-	myTime = mktime(&myTm);
-	tmTime = myTime;
-	
+	tmTime = (time_t)floor(fTime);
 	return true;
 }
 
+// One parser for the single calls, so the local offsets it has looked up are kept
+static struct stSharedTimeParser
+{
+	CTimeParser			parser;
+	CRITICAL_SECTION	cs;
+	stSharedTimeParser(){InitializeCriticalSection(&cs);}
+	~stSharedTimeParser(){DeleteCriticalSection(&cs);}
+}s_SharedTimeParser;
+
 bool	MyStr2Time(tstring strTime, tstring fmt, double &fTime)
 {
-	time_t tmTime;
-	if(!MyStr2Time(strTime, fmt, tmTime))return false;
+	bool ret;
+	EnterCriticalSection(&s_SharedTimeParser.cs);
+	if(s_SharedTimeParser.parser.GetFormat() != fmt)s_SharedTimeParser.parser.SetFormat(fmt.c_str());
+	ret = s_SharedTimeParser.parser.Parse(strTime.c_str(), fTime);
+	LeaveCriticalSection(&s_SharedTimeParser.cs);
+	return ret;
+}
 
-	fTime = (double)tmTime;
-	return true;
+int		MyStr2TimeBatch(const tstring *pStrTime, int nCount, tstring fmt, double *pTime)
+{
+	if(!pStrTime || !pTime)return 0;
+	CTimeParser parser(fmt.c_str());
+	int i;
+	for(i=0; i<nCount; i++)
+	{
+		if(!parser.Parse(pStrTime[i].c_str(), pTime[i]))break;
+	}
+	return i;
+}
+
+int		MyStr2TimeBatch(TCHAR **pStrTime, int nCount, tstring fmt, double *pTime)
+{
+	if(!pStrTime || !pTime)return 0;
+	CTimeParser parser(fmt.c_str());
+	int i;
+	for(i=0; i<nCount; i++)
+	{
+		if(!parser.Parse(pStrTime[i], pTime[i]))break;
+	}
+	return i;
 }
 
 bool	MyTime2Str(time_t tmTime, tstring &strTime, tstring fmt)
 {
-	TCHAR strLabel[32];
+	TCHAR strLabel[64];
 	struct tm *myTm;
 	
 #if defined(_MSC_VER) && (_MSC_VER>=1300)
@@ -1988,8 +2103,8 @@ bool	MyTime2Str(time_t tmTime, tstring &strTime, tstring fmt)
 	myTm = localtime(&tmTime);
 #endif
 	
-	memset(strLabel, 0, sizeof(TCHAR)*32);
-	_tcsftime(strLabel, 31, fmt.c_str(), myTm);
+	memset(strLabel, 0, sizeof(TCHAR)*64);
+	_tcsftime(strLabel, 63, fmt.c_str(), myTm);
 	
 #if defined(_MSC_VER) && (_MSC_VER>=1300)
 	delete myTm;
@@ -1999,6 +2114,89 @@ bool	MyTime2Str(time_t tmTime, tstring &strTime, tstring fmt)
 	return true;
 }
 
+bool	MyTimeNs2Str(__int64 nTime, __int64 nStep, tstring &strTime, tstring fmt)
+{
+	const __int64 nSecond = 1000000000;
+	if(nTime < 0)nTime = 0;
+
+	// digits of the second needed by the step, none without a step
+	__int64 nFrac = (nStep > 0) ? nStep % nSecond : 0;
+	__int64 nUnit = nSecond;
+	int nDigits = 0;
+	while(nFrac % nUnit != 0)
+	{
+		nUnit /= 10;
+		nDigits++;
+	}
+	nTime = (nTime + nUnit/2)/nUnit*nUnit;
+
+	TCHAR strFrac[16];
+	int i;
+	__int64 nDigit = (nTime % nSecond)/nUnit;
+	for(i=0; i<nDigits; i++)
+	{
+		strFrac[nDigits-1-i] = _TEXT('0') + (TCHAR)(nDigit % 10);
+		nDigit /= 10;
+	}
+	strFrac[nDigits] = 0;
+
+	bool bFrac = false;
+	for(i=0; i+1<(int)fmt.length(); i++)
+	{
+		if(fmt[i] != _TEXT('%'))continue;
+		i++;
+		if(fmt[i] == _TEXT('f'))bFrac = true;
+	}
+
+	tstring strFmt;
+	for(i=0; i<(int)fmt.length(); i++)
+	{
+		if(fmt[i] != _TEXT('%') || i+1 >= (int)fmt.length())
+		{
+			strFmt += fmt[i];
+			continue;
+		}
+		i++;
+		if(fmt[i] == _TEXT('f'))
+		{
+			strFmt += strFrac;
+			continue;
+		}
+		strFmt += _TEXT('%');
+		strFmt += fmt[i];
+		if(fmt[i] == _TEXT('S') && !bFrac && nDigits > 0)
+		{
+			strFmt += _TEXT('.');
+			strFmt += strFrac;
+		}
+	}
+
+	return MyTime2Str((time_t)(nTime/nSecond), strTime, strFmt);
+}
+
+int		GetLocalTimeOffset(time_t tmTime)
+{
+	if(tmTime < 0)tmTime = 0;
+
+	struct tm lt, gt;
+#if defined(_MSC_VER) && (_MSC_VER>=1300)
+	if(localtime_s(&lt, &tmTime) != 0)return 0;
+	if(gmtime_s(&gt, &tmTime) != 0)return 0;
+#else
+	struct tm *myTm;
+	myTm = localtime(&tmTime);
+	if(!myTm)return 0;
+	lt = *myTm;
+	myTm = gmtime(&tmTime);
+	if(!myTm)return 0;
+	gt = *myTm;
+#endif
+
+	int nDays = lt.tm_yday - gt.tm_yday;
+	if(lt.tm_year != gt.tm_year)nDays = (lt.tm_year > gt.tm_year) ? 1 : -1;
+	return nDays*86400 + (lt.tm_hour - gt.tm_hour)*3600 + (lt.tm_min - gt.tm_min)*60 + (lt.tm_sec - gt.tm_sec);
+}
+
 bool	ValInInterval(double val, double low, double high)
 {
 	return (val - low) * (high - val) >= 0.0;
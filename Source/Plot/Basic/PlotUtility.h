@@ -67,6 +67,8 @@ double			GetTickOptimalTickInterval( double lower, double upper );
 void			GetLogValue(double val, int &ev, double &rv);
 void			RegulateTicks(double dMin, double dMax, int &nTicks, int &nMinorTicks, double &tickMin, double &tickMax);
 void			ComputeTicksWithGap(double dMin, double dMax, double gap, int &nTicks, int &nMinorTicks, double &tickMin, double &tickMax);
+// dMin and dMax are seconds from nOrigin, ns since 1970. The step goes from 1ns to years
+void			ComputeTimeTicks(double dMin, double dMax, __int64 nOrigin, int &nTicks, int &nMinorTicks, double &tickMin, double &tickMax, __int64 &nStep);
 
 void			GradientSides( HDC hDC, POINT pt1, POINT pt2, POINT pt3, POINT pt4, COLORREF crCt, COLORREF crS1, COLORREF crS2);
 void			GradientSides( HDC hDC, POINT point[6], COLORREF crCt, COLORREF crS1, COLORREF crS2);
@@ -113,7 +115,14 @@ RECT			GetTextRect(HDC hDC, POINT ptLT, tstring text, LOGFONT *logFont, bool bCo
 
 bool			MyStr2Time(tstring strTime, tstring fmt, double &fTime);
 bool			MyStr2Time(tstring strTime, tstring fmt, time_t &tmTime);
+// One parser for all the strings, returns the count converted before the first failure
+int				MyStr2TimeBatch(const tstring *pStrTime, int nCount, tstring fmt, double *pTime);
+int				MyStr2TimeBatch(TCHAR **pStrTime, int nCount, tstring fmt, double *pTime);
 bool			MyTime2Str(time_t tmTime, tstring &strTime, tstring fmt);
+// nTime in ns since 1970. %f gives the digits of the second that nStep needs, without %f they follow %S, a step of 0 gives whole seconds
+bool			MyTimeNs2Str(__int64 nTime, __int64 nStep, tstring &strTime, tstring fmt);
+// seconds from UTC to the local time at tmTime
+int				GetLocalTimeOffset(time_t tmTime);
 
 bool			ValInInterval(double val, double low, double high);
 void			SetMyCapture(HWND hWnd);
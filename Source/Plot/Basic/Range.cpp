@@ -74,5 +74,9 @@ void	CRange::SetDefaults()
 	m_nZoomCenter = kRangeZoomCenterM;
 
 	m_tmtStartTime = 0;
+
+	m_bTimeTicks = false;
+	m_nTimeOrigin = 0;
+	m_nTimeStep = 0;
 }
 
@@ -74,6 +74,13 @@ protected:
 
 	time_t		m_tmtStartTime;
 
+	// ticks on whole time units, from the time axis of the plot
+	bool		m_bTimeTicks;
+	// value 0 of a time range, ns since 1970, the values are seconds from it
+	__int64		m_nTimeOrigin;
+	// ns between the time ticks
+	__int64		m_nTimeStep;
+
 public:
 	bool		m_bFloatTicksOld;
 	
@@ -114,7 +121,7 @@ public:
 	inline bool				IsAutoMinorTick( void ) { return m_bAutoMinorTick; }
 	inline void				SetAutoMinorTick( bool amt ) { m_bAutoMinorTick=amt; }
 	
-	inline	bool			IsFloatTicks( void ) { return m_bFloatTicks; }
+	inline	bool			IsFloatTicks( void ) { return m_bFloatTicks || m_bTimeTicks; }
 	inline	void			SetFloatTicks( bool flt ) { m_bFloatTicks = flt; m_bRangeSet = false; }
 	inline	bool			IsFloatTicksOld( void ) { return m_bFloatTicksOld; }
 	inline	void			SetFloatTicksOld( bool flt ) { m_bFloatTicksOld = flt; }
@@ -151,6 +158,12 @@ public:
 
 	inline	time_t			GetStartTime() { return m_tmtStartTime; }
 	inline	void			SetStartTime(time_t tmt) { m_tmtStartTime = tmt; }
+
+	inline	bool			IsTimeTicks() { return m_bTimeTicks; }
+	inline	void			SetTimeTicks(bool time) { if(time != m_bTimeTicks){ m_bTimeTicks = time; m_bRangeSet = false; } }
+	inline	__int64			GetTimeOrigin() { return m_nTimeOrigin; }
+	inline	void			SetTimeOrigin(__int64 origin) { m_nTimeOrigin = origin; m_bRangeSet = false; }
+	inline	__int64			GetTimeStep() { return m_nTimeStep; }
 };
 
 Declare_Namespace_End
\ No newline at end of file
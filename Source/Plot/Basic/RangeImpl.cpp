@@ -74,6 +74,10 @@ void	CRangeImpl::SetRange( double low, double high, bool bRangeSet )
 			outRange[1]=outRange[1]*(GetAtom())+(GetAtomZero());
 		}
 	}
+	else if(IsTimeTicks())
+	{
+		CalcTimeTicks(m_pfPlotRange);
+	}
 	else
 	{
 		double v1, v2, realGap;
@@ -138,6 +142,14 @@ void	CRangeImpl::CalcRange(double range[2], double dataRange[2], bool bNewDataCo
 	{
 		if(!IsRangeSet())memcpy(range, dataRange, 2*sizeof(double));
 
+		if(IsTimeTicks())
+		{
+			CalcTimeTicks(range);
+			SetRange(range);
+			SetRangeSet(true);
+			return;
+		}
+
 		if(fabs(GetAtom())!=0.0 && fabs(GetAtom())!=1.0)
 		{
 			range[0]=(range[0]-GetAtomZero())/(GetAtom());
@@ -194,6 +206,15 @@ void	CRangeImpl::CalcRange(double range[2], double dataRange[2], bool bNewDataCo
 	{
 		//GetDataRange(Range);
 		memcpy(Range, dataRange, 2*sizeof(double));
+
+		if(IsTimeTicks())
+		{
+			memcpy(range, Range, 2*sizeof(double));
+			CalcTimeTicks(range);
+			SetRangeSet(true);
+			SetRange(range);
+			return;
+		}
 		
 		// divide
 		realGap = m_fTickGap;
@@ -303,6 +324,17 @@ void		CRangeImpl::ZoomRange( double fFact )
 	m_pfPlotRange[1] = ct + fFact*(m_pfPlotRange[1] - ct);
 }
 
+// The range is kept as it is, the ticks fall on whole time units inside it
+void		CRangeImpl::CalcTimeTicks( double *range )
+{
+	if(range[1] <= range[0])
+	{
+		range[0] -= 1.0;
+		range[1] += 1.0;
+	}
+	ComputeTimeTicks(range[0], range[1], m_nTimeOrigin, m_nMajorTicks, m_nMinorTicks, m_fTickMin, m_fTickMax, m_nTimeStep);
+}
+
 /*
 double		CRangeImpl::GetMajorTickPosValue( int whichTick )
 {
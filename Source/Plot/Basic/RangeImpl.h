@@ -43,6 +43,9 @@ public:
 
 	void				ZoomRange( double fFact );
 
+protected:
+	void				CalcTimeTicks( double *range );
+
 public:
 	//double				GetMajorTickPosValue( int whichTick );
 	//bool				GetMinorTickPosValue( int whichMajor, double *fPos );
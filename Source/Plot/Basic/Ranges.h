@@ -240,6 +240,13 @@ public:
 	inline	time_t			GetYStartTime(){return m_Y0(GetStartTime);}
 	inline	void			SetYStartTime(time_t tmt){m_Y1(SetStartTime, tmt);}
 
+	inline	__int64			GetXTimeOrigin(){return m_X0(GetTimeOrigin);}
+	inline	void			SetXTimeOrigin(__int64 origin){m_X1(SetTimeOrigin, origin);}
+	inline	__int64			GetYTimeOrigin(){return m_Y0(GetTimeOrigin);}
+	inline	void			SetYTimeOrigin(__int64 origin){m_Y1(SetTimeOrigin, origin);}
+	inline	__int64			GetXTimeStep(){return m_X0(GetTimeStep);}
+	inline	__int64			GetYTimeStep(){return m_Y0(GetTimeStep);}
+
 	//virtual	double				GetMajorTickPosValue( bool bX, int whichTick ){return 0.0;};
 	//virtual bool				GetMinorTickPosValue( bool bX, int whichMajor, double *fPos ){return 0.0;};
 };
@@ -112,6 +112,9 @@ void	CRangesImpl<PlotImplT>::GetPlotRange( double *xRange, double *yRange )
 {
 	PlotImplT* pT = static_cast<PlotImplT*>(this);
 
+	GetClsRange(0)->SetTimeTicks(pT->IsXTime());
+	GetClsRange(1)->SetTimeTicks(pT->IsYTime());
+
 	bool bXStatic = IsStaticXRange();
 	bool bYStatic = IsStaticYRange();
 	if(bXStatic)
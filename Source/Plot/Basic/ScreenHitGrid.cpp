@@ -0,0 +1,291 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#include "ScreenHitGrid.h"
+#include "ScreenTransform.h"
+#include <math.h>
+#include <stdlib.h>
+#include <algorithm>
+
+Declare_Namespace_CChart
+
+// Aim at about this many segments per cell
+const int	kHitGridLoad = 2;
+// The smallest cell, in pixels
+const long	kHitGridMinCell = 4;
+// Cells crossed by a segment on average at most, long noisy segments make larger cells
+const int	kHitGridMaxCross = 8;
+
+CScreenHitGrid::CScreenHitGrid()
+{
+	Clear();
+}
+
+void	CScreenHitGrid::Clear()
+{
+	SetRectEmpty(&m_rect);
+	m_nPoints = 0;
+	m_nCell = kHitGridMinCell;
+	m_nCols = m_nRows = 0;
+	m_vCellStart.clear();
+	m_vItems.clear();
+	m_vPointStart.clear();
+	m_vPoints.clear();
+}
+
+// The cells crossed from (u0, v0) to (u1, v1), in cell units within the grid, in the order of
+// the walk. A corner met exactly also lists the two cells beside it
+void	CScreenHitGrid::WalkCells(double u0, double v0, double u1, double v1, std::vector<int> &vCells) const
+{
+	int c = (int)floor(u0), r = (int)floor(v0);
+	int c1 = (int)floor(u1), r1 = (int)floor(v1);
+	if(c >= m_nCols)c = m_nCols-1;
+	if(r >= m_nRows)r = m_nRows-1;
+	if(c1 >= m_nCols)c1 = m_nCols-1;
+	if(r1 >= m_nRows)r1 = m_nRows-1;
+
+	int sc = c1 > c ? 1 : -1, sr = r1 > r ? 1 : -1;
+	int nc = abs(c1 - c), nr = abs(r1 - r);
+	double du = fabs(u1 - u0), dv = fabs(v1 - v0);
+	// the walk parameter at the next column and row boundary, and between two of them
+	double tu = nc > 0 ? (sc > 0 ? c + 1 - u0 : u0 - c) / du : 0.0;
+	double tv = nr > 0 ? (sr > 0 ? r + 1 - v0 : v0 - r) / dv : 0.0;
+	double dtu = nc > 0 ? 1.0 / du : 0.0;
+	double dtv = nr > 0 ? 1.0 / dv : 0.0;
+
+	// pieces of one segment join in a cell, list it once
+	if(vCells.empty() || vCells.back() != r*m_nCols + c)vCells.push_back(r*m_nCols + c);
+	while(nc > 0 || nr > 0)
+	{
+		if(nc > 0 && (nr == 0 || tu < tv))
+		{
+			c += sc;
+			tu += dtu;
+			nc--;
+		}
+		else if(nr > 0 && (nc == 0 || tv < tu))
+		{
+			r += sr;
+			tv += dtv;
+			nr--;
+		}
+		else
+		{
+			vCells.push_back(r*m_nCols + c + sc);
+			vCells.push_back((r + sr)*m_nCols + c);
+			c += sc;
+			r += sr;
+			tu += dtu;
+			tv += dtv;
+			nc--;
+			nr--;
+		}
+		vCells.push_back(r*m_nCols + c);
+	}
+}
+
+// Points out of the rect fall in the border cells, so that any segment can be found: the
+// segment is cut where it leaves the grid and the pieces outside are pressed onto the border.
+// A segment with one gap end is kept as its other end, so that no point is lost
+void	CScreenHitGrid::GetSegmentCells(const POINT *pPoints, int k, std::vector<int> &vCells) const
+{
+	vCells.clear();
+	POINT p = pPoints[k];
+	POINT q = pPoints[k+1<m_nPoints ? k+1 : 0];
+	if(IsScreenGap(p) && IsScreenGap(q))return;
+	if(IsScreenGap(p))p = q;
+	else if(IsScreenGap(q))q = p;
+
+	double u0 = (double)(p.x - m_rect.left) / m_nCell, v0 = (double)(p.y - m_rect.top) / m_nCell;
+	double u1 = (double)(q.x - m_rect.left) / m_nCell, v1 = (double)(q.y - m_rect.top) / m_nCell;
+	double du = u1 - u0, dv = v1 - v0;
+
+	// the walk parameters where the segment meets the edges of the grid, in order
+	double t[6], tt, ua, va, ub, vb;
+	int n = 0, i;
+	t[n++] = 0.0;
+	if(du != 0.0)
+	{
+		tt = -u0 / du;
+		if(tt > 0.0 && tt < 1.0)t[n++] = tt;
+		tt = (m_nCols - u0) / du;
+		if(tt > 0.0 && tt < 1.0)t[n++] = tt;
+	}
+	if(dv != 0.0)
+	{
+		tt = -v0 / dv;
+		if(tt > 0.0 && tt < 1.0)t[n++] = tt;
+		tt = (m_nRows - v0) / dv;
+		if(tt > 0.0 && tt < 1.0)t[n++] = tt;
+	}
+	t[n++] = 1.0;
+	std::sort(t, t + n);
+
+	for(i=0; i<n-1; i++)
+	{
+		ua = u0 + du*t[i];
+		va = v0 + dv*t[i];
+		ub = u0 + du*t[i+1];
+		vb = v0 + dv*t[i+1];
+		// a piece lies on one side of each edge, pressing it on the border keeps it straight
+		ua = ua < 0.0 ? 0.0 : (ua > m_nCols ? m_nCols : ua);
+		va = va < 0.0 ? 0.0 : (va > m_nRows ? m_nRows : va);
+		ub = ub < 0.0 ? 0.0 : (ub > m_nCols ? m_nCols : ub);
+		vb = vb < 0.0 ? 0.0 : (vb > m_nRows ? m_nRows : vb);
+		WalkCells(ua, va, ub, vb, vCells);
+	}
+}
+
+void	CScreenHitGrid::Build(const POINT *pPoints, int nPoints, RECT rect)
+{
+	Clear();
+	if(!pPoints || nPoints <= 0)return;
+
+	long nWidth = rect.right - rect.left;
+	long nHeight = rect.bottom - rect.top;
+	if(nWidth < 1)nWidth = 1;
+	if(nHeight < 1)nHeight = 1;
+
+	m_rect = rect;
+	m_nPoints = nPoints;
+	m_nCell = (long)ceil(sqrt((double)nWidth * nHeight * kHitGridLoad / nPoints));
+	if(m_nCell < kHitGridMinCell)m_nCell = kHitGridMinCell;
+
+	// the length of the segments within the rect, as the cells they cross grow with it
+	int k, c;
+	double fLength = 0.0;
+	POINT p, q;
+	for(k=0; k<nPoints; k++)
+	{
+		p = pPoints[k];
+		q = pPoints[k+1<nPoints ? k+1 : 0];
+		if(IsScreenGap(p) || IsScreenGap(q))continue;
+		fLength += fabs((double)ClampX(p.x) - ClampX(q.x)) + fabs((double)ClampY(p.y) - ClampY(q.y));
+	}
+	if(fLength / m_nCell > (double)kHitGridMaxCross * nPoints)
+	{
+		m_nCell = (long)ceil(fLength / ((double)kHitGridMaxCross * nPoints));
+	}
+	m_nCols = (int)((nWidth + m_nCell - 1)/m_nCell);
+	m_nRows = (int)((nHeight + m_nCell - 1)/m_nCell);
+
+	// count the segments and the points of each cell first, then place them
+	int nCells = m_nCols * m_nRows;
+	std::vector<int> vCells;
+	m_vCellStart.assign(nCells + 1, 0);
+	m_vPointStart.assign(nCells + 1, 0);
+	for(k=0; k<nPoints; k++)
+	{
+		GetSegmentCells(pPoints, k, vCells);
+		for(c=0; c<(int)vCells.size(); c++)m_vCellStart[vCells[c] + 1]++;
+		if(!IsScreenGap(pPoints[k]))m_vPointStart[GetRow(pPoints[k].y)*m_nCols + GetCol(pPoints[k].x) + 1]++;
+	}
+	for(c=0; c<nCells; c++)
+	{
+		m_vCellStart[c+1] += m_vCellStart[c];
+		m_vPointStart[c+1] += m_vPointStart[c];
+	}
+
+	std::vector<int> vNext(m_vCellStart.begin(), m_vCellStart.end() - 1);
+	std::vector<int> vNextPoint(m_vPointStart.begin(), m_vPointStart.end() - 1);
+	m_vItems.resize(m_vCellStart[nCells]);
+	m_vPoints.resize(m_vPointStart[nCells]);
+	for(k=0; k<nPoints; k++)
+	{
+		GetSegmentCells(pPoints, k, vCells);
+		for(c=0; c<(int)vCells.size(); c++)m_vItems[vNext[vCells[c]]++] = k;
+		if(!IsScreenGap(pPoints[k]))m_vPoints[vNextPoint[GetRow(pPoints[k].y)*m_nCols + GetCol(pPoints[k].x)]++] = k;
+	}
+}
+
+void	CScreenHitGrid::Collect(int c0, int c1, int r0, int r1, std::vector<int> &vSegs) const
+{
+	int c, r, j;
+	for(r=r0; r<=r1; r++)
+	{
+		for(c=c0; c<=c1; c++)
+		{
+			for(j=m_vCellStart[r*m_nCols + c]; j<m_vCellStart[r*m_nCols + c + 1]; j++)
+			{
+				vSegs.push_back(m_vItems[j]);
+			}
+		}
+	}
+	// a segment is listed in every cell it crosses
+	std::sort(vSegs.begin(), vSegs.end());
+	vSegs.erase(std::unique(vSegs.begin(), vSegs.end()), vSegs.end());
+}
+
+void	CScreenHitGrid::QueryBox(POINT pt, long rx, long ry, std::vector<int> &vSegs) const
+{
+	vSegs.clear();
+	if(m_nPoints <= 0)return;
+	Collect(GetCol(pt.x - rx), GetCol(pt.x + rx), GetRow(pt.y - ry), GetRow(pt.y + ry), vSegs);
+}
+
+void	CScreenHitGrid::QueryRay(POINT pt, std::vector<int> &vSegs) const
+{
+	vSegs.clear();
+	if(m_nPoints <= 0)return;
+	Collect(GetCol(pt.x), m_nCols - 1, GetRow(pt.y), GetRow(pt.y), vSegs);
+}
+
+void	CScreenHitGrid::QueryPoints(POINT pt, long rx, long ry, std::vector<int> &vPoints) const
+{
+	vPoints.clear();
+	if(m_nPoints <= 0)return;
+	int c, r, j;
+	int c0 = GetCol(pt.x - rx), c1 = GetCol(pt.x + rx);
+	int r0 = GetRow(pt.y - ry), r1 = GetRow(pt.y + ry);
+	for(r=r0; r<=r1; r++)
+	{
+		for(c=c0; c<=c1; c++)
+		{
+			for(j=m_vPointStart[r*m_nCols + c]; j<m_vPointStart[r*m_nCols + c + 1]; j++)
+			{
+				vPoints.push_back(m_vPoints[j]);
+			}
+		}
+	}
+	std::sort(vPoints.begin(), vPoints.end());
+}
+
+bool	CScreenHitGrid::IsInside(const POINT *pPoints, POINT pt) const
+{
+	if(!pPoints || m_nPoints <= 0)return false;
+
+	std::vector<int> vSegs;
+	QueryRay(pt, vSegs);
+
+	bool bInside = false;
+	int i;
+	double x;
+	for(i=0; i<(int)vSegs.size(); i++)
+	{
+		const POINT &p = pPoints[vSegs[i]];
+		const POINT &q = pPoints[vSegs[i]+1<m_nPoints ? vSegs[i]+1 : 0];
+		if(IsScreenGap(p) || IsScreenGap(q))continue;
+		if((p.y > pt.y) == (q.y > pt.y))continue;
+		x = p.x + (double)(pt.y - p.y) * (q.x - p.x) / (q.y - p.y);
+		if(pt.x < x)bInside = !bInside;
+	}
+	return bInside;
+}
+
+Declare_Namespace_End
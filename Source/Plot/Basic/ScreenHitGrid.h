@@ -0,0 +1,70 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#include <windows.h>
+#include <vector>
+#include "CChartNameSpace.h"
+
+Declare_Namespace_CChart
+
+// A uniform grid over the segments and the points of a screen polyline, so that a hit test
+// visits the few near the point instead of all of them. Segment k joins point k and point k+1,
+// the last one closes the polyline back to point 0. A segment is listed in the cells it
+// crosses, gaps of kScreenGap are left out
+class CScreenHitGrid
+{
+public:
+	CScreenHitGrid();
+
+	void	Build(const POINT *pPoints, int nPoints, RECT rect);
+	void	Clear();
+	inline	bool	IsBuilt() const {return m_nPoints > 0;}
+
+	// Segments whose bounding box meets the box of rx, ry pixels around pt, ascending and unique
+	void	QueryBox(POINT pt, long rx, long ry, std::vector<int> &vSegs) const;
+	// Segments that may cross the horizontal ray from pt to the right, ascending and unique
+	void	QueryRay(POINT pt, std::vector<int> &vSegs) const;
+	// Points in the cells met by the box of rx, ry pixels around pt, ascending
+	void	QueryPoints(POINT pt, long rx, long ry, std::vector<int> &vPoints) const;
+	// Even-odd test against the closed polyline, as the alternate fill mode of GDI,
+	// pPoints must be the points the grid was built from
+	bool	IsInside(const POINT *pPoints, POINT pt) const;
+
+protected:
+	void	GetSegmentCells(const POINT *pPoints, int k, std::vector<int> &vCells) const;
+	void	WalkCells(double u0, double v0, double u1, double v1, std::vector<int> &vCells) const;
+	void	Collect(int c0, int c1, int r0, int r1, std::vector<int> &vSegs) const;
+	inline	int		GetCol(long x) const {if(x < m_rect.left)return 0; long c = (x - m_rect.left)/m_nCell; return c >= m_nCols ? m_nCols-1 : (int)c;}
+	inline	long	ClampX(long x) const {return x < m_rect.left ? m_rect.left : (x > m_rect.right ? m_rect.right : x);}
+	inline	long	ClampY(long y) const {return y < m_rect.top ? m_rect.top : (y > m_rect.bottom ? m_rect.bottom : y);}
+	inline	int		GetRow(long y) const {if(y < m_rect.top)return 0; long r = (y - m_rect.top)/m_nCell; return r >= m_nRows ? m_nRows-1 : (int)r;}
+
+	RECT	m_rect;
+	int		m_nPoints;
+	long	m_nCell;// cell size in pixels
+	int		m_nCols, m_nRows;
+	std::vector<int>	m_vCellStart;// m_nCols*m_nRows+1 offsets into m_vItems, row by row
+	std::vector<int>	m_vItems;
+	std::vector<int>	m_vPointStart;// the same for the points, in m_vPoints
+	std::vector<int>	m_vPoints;
+};
+
+Declare_Namespace_End
@@ -0,0 +1,150 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#include "ScreenTransform.h"
+#include <math.h>
+#include <float.h>
+
+#if defined(__AVX__)
+#	include <immintrin.h>
+#	define CCHART_SCREEN_AVX
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define CCHART_SCREEN_SSE2
+#endif
+
+Declare_Namespace_CChart
+
+// Values are transformed in blocks of this size, so the temporaries stay in the cache
+const int	kScreenBlock = 256;
+
+ScreenAxisMap	MakeScreenAxisMap(long nOrigin, double fScale, double fStart, bool bReverse, bool bLog, bool bRound)
+{
+	ScreenAxisMap map;
+	map.fOrigin = nOrigin;
+	map.fScale = bReverse ? -fScale : fScale;
+	map.fStart = fStart;
+	map.fRound = bRound ? 0.5 : 0.0;
+	map.bLog = bLog;
+	return map;
+}
+
+// The linear part on contiguous values, all paths do the same operations in the same order.
+// A non-finite result becomes NaN, which the clamp keeps and the truncation turns into kScreenGap
+static void	TransformBlock(const ScreenAxisMap &map, const double *pVal, long *pOut, int nCnt)
+{
+	int i = 0;
+#if defined(CCHART_SCREEN_AVX)
+	__m256d vOrigin = _mm256_set1_pd(map.fOrigin);
+	__m256d vScale = _mm256_set1_pd(map.fScale);
+	__m256d vStart = _mm256_set1_pd(map.fStart);
+	__m256d vRound = _mm256_set1_pd(map.fRound);
+	__m256d vHigh = _mm256_set1_pd((double)kScreenLimit);
+	__m256d vLow = _mm256_set1_pd(-(double)kScreenLimit);
+	__m256d t, d;
+	int pInt[4];
+	for(; i+4<=nCnt; i+=4)
+	{
+		t = _mm256_sub_pd(_mm256_loadu_pd(pVal + i), vStart);
+		t = _mm256_add_pd(_mm256_add_pd(vOrigin, _mm256_mul_pd(vScale, t)), vRound);
+		d = _mm256_sub_pd(t, t);
+		t = _mm256_or_pd(t, _mm256_cmp_pd(d, d, _CMP_UNORD_Q));
+		t = _mm256_max_pd(vLow, _mm256_min_pd(vHigh, t));
+		_mm_storeu_si128((__m128i *)pInt, _mm256_cvttpd_epi32(t));
+		pOut[i] = pInt[0];
+		pOut[i+1] = pInt[1];
+		pOut[i+2] = pInt[2];
+		pOut[i+3] = pInt[3];
+	}
+#elif defined(CCHART_SCREEN_SSE2)
+	__m128d vOrigin = _mm_set1_pd(map.fOrigin);
+	__m128d vScale = _mm_set1_pd(map.fScale);
+	__m128d vStart = _mm_set1_pd(map.fStart);
+	__m128d vRound = _mm_set1_pd(map.fRound);
+	__m128d vHigh = _mm_set1_pd((double)kScreenLimit);
+	__m128d vLow = _mm_set1_pd(-(double)kScreenLimit);
+	__m128d t, d;
+	int pInt[4];
+	for(; i+2<=nCnt; i+=2)
+	{
+		t = _mm_sub_pd(_mm_loadu_pd(pVal + i), vStart);
+		t = _mm_add_pd(_mm_add_pd(vOrigin, _mm_mul_pd(vScale, t)), vRound);
+		d = _mm_sub_pd(t, t);
+		t = _mm_or_pd(t, _mm_cmpunord_pd(d, d));
+		t = _mm_max_pd(vLow, _mm_min_pd(vHigh, t));
+		_mm_storeu_si128((__m128i *)pInt, _mm_cvttpd_epi32(t));
+		pOut[i] = pInt[0];
+		pOut[i+1] = pInt[1];
+	}
+#endif
+	double v;
+	for(; i<nCnt; i++)
+	{
+		v = map.fOrigin + map.fScale * (pVal[i] - map.fStart) + map.fRound;
+		if(!(fabs(v) <= DBL_MAX))pOut[i] = kScreenGap;
+		else if(v > kScreenLimit)pOut[i] = kScreenLimit;
+		else if(v < -kScreenLimit)pOut[i] = -kScreenLimit;
+		else pOut[i] = (long)v;
+	}
+}
+
+// Time axes take the linear path, their precision is kept by subtracting the start first.
+// The log path takes log10 value by value before the linear part
+void	DataToScreen(const ScreenAxisMap &map, const double *pSrc, int nSrcStride, long *pDst, int nDstStride, int nCnt)
+{
+	double	pVal[kScreenBlock];
+	long	pOut[kScreenBlock];
+	const double	*pIn;
+	int		i, j, nLen;
+	for(i=0; i<nCnt; i+=kScreenBlock)
+	{
+		nLen = (nCnt - i < kScreenBlock) ? nCnt - i : kScreenBlock;
+		pIn = pSrc + i*nSrcStride;
+		if(map.bLog)
+		{
+			for(j=0; j<nLen; j++)pVal[j] = log10(pIn[j*nSrcStride]);
+			pIn = pVal;
+		}
+		else if(nSrcStride != 1)
+		{
+			for(j=0; j<nLen; j++)pVal[j] = pIn[j*nSrcStride];
+			pIn = pVal;
+		}
+		
+		if(nDstStride == 1)
+		{
+			TransformBlock(map, pIn, pDst + i, nLen);
+		}
+		else
+		{
+			TransformBlock(map, pIn, pOut, nLen);
+			for(j=0; j<nLen; j++)pDst[(i+j)*nDstStride] = pOut[j];
+		}
+	}
+}
+
+int		NextScreenRun(const POINT *pPoints, int nPts, int &nStart)
+{
+	while(nStart < nPts && IsScreenGap(pPoints[nStart]))nStart++;
+	int nEnd = nStart;
+	while(nEnd < nPts && !IsScreenGap(pPoints[nEnd]))nEnd++;
+	return nEnd - nStart;
+}
+
+Declare_Namespace_End
@@ -0,0 +1,62 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#include <windows.h>
+#include "CChartNameSpace.h"
+
+Declare_Namespace_CChart
+
+// The transform of one axis from data values to screen coordinates, the formula of the draw code:
+// coord = (long)(fOrigin + fScale * (value - fStart) + fRound), value is log10 of the data on a log axis.
+// The start is subtracted before scaling, so that time values keep their precision
+struct ScreenAxisMap
+{
+	double	fOrigin;
+	double	fScale;
+	double	fStart;
+	double	fRound;
+	bool	bLog;
+};
+
+// NaN and infinite results, as from non-positive data on a log axis, are mapped to kScreenGap
+const long	kScreenGap = (-2147483647L - 1);
+// Finite results are clamped into +/-kScreenLimit, GDI can not use larger coordinates
+const long	kScreenLimit = 0x07FFFFFF;
+
+// A point with a gap in either coordinate is left out of the lines, the fills and the markers,
+// the lines on both sides of it are drawn as separate runs
+inline	bool	IsScreenGap(const POINT &pt){ return pt.x == kScreenGap || pt.y == kScreenGap; }
+// The run of points without gaps from nStart on, nStart is first moved over the gaps.
+// Returns the length of the run, 0 when no point is left
+int		NextScreenRun(const POINT *pPoints, int nPts, int &nStart);
+// Whether the points hold no gap, so they can be drawn as one run
+inline	bool	IsScreenRunWhole(const POINT *pPoints, int nPts){ int nStart = 0; return NextScreenRun(pPoints, nPts, nStart) == nPts; }
+
+// bReverse for an opposite x axis or a normal y axis, whose coordinates decrease with the value
+// bRound adds the half pixel used for the curve points
+ScreenAxisMap	MakeScreenAxisMap(long nOrigin, double fScale, double fStart, bool bReverse, bool bLog, bool bRound);
+
+// Transforms nCnt values, pSrc and pDst step by nSrcStride doubles and nDstStride longs,
+// so the x or y of DataPoint2D and POINT arrays are used in place.
+// The arithmetic runs in blocks with SSE2 or AVX where the compiler targets them
+void	DataToScreen(const ScreenAxisMap &map, const double *pSrc, int nSrcStride, long *pDst, int nDstStride, int nCnt);
+
+Declare_Namespace_End
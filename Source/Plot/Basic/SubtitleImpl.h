@@ -42,7 +42,7 @@ public:
 	void		SetSubTitleShow(bool show);
 	COLORREF	GetSubTitleColor();
 	void		SetSubTitleColor(COLORREF color);
-	LOGFONT&	GetSubTitleFont();
+	LOGFONT		GetSubTitleFont();
 	void		SetSubTitleFont(LOGFONT logFont);
 };
 
@@ -136,7 +136,7 @@ void		CSubtitleImpl<PlotImplT>::SetSubTitleColor(COLORREF color)
 }
 
 template<class PlotImplT>
-LOGFONT&	CSubtitleImpl<PlotImplT>::GetSubTitleFont()
+LOGFONT		CSubtitleImpl<PlotImplT>::GetSubTitleFont()
 {
 	PlotImplT* pT = static_cast<PlotImplT*>(this);
 
@@ -144,12 +144,12 @@ LOGFONT&	CSubtitleImpl<PlotImplT>::GetSubTitleFont()
 	if(commentID>=0)return pT->GetComment(commentID)->GetCommentFont();
 	else
 	{
-		static LOGFONT logFont={0};
+		// a stock object, never deleted
+		LOGFONT logFont={0};
 		HFONT hfont=(HFONT)GetStockObject(DEFAULT_GUI_FONT);
 		if (hfont!=NULL)
 		{
 			::GetObject(hfont, sizeof(LOGFONT), &logFont);
-			::DeleteObject(hfont);
 		}
 		return logFont;
 	}
@@ -0,0 +1,202 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+//#include "StdAfx.h"
+#include "TextDataWriter.h"
+#include <tchar.h>
+
+using namespace NsCChart;
+
+bool	CTextDataWriter::AppendToString(const TCHAR *pText, int nLen, void *pPara)
+{
+	((tstring *)pPara)->append(pText, nLen);
+	return true;
+}
+
+CTextDataWriter::CTextDataWriter()
+{
+	m_nUsed = 0;
+	m_fcnSink = 0;
+	m_pSinkPara = 0;
+	m_bFailed = false;
+	m_nPrecision = 6;
+	m_fChars = 0.0;
+}
+
+CTextDataWriter::~CTextDataWriter()
+{
+	Close();
+}
+
+bool	CTextDataWriter::Open(tstring pathName)
+{
+	Close();
+#if defined(_UNICODE) || defined(UNICODE)
+	string name;
+	if(!mywcs2mbs(pathName, name))return false;
+	m_ofs.open(name.c_str(), ios::out);
+#else
+	m_ofs.open(pathName.c_str(), ios::out);
+#endif
+	m_bFailed = false;
+	m_fChars = 0.0;
+	return m_ofs.is_open();
+}
+
+void	CTextDataWriter::SetSink(FcnTextSink fcnSink, void *pPara)
+{
+	Close();
+	m_fcnSink = fcnSink;
+	m_pSinkPara = pPara;
+	m_bFailed = false;
+	m_fChars = 0.0;
+}
+
+bool	CTextDataWriter::Close()
+{
+	bool ret = Flush();
+	if(m_ofs.is_open())
+	{
+		if(!m_ofs.good())ret = false;
+		m_ofs.close();
+	}
+	m_fcnSink = 0;
+	m_pSinkPara = 0;
+	return ret && !m_bFailed;
+}
+
+bool	CTextDataWriter::Flush()
+{
+	if(m_nUsed <= 0)return !m_bFailed;
+	if(!m_bFailed)
+	{
+		if(m_ofs.is_open())
+		{
+#if defined(_UNICODE) || defined(UNICODE)
+			string str;
+			if(mywcs2mbs(wstring(m_pBuff, m_nUsed), str))m_ofs.write(str.c_str(), str.length());
+			else m_bFailed = true;
+#else
+			m_ofs.write(m_pBuff, m_nUsed);
+#endif
+			if(!m_ofs.good())m_bFailed = true;
+		}
+		else if(m_fcnSink)
+		{
+			if(!m_fcnSink(m_pBuff, m_nUsed, m_pSinkPara))m_bFailed = true;
+		}
+		else
+		{
+			m_bFailed = true;
+		}
+	}
+	m_fChars += m_nUsed;
+	m_nUsed = 0;
+	return !m_bFailed;
+}
+
+bool	CTextDataWriter::Write(const TCHAR *pText, int nLen)
+{
+	int n;
+	while(nLen > 0)
+	{
+		if(m_nUsed >= kBuffSize && !Flush())return false;
+		n = kBuffSize - m_nUsed;
+		if(n > nLen)n = nLen;
+		memcpy(m_pBuff + m_nUsed, pText, n * sizeof(TCHAR));
+		m_nUsed += n;
+		pText += n;
+		nLen -= n;
+	}
+	return !m_bFailed;
+}
+
+bool	CTextDataWriter::WriteNumber(double val)
+{
+	// room for the longest %.17g
+	if(m_nUsed + CNumberFormat::kMinBuffSize > kBuffSize && !Flush())return false;
+	if(m_nPrecision == 0)
+		m_nUsed += CNumberFormat::FormatShortest(m_pBuff + m_nUsed, val);
+	else
+		m_nUsed += CNumberFormat::FormatG(m_pBuff + m_nUsed, val, m_nPrecision);
+	return !m_bFailed;
+}
+
+bool	CTextDataWriter::WriteCurves(std::vector<CPlotData<DataPoint2D> *> &vpData, int nLayout, const tstring &strDataSep, const tstring &strFileSep)
+{
+	int nCurves = (int)vpData.size();
+	if(nCurves <= 0)return false;
+
+	const TCHAR *pNewLine = _TEXT("\n");
+	int i, j, nCount, nMaxCount = 0;
+	if(nLayout == kTextLayoutSequence)
+	{
+		tstring strCurveSep = _TEXT("\r\n") + strFileSep + _TEXT("\r\n");
+		for(j=0; j<nCurves; j++)
+		{
+			tstring strSpace = vpData[j]->GetStrSpaceSeparator();
+			nCount = vpData[j]->GetDataCount();
+			for(i=0; i<nCount; i++)
+			{
+				const DataPoint2D &dp = vpData[j]->GetDataAt(i);
+				WriteNumber(dp.val[0]);
+				Write(strSpace);
+				WriteNumber(dp.val[1]);
+				if(!Write(pNewLine, 1))return false;
+			}
+			if(j < nCurves-1 && !Write(strCurveSep))return false;
+		}
+		return !m_bFailed;
+	}
+
+	std::vector<tstring> vSpace(nCurves);
+	for(j=0; j<nCurves; j++)
+	{
+		vSpace[j] = vpData[j]->GetStrSpaceSeparator();
+		if(vpData[j]->GetDataCount() > nMaxCount)nMaxCount = vpData[j]->GetDataCount();
+	}
+	// missing points of the shorter curves are zeros
+	for(i=0; i<nMaxCount; i++)
+	{
+		for(j=0; j<nCurves; j++)
+		{
+			bool bHas = i < vpData[j]->GetDataCount();
+			double x = bHas ? vpData[j]->GetDataAt(i).val[0] : 0.0;
+			double y = bHas ? vpData[j]->GetDataAt(i).val[1] : 0.0;
+			if(j > 0)Write(strDataSep);
+			if(nLayout == kTextLayoutSeparateX)
+			{
+				WriteNumber(x);
+				Write(bHas ? vSpace[j] : strDataSep);
+				WriteNumber(y);
+			}
+			else
+			{
+				if(j == 0)
+				{
+					WriteNumber(x);
+					Write(strDataSep);
+				}
+				WriteNumber(y);
+			}
+		}
+		if(!Write(pNewLine, 1))return false;
+	}
+	return !m_bFailed;
+}
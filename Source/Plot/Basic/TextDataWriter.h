@@ -0,0 +1,87 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#pragma warning(disable:4786)
+
+#include "PlotData.h"
+#include "NumberFormat.h"
+
+Declare_Namespace_CChart
+
+// Takes the text in chunks, returns false to stop the writing
+typedef bool	(*FcnTextSink)(const TCHAR *pText, int nLen, void *pPara);
+
+enum
+{
+	kTextLayoutSequence,	// the curves one after another, split by the file separator
+	kTextLayoutSeparateX,	// a row holds x and y of every curve
+	kTextLayoutSharedX,		// a row holds x of the first curve and y of every curve
+
+	kTextLayoutCount
+};
+
+// Writes data as text rows through a fixed buffer, to a file or to a sink.
+// Numbers are written as %.*g of the precision, the common cases without sprintf.
+// Precision 0 writes the shortest text that reads back to the same double
+class CTextDataWriter
+{
+public:
+	CTextDataWriter();
+	virtual ~CTextDataWriter();
+
+protected:
+	enum{kBuffSize = 16384};
+	TCHAR		m_pBuff[kBuffSize];
+	int			m_nUsed;
+
+	ofstream	m_ofs;
+	FcnTextSink	m_fcnSink;
+	void		*m_pSinkPara;
+	bool		m_bFailed;
+
+	int			m_nPrecision;
+	double		m_fChars;
+
+	bool		Flush();
+
+public:
+	// a text file, or a sink
+	bool		Open(tstring pathName);
+	void		SetSink(FcnTextSink fcnSink, void *pPara);
+	// flushes the buffer, returns false if any write failed
+	bool		Close();
+
+	inline	int		GetPrecision(){return m_nPrecision;}
+	inline	void	SetPrecision(int nPrecision){m_nPrecision = nPrecision<0 ? 0 : (nPrecision>17 ? 17 : nPrecision);}
+	// characters passed on so far
+	inline	double	GetCharCount(){return m_fChars + m_nUsed;}
+
+	bool		Write(const TCHAR *pText, int nLen);
+	inline	bool	Write(const tstring &str){return Write(str.c_str(), (int)str.length());}
+	bool		WriteNumber(double val);
+
+	bool		WriteCurves(std::vector<CPlotData<DataPoint2D> *> &vpData, int nLayout, const tstring &strDataSep, const tstring &strFileSep);
+
+	// a sink appending to the tstring at pPara
+	static	bool	AppendToString(const TCHAR *pText, int nLen, void *pPara);
+};
+
+Declare_Namespace_End
@@ -0,0 +1,116 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+//#include "StdAfx.h"
+#include "TextFileReader.h"
+
+using namespace NsCChart;
+
+CTextFileReader::CTextFileReader()
+{
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_nSize = 0;
+	m_nRead = 0;
+	m_nDone = 0;
+	m_nRawUsed = 0;
+	m_nLinesEnd = 0;
+}
+
+CTextFileReader::~CTextFileReader()
+{
+	Close();
+}
+
+bool	CTextFileReader::Open(tstring pathName, int nWindow)
+{
+	Close();
+	m_hFile = CreateFile(pathName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if(m_hFile == INVALID_HANDLE_VALUE)return false;
+
+	DWORD high = 0;
+	DWORD low = GetFileSize(m_hFile, &high);
+	m_nSize = ((__int64)high << 32) | low;
+	m_vRaw.resize(nWindow>=4096 ? nWindow : 4096);
+	return true;
+}
+
+void	CTextFileReader::Close()
+{
+	if(m_hFile != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_hFile);
+		m_hFile = INVALID_HANDLE_VALUE;
+	}
+	m_nSize = m_nRead = m_nDone = 0;
+	m_nRawUsed = m_nLinesEnd = 0;
+	std::vector<char>().swap(m_vRaw);
+#if defined(_UNICODE) || defined(UNICODE)
+	std::vector<wchar_t>().swap(m_vLines);
+#endif
+}
+
+bool	CTextFileReader::ReadLines(const TCHAR *&pBegin, const TCHAR *&pEnd)
+{
+	if(m_hFile == INVALID_HANDLE_VALUE)return false;
+
+	// the cut line goes to the front
+	if(m_nLinesEnd > 0)
+	{
+		memmove(&m_vRaw[0], &m_vRaw[m_nLinesEnd], m_nRawUsed - m_nLinesEnd);
+		m_nRawUsed -= m_nLinesEnd;
+		m_nLinesEnd = 0;
+	}
+
+	int n;
+	for(;;)
+	{
+		if(m_nRawUsed == (int)m_vRaw.size())m_vRaw.resize(m_vRaw.size() * 2);
+
+		DWORD nRead = 0;
+		if(m_nRead < m_nSize)
+		{
+			if(!ReadFile(m_hFile, &m_vRaw[m_nRawUsed], (DWORD)(m_vRaw.size() - m_nRawUsed), &nRead, NULL))return false;
+			m_nRawUsed += nRead;
+			m_nRead += nRead;
+		}
+		if(nRead == 0 || m_nRead >= m_nSize)
+		{
+			n = m_nRawUsed;
+			break;
+		}
+		for(n = m_nRawUsed; n > 0 && m_vRaw[n-1] != '\n'; n--);
+		if(n > 0)break;
+	}
+	if(n <= 0)return false;
+
+	m_nLinesEnd = n;
+	m_nDone += n;
+#if defined(_UNICODE) || defined(UNICODE)
+	int len = MultiByteToWideChar(CP_ACP, 0, &m_vRaw[0], n, NULL, 0);
+	if(len <= 0)return false;
+	m_vLines.resize(len);
+	MultiByteToWideChar(CP_ACP, 0, &m_vRaw[0], n, &m_vLines[0], len);
+	pBegin = &m_vLines[0];
+	pEnd = pBegin + len;
+#else
+	pBegin = &m_vRaw[0];
+	pEnd = pBegin + n;
+#endif
+	return true;
+}
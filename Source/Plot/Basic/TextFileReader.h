@@ -0,0 +1,67 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#pragma warning(disable:4786)
+
+#include <windows.h>
+#include <vector>
+#include "MyString.h"
+#include "CChartNameSpace.h"
+
+Declare_Namespace_CChart
+
+// Progress of a load from 0 to 1, return false to cancel
+typedef bool	(*FcnLoadProgress)(double fDone, void *pPara);
+
+// Reads a text file in windows of a fixed size and hands out whole lines, a line cut by the
+// end of a window is carried into the next one. Only a line longer than the window grows it
+class CTextFileReader
+{
+public:
+	CTextFileReader();
+	virtual ~CTextFileReader();
+
+	enum{kDefaultWindow = 4194304};
+
+protected:
+	HANDLE		m_hFile;
+	__int64		m_nSize, m_nRead, m_nDone;
+
+	std::vector<char>	m_vRaw;
+	int			m_nRawUsed, m_nLinesEnd;
+#if defined(_UNICODE) || defined(UNICODE)
+	std::vector<wchar_t>	m_vLines;
+#endif
+
+public:
+	bool		Open(tstring pathName, int nWindow = kDefaultWindow);
+	void		Close();
+
+	inline	__int64	GetSize(){return m_nSize;}
+	// bytes of the lines handed out so far
+	inline	__int64	GetDone(){return m_nDone;}
+	inline	double	GetProgress(){return m_nSize>0 ? (double)m_nDone/(double)m_nSize : 1.0;}
+
+	// the next lines, up to the last line end of the window or the end of the file, false when none is left
+	bool		ReadLines(const TCHAR *&pBegin, const TCHAR *&pEnd);
+};
+
+Declare_Namespace_End
@@ -0,0 +1,459 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#include "TimeParser.h"
+#include <time.h>
+#include <math.h>
+#include <tchar.h>
+#include "mytime.h"
+
+using namespace NsCChart;
+
+static const TCHAR *s_pMonNames[12] =
+{
+	_TEXT("january"), _TEXT("february"), _TEXT("march"), _TEXT("april"), _TEXT("may"), _TEXT("june"),
+	_TEXT("july"), _TEXT("august"), _TEXT("september"), _TEXT("october"), _TEXT("november"), _TEXT("december")
+};
+static const TCHAR *s_pDayNames[7] =
+{
+	_TEXT("sunday"), _TEXT("monday"), _TEXT("tuesday"), _TEXT("wednesday"), _TEXT("thursday"), _TEXT("friday"), _TEXT("saturday")
+};
+
+static inline bool	IsDigit(TCHAR c)
+{
+	return c>=_TEXT('0') && c<=_TEXT('9');
+}
+
+static inline TCHAR	ToLower(TCHAR c)
+{
+	return (c>=_TEXT('A') && c<=_TEXT('Z')) ? TCHAR(c - _TEXT('A') + _TEXT('a')) : c;
+}
+
+// Same as conv_num of strptime, the upper limit also limits the digits, so %Y%m%d reads 20191015
+static const TCHAR	*ParseNum(const TCHAR *str, int &val, int nLow, int nHigh)
+{
+	if(!IsDigit(*str))return 0;
+	int result = 0, rulim = nHigh;
+	do
+	{
+		result = result*10 + (*str++ - _TEXT('0'));
+		rulim /= 10;
+	}while(result*10 <= nHigh && rulim && IsDigit(*str));
+	if(result<nLow || result>nHigh)return 0;
+	val = result;
+	return str;
+}
+
+// Exactly n digits
+static const TCHAR	*ParseDigits(const TCHAR *str, int n, int &val)
+{
+	int result = 0;
+	for(int i=0; i<n; i++)
+	{
+		if(!IsDigit(str[i]))return 0;
+		result = result*10 + (str[i] - _TEXT('0'));
+	}
+	val = result;
+	return str + n;
+}
+
+// Digits after the point, beyond nanoseconds they are skipped
+static const TCHAR	*ParseFrac(const TCHAR *str, double &frac)
+{
+	if(!IsDigit(*str))return 0;
+	double val = 0.0, scale = 1.0;
+	int n = 0;
+	while(IsDigit(*str))
+	{
+		if(n<9)
+		{
+			val = val*10.0 + (*str - _TEXT('0'));
+			scale *= 10.0;
+			n++;
+		}
+		str++;
+	}
+	frac = val/scale;
+	return str;
+}
+
+// Z, +hh, +hhmm or +hh:mm, in seconds east of UTC
+static const TCHAR	*ParseOffset(const TCHAR *str, int &offset)
+{
+	if(*str==_TEXT('Z') || *str==_TEXT('z'))
+	{
+		offset = 0;
+		return str+1;
+	}
+	if(*str!=_TEXT('+') && *str!=_TEXT('-'))return 0;
+	int sign = (*str==_TEXT('-'))?-1:1;
+	int hour, minute = 0;
+	str = ParseDigits(str+1, 2, hour);
+	if(!str || hour>23)return 0;
+	if(*str==_TEXT(':'))
+	{
+		str = ParseDigits(str+1, 2, minute);
+		if(!str)return 0;
+	}
+	else if(IsDigit(*str))
+	{
+		str = ParseDigits(str, 2, minute);
+		if(!str)return 0;
+	}
+	if(minute>59)return 0;
+	offset = sign*(hour*3600 + minute*60);
+	return str;
+}
+
+// Full or three letter name, case insensitive
+static const TCHAR	*ParseName(const TCHAR *str, const TCHAR **pNames, int nNames, int &val)
+{
+	for(int i=0; i<nNames; i++)
+	{
+		const TCHAR *name = pNames[i];
+		int n = 0;
+		while(name[n] && ToLower(str[n])==name[n])n++;
+		if(name[n]==0 || n>=3)
+		{
+			val = i;
+			return str + (name[n]==0 ? n : 3);
+		}
+	}
+	return 0;
+}
+
+// Days from 1970-01-01 of a date of the proleptic Gregorian calendar
+static double	DaysFromCivil(int y, int m, int d)
+{
+	y -= (m<=2)?1:0;
+	int era = (y>=0 ? y : y-399)/400;
+	int yoe = y - era*400;
+	int doy = (153*(m + (m>2 ? -3 : 9)) + 2)/5 + d - 1;
+	int doe = yoe*365 + yoe/4 - yoe/100 + doy;
+	return era*146097.0 + doe - 719468.0;
+}
+
+CTimeParser::CTimeParser(const TCHAR *fmt)
+{
+	for(int i=0; i<kOffsetCacheSize; i++)
+	{
+		// not a whole hour, never matches
+		m_pfOffsetHour[i] = 0.5;
+		m_pfOffset[i] = 0.0;
+	}
+	SetFormat(fmt);
+}
+
+CTimeParser::~CTimeParser()
+{
+
+}
+
+void	CTimeParser::SetFormat(const TCHAR *fmt)
+{
+	m_strFmt = fmt?fmt:_TEXT("");
+	m_bISO = m_strFmt.length()==0;
+	m_bFast = true;
+
+	const TCHAR *p = m_strFmt.c_str();
+	while(*p)
+	{
+		if(*p++ != _TEXT('%'))continue;
+		if(*p==0 || _tcschr(_TEXT("CEO"), *p))
+		{
+			m_bFast = false;
+			break;
+		}
+		p++;
+	}
+}
+
+const TCHAR	*CTimeParser::ParseFormat(const TCHAR *str, const TCHAR *fmt, stFields &fields)
+{
+	int val;
+	TCHAR c;
+	bool bPadded;
+	// where the last space of the format stopped, if it took any
+	const TCHAR *pSpaced = 0, *pFrom, *pDay;
+	while((c = *fmt++) != 0)
+	{
+		if(_istspace(c))
+		{
+			pFrom = str;
+			while(_istspace(*str))str++;
+			if(str != pFrom)pSpaced = str;
+			continue;
+		}
+		if(c != _TEXT('%'))
+		{
+			if(*str++ != c)return 0;
+			continue;
+		}
+
+		switch(c = *fmt++)
+		{
+		case _TEXT('%'):
+			if(*str++ != c)return 0;
+			break;
+		case _TEXT('Y'):
+			if(!(str = ParseNum(str, fields.nYear, 0, 9999)))return 0;
+			break;
+		case _TEXT('y'):
+			if(!(str = ParseNum(str, val, 0, 99)))return 0;
+			fields.nYear = val<=68 ? 2000+val : 1900+val;
+			break;
+		case _TEXT('m'):
+			if(!(str = ParseNum(str, fields.nMon, 1, 12)))return 0;
+			break;
+		case _TEXT('d'):
+			if(!(str = ParseNum(str, fields.nDay, 1, 31)))return 0;
+			break;
+		case _TEXT('e'):
+			// a one digit day is padded with a space, which a space of the format may have taken
+			bPadded = (*str==_TEXT(' ')) || (str==pSpaced);
+			pDay = (*str==_TEXT(' ')) ? str+1 : str;
+			if(!(str = ParseNum(pDay, fields.nDay, 1, 31)))return 0;
+			if(str-pDay==1 && !bPadded)return 0;
+			break;
+		case _TEXT('H'):
+		case _TEXT('k'):
+			if(!(str = ParseNum(str, fields.nHour, 0, 23)))return 0;
+			break;
+		case _TEXT('I'):
+		case _TEXT('l'):
+			if(!(str = ParseNum(str, fields.nHour, 1, 12)))return 0;
+			if(fields.nHour==12)fields.nHour = 0;
+			break;
+		case _TEXT('M'):
+			if(!(str = ParseNum(str, fields.nMin, 0, 59)))return 0;
+			break;
+		case _TEXT('S'):
+			if(!(str = ParseNum(str, fields.nSec, 0, 61)))return 0;
+			// a fraction the format does not mention
+			if((*str==_TEXT('.') || *str==_TEXT(',')) && IsDigit(str[1]) && *fmt!=*str)
+			{
+				str = ParseFrac(str+1, fields.fFrac);
+			}
+			break;
+		case _TEXT('f'):
+			if(!(str = ParseFrac(str, fields.fFrac)))return 0;
+			break;
+		case _TEXT('z'):
+			if(!(str = ParseOffset(str, fields.nOffset)))return 0;
+			fields.bOffset = true;
+			break;
+		case _TEXT('p'):
+			if(ToLower(str[0])==_TEXT('a') && ToLower(str[1])==_TEXT('m'))fields.nAmPm = 1;
+			else if(ToLower(str[0])==_TEXT('p') && ToLower(str[1])==_TEXT('m'))fields.nAmPm = 2;
+			else return 0;
+			str += 2;
+			break;
+		case _TEXT('b'):
+		case _TEXT('B'):
+		case _TEXT('h'):
+			if(!(str = ParseName(str, s_pMonNames, 12, val)))return 0;
+			fields.nMon = val+1;
+			break;
+		case _TEXT('a'):
+		case _TEXT('A'):
+			if(!(str = ParseName(str, s_pDayNames, 7, val)))return 0;
+			break;
+		// checked and dropped, as mktime did
+		case _TEXT('j'):
+			if(!(str = ParseNum(str, val, 1, 366)))return 0;
+			break;
+		case _TEXT('U'):
+		case _TEXT('W'):
+			if(!(str = ParseNum(str, val, 0, 53)))return 0;
+			break;
+		case _TEXT('w'):
+			if(!(str = ParseNum(str, val, 0, 6)))return 0;
+			break;
+		case _TEXT('T'):
+		case _TEXT('X'):
+			if(!(str = ParseFormat(str, _TEXT("%H:%M:%S"), fields)))return 0;
+			break;
+		case _TEXT('R'):
+			if(!(str = ParseFormat(str, _TEXT("%H:%M"), fields)))return 0;
+			break;
+		case _TEXT('r'):
+			if(!(str = ParseFormat(str, _TEXT("%I:%M:%S %p"), fields)))return 0;
+			break;
+		case _TEXT('D'):
+		case _TEXT('x'):
+			if(!(str = ParseFormat(str, _TEXT("%m/%d/%y"), fields)))return 0;
+			break;
+		case _TEXT('c'):
+			if(!(str = ParseFormat(str, _TEXT("%m/%d/%y %H:%M:%S"), fields)))return 0;
+			break;
+		case _TEXT('F'):
+			if(!(str = ParseFormat(str, _TEXT("%Y-%m-%d"), fields)))return 0;
+			break;
+		case _TEXT('n'):
+		case _TEXT('t'):
+			while(_istspace(*str))str++;
+			break;
+		default:
+			return 0;
+		}
+	}
+	return str;
+}
+
+// YYYY-MM-DD or YYYYMMDD, then optionally T or a space and hh:mm[:ss[.fff]] or hhmm[ss[.fff]],
+// then optionally Z or +hh[:mm]
+bool	CTimeParser::ParseISO(const TCHAR *str, stFields &fields)
+{
+	while(_istspace(*str))str++;
+	if(!(str = ParseDigits(str, 4, fields.nYear)))return false;
+	bool bExtended = (*str==_TEXT('-'));
+	if(bExtended)str++;
+	if(!(str = ParseDigits(str, 2, fields.nMon)))return false;
+	if(bExtended)
+	{
+		if(*str==_TEXT('-'))
+		{
+			if(!(str = ParseDigits(str+1, 2, fields.nDay)))return false;
+		}
+	}
+	else
+	{
+		if(!(str = ParseDigits(str, 2, fields.nDay)))return false;
+	}
+	if(fields.nMon<1 || fields.nMon>12 || fields.nDay<1 || fields.nDay>31)return false;
+
+	if((*str==_TEXT('T') || *str==_TEXT('t') || *str==_TEXT(' ')) && IsDigit(str[1]))
+	{
+		str++;
+		if(!(str = ParseDigits(str, 2, fields.nHour)))return false;
+		if(*str==_TEXT(':'))str++;
+		if(!(str = ParseDigits(str, 2, fields.nMin)))return false;
+		if(*str==_TEXT(':') && IsDigit(str[1]))str++;
+		if(IsDigit(*str))
+		{
+			if(!(str = ParseDigits(str, 2, fields.nSec)))return false;
+			if((*str==_TEXT('.') || *str==_TEXT(',')) && IsDigit(str[1]))
+			{
+				str = ParseFrac(str+1, fields.fFrac);
+			}
+		}
+		if(fields.nHour>24 || fields.nMin>59 || fields.nSec>60)return false;
+		// 24:00 is the end of the day, nothing later
+		if(fields.nHour==24 && (fields.nMin>0 || fields.nSec>0 || fields.fFrac>0.0))return false;
+	}
+
+	while(*str==_TEXT(' '))str++;
+	if(*str==_TEXT('Z') || *str==_TEXT('z') || *str==_TEXT('+') || *str==_TEXT('-'))
+	{
+		if(!(str = ParseOffset(str, fields.nOffset)))return false;
+		fields.bOffset = true;
+	}
+	while(_istspace(*str))str++;
+	return *str==0;
+}
+
+bool	CTimeParser::ParseSlow(const TCHAR *str, double &fTime)
+{
+	struct tm myTm = {0};
+	str = _tcsptime(str, m_strFmt.c_str(), &myTm);
+	if(!str)return false;
+	while(_istspace(*str))str++;
+	if(*str)return false;
+	// let mktime find out whether daylight saving is in effect
+	myTm.tm_isdst = -1;
+	time_t t = mktime(&myTm);
+	if(t == (time_t)-1)return false;
+	fTime = (double)t;
+	return true;
+}
+
+double	CTimeParser::GetLocalOffset(const stFields &fields, double fHourStart)
+{
+	double fHour = floor(fHourStart/3600.0);
+	int nSlot = (int)(fHour - floor(fHour/kOffsetCacheSize)*kOffsetCacheSize);
+	if(m_pfOffsetHour[nSlot] == fHourStart)return m_pfOffset[nSlot];
+
+	double fOffset;
+	struct tm myTm = {0};
+	myTm.tm_year = fields.nYear - 1900;
+	myTm.tm_mon = fields.nMon - 1;
+	myTm.tm_mday = fields.nDay;
+	myTm.tm_hour = fields.nHour;
+	myTm.tm_isdst = -1;
+	time_t t = mktime(&myTm);
+	if(t != (time_t)-1)
+	{
+		fOffset = (double)t - fHourStart;
+	}
+	else
+	{
+		// out of the range of mktime, take the offset of the second day of 1970
+		struct tm refTm = {0};
+		refTm.tm_year = 70;
+		refTm.tm_mday = 2;
+		refTm.tm_isdst = -1;
+		t = mktime(&refTm);
+		fOffset = (t != (time_t)-1) ? (double)t - 86400.0 : 0.0;
+	}
+	m_pfOffsetHour[nSlot] = fHourStart;
+	m_pfOffset[nSlot] = fOffset;
+	return fOffset;
+}
+
+bool	CTimeParser::Parse(const TCHAR *str, double &fTime)
+{
+	if(!str)return false;
+	if(!m_bFast)return ParseSlow(str, fTime);
+
+	stFields fields;
+	fields.nYear = 1970;
+	fields.nMon = 1;
+	fields.nDay = 1;
+	fields.nHour = fields.nMin = fields.nSec = 0;
+	fields.nAmPm = 0;
+	fields.fFrac = 0.0;
+	fields.bOffset = false;
+	fields.nOffset = 0;
+
+	if(m_bISO)
+	{
+		if(!ParseISO(str, fields))return false;
+	}
+	else
+	{
+		str = ParseFormat(str, m_strFmt.c_str(), fields);
+		if(!str)return false;
+		// only spaces may follow what the format matched
+		while(_istspace(*str))str++;
+		if(*str)return false;
+		if(fields.nAmPm==2 && fields.nHour<12)fields.nHour += 12;
+	}
+
+	double fHourStart = DaysFromCivil(fields.nYear, fields.nMon, fields.nDay)*86400.0 + fields.nHour*3600.0;
+	double fSeconds = fields.nMin*60.0 + fields.nSec + fields.fFrac;
+	if(fields.bOffset)
+	{
+		fTime = fHourStart + fSeconds - fields.nOffset;
+	}
+	else
+	{
+		fTime = fHourStart + fSeconds + GetLocalOffset(fields, fHourStart);
+	}
+	return true;
+}
@@ -0,0 +1,68 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#include <windows.h>
+#include "MyString.h"
+#include "CChartNameSpace.h"
+
+Declare_Namespace_CChart
+
+// Converts time strings into epoch seconds, keeping the fraction of a second.
+// An empty format takes ISO-8601: 2019-10-15, 2019-10-15T08:30, 2019-10-15 08:30:05.25,
+// 20191015T083005Z or 2019-10-15T08:30:05.250+08:00.
+// Other formats use the directives of strptime, %S also takes a trailing .fff, %f is a
+// fraction and %z is Z or +hh[:mm]. %e takes a one digit day only after a space. A format with %C, %E or %O goes through strptime and mktime.
+// Times without an offset are local, mktime is called once for every hour met, not for every string
+class CTimeParser
+{
+public:
+	CTimeParser(const TCHAR *fmt = 0);
+	virtual	~CTimeParser();
+
+	void	SetFormat(const TCHAR *fmt);
+	inline	const tstring	&GetFormat(){return m_strFmt;}
+	inline	bool	IsFastFormat(){return m_bFast;}
+
+	bool	Parse(const TCHAR *str, double &fTime);
+
+protected:
+	struct	stFields
+	{
+		int		nYear, nMon, nDay, nHour, nMin, nSec, nAmPm;
+		double	fFrac;
+		bool	bOffset;
+		int		nOffset;
+	};
+
+	const TCHAR	*ParseFormat(const TCHAR *str, const TCHAR *fmt, stFields &fields);
+	bool		ParseISO(const TCHAR *str, stFields &fields);
+	bool		ParseSlow(const TCHAR *str, double &fTime);
+	double		GetLocalOffset(const stFields &fields, double fHourStart);
+
+	tstring	m_strFmt;
+	bool	m_bFast, m_bISO;
+
+	// offsets of local time by hour, direct mapped
+	enum{kOffsetCacheSize = 256};
+	double	m_pfOffsetHour[kOffsetCacheSize], m_pfOffset[kOffsetCacheSize];
+};
+
+Declare_Namespace_End
@@ -85,6 +85,9 @@ CXYPlotBasicImpl::CXYPlotBasicImpl()
 	InitGrid(CGlobal::MyGetModuleHandle());
 
 	m_fcnDefScreen = MyDefScreen;
+
+	m_pbDataRangeCached[0] = m_pbDataRangeCached[1] = false;
+	m_pbDataRangeLog[0] = m_pbDataRangeLog[1] = false;
 }
 
 CXYPlotBasicImpl::~CXYPlotBasicImpl()
@@ -132,6 +135,17 @@ int		CXYPlotBasicImpl::SelectByPoint( HDC hDC, POINT point )
 	}
 }
 
+// The pixels covered by a length in data units, with a slack for the rounding of the screen points,
+// -1 if the range is empty
+static long	HitPixels(double fLen, double *range, long nPixels)
+{
+	double fWidth = fabs(range[1] - range[0]);
+	if(!(fWidth > 0.0) || !(fLen >= 0.0))return -1;
+	double fPixels = fLen * nPixels / fWidth;
+	if(!(fPixels < kScreenLimit))return -1;
+	return (long)ceil(fPixels) + 2;
+}
+
 int		CXYPlotBasicImpl::GetNeareastPlotData( HDC hDC, POINT point )
 {
 	if(m_vpPlotData.size()<=0)return -1;
@@ -152,6 +166,17 @@ int		CXYPlotBasicImpl::GetNeareastPlotData( HDC hDC, POINT point )
 	double xMin, xMax;
 	double xm,x1;
 
+	// the tolerance in pixels, for the segments found by the hit grid
+	double xRange[2], yRange[2];
+	GetXRange(xRange);
+	GetYRange(yRange);
+	RECT plotRect = GetLastPlotRect();
+	long rx = HitPixels(dlM, xRange, Width(plotRect));
+	long ry = HitPixels(dlM, yRange, Height(plotRect));
+	std::vector<int> vSegs;
+	bool bGrid;
+	int k, nCand;
+
 	nIdx=-1;
 	for(i=0;i<GetPlotDataCount();i++)
 	{
@@ -162,33 +187,10 @@ int		CXYPlotBasicImpl::GetNeareastPlotData( HDC hDC, POINT point )
 		switch(m_vpPlotData[i]->nSLMode)
 		{
 		case kSLByFillArea:
-			POINT *myPoints;
-			int nPts4Fill;
-			myPoints = m_vpPlotData[i]->pPointsGdi;
-			nPts4Fill = m_vpPlotData[i]->nPts4Fill;
-
-			if(!myPoints)break;
-			
-			BeginPath(hDC);
-			Polyline(hDC, myPoints, nPts4Fill);
-			EndPath( hDC );
-
+			// the even-odd rule of the alternate fill mode, on the points of the last draw
+			if(m_vpPlotData[i]->HitFillArea(point) > 0)
 			{
-				HRGN hRgn = PathToRegion(hDC);
-				if(!hRgn)break;
-				
-				Region rgn(hRgn);
-				
-				if(PtInRegion(hRgn, point.x, point.y))
-				{
-					nIdx = i;
-				}
-				DeleteObject(hRgn);
-			}
-
-			if(nIdx>=0)
-			{
-				return GetDataID(nIdx);
+				return GetDataID(i);
 			}
 
 			break;
@@ -215,17 +217,24 @@ int		CXYPlotBasicImpl::GetNeareastPlotData( HDC hDC, POINT point )
 			}
 			else
 			{
-				for(j=1;j<dataSet->GetDataCount();j++)
+				// the segments around x if it is monotonic, else those near the point on the screen
+				int jFirst, jLast;
+				dataSet->GetXSegmentWindow(IsXLogarithm()?pow(10.0, data[0]):data[0], jFirst, jLast);
+				bGrid = !dataSet->IsXMonotonic() && rx >= 0 && ry >= 0 &&
+					dataSet->GetHitSegments(plotRect, xRange, yRange, point, rx, ry, vSegs);
+				nCand = bGrid ? (int)vSegs.size() : jLast - jFirst + 1;
+				for(k=0;k<nCand;k++)
 				{
+					j = bGrid ? vSegs[k] + 1 : jFirst + k;
 					if(IsXLogarithm())
 					{
-						xm = log10(dataSet->GetData()[j-1].val[0]);
-						x1 = log10(dataSet->GetData()[j].val[0]);
+						xm = log10(dataSet->GetDataAt(j-1).val[0]);
+						x1 = log10(dataSet->GetDataAt(j).val[0]);
 					}
 					else
 					{
-						xm = dataSet->GetData()[j-1].val[0];
-						x1 = dataSet->GetData()[j].val[0];
+						xm = dataSet->GetDataAt(j-1).val[0];
+						x1 = dataSet->GetDataAt(j).val[0];
 					}
 					if( (data[0]-xm)*(x1-data[0])>=0.0 )
 					{
@@ -253,6 +262,7 @@ int		CXYPlotBasicImpl::GetNeareastDataPoint( int dataID, HDC hDC, POINT point, d
 	if(pDataSet->GetDataCount()<=0)return -1;
 
 	int idx = GetIndex(dataID);
+	m_vpPlotData[idx]->GetDataRange();
 
 	double xMin, xMax;
 	if(IsXLogarithm())
@@ -276,17 +286,20 @@ int		CXYPlotBasicImpl::GetNeareastDataPoint( int dataID, HDC hDC, POINT point, d
 	double y1, dist = 1.0e90;
 	double xlo, xup, ylo, yup;
 
-	for(int i=1; i<pDataSet->GetDataCount(); i++)
+	// only the segments around x when it is monotonic
+	int iFirst, iLast;
+	pDataSet->GetXSegmentWindow(IsXLogarithm()?pow(10.0, data[0]):data[0], iFirst, iLast);
+	for(int i=iFirst; i<=iLast; i++)
 	{
 		if(IsXLogarithm())
 		{
-			xm = log10(pDataSet->GetData()[i-1].val[0]);
-			x1 = log10(pDataSet->GetData()[i].val[0]);
+			xm = log10(pDataSet->GetDataAt(i-1).val[0]);
+			x1 = log10(pDataSet->GetDataAt(i).val[0]);
 		}
 		else
 		{
-			xm = pDataSet->GetData()[i-1].val[0];
-			x1 = pDataSet->GetData()[i].val[0];
+			xm = pDataSet->GetDataAt(i-1).val[0];
+			x1 = pDataSet->GetDataAt(i).val[0];
 		}
 		if( (data[0]-xm)*(x1-data[0])>=0.0 )
 		{
@@ -296,24 +309,24 @@ int		CXYPlotBasicImpl::GetNeareastDataPoint( int dataID, HDC hDC, POINT point, d
 			
 			if(IsXLogarithm())
 			{
-				xlo = log10(pDataSet->GetData()[lo].val[0]);
-				xup = log10(pDataSet->GetData()[up].val[0]);
+				xlo = log10(pDataSet->GetDataAt(lo).val[0]);
+				xup = log10(pDataSet->GetDataAt(up).val[0]);
 			}
 			else
 			{
-				xlo = pDataSet->GetData()[lo].val[0];
-				xup = pDataSet->GetData()[up].val[0];
+				xlo = pDataSet->GetDataAt(lo).val[0];
+				xup = pDataSet->GetDataAt(up).val[0];
 			}
 			
 			if(IsYLogarithm())
 			{
-				ylo = log10(pDataSet->GetData()[lo].val[1]);
-				yup = log10(pDataSet->GetData()[up].val[1]);
+				ylo = log10(pDataSet->GetDataAt(lo).val[1]);
+				yup = log10(pDataSet->GetDataAt(up).val[1]);
 			}
 			else
 			{
-				ylo = pDataSet->GetData()[lo].val[1];
-				yup = pDataSet->GetData()[up].val[1];
+				ylo = pDataSet->GetDataAt(lo).val[1];
+				yup = pDataSet->GetDataAt(up).val[1];
 			}
 
 			if( xup - xlo != 0.0 )
@@ -339,24 +352,50 @@ int		CXYPlotBasicImpl::GetNeareastDP(int dataID, HDC hDC, POINT point)
 	int index = GetIndex(dataID);
 	if(index<0)return -1;
 
-	double range[2];
-	GetXRange(range);
-	double dlMx=(range[1]-range[0])/m_fHitPrecision;
-	GetYRange(range);
-	double dlMy=(range[1]-range[0])/m_fHitPrecision;
+	CPlotDataImpl<DataPoint2D> *pDataSet = GetAbsPlotData(index);
+	int nCount = pDataSet->GetDataCount();
+	if(nCount<=0)return -1;
+
+	double xRange[2], yRange[2];
+	GetXRange(xRange);
+	double dlMx=(xRange[1]-xRange[0])/m_fHitPrecision;
+	GetYRange(yRange);
+	double dlMy=(yRange[1]-yRange[0])/m_fHitPrecision;
+	if(!(dlMx > 0.0) || !(dlMy > 0.0))return -1;
 
-	int i;
-	double x1, y1;
 	double data[2];
 	LPToData(&point, data);
-	for(i=0; i<GetAbsPlotData(index)->GetDataCount(); i++)
-	{
-		x1 = GetAbsData(index)[i].def.x;
-		y1 = GetAbsData(index)[i].def.y;
-		if(fabs(x1-data[0])<dlMx && fabs(y1-data[1])<dlMy)
-			return i;
+
+	// the points near the point on the screen, or all of them
+	RECT plotRect = GetLastPlotRect();
+	long rx = HitPixels(dlMx, xRange, Width(plotRect));
+	long ry = HitPixels(dlMy, yRange, Height(plotRect));
+	std::vector<int> vPoints;
+	bool bGrid = rx >= 0 && ry >= 0 &&
+		pDataSet->GetHitPoints(plotRect, xRange, yRange, point, rx, ry, vPoints);
+	int nCand = bGrid ? (int)vPoints.size() : nCount;
+
+	// the nearest point within the precision, compared as drawn, in log10 on a log axis
+	int i, k, nNearest = -1;
+	double x1, y1, dx, dy, dist, dist0 = 2.0;
+	for(k=0; k<nCand; k++)
+	{
+		i = bGrid ? vPoints[k] : k;
+		x1 = pDataSet->GetDataAt(i).val[0];
+		y1 = pDataSet->GetDataAt(i).val[1];
+		if(IsXLogarithm())x1 = log10(x1);
+		if(IsYLogarithm())y1 = log10(y1);
+		dx = fabs(x1-data[0])/dlMx;
+		dy = fabs(y1-data[1])/dlMy;
+		if(!(dx<1.0 && dy<1.0))continue;
+		dist = dx*dx + dy*dy;
+		if(dist < dist0)
+		{
+			dist0 = dist;
+			nNearest = i;
+		}
 	}
-	return -1;
+	return nNearest;
 }
 
 void	CXYPlotBasicImpl::ApproachNearestIdx(int curIdx,int &nIdx,double *data,int lo,int up,double dlM,double &dl0)
@@ -369,27 +408,28 @@ void	CXYPlotBasicImpl::ApproachNearestIdxByY(int curIdx,int &nIdx,double *data,i
 	double dlt;
 	double x0=data[0],y0;
 	double xlo,xup,ylo,yup;
+	CPlotDataImpl<DataPoint2D> *pDataSet = GetAbsPlotData(curIdx);
 
 	if(IsXLogarithm())
 	{
-		xlo = log10(GetAbsData( curIdx )[lo].val[0]);
-		xup = log10(GetAbsData( curIdx )[up].val[0]);
+		xlo = log10(pDataSet->GetDataAt(lo).val[0]);
+		xup = log10(pDataSet->GetDataAt(up).val[0]);
 	}
 	else
 	{
-		xlo = GetAbsData( curIdx )[lo].val[0];
-		xup = GetAbsData( curIdx )[up].val[0];
+		xlo = pDataSet->GetDataAt(lo).val[0];
+		xup = pDataSet->GetDataAt(up).val[0];
 	}
 	
 	if(IsYLogarithm())
 	{
-		ylo = log10(GetAbsData( curIdx )[lo].val[1]);
-		yup = log10(GetAbsData( curIdx )[up].val[1]);
+		ylo = log10(pDataSet->GetDataAt(lo).val[1]);
+		yup = log10(pDataSet->GetDataAt(up).val[1]);
 	}
 	else
 	{
-		ylo = GetAbsData( curIdx )[lo].val[1];
-		yup = GetAbsData( curIdx )[up].val[1];
+		ylo = pDataSet->GetDataAt(lo).val[1];
+		yup = pDataSet->GetDataAt(up).val[1];
 	}
 	
 	if( xup - xlo != 0.0 )
@@ -505,6 +545,7 @@ bool		CXYPlotBasicImpl::CheckLogSafety(bool bX)
 	int i;
 	for(i=0; i<GetPlotDataCount(); i++)
 	{
+		GetAbsPlotData(i)->GetDataRange();
 		if( (bX?GetAbsPlotData(i)->GetXDataRange()[0]:GetAbsPlotData(i)->GetYDataRange()[0]) <=0.0 )return false;
 	}
 	return true;
@@ -512,6 +553,9 @@ bool		CXYPlotBasicImpl::CheckLogSafety(bool bX)
 
 void	CXYPlotBasicImpl::FinalDraw(HDC hDC, RECT destRect)
 {
+	// points staged by producer threads join the curves first
+	DrainIngestQueues();
+
 	//if there is no data, doing nothing
 	if(IsEmpty())
 	{
@@ -528,8 +572,11 @@ void	CXYPlotBasicImpl::FinalDraw(HDC hDC, RECT destRect)
 		}
 	}
 	
+	DRAW_STATS_FRAME_BEGIN(&m_DrawStats);
 	double xRange[2], yRange[2];
+	DRAW_STATS_BEGIN(&m_DrawStats, kDrawPhasePlotRange);
 	GetPlotRange(xRange, yRange);
+	DRAW_STATS_END(&m_DrawStats, kDrawPhasePlotRange);
 
 	SetPlotColors();
 	SetPlotLineStyles();
@@ -545,6 +592,7 @@ void	CXYPlotBasicImpl::FinalDraw(HDC hDC, RECT destRect)
 	{
 		memdc->CreateMemDC(hDC, NULL, &destRect);
 		hdc = memdc;
+		DRAW_STATS_COUNT(&m_DrawStats, kDrawCountAllocations, 1);
 	}
 
 //	EnterCriticalSection(&m_csPlot);
@@ -559,6 +607,14 @@ void	CXYPlotBasicImpl::FinalDraw(HDC hDC, RECT destRect)
 	RestoreDC(hDC, saveDC );
 	DeleteObject(hRgn);
 //	LeaveCriticalSection(&m_csPlot);
+
+	if(m_bDoubleBuffer)
+	{
+		DRAW_STATS_BEGIN(&m_DrawStats, kDrawPhaseBlit);
+		memdc->Flush();
+		DRAW_STATS_END(&m_DrawStats, kDrawPhaseBlit);
+	}
+	DRAW_STATS_FRAME_END(&m_DrawStats);
 }
 
 void	CXYPlotBasicImpl::DrawDefScreen(HDC hDC, RECT destRect)
@@ -589,14 +645,31 @@ void	CXYPlotBasicImpl::GetDataRange1D( int whichDim, double *range )
 	}
 
 	bool bX = (whichDim==0)?true:false;
+	bool bLog = bX?IsXLogarithm():IsYLogarithm();
+
+	// every curve range change renews its stamp, so equal stamps mean an equal result
+	int nDim = bX?0:1;
+	vector<unsigned int> &vStamps = m_vDataRangeStamps[nDim];
+	bool bHit = m_pbDataRangeCached[nDim] && m_pbDataRangeLog[nDim]==bLog && (int)vStamps.size()==GetPlotDataCount();
+	for(i = 0; i<GetPlotDataCount() && bHit; i++)
+	{
+		if(vStamps[i] != (m_vpPlotData[i]->GetDataCount()>0?m_vpPlotData[i]->GetDataRangeStamp():0))bHit = false;
+	}
+	if(bHit)
+	{
+		memcpy(range, m_pfDataRangeCache[nDim], 2*sizeof(double));
+		DRAW_STATS_COUNT(&m_DrawStats, kDrawCountRangeHits, 1);
+		return;
+	}
+	DRAW_STATS_COUNT(&m_DrawStats, kDrawCountRangeMisses, 1);
 
 	int count = 0;
 	for( i = 0; i < GetPlotDataCount(); i++ )
 	{
-		if(m_vpPlotData[i]->GetData().size()<=0)continue;
+		if(m_vpPlotData[i]->GetDataCount()<=0)continue;
 		count++;
 		
-		if(bX?IsXLogarithm():IsYLogarithm())
+		if(bLog)
 		{
 			range[0] = min( range[0], log10(bX?m_vpPlotData[i]->GetXDataRange()[0]:m_vpPlotData[i]->GetYDataRange()[0]) );
 			range[1] = max( range[1], log10(bX?m_vpPlotData[i]->GetXDataRange()[1]:m_vpPlotData[i]->GetYDataRange()[1]) );
@@ -625,6 +698,15 @@ void	CXYPlotBasicImpl::GetDataRange1D( int whichDim, double *range )
 		range[0] = 0;
 		range[1] = 10;
 	}
+
+	vStamps.resize(GetPlotDataCount());
+	for(i = 0; i<GetPlotDataCount(); i++)
+	{
+		vStamps[i] = m_vpPlotData[i]->GetDataCount()>0?m_vpPlotData[i]->GetDataRangeStamp():0;
+	}
+	memcpy(m_pfDataRangeCache[nDim], range, 2*sizeof(double));
+	m_pbDataRangeLog[nDim] = bLog;
+	m_pbDataRangeCached[nDim] = true;
 }
 
 void	CXYPlotBasicImpl::GetPlotRange1D( int whichDim, double *range )
@@ -61,6 +61,13 @@ public:
 	bool				CheckLogSafety();
 	bool				CheckLogSafety(bool bX);
 
+protected:
+	// plot level data range, valid while no curve range stamp changes
+	double				m_pfDataRangeCache[2][2];
+	bool				m_pbDataRangeCached[2];
+	bool				m_pbDataRangeLog[2];
+	vector<unsigned int>	m_vDataRangeStamps[2];
+
 protected:
 	void				DrawDefScreen(HDC hDC, RECT destRect);
 
@@ -59,12 +59,14 @@ int		CXYPlotImpl::GetDataIDByPoint( HDC hDC, POINT point )
 
 void	CXYPlotImpl::FinalDraw(HDC hDC, RECT destRect)
 {
+	DrainIngestQueues();
 	if(IsEmpty())
 	{
 		DrawDefScreen(hDC, destRect);
 		return;
 	}
 	
+	DRAW_STATS_FRAME_BEGIN(&m_DrawStats);
 	HDC hdc;
 	CMyMemDC memdc;
 	if(!m_bDoubleBuffer)
@@ -75,13 +77,92 @@ void	CXYPlotImpl::FinalDraw(HDC hDC, RECT destRect)
 	{
 		memdc->CreateMemDC(hDC, NULL, &destRect);
 		hdc = memdc;
+		DRAW_STATS_COUNT(&m_DrawStats, kDrawCountAllocations, 1);
 	}
 	bool bDB = IsDoubleBuffer();
 	SetDoubleBuffer(false);
 	CXYPlotBasicImpl::FinalDraw(hdc, destRect);
 	SetDoubleBuffer(bDB);
 	
+	DRAW_STATS_BEGIN(&m_DrawStats, kDrawPhaseLegend);
 	DrawLegend(hdc);
+	DRAW_STATS_END(&m_DrawStats, kDrawPhaseLegend);
+
+	if(m_bDoubleBuffer)
+	{
+		DRAW_STATS_BEGIN(&m_DrawStats, kDrawPhaseBlit);
+		memdc->Flush();
+		DRAW_STATS_END(&m_DrawStats, kDrawPhaseBlit);
+	}
+	DRAW_STATS_FRAME_END(&m_DrawStats);
+}
+
+bool	CXYPlotImpl::RenderToBuffer( CRasterSurface &surface )
+{
+	int width = surface.GetWidth(), height = surface.GetHeight();
+	if(width<=0 || height<=0)return false;
+
+	surface.SetClip(0);
+	surface.Clear(GetBkgndColor());
+
+	DrainIngestQueues();
+	// the default screen and the log warning need a device, the background is left
+	if(IsEmpty())return true;
+	if(IsXLogarithm() || IsYLogarithm())
+	{
+		if(!CheckLogSafety())return true;
+	}
+
+	// the ranges give the tick labels, so they come before the layout
+	double xRange[2], yRange[2];
+	GetPlotRange(xRange, yRange);
+
+	RECT destRect = {0, 0, width, height};
+	m_rctClient = destRect;
+	m_rctPlot = GetPlotRect(&surface, destRect);
+
+	if(!m_bNothingElse)
+	{
+		DrawCanvas(&surface);
+		DrawGrids(&surface);
+	}
+	DrawCurves(&surface, m_rctPlot, xRange, yRange);
+	if(!m_bNothingElse)
+	{
+		DrawAxes(&surface);
+	}
+	return true;
+}
+
+void	CXYPlotImpl::DrawCurves( CDrawSurface *pSurface, RECT plotRect )
+{
+	if(IsEmpty())return;
+	if(IsXLogarithm() || IsYLogarithm())
+	{
+		if(!CheckLogSafety())return;
+	}
+
+	double xRange[2], yRange[2];
+	GetPlotRange(xRange, yRange);
+
+	DrawCurves(pSurface, plotRect, xRange, yRange);
+}
+
+void	CXYPlotImpl::DrawCurves( CDrawSurface *pSurface, RECT plotRect, double *xRange, double *yRange )
+{
+	SetPlotColors();
+	SetPlotLineStyles();
+	SetPlotLineSizes();
+
+	// the plot data are drawn in the rect given, as the window path draws in the last plot rect
+	m_rctPlot = plotRect;
+	pSurface->SetClip(&plotRect);
+	int i;
+	for(i=0; i<GetPlotDataCount(); i++)
+	{
+		DrawSinglePlotData(i, pSurface, xRange, yRange);
+	}
+	pSurface->SetClip(0);
 }
 
 
@@ -160,6 +241,7 @@ tstring		CXYPlotImplI::GetDescriptionByMousePos(HDC hDC, POINT point)
 
 	tostringstream ostr;
 	tstring str = _TEXT("");
+	TCHAR strNum[CNumberFormat::kMinBuffSize];
 	switch(m_nPointDesType)
 	{
 	case kDesCoords:
@@ -194,14 +276,16 @@ tstring		CXYPlotImplI::GetDescriptionByMousePos(HDC hDC, POINT point)
 			switch(CGlobal::m_nLangurage)
 			{
 			case kLangEnglish:
-				ostr<<_TEXT("Mouse point data: ")<<data[0]<<_TEXT(", ")<<data[1];
+				str = _TEXT("Mouse point data: ");
 				break;
 			case kLangChinese:
-				ostr<<_TEXT(": ")<<data[0]<<_TEXT(", ")<<data[1];
+				str = _TEXT(": ");
 				break;
 			}
+			str.append(strNum, CNumberFormat::FormatG(strNum, data[0], 6));
+			str += _TEXT(", ");
+			str.append(strNum, CNumberFormat::FormatG(strNum, data[1], 6));
 		}
-		str = ostr.str();
 		break;
 	case kDesXAndYAll:
 		if(GetPlotDataCount()<=0)
@@ -248,15 +332,11 @@ tstring		CXYPlotImplI::GetDescriptionByMousePos(HDC hDC, POINT point)
 		}
 		for(i=0; i<GetPlotDataCount(); i++)
 		{
-			if(GetAbsData(i).size()==0)continue;
-			ostr.str(_TEXT(""));
-			ostr<<fixed<<setprecision(2)<<data[0]-m_vpPlotData[i]->fOffsetX;
-			str += ostr.str();
+			if(GetAbsPlotData(i)->GetDataCount()==0)continue;
+			str.append(strNum, CNumberFormat::FormatFixed(strNum, CNumberFormat::kMinBuffSize, data[0]-m_vpPlotData[i]->fOffsetX, 2));
 			if(i!=GetPlotDataCount()-1)
 			{
-				ostr.str(_TEXT(""));
-				ostr<<_TEXT(",");
-				str += ostr.str();
+				str += _TEXT(",");
 			}
 		}
 		switch(CGlobal::m_nLangurage)
@@ -274,15 +354,11 @@ tstring		CXYPlotImplI::GetDescriptionByMousePos(HDC hDC, POINT point)
 		}
 		for(i=0; i<GetPlotDataCount(); i++)
 		{
-			if(GetAbsData(i).size()==0)continue;
-			ostr.str(_TEXT(""));
-			ostr<<fixed<<setprecision(2)<<GetValueFromX(data[0], i)-m_vpPlotData[i]->fOffsetY;
-			str += ostr.str();
+			if(GetAbsPlotData(i)->GetDataCount()==0)continue;
+			str.append(strNum, CNumberFormat::FormatFixed(strNum, CNumberFormat::kMinBuffSize, GetValueFromX(data[0], i)-m_vpPlotData[i]->fOffsetY, 2));
 			if(i!=GetPlotDataCount()-1)
 			{
-				ostr.str(_TEXT(""));
-				ostr<<_TEXT(",");
-				str += ostr.str();
+				str += _TEXT(",");
 			}
 		}
 		break;
@@ -290,11 +366,11 @@ tstring		CXYPlotImplI::GetDescriptionByMousePos(HDC hDC, POINT point)
 		for(i=0; i<GetPlotDataCount(); i++)
 		{
 			bool handled = false;
-			if(GetAbsData(i).size()==0)continue;
-			for(int j=0; j<(int)GetAbsData(i).size(); j++)
+			if(GetAbsPlotData(i)->GetDataCount()==0)continue;
+			for(int j=0; j<GetAbsPlotData(i)->GetDataCount(); j++)
 			{
 				POINT scnPt;
-				DataToLP((double *)(GetAbsData(i)[j].val), &scnPt);
+				DataToLP((double *)(GetAbsPlotData(i)->GetDataAt(j).val), &scnPt);
 
 				if(abs(point.x - scnPt.x)<=m_nPointDesAccuracy && abs(point.y - scnPt.y)<=m_nPointDesAccuracy)
 				{
@@ -302,13 +378,17 @@ tstring		CXYPlotImplI::GetDescriptionByMousePos(HDC hDC, POINT point)
 					switch(CGlobal::m_nLangurage)
 					{
 					case kLangEnglish:
-						ostr<<fixed<<setprecision(2)<<_TEXT("Curve No:")<<i+1<<_TEXT("\nData point: ")<<GetAbsData(i)[j].def.x<<","<<GetAbsData(i)[j].def.y;
+						ostr<<_TEXT("Curve No:")<<i+1<<_TEXT("\nData point: ");
 						break;
 					case kLangChinese:
-						ostr<<fixed<<setprecision(2)<<_TEXT(":")<<i+1<<_TEXT("\nݵ: ")<<GetAbsData(i)[j].def.x<<","<<GetAbsData(i)[j].def.y;
+						ostr<<_TEXT(":")<<i+1<<_TEXT("\nݵ: ");
 						break;
 					}
 					str += ostr.str();
+					// the stored values, exactly
+					str.append(strNum, CNumberFormat::FormatShortest(strNum, GetAbsPlotData(i)->GetDataAt(j).def.x));
+					str += _TEXT(",");
+					str.append(strNum, CNumberFormat::FormatShortest(strNum, GetAbsPlotData(i)->GetDataAt(j).def.y));
 					handled = true;
 					break;
 				}
@@ -460,12 +540,14 @@ Elements:
 
 void	CXYPlotImplI::FinalDraw(HDC hDC, RECT destRect)
 {
+	DrainIngestQueues();
 	if(IsEmpty())
 	{
 		DrawDefScreen(hDC, destRect);
 		return;
 	}
 
+	DRAW_STATS_FRAME_BEGIN(&m_DrawStats);
 	HDC hdc;
 	CMyMemDC memdc;
 	if(!m_bDoubleBuffer)
@@ -476,6 +558,7 @@ void	CXYPlotImplI::FinalDraw(HDC hDC, RECT destRect)
 	{
 		memdc->CreateMemDC(hDC, NULL, &destRect);
 		hdc = memdc;
+		DRAW_STATS_COUNT(&m_DrawStats, kDrawCountAllocations, 1);
 	}
 	bool bDB = IsDoubleBuffer();
 	SetDoubleBuffer(false);
@@ -488,5 +571,13 @@ void	CXYPlotImplI::FinalDraw(HDC hDC, RECT destRect)
 	}
 
 	DrawOscilloScope(hdc);
+
+	if(m_bDoubleBuffer)
+	{
+		DRAW_STATS_BEGIN(&m_DrawStats, kDrawPhaseBlit);
+		memdc->Flush();
+		DRAW_STATS_END(&m_DrawStats, kDrawPhaseBlit);
+	}
+	DRAW_STATS_FRAME_END(&m_DrawStats);
 }
 
@@ -50,6 +50,12 @@ public:
 	
 public:
 	virtual	void		FinalDraw( HDC hDC, RECT destRect );
+	// Frame into the surface's pixels without GDI: canvas, grids, curves, axis lines, ticks and labels
+	bool				RenderToBuffer( CRasterSurface &surface );
+	// The plot data only, each through DrawSinglePlotData, through any surface
+	void				DrawCurves( CDrawSurface *pSurface, RECT plotRect );
+protected:
+	void				DrawCurves( CDrawSurface *pSurface, RECT plotRect, double *xRange, double *yRange );
 	
 public:
 	int					RegionIdentifyEx(HDC hDC, POINT point, bool &legendRegion, int &centerAxisRegion);
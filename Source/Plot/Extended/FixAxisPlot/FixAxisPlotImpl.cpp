@@ -407,13 +407,13 @@ int		CFixAxisPlotImpl::GetNeareastPlotData( HDC hDC, POINT point )
 				{
 					if(IsXLogarithm())
 					{
-						xm = log10(dataSet->GetData()[j-1].val[0]);
-						x1 = log10(dataSet->GetData()[j].val[0]);
+						xm = log10(dataSet->GetDataAt(j-1).val[0]);
+						x1 = log10(dataSet->GetDataAt(j).val[0]);
 					}
 					else
 					{
-						xm = dataSet->GetData()[j-1].val[0];
-						x1 = dataSet->GetData()[j].val[0];
+						xm = dataSet->GetDataAt(j-1).val[0];
+						x1 = dataSet->GetDataAt(j).val[0];
 					}
 					if( (data[0]-xm)*(x1-data[0])>=0.0 )
 					{
@@ -466,13 +466,13 @@ int		CFixAxisPlotImpl::GetNeareastDataPoint( int dataID, HDC hDC, POINT point, d
 	{		
 		if(IsXLogarithm())
 		{
-			xm = log10(pDataSet->GetData()[i-1].val[0]);
-			x1 = log10(pDataSet->GetData()[i].val[0]);
+			xm = log10(pDataSet->GetDataAt(i-1).val[0]);
+			x1 = log10(pDataSet->GetDataAt(i).val[0]);
 		}
 		else
 		{
-			xm = pDataSet->GetData()[i-1].val[0];
-			x1 = pDataSet->GetData()[i].val[0];
+			xm = pDataSet->GetDataAt(i-1).val[0];
+			x1 = pDataSet->GetDataAt(i).val[0];
 		}
 		if( (data[0]-xm)*(x1-data[0])>=0.0 )
 		{
@@ -482,24 +482,24 @@ int		CFixAxisPlotImpl::GetNeareastDataPoint( int dataID, HDC hDC, POINT point, d
 			
 			if(IsXLogarithm())
 			{
-				xlo = log10(pDataSet->GetData()[lo].val[0]);
-				xup = log10(pDataSet->GetData()[up].val[0]);
+				xlo = log10(pDataSet->GetDataAt(lo).val[0]);
+				xup = log10(pDataSet->GetDataAt(up).val[0]);
 			}
 			else
 			{
-				xlo = pDataSet->GetData()[lo].val[0];
-				xup = pDataSet->GetData()[up].val[0];
+				xlo = pDataSet->GetDataAt(lo).val[0];
+				xup = pDataSet->GetDataAt(up).val[0];
 			}
 			
 			if(IsYLogarithm())
 			{
-				ylo = log10(pDataSet->GetData()[lo].val[1]);
-				yup = log10(pDataSet->GetData()[up].val[1]);
+				ylo = log10(pDataSet->GetDataAt(lo).val[1]);
+				yup = log10(pDataSet->GetDataAt(up).val[1]);
 			}
 			else
 			{
-				ylo = pDataSet->GetData()[lo].val[1];
-				yup = pDataSet->GetData()[up].val[1];
+				ylo = pDataSet->GetDataAt(lo).val[1];
+				yup = pDataSet->GetDataAt(up).val[1];
 			}
 
 			if( xup - xlo != 0.0 )
@@ -715,6 +715,7 @@ tstring	CFixAxisPlotImplI::GetDescriptionByMousePos(HDC hDC, POINT point)
 	
 	tostringstream ostr;
 	tstring str;
+	TCHAR strNum[CNumberFormat::kMinBuffSize];
 	switch(m_nPointDesType)
 	{
 	case kDesCoords:
@@ -768,16 +769,12 @@ tstring	CFixAxisPlotImplI::GetDescriptionByMousePos(HDC hDC, POINT point)
 		}
 		for(i=0; i<GetPlotDataCount(); i++)
 		{
-			if(GetAbsData(i).size()==0)continue;
+			if(GetAbsPlotData(i)->GetDataCount()==0)continue;
 			LPToData(&point, data, i);
-			ostr.str(_TEXT(""));
-			ostr<<fixed<<setprecision(2)<<data[0]-GetAbsPlotData(i)->fOffsetX;
-			str += ostr.str();
+			str.append(strNum, CNumberFormat::FormatFixed(strNum, CNumberFormat::kMinBuffSize, data[0]-GetAbsPlotData(i)->fOffsetX, 2));
 			if(i!=GetPlotDataCount()-1)
 			{
-				ostr.str(_TEXT(""));
-				ostr<<_TEXT(",");
-				str += ostr.str();
+				str += _TEXT(",");
 			}
 		}
 		switch(CGlobal::m_nLangurage)
@@ -795,15 +792,11 @@ tstring	CFixAxisPlotImplI::GetDescriptionByMousePos(HDC hDC, POINT point)
 		}
 		for(i=0; i<GetPlotDataCount(); i++)
 		{
-			if(GetAbsData(i).size()==0)continue;
-			ostr.str(_TEXT(""));
-			ostr<<fixed<<setprecision(2)<<GetValueFromX(data[0], i)-GetAbsPlotData(i)->fOffsetY;
-			str += ostr.str();
+			if(GetAbsPlotData(i)->GetDataCount()==0)continue;
+			str.append(strNum, CNumberFormat::FormatFixed(strNum, CNumberFormat::kMinBuffSize, GetValueFromX(data[0], i)-GetAbsPlotData(i)->fOffsetY, 2));
 			if(i!=GetPlotDataCount()-1)
 			{
-				ostr.str(_TEXT(""));
-				ostr<<_TEXT(",");
-				str += ostr.str();
+				str += _TEXT(",");
 			}
 		}
 		break;
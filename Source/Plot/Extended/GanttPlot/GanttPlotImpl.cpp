@@ -144,6 +144,31 @@ void	CGanttPlotImpl::DrawSinglePlotData( int which, HDC hDC, double *xRange, dou
 	}	
 }
 
+// Without a device context only the gantt bar is drawn, the titles are formatted for GDI fonts
+void	CGanttPlotImpl::DrawSinglePlotData( int which, CDrawSurface *pSurface, double *xRange, double *yRange )
+{
+	if(which < 0 || which >= GetPlotDataCount())return;
+	if(pSurface->GetDC())
+	{
+		DrawSinglePlotData(which, pSurface->GetDC(), xRange, yRange);
+		return;
+	}
+
+	RECT plotRect = GetLastPlotRect();
+	RECT dataRect = GetDataRect(which, plotRect, xRange, yRange);
+
+	int dataID = GetDataID(which);
+
+	POINT pt[4];
+	pt[0].x = dataRect.left; pt[0].y = dataRect.top;
+	pt[1].x = dataRect.right-1; pt[1].y = dataRect.top;
+	pt[2].x = dataRect.right-1; pt[2].y = dataRect.bottom-1;
+	pt[3].x = dataRect.left; pt[3].y = dataRect.bottom-1;
+	pSurface->SetPen(GetPlotColor(dataID), GetPlotLineSize(dataID), GetPlotLineStyle(dataID));
+	pSurface->SetBrush(GetPlotColor(dataID));
+	pSurface->FillPolygon(pt, 4);
+}
+
 RECT		CGanttPlotImpl::GetDataRect( int which, RECT plotRect, double *xRange, double *yRange )
 {
 	RECT dataRect =  {0, 0, 0, 0};
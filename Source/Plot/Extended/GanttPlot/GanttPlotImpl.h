@@ -37,6 +37,7 @@ public:
 
 protected:
 	void	DrawSinglePlotData( int which, HDC hDC, double *xRange, double *yRange );
+	void	DrawSinglePlotData( int which, CDrawSurface *pSurface, double *xRange, double *yRange );
 	void	GetPlotRange( double *xRange, double *yRange );
 	RECT	GetDataRect( int which, RECT plotRect, double *xRange, double *yRange  );
 	void	GetGanttTitleRect( HDC hDC, RECT plotRect, tstring titleL, tstring titleR, RECT dataRect, RECT &leftRect, RECT &rightRect );
@@ -29,19 +29,87 @@ CHugePlotImpl::CHugePlotImpl()
 
 CHugePlotImpl::~CHugePlotImpl()
 {
-	int i;
-	for(i=0; i<GetPlotDataCount(); i++)
+	// the saved data are released by the plot data themselves
+}
+
+CHugePyramid	*CHugePlotImpl::GetPyramid(int dataID)
+{
+	std::map<int, CHugePyramid>::iterator it = m_mapPyramid.find(dataID);
+	if(it == m_mapPyramid.end())return 0;
+	return &it->second;
+}
+
+void	CHugePlotImpl::FinalDraw(HDC hDC, RECT destRect)
+{
+	// forget the pyramids of the deleted curves
+	std::map<int, CHugePyramid>::iterator it = m_mapPyramid.begin();
+	while(it != m_mapPyramid.end())
 	{
-		vector<DataPoint2D> *pData = GetAbsPlotData(i)->GetPDataSaved();
-		delete pData;
-		pData = 0;
+		if(GetIndex(it->first) < 0)m_mapPyramid.erase(it++);
+		else ++it;
 	}
+	
+	CXYPlotImpl::FinalDraw(hDC, destRect);
 }
 
-void	CHugePlotImpl::FinalDraw(HDC hDC, RECT destRect)
+// Only the pyramid nodes covering the visible range are drawn, no node is wider than one pixel column,
+// so a frame costs O(pixels + log n) after the appended points have been indexed
+bool	CHugePlotImpl::SelectPyramid( int which, double *xRange )
 {
-	//if there is no data, doing nothing
+	CPlotDataImpl<DataPoint2D> *pData = GetAbsPlotData(which);
+	RECT plotRect = GetLastPlotRect();
+	
+	MyLock();
+	CHugePyramid &pyramid = m_mapPyramid[pData->GetDataID()];
+	pyramid.Update(pData);
+	// the pyramid needs increasing x on a linear axis
+	if(!pyramid.IsMonotonic() || IsXLogarithm() || pData->IsClipData())
+	{
+		if(pData->bDrawDataExternal)
+		{
+			pData->bDrawDataExternal = false;
+			pData->bDrawDataChanged = true;
+		}
+		MyUnlock();
+		return false;
+	}
+	
+	int nBegin, nEnd;
+	pyramid.GetVisibleRange(pData, xRange, nBegin, nEnd);
+	pyramid.Select(pData, nBegin, nEnd, Width(plotRect), pData->vDrawData);
+	pData->bCompactDraw = true;
+	pData->bDrawDataExternal = true;
+	pData->bForceUpdate = true;
+	MyUnlock();
+	return true;
+}
 
+void	CHugePlotImpl::DrawSinglePlotData( int which, HDC hDC, double *xRange, double *yRange )
+{
+	if(which<0 || which>=GetPlotDataCount())return;
+	
+	if(!SelectPyramid(which, xRange))
+	{
+		CXYPlotImpl::DrawSinglePlotData(which, hDC, xRange, yRange);
+		return;
+	}
+	GetAbsPlotData(which)->DrawPlotData(hDC, GetLastPlotRect(), xRange, yRange);
+}
 
+void	CHugePlotImpl::DrawSinglePlotData( int which, CDrawSurface *pSurface, double *xRange, double *yRange )
+{
+	if(which<0 || which>=GetPlotDataCount())return;
+	
+	if(pSurface->GetDC())
+	{
+		DrawSinglePlotData(which, pSurface->GetDC(), xRange, yRange);
+		return;
+	}
+	if(!SelectPyramid(which, xRange))
+	{
+		CXYPlotImpl::DrawSinglePlotData(which, pSurface, xRange, yRange);
+		return;
+	}
+	GetAbsPlotData(which)->DrawCurve(pSurface, GetLastPlotRect(), xRange, yRange);
 }
 
@@ -20,7 +20,9 @@
 #pragma once
 
 #include "HugePlot.h"
+#include "HugePyramid.h"
 #include "../../Basic/XYPlotImpl.h"
+#include <map>
 
 Declare_Namespace_CChart
 
@@ -33,7 +35,16 @@ public:
 public:
 	virtual	TCHAR*		GetTypeName(){return _TEXT("HugePlot");}
 	virtual	void		FinalDraw( HDC hDC, RECT destRect );
+	void				DrawSinglePlotData( int which, HDC hDC, double *xRange, double *yRange );
+	void				DrawSinglePlotData( int which, CDrawSurface *pSurface, double *xRange, double *yRange );
+	// Select the points of the pyramid into the draw data, false if the curve must be drawn as usual
+	bool				SelectPyramid( int which, double *xRange );
 
+protected:
+	std::map<int, CHugePyramid>	m_mapPyramid;// by data ID
+
+public:
+	CHugePyramid		*GetPyramid(int dataID);
 };
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,240 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+//#include "StdAfx.h"
+#include "HugePyramid.h"
+
+using namespace NsCChart;
+
+CHugePyramid::CHugePyramid()
+{
+	Reset();
+}
+
+CHugePyramid::~CHugePyramid()
+{
+	
+}
+
+void	CHugePyramid::Reset()
+{
+	m_vvLevels.clear();
+	m_vnFirstNode.clear();
+	m_nBase = 0;
+	m_nCount = 0;
+	m_nEditGeneration = 0;
+	m_nFrontDrops = 0;
+	m_bMonotonic = true;
+}
+
+// Forget the nodes that hold dropped points only, a level is shortened once half of it is gone
+void	CHugePyramid::TrimLevels()
+{
+	int l, nDead;
+	for(l = 0; l < GetLevelCount(); l++)
+	{
+		nDead = m_nBase / (kHugeBaseSize<<l) - m_vnFirstNode[l];
+		if(nDead <= 0 || 2*nDead < (int)m_vvLevels[l].size())continue;
+		m_vvLevels[l].erase(m_vvLevels[l].begin(), m_vvLevels[l].begin() + nDead);
+		m_vnFirstNode[l] += nDead;
+	}
+}
+
+bool	CHugePyramid::Update(CPlotData<DataPoint2D> *pData)
+{
+	int n = pData->GetDataCount();
+	unsigned int nDropped = pData->GetFrontDrops() - m_nFrontDrops;
+	bool bDropped = false;
+	if(m_nCount > 0)
+	{
+		// appending and dropping at the front keep the points still indexed, anything else means a rebuild,
+		// so does a base that would overflow the node sizes
+		if( pData->GetEditGeneration() != m_nEditGeneration || nDropped > (unsigned int)m_nCount ||
+			n < m_nCount - (int)nDropped || m_nBase > (1<<30) - (int)nDropped )
+		{
+			Reset();
+		}
+		else if(nDropped > 0)
+		{
+			m_nBase += (int)nDropped;
+			m_nCount -= (int)nDropped;
+			bDropped = true;
+			TrimLevels();
+		}
+	}
+	m_nEditGeneration = pData->GetEditGeneration();
+	m_nFrontDrops = pData->GetFrontDrops();
+	if(n == m_nCount)return bDropped;
+	
+	// kept by the data on appends, scanned once otherwise
+	m_bMonotonic = pData->IsXMonotonic();
+	if(!m_bMonotonic)
+	{
+		m_vvLevels.clear();
+		m_vnFirstNode.clear();
+		m_nBase = 0;
+		m_nCount = 0;
+		return true;
+	}
+	
+	// the finest level, from the node holding the first new point, in point numbers from the base
+	int i, j, l, m = m_nBase + m_nCount, nEndPoint = m_nBase + n;
+	int j0 = m / kHugeBaseSize;
+	int nNodes, nBegin, nEnd;
+	double y;
+	if(m_vvLevels.size() <= 0)
+	{
+		m_vvLevels.resize(1);
+		m_vnFirstNode.assign(1, m_nBase / kHugeBaseSize);
+	}
+	nNodes = (nEndPoint + kHugeBaseSize - 1) / kHugeBaseSize;
+	m_vvLevels[0].resize(nNodes - m_vnFirstNode[0]);
+	for(j = j0; j < nNodes; j++)
+	{
+		HugeNode &node = GetNode(0, j);
+		nBegin = j * kHugeBaseSize;
+		nEnd = (nEndPoint - nBegin > kHugeBaseSize) ? nBegin + kHugeBaseSize : nEndPoint;
+		// a node holding dropped points is never selected
+		if(nBegin < m_nBase)
+		{
+			node.iMin = node.iMax = -1;
+			continue;
+		}
+		node.iMin = node.iMax = nBegin;
+		for(i = nBegin + 1; i < nEnd; i++)
+		{
+			y = pData->GetDataAt(i - m_nBase).val[1];
+			if(y < pData->GetDataAt(node.iMin - m_nBase).val[1])node.iMin = i;
+			if(y > pData->GetDataAt(node.iMax - m_nBase).val[1])node.iMax = i;
+		}
+	}
+	
+	// the coarser levels, each node merges two children, stop at two nodes so that S never overflows
+	int nSize, jChildEnd;
+	for(l = 1; (int)m_vvLevels[l-1].size() > 2; l++)
+	{
+		nSize = kHugeBaseSize<<l;
+		if((int)m_vvLevels.size() <= l)
+		{
+			m_vvLevels.resize(l+1);
+			m_vnFirstNode.push_back(m_nBase / nSize);
+			j0 = m_vnFirstNode[l];
+		}
+		else
+		{
+			j0 /= 2;
+			if(j0 < m_vnFirstNode[l])j0 = m_vnFirstNode[l];
+		}
+		jChildEnd = m_vnFirstNode[l-1] + (int)m_vvLevels[l-1].size();
+		nNodes = (jChildEnd + 1) / 2;
+		m_vvLevels[l].resize(nNodes - m_vnFirstNode[l]);
+		for(j = j0; j < nNodes; j++)
+		{
+			HugeNode &node = GetNode(l, j);
+			if(j * nSize < m_nBase || 2*j < m_vnFirstNode[l-1])
+			{
+				node.iMin = node.iMax = -1;
+				continue;
+			}
+			node = GetNode(l-1, 2*j);
+			if(2*j+1 >= jChildEnd)continue;
+			
+			const HugeNode &right = GetNode(l-1, 2*j+1);
+			if(pData->GetDataAt(right.iMin - m_nBase).val[1] < pData->GetDataAt(node.iMin - m_nBase).val[1])node.iMin = right.iMin;
+			if(pData->GetDataAt(right.iMax - m_nBase).val[1] > pData->GetDataAt(node.iMax - m_nBase).val[1])node.iMax = right.iMax;
+		}
+	}
+	m_vvLevels.resize(l);
+	m_vnFirstNode.resize(l);
+	m_nCount = n;
+	
+	return true;
+}
+
+int		CHugePyramid::GetVisibleRange(CPlotData<DataPoint2D> *pData, double *xRange, int &nBegin, int &nEnd)
+{
+	int lo, hi, mid, n = m_nCount;
+	
+	// first point not left of the range
+	lo = 0;
+	hi = n;
+	while(lo < hi)
+	{
+		mid = lo + (hi - lo) / 2;
+		if(pData->GetDataAt(mid).val[0] < xRange[0])lo = mid + 1;
+		else hi = mid;
+	}
+	nBegin = lo > 0 ? lo - 1 : 0;
+	
+	// first point right of the range
+	hi = n;
+	while(lo < hi)
+	{
+		mid = lo + (hi - lo) / 2;
+		if(pData->GetDataAt(mid).val[0] <= xRange[1])lo = mid + 1;
+		else hi = mid;
+	}
+	nEnd = lo < n ? lo + 1 : n;
+	
+	return nEnd - nBegin;
+}
+
+void	CHugePyramid::Select(CPlotData<DataPoint2D> *pData, int nBegin, int nEnd, int nPixels, MyVData2D &vOut)
+{
+	vOut.clear();
+	if(nEnd <= nBegin)return;
+	if(nPixels < 1)nPixels = 1;
+	
+	// the coarsest level whose nodes hold no more points than one pixel column
+	int nPerPixel = (nEnd - nBegin) / nPixels;
+	int level = -1;
+	while(level + 1 < GetLevelCount() && (kHugeBaseSize<<(level+1)) <= nPerPixel)level++;
+	
+	// walk the range with the largest aligned nodes that fit, the ends are filled with finer nodes and single points,
+	// the nodes are aligned on the point numbers from the base, which no node used starts before
+	int l, nSize, i = nBegin + m_nBase;
+	nEnd += m_nBase;
+	while(i < nEnd)
+	{
+		for(l = level; l >= 0; l--)
+		{
+			nSize = kHugeBaseSize<<l;
+			if(i % nSize == 0 && nSize <= nEnd - i)break;
+		}
+		if(l < 0)
+		{
+			vOut.push_back(pData->GetDataAt(i - m_nBase));
+			i++;
+			continue;
+		}
+		SelectNode(pData, i, i + nSize - 1, GetNode(l, i / nSize), vOut);
+		i += nSize;
+	}
+}
+
+void	CHugePyramid::SelectNode(CPlotData<DataPoint2D> *pData, int nFirst, int nLast, const HugeNode &node, MyVData2D &vOut)
+{
+	int iLo = node.iMin < node.iMax ? node.iMin : node.iMax;
+	int iHi = node.iMin < node.iMax ? node.iMax : node.iMin;
+	
+	vOut.push_back(pData->GetDataAt(nFirst - m_nBase));
+	if(iLo > nFirst)vOut.push_back(pData->GetDataAt(iLo - m_nBase));
+	if(iHi > iLo)vOut.push_back(pData->GetDataAt(iHi - m_nBase));
+	if(nLast > iHi)vOut.push_back(pData->GetDataAt(nLast - m_nBase));
+}
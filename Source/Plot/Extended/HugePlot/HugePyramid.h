@@ -0,0 +1,76 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#pragma warning(disable:4786)
+
+#include "../../Basic/PlotData.h"
+
+Declare_Namespace_CChart
+
+// Size of the nodes of the finest level, shorter runs are taken point by point
+const int kHugeBaseSize = 16;
+
+// Min/max pyramid over the point index of a curve whose x increases
+// Node j of level l covers the points [j*S, (j+1)*S), S = kHugeBaseSize<<l, and keeps the index of its min and max y
+// The points are counted from the first one indexed, points dropped at the front only move the base,
+// nodes holding dropped points are left unused. The last node of each level may be partial, it is
+// rebuilt when points are appended
+class CHugePyramid
+{
+public:
+	CHugePyramid();
+	virtual ~CHugePyramid();
+
+	void	Reset();
+
+protected:
+	typedef struct stHugeNode
+	{
+		int	iMin, iMax;
+	}HugeNode;
+
+	std::vector< std::vector<HugeNode> >	m_vvLevels;
+	std::vector<int>	m_vnFirstNode;// node number of the first node kept on each level
+	int			m_nBase;// number of the first point of the data
+	int			m_nCount;// points already indexed
+	unsigned int	m_nEditGeneration, m_nFrontDrops;// of the data when they were indexed
+	bool		m_bMonotonic;
+
+public:
+	inline	int		GetCount(){return m_nCount;}
+	inline	int		GetLevelCount(){return (int)m_vvLevels.size();}
+	inline	bool	IsMonotonic(){return m_bMonotonic;}
+
+	// Index the points appended and forget those dropped at the front since the last call,
+	// rebuild if the data were changed otherwise
+	bool	Update(CPlotData<DataPoint2D> *pData);
+	// Indexes of the points to draw for xRange, one point outside on each side is included
+	int		GetVisibleRange(CPlotData<DataPoint2D> *pData, double *xRange, int &nBegin, int &nEnd);
+	// First, min, max and last points of the nodes covering [nBegin, nEnd), no node is wider than one pixel
+	void	Select(CPlotData<DataPoint2D> *pData, int nBegin, int nEnd, int nPixels, MyVData2D &vOut);
+
+protected:
+	inline	HugeNode	&GetNode(int l, int j){return m_vvLevels[l][j - m_vnFirstNode[l]];}
+	void	TrimLevels();
+	void	SelectNode(CPlotData<DataPoint2D> *pData, int nFirst, int nLast, const HugeNode &node, MyVData2D &vOut);
+};
+
+Declare_Namespace_End
@@ -66,7 +66,7 @@ protected:
 public:
 	virtual	CPlotData<DataPoint2D>	*GetPlotDataByTitle( tstring title );
 	void		DeleteAllData();
-	double		GetValueFromX(double x, int which, int nIndex);
+	double		GetValueFromX(double x, int which, int nIndex, bool bInterpolate = true);
 
 	virtual tstring		GetAbsDataTitle( int which );
 	virtual tstring		GetAbsDataAppendix( int which );
@@ -937,11 +937,11 @@ void	CLayeredPlotBasicImpl<PlotLayerImplIT>::DeleteAllData()
 }
 
 template<class PlotLayerImplIT>
-double	CLayeredPlotBasicImpl<PlotLayerImplIT>::GetValueFromX(double x, int which, int nIndex)
+double	CLayeredPlotBasicImpl<PlotLayerImplIT>::GetValueFromX(double x, int which, int nIndex, bool bInterpolate)
 {
 	CPlotLayerImplI *pLayer=GetLayer(nIndex);
 	if(!pLayer)return 0.0;
-	return pLayer->GetValueFromX(x, which);
+	return pLayer->GetValueFromX(x, which, bInterpolate);
 }
 
 template<class PlotLayerImplIT>
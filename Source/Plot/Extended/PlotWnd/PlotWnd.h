@@ -25,11 +25,17 @@
 #include <tchar.h>
 
 #include <vector>
+#include <math.h>
 using namespace std;
 
+#include "RedrawScheduler.h"
+
 namespace NsCChart{
 
 #define	PLOT_CLASS_NAME		_TEXT("PlotWnd_Defined_by_Yang_Guojun")
+#define	PLOT_REDRAW_MSG_NAME	_TEXT("PlotWnd_Redraw_Defined_by_Yang_Guojun")
+// the redraw timer of a CPlotWnd is this plus its nPlotWndID
+#define	PLOT_REDRAW_TIMER_BASE	0x5D00
 
 //////////////////////////////////////////////////////////////////////////////////////////////
 // This is a templated class, but a glabal value pThis must be used. it may cause trouble
@@ -55,6 +61,15 @@ struct stWndProcPara
 	int				nPlotWndID;
 
 	int				nCurrPlotID;
+
+	// ReDraw only marks the plots dirty, frames are drawn by the scheduler
+	CRedrawScheduler	scheduler;
+	CRITICAL_SECTION	csRedraw;
+
+	static	UINT	GetRedrawMessage();
+	void			RequestFrame(PlotImplT *plot);
+	void			RunScheduledFrame(HWND hWnd);
+	void			DrawPlots(const vector<int> &vPlotIDs);
 };
 
 
@@ -118,6 +133,15 @@ public:
 	void	ReDraw(HWND hWnd);
 	void	ReDraw(int nPlotIndex);
 	void	ReDraw(PlotImplT *plot);
+
+	// ReDraw requests are coalesced into at most fMaxFps frames per second,
+	// all frames are drawn in the window thread. 0 draws on the next posted message
+	void	SetMaxFrameRate(double fMaxFps);
+	double	GetMaxFrameRate();
+	void	SetRedrawClock(FcnRedrawClock fcnClock, void *pPara);
+	unsigned int	GetRequestedFrames();
+	unsigned int	GetRenderedFrames();
+	void	ResetFrameCounters();
 };
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -141,6 +165,8 @@ CPlotWnd<PlotImplT>::CPlotWnd( )
 	nPlotWndCount++;
 
 	m_pWndProcPara->nCurrPlotID = 0;
+
+	InitializeCriticalSection(&m_pWndProcPara->csRedraw);
 }
 
 template<class PlotImplT>
@@ -156,6 +182,7 @@ CPlotWnd<PlotImplT>::~CPlotWnd()
 		}
 	}
 	
+	DeleteCriticalSection(&m_pWndProcPara->csRedraw);
 	delete m_pWndProcPara;
 	m_pWndProcPara = 0;
 }
@@ -235,6 +262,21 @@ LRESULT	CALLBACK	stWndProcPara<PlotImplT>::PlotWindowProc(HWND hWnd, UINT msg, W
 	PAINTSTRUCT ps;
 	HDC hDC;
 	
+	// a deferred frame, the owner is found by its ID as it may be gone
+	if(msg == GetRedrawMessage() || (msg == WM_TIMER && wParam >= PLOT_REDRAW_TIMER_BASE))
+	{
+		idx = (msg == WM_TIMER)?(int)(wParam - PLOT_REDRAW_TIMER_BASE):(int)wParam;
+		for(j=0; j<(int)stWndProcPara<PlotImplT>::vpThis.size(); j++)
+		{
+			if(stWndProcPara<PlotImplT>::vpThis[j]->nPlotWndID == idx)
+			{
+				stWndProcPara<PlotImplT>::vpThis[j]->RunScheduledFrame(hWnd);
+				return 0;
+			}
+		}
+		if(msg != WM_TIMER)return 0;
+	}
+
 	switch(msg)
 	{
 	case WM_PAINT:
@@ -573,7 +615,7 @@ void	CPlotWnd<PlotImplT>::ReDraw(HWND hWnd)
 	{
 		if(m_pWndProcPara->vpPlot[i]->GetWnd() == hWnd)
 		{
-			m_pWndProcPara->vpPlot[i]->OnDraw(hWnd);
+			m_pWndProcPara->RequestFrame(m_pWndProcPara->vpPlot[i]);
 		}
 	}
 }
@@ -583,7 +625,7 @@ void	CPlotWnd<PlotImplT>::ReDraw(int nPlotIndex)
 {
 	if(nPlotIndex<0 || nPlotIndex>=(int)m_pWndProcPara->vpPlot.size())return;
 	
-	m_pWndProcPara->vpPlot[nPlotIndex]->OnDraw(m_pWndProcPara->vpPlot[nPlotIndex]->GetWnd());
+	m_pWndProcPara->RequestFrame(m_pWndProcPara->vpPlot[nPlotIndex]);
 }
 
 template<class PlotImplT>
@@ -595,12 +637,113 @@ void	CPlotWnd<PlotImplT>::ReDraw(PlotImplT *plot)
 	{
 		if(plot == m_pWndProcPara->vpPlot[i])
 		{
-			plot->OnDraw(plot->GetWnd());
+			m_pWndProcPara->RequestFrame(plot);
 			break;
 		}
 	}
 }
 
+template<class PlotImplT>
+void	CPlotWnd<PlotImplT>::SetMaxFrameRate(double fMaxFps)
+{
+	EnterCriticalSection(&m_pWndProcPara->csRedraw);
+	m_pWndProcPara->scheduler.SetMaxFrameRate(fMaxFps);
+	LeaveCriticalSection(&m_pWndProcPara->csRedraw);
+}
+
+template<class PlotImplT>
+double	CPlotWnd<PlotImplT>::GetMaxFrameRate()
+{
+	return m_pWndProcPara->scheduler.GetMaxFrameRate();
+}
+
+template<class PlotImplT>
+void	CPlotWnd<PlotImplT>::SetRedrawClock(FcnRedrawClock fcnClock, void *pPara)
+{
+	EnterCriticalSection(&m_pWndProcPara->csRedraw);
+	m_pWndProcPara->scheduler.SetClock(fcnClock, pPara);
+	LeaveCriticalSection(&m_pWndProcPara->csRedraw);
+}
+
+template<class PlotImplT>
+unsigned int	CPlotWnd<PlotImplT>::GetRequestedFrames()
+{
+	return m_pWndProcPara->scheduler.GetRequestedFrames();
+}
+
+template<class PlotImplT>
+unsigned int	CPlotWnd<PlotImplT>::GetRenderedFrames()
+{
+	return m_pWndProcPara->scheduler.GetRenderedFrames();
+}
+
+template<class PlotImplT>
+void	CPlotWnd<PlotImplT>::ResetFrameCounters()
+{
+	EnterCriticalSection(&m_pWndProcPara->csRedraw);
+	m_pWndProcPara->scheduler.ResetCounters();
+	LeaveCriticalSection(&m_pWndProcPara->csRedraw);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// Scheduled redraw
+
+template<class PlotImplT>
+UINT	stWndProcPara<PlotImplT>::GetRedrawMessage()
+{
+	static UINT uMsg = RegisterWindowMessage(PLOT_REDRAW_MSG_NAME);
+	return uMsg;
+}
+
+// Called from any thread, only marks the plot dirty. The first request since the last
+// frame posts to the window thread, which draws the frame or sets the timer
+template<class PlotImplT>
+void	stWndProcPara<PlotImplT>::RequestFrame(PlotImplT *plot)
+{
+	bool bPost;
+
+	EnterCriticalSection(&csRedraw);
+	bPost = scheduler.Request(plot->GetPlotID());
+	LeaveCriticalSection(&csRedraw);
+
+	if(bPost)PostMessage(plot->GetWnd(), GetRedrawMessage(), (WPARAM)nPlotWndID, 0);
+}
+
+// In the window thread, on the posted message or the timer
+template<class PlotImplT>
+void	stWndProcPara<PlotImplT>::RunScheduledFrame(HWND hWnd)
+{
+	vector<int> vPlotIDs;
+	double fDelay;
+
+	KillTimer(hWnd, PLOT_REDRAW_TIMER_BASE + nPlotWndID);
+	EnterCriticalSection(&csRedraw);
+	fDelay = scheduler.GetDelay();
+	if(fDelay == 0.0)scheduler.BeginFrame(vPlotIDs);
+	LeaveCriticalSection(&csRedraw);
+
+	if(fDelay > 0.0)SetTimer(hWnd, PLOT_REDRAW_TIMER_BASE + nPlotWndID, (UINT)ceil(fDelay), NULL);
+	DrawPlots(vPlotIDs);
+}
+
+template<class PlotImplT>
+void	stWndProcPara<PlotImplT>::DrawPlots(const vector<int> &vPlotIDs)
+{
+	int i, j;
+	for(j=0; j<(int)vPlotIDs.size(); j++)
+	{
+		// a plot detached meanwhile is simply not found
+		for(i=0; i<(int)vpPlot.size(); i++)
+		{
+			if(vpPlot[i]->GetPlotID() == vPlotIDs[j])
+			{
+				vpPlot[i]->OnDraw(vpPlot[i]->GetWnd());
+				break;
+			}
+		}
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -0,0 +1,110 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#include "RedrawScheduler.h"
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+Declare_Namespace_CChart
+
+static double	SystemRedrawClock(void *pPara)
+{
+#ifdef _WIN32
+	static LARGE_INTEGER liFreq = {0};
+	LARGE_INTEGER liNow;
+	if(liFreq.QuadPart == 0)QueryPerformanceFrequency(&liFreq);
+	QueryPerformanceCounter(&liNow);
+	return 1000.0*(double)liNow.QuadPart/(double)liFreq.QuadPart;
+#else
+	timeval tv;
+	gettimeofday(&tv, 0);
+	return 1000.0*tv.tv_sec + tv.tv_usec/1000.0;
+#endif
+}
+
+CRedrawScheduler::CRedrawScheduler()
+{
+	m_fMaxFps = 0.0;
+	m_fcnClock = SystemRedrawClock;
+	m_pClockPara = 0;
+	m_bFramed = false;
+	m_fLastFrame = 0.0;
+	m_nRequested = 0;
+	m_nRendered = 0;
+}
+
+void	CRedrawScheduler::SetMaxFrameRate(double fMaxFps)
+{
+	m_fMaxFps = fMaxFps;
+}
+
+void	CRedrawScheduler::SetClock(FcnRedrawClock fcnClock, void *pPara)
+{
+	m_fcnClock = fcnClock?fcnClock:SystemRedrawClock;
+	m_pClockPara = fcnClock?pPara:0;
+	// the old time base means nothing to the new clock
+	m_bFramed = false;
+}
+
+double	CRedrawScheduler::GetTime() const
+{
+	return m_fcnClock(m_pClockPara);
+}
+
+bool	CRedrawScheduler::Request(int nKey)
+{
+	m_nRequested++;
+	bool bFirst = m_vDirty.size() == 0;
+	if(std::find(m_vDirty.begin(), m_vDirty.end(), nKey) == m_vDirty.end())
+		m_vDirty.push_back(nKey);
+	return bFirst;
+}
+
+double	CRedrawScheduler::GetDelay() const
+{
+	if(m_vDirty.size() == 0)return -1.0;
+	if(m_fMaxFps <= 0.0 || !m_bFramed)return 0.0;
+
+	double fDelay = m_fLastFrame + 1000.0/m_fMaxFps - GetTime();
+	return fDelay>0.0?fDelay:0.0;
+}
+
+bool	CRedrawScheduler::BeginFrame(std::vector<int> &vKeys)
+{
+	vKeys.clear();
+	if(GetDelay() != 0.0)return false;
+
+	vKeys.swap(m_vDirty);
+	m_fLastFrame = GetTime();
+	m_bFramed = true;
+	m_nRendered++;
+	return true;
+}
+
+void	CRedrawScheduler::ResetCounters()
+{
+	m_nRequested = 0;
+	m_nRendered = 0;
+}
+
+Declare_Namespace_End
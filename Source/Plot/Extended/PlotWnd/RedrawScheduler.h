@@ -0,0 +1,68 @@
+/*============================================================================*/
+/*                                                                            */
+/*                            C O P Y R I G H T                               */
+/*                                                                            */
+/*                          (C) Copyright 2019 by                             */
+/*                              Yang Guojun                                   */
+/*                           All Rights Reserved                              */
+/*                                                                            */
+/*      The author assumes no responsibility for the use or reliability of    */
+/*      his software.                                                         */
+/*                                                                            */
+/*============================================================================*/
+////////////////////////////////////////////////////////////////////////////////
+//                                  Ȩ                                  //
+//                         Ȩ(C)2006-2019                       //
+//                                ȫȨ                                //
+////////////////////////////////////////////////////////////////////////////////
+/* ############################################################################################################################## */
+
+#pragma once
+
+#include <vector>
+#include "../../Basic/CChartNameSpace.h"
+
+Declare_Namespace_CChart
+
+// Time source of the scheduler in milliseconds, a fake one can be installed to test the timing
+typedef double	(*FcnRedrawClock)(void *pPara);
+
+// Coalesces redraw requests into frames no closer than 1/fps seconds apart.
+// It only keeps the timing and the dirty keys, the caller locks it and does the drawing,
+// so it has no dependence on the window system
+class CRedrawScheduler
+{
+public:
+	CRedrawScheduler();
+
+	// fMaxFps <= 0 removes the cap, every frame is due at once
+	void	SetMaxFrameRate(double fMaxFps);
+	inline	double	GetMaxFrameRate() const {return m_fMaxFps;}
+	// A null fcnClock restores the system clock
+	void	SetClock(FcnRedrawClock fcnClock, void *pPara);
+	double	GetTime() const;
+
+	// Mark a key dirty, returns true for the first request since the last frame,
+	// the caller then has to arrange that a frame follows
+	bool	Request(int nKey);
+	// Milliseconds until the next frame is due, 0 when it is due now, -1 when nothing is dirty
+	double	GetDelay() const;
+	// Take the dirty keys if a frame is due, and count the frame as rendered
+	bool	BeginFrame(std::vector<int> &vKeys);
+	inline	bool	IsDirty() const {return m_vDirty.size() > 0;}
+
+	inline	unsigned int	GetRequestedFrames() const {return m_nRequested;}
+	inline	unsigned int	GetRenderedFrames() const {return m_nRendered;}
+	void	ResetCounters();
+
+protected:
+	double			m_fMaxFps;
+	FcnRedrawClock	m_fcnClock;
+	void			*m_pClockPara;
+	bool			m_bFramed;// a frame has been rendered, m_fLastFrame is valid
+	double			m_fLastFrame;
+	std::vector<int>	m_vDirty;
+	unsigned int	m_nRequested, m_nRendered;
+};
+
+Declare_Namespace_End
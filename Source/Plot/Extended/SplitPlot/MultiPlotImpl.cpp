@@ -76,12 +76,21 @@ void	CMultiPlotImpl::FinalDraw(HDC hDC, RECT destRect)
 	}
 	
 	int i, count = GetPlotCount(m_nSplitMode, m_nRows, m_nCols);
+	vector<CPlotImpl *> vpPlots(count);
+	vector<RECT> vRects(count);
 	for(i=0; i<count; i++)
 	{
-		RECT plotRect = GetSubPlotRect(destRect,i);
+		vpPlots[i] = m_vpPlots[i];
+		vRects[i] = GetSubPlotRect(destRect,i);
+	}
+	bool bDrawn = DrawSubPlotsAtOnce(hdc, vpPlots, vRects);
+
+	for(i=0; i<count; i++)
+	{
+		RECT plotRect = vRects[i];
 		if(m_vpPlots[i])
 		{
-			m_vpPlots[i]->FinalDraw(hdc, plotRect);
+			if(!bDrawn)m_vpPlots[i]->FinalDraw(hdc, plotRect);
 		}
 		else
 		{
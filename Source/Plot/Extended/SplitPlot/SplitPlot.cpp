@@ -18,23 +18,73 @@
 /* ############################################################################################################################## */
 
 #include "SplitPlot.h"
+#include "../../Basic/PlotImpl.h"
+#include "../../Basic/MyMemDC.h"
 
 using namespace NsCChart;
 
 CSplitPlotBase::CSplitPlotBase()
 {
+	m_pDrawPool = 0;
 	SetDefaults();
 }
 
 CSplitPlotBase::~CSplitPlotBase()
 {
-
+	if(m_pDrawPool)
+	{
+		delete m_pDrawPool;
+		m_pDrawPool = 0;
+	}
 }
 
 void	CSplitPlotBase::SetDefaults()
 {
 	m_bSingleMode = false;
 	m_nTopIndex = -1;
+	m_nDrawThreads = 0;
+}
+
+struct stSubPlotJobs
+{
+	vector<CPlotImpl *>	*pvpPlots;
+	vector<RECT>		*pvRects;
+	vector<CMyMemDC *>	vpMemDC;
+};
+
+static void	DrawSubPlotJob(void *pPara, int nJob)
+{
+	stSubPlotJobs *pJobs = (stSubPlotJobs *)pPara;
+	if(!pJobs->vpMemDC[nJob])return;
+	(*pJobs->pvpPlots)[nJob]->FinalDraw(*pJobs->vpMemDC[nJob], (*pJobs->pvRects)[nJob]);
+}
+
+bool	CSplitPlotBase::DrawSubPlotsAtOnce(HDC hDC, vector<CPlotImpl *> &vpPlots, vector<RECT> &vRects)
+{
+	int i, nThreads = m_nDrawThreads<0?CDrawWorkerPool::GetProcessorCount():m_nDrawThreads;
+	int nJobs = (int)vpPlots.size();
+	if(nThreads <= 1 || nJobs <= 1 || (int)vRects.size() != nJobs)return false;
+
+	if(!m_pDrawPool)m_pDrawPool = new CDrawWorkerPool;
+
+	// the buffers start as a copy of hDC, so the background is already there
+	stSubPlotJobs jobs;
+	jobs.pvpPlots = &vpPlots;
+	jobs.pvRects = &vRects;
+	jobs.vpMemDC.resize(nJobs);
+	for(i=0; i<nJobs; i++)
+	{
+		jobs.vpMemDC[i] = vpPlots[i]?new CMyMemDC(hDC, NULL, &vRects[i]):0;
+	}
+
+	m_pDrawPool->Run(DrawSubPlotJob, &jobs, nJobs, nThreads);
+
+	// a buffer is copied back to hDC when it is deleted
+	for(i=0; i<nJobs; i++)
+	{
+		if(jobs.vpMemDC[i])delete jobs.vpMemDC[i];
+	}
+	return true;
 }
 
 int		CSplitPlotBase::GetPlotCount(int mode, int nRows, int nCols)
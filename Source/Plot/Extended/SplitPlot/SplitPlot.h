@@ -32,9 +32,12 @@ using namespace std;
 #include "../../Basic/PlotData.h"
 #include "../../Basic/ReactStatus.h"
 #include "../../Basic/CChartNameSpace.h"
+#include "../../Basic/DrawWorkerPool.h"
 
 Declare_Namespace_CChart
 
+class CPlotImpl;
+
 // enumutation of split modes
 enum
 {
@@ -87,6 +90,19 @@ public:
 
 	inline	bool	IsReallySingle(){return m_bSingleMode && m_nTopIndex>=0 && m_nTopIndex<GetPlotCount();}
 
+protected:
+	int				m_nDrawThreads;
+	CDrawWorkerPool	*m_pDrawPool;
+
+	// Draw the subplots at once, each into its own buffer, then copy the buffers to hDC in order.
+	// Returns false when they are to be drawn in turn
+	bool			DrawSubPlotsAtOnce(HDC hDC, vector<CPlotImpl *> &vpPlots, vector<RECT> &vRects);
+public:
+	// Threads drawing the subplots, 0 or 1 draws them in turn, a negative value takes one per processor.
+	// User drawing functions of the subplots are then called from these threads
+	inline	int		GetDrawThreads(){return m_nDrawThreads;}
+	inline	void	SetDrawThreads(int threads){m_nDrawThreads = threads;}
+
 protected:
 	void			InitSpliters(RECT plotRect);
 public:
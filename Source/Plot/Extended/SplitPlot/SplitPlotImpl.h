@@ -172,11 +172,13 @@ void	CSplitPlotImpl<PlotImplT>::FinalDraw(HDC hDC, RECT destRect)
 		DrawTitle( hdc );
 	}
 
-	for(int i=0; i<GetPlotCount(m_nSplitMode, m_nRows, m_nCols); i++)
+	int i, count = GetPlotCount(m_nSplitMode, m_nRows, m_nCols);
+	vector<COLORREF> vBkCr(count);
+	for(i=0; i<count; i++)
 	{
 		if(m_vpPlots[i])
 		{
-			COLORREF bkCr;
+			COLORREF &bkCr = vBkCr[i];
 			if(m_vpPlots[i]->IsPlotSelected())
 			{
 				bool bSet=false;
@@ -197,10 +199,26 @@ void	CSplitPlotImpl<PlotImplT>::FinalDraw(HDC hDC, RECT destRect)
 				b = GetBValue(bkCr)>=10?GetBValue(bkCr)-10:GetBValue(bkCr)+10;
 				m_vpPlots[i]->SetBkgndColor(RGB(r, g, b));
 			}
-			m_vpPlots[i]->FinalDraw(hdc, GetSubPlotRect(plotRect,i) );
+		}
+	}
+
+	vector<CPlotImpl *> vpPlots(count);
+	vector<RECT> vRects(count);
+	for(i=0; i<count; i++)
+	{
+		vpPlots[i] = m_vpPlots[i];
+		vRects[i] = GetSubPlotRect(plotRect,i);
+	}
+	bool bDrawn = DrawSubPlotsAtOnce(hdc, vpPlots, vRects);
+
+	for(i=0; i<count; i++)
+	{
+		if(m_vpPlots[i])
+		{
+			if(!bDrawn)m_vpPlots[i]->FinalDraw(hdc, vRects[i]);
 			if(m_vpPlots[i]->IsPlotSelected())
 			{
-				m_vpPlots[i]->SetBkgndColor(bkCr);
+				m_vpPlots[i]->SetBkgndColor(vBkCr[i]);
 			}
 		}
 	}
@@ -432,11 +432,103 @@ void	CStemPlotImpl::DrawSinglePlotData( int which, HDC hDC, double *xRange, doub
 	DeleteObject(hBrush);
 }
 
+// Without a device context the stems are filled flat, the gradient needs GDI
+void	CStemPlotImpl::DrawSinglePlotData( int which, CDrawSurface *pSurface, double *xRange, double *yRange )
+{
+	if(pSurface->GetDC())
+	{
+		DrawSinglePlotData(which, pSurface->GetDC(), xRange, yRange);
+		return;
+	}
+	if(!GetAbsPlotData(which)->IsVisible())return;
+
+	if(GetAbsPlotData(which)->GetFlag())
+	{
+		CXYPlotImpl::DrawSinglePlotData(which, pSurface, xRange, yRange);
+	}
+
+	RECT plotRect = GetLastPlotRect();
+
+	CPlotData<DataPoint2D>	*dataSet = GetAbsPlotData( which );
+	if( dataSet->GetDataCount()<=0 ) return;
+
+	COLORREF linecolor = m_crStemEdgeColor;
+	if( GetAbsPlotData(which)->IsLighted() || GetAbsPlotData(which)->IsSelected() )
+	{
+		linecolor = RGB(255 - GetRValue(linecolor), 255 - GetGValue(linecolor), 255 - GetBValue(linecolor));
+	}
+	COLORREF stemColor = GetAbsPlotData(which)->GetPlotColor();
+
+	int i;
+	POINT pt[4];
+	RECT frontFace;
+	if(m_b3DStem)
+	{
+		int r, g, b;
+		r = GetRValue(stemColor);
+		g = GetGValue(stemColor);
+		b = GetBValue(stemColor);
+
+		pSurface->SetPen(linecolor, 1, PS_NULL);
+		pSurface->SetBrush(RGB(r+50>255?255:r+50, g+50>255?255:g+50, b+50>255?255:b+50));
+		for(i=0; i<dataSet->GetDataCount(); i++)
+		{
+			GetFrontFace(which, i, plotRect, xRange, yRange, frontFace);
+			Get3DYFaceAdded(frontFace, pt);
+			pSurface->FillPolygon(pt, 4);
+		}
+		pSurface->SetBrush(RGB(r/2, g/2, b/2));
+		for(i=0; i<dataSet->GetDataCount(); i++)
+		{
+			GetFrontFace(which, i, plotRect, xRange, yRange, frontFace);
+			Get3DXFaceAdded(frontFace, pt);
+			pSurface->FillPolygon(pt, 4);
+		}
+	}
+
+	double val;
+	tstring str;
+	SIZE textSize;
+	RECT valRect;
+	pSurface->SetFont(m_lfValOnTop);
+	pSurface->SetTextColor(stemColor);
+	for(i=0; i<dataSet->GetDataCount(); i++)
+	{
+		GetFrontFace(which, i, plotRect, xRange, yRange, frontFace);
+		pSurface->SetPen(linecolor, GetAbsPlotData(which)->GetPlotLineSize(), GetAbsPlotData(which)->GetPlotLineStyle());
+		pSurface->SetBrush(stemColor);
+		pt[0].x = frontFace.left; pt[0].y = frontFace.top;
+		pt[1].x = frontFace.right-1; pt[1].y = frontFace.top;
+		pt[2].x = frontFace.right-1; pt[2].y = frontFace.bottom-1;
+		pt[3].x = frontFace.left; pt[3].y = frontFace.bottom-1;
+		pSurface->FillPolygon(pt, 4);
+		if(m_bShowValOnTop)
+		{
+			if(m_nStemBase == kStemBaseBottom || m_nStemBase == kStemBaseTop)
+				val = dataSet->GetData()[i].def.y;
+			else
+				val = dataSet->GetData()[i].def.x;
+
+			tostringstream ostr;
+			ostr<<val;
+			str = ostr.str();
+
+			textSize = pSurface->MeasureString(str.c_str(), (int)str.length());
+			valRect = GetValueRect(textSize, frontFace);
+			pSurface->DrawString((valRect.left + valRect.right - textSize.cx)/2, valRect.top, str.c_str(), (int)str.length());
+		}
+	}
+}
+
 RECT	CStemPlotImpl::GetValueRect(HDC hDC, tstring text, RECT faceRect)
 {
 	SIZE textSize;
 	MyGetTextExtentPoint(hDC, &m_lfValOnTop, text, DT_LEFT, &textSize);
+	return GetValueRect(textSize, faceRect);
+}
 
+RECT	CStemPlotImpl::GetValueRect(SIZE textSize, RECT faceRect)
+{
 	RECT valRect;
 	valRect = faceRect;
 	switch(m_nStemBase)
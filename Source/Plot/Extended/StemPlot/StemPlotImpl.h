@@ -50,6 +50,7 @@ public:
 
 protected:
 	void	DrawSinglePlotData( int which, HDC hDC, double *xRange, double *yRange );
+	void	DrawSinglePlotData( int which, CDrawSurface *pSurface, double *xRange, double *yRange );
 
 	void	GetFrontFace(int which, int iPoint, RECT plotRect, double *xRange, double *yRange, RECT &faceRect);
 	void	Get3DXFaceAdded(RECT faceRect, POINT pt[4]);
@@ -58,6 +59,7 @@ protected:
 	void	ChangeAxisData(RECT plotRect);
 
 	RECT	GetValueRect(HDC hDC, tstring text, RECT faceRect);
+	RECT	GetValueRect(SIZE textSize, RECT faceRect);
 
 public:
 	void	GetPlotRange( double *xRange, double *yRange );
@@ -1054,6 +1054,32 @@ int		CXY3DPlotImpl::AddPoint(double x, double y, double z, int nWhich)
 
 }
 
+int		CXY3DPlotImpl::AppendPoints( int dataID, double *pX, double *pY, double *pZ, int nLen )
+{
+	if(!pZ)return -1;
+	if(CXYPlotImpl::AppendPoints(dataID, pX, pY, nLen)<0)return -1;
+
+	CPlotData<DataPoint2D> *plotdata = GetPlotData(dataID);
+	if(!plotdata->GetExtProp())
+	{
+		XY3DProp *pPP = new XY3DProp;
+		plotdata->SetExtProp(pPP);
+	}
+	vector<double> &vfZData = ((XY3DProp*)plotdata->GetExtProp())->vfZData;
+	vfZData.insert(vfZData.end(), pZ, pZ + nLen);
+	// keep z values aligned with the points left after MaxPoints trimming
+	if((int)vfZData.size() > plotdata->GetDataCount())
+	{
+		vfZData.erase(vfZData.begin(), vfZData.begin() + ((int)vfZData.size() - plotdata->GetDataCount()));
+	}
+
+	GetZDataRange(dataID);
+	
+	m_bNewDataComming = true;
+	
+	return dataID;
+}
+
 bool	CXY3DPlotImpl::WriteToFile( tstring pathName )
 {
 	return CXYPlotImpl::WriteToFile(pathName);
@@ -1073,3 +1099,41 @@ bool	CXY3DPlotImpl::ReadFromFile( int which, tstring pathName )
 {
 	return CXYPlotImpl::ReadFromFile(which, pathName);
 }
+
+bool	CXY3DPlotImpl::WriteToBinaryFile( tstring pathName )
+{
+	if( GetPlotDataCount() <= 0 ) return false;
+	
+	vector<CPlotData<DataPoint2D> *> vpData;
+	vector<vector<double> *> vpZ;
+	int i;
+	for(i=0; i<GetPlotDataCount(); i++)
+	{
+		vpData.push_back(GetAbsPlotData(i));
+		XY3DProp *pPP = (XY3DProp*)GetAbsPlotData(i)->GetExtProp();
+		vpZ.push_back(pPP ? &pPP->vfZData : 0);
+	}
+	
+	MyLock();
+	bool ret = CBinaryDataFile::Write(pathName, vpData, &vpZ);
+	MyUnlock();
+	return ret;
+}
+
+// Called for every curve of a binary file, by ReadFromBinaryFile or on this thread for a load thread
+int		CXY3DPlotImpl::AddBinaryCurve( LoadWindow &curve )
+{
+	int nLen = (int)curve.vData.size();
+	int dataID = CXYPlotImpl::AddBinaryCurve(curve);
+	if(dataID < 0)return -1;
+	
+	// z is 0 when the file holds 2D data
+	XY3DProp *pPP = new XY3DProp;
+	if(curve.vZ.size() > 0)pPP->vfZData.swap(curve.vZ);
+	else pPP->vfZData.resize(nLen, 0.0);
+	GetPlotData(dataID)->SetExtProp(pPP);
+	GetZDataRange(dataID);
+	
+	m_bNewDataComming = true;
+	return dataID;
+}
@@ -52,6 +52,7 @@ public:
 public:
 	int				AddCurve( double *pX, double *pY, double *pZ, int nLen );
 	virtual	int		AddPoint( double x, double y, double z, int nWhich);
+	int				AppendPoints( int dataID, double *pX, double *pY, double *pZ, int nLen );
 
 public:
 	CAxisImpl			*m_pAxisZ;
@@ -117,6 +118,9 @@ public:
 	virtual	bool	WriteToFile( int which, tstring pathName );
 	virtual	bool	ReadFromFile( tstring pathName );
 	virtual	bool	ReadFromFile( int which, tstring pathName );
+	virtual	bool	WriteToBinaryFile( tstring pathName );
+protected:
+	virtual	int		AddBinaryCurve( LoadWindow &curve );
 };
 
 //typedef CXY3DPlotImpl CXY3DPlotImplI;
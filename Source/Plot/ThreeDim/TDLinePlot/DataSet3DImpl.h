@@ -65,6 +65,7 @@ public:
 	int					AddPointFinal(DataPoint3D dp3d, int nWhich);
 	int					AddPoint(double x, double y, double z, int nWhich);
 	int					AddPoint( double x, double y, double z) ;
+	int					AppendPoints( int dataID, double *pX, double *pY, double *pZ, int nLen );
 
 	template<typename T1, typename T2>
 	int					InsertPoint( T1 x, T2 y, int nPos, int nWhich )
@@ -211,6 +212,7 @@ int	CDataSet3DImpl<PlotImplT>::AddData( MyVData3D vData )
 	plotData->SetDataSet(this);
 	
 	m_vpPlotData.push_back(plotData);
+	SetIndexOfID(GetPlotDataCount()-1);
 	//GetDataRanges();
 	plotData->GetDataRange();
 		
@@ -361,4 +363,48 @@ int		CDataSet3DImpl<PlotImplT>::AddPoint(double x, double y, double z)
 	}
 }
 
+template<class PlotImplT>
+int		CDataSet3DImpl<PlotImplT>::AppendPoints( int dataID, double *pX, double *pY, double *pZ, int nLen )
+{
+	PlotImplT* pT = static_cast<PlotImplT*>(this);
+
+	int nIndex = GetIndex(dataID);
+	if(nIndex < 0)return -1;
+	if(!pX || !pY || !pZ || nLen<=0)return -1;
+
+	MyVData3D &vData = GetAbsPlotData(nIndex)->GetData();
+	DataPoint3D dp3d;
+	int i, nStart = 0;
+
+	MyLock();
+	if(m_nMaxPoints>0 && !m_bMaxPointsReset && nLen>m_nMaxPoints)
+	{
+		nStart = nLen - m_nMaxPoints;
+	}
+	vData.reserve(vData.size() + nLen - nStart);
+	for(i=nStart; i<nLen; i++)
+	{
+		if(m_nMaxPoints>0 && m_bMaxPointsReset && (int)vData.size()>=m_nMaxPoints)
+		{
+			vData.clear();
+		}
+		dp3d.val[0] = pX[i];
+		dp3d.val[1] = pY[i];
+		dp3d.val[2] = pZ[i];
+		vData.push_back(dp3d);
+		UpdateDataRanges(dp3d, nIndex);
+	}
+	// rolling curve, drop the oldest points once for the whole batch
+	if(m_nMaxPoints>0 && !m_bMaxPointsReset && (int)vData.size()>m_nMaxPoints)
+	{
+		vData.erase(vData.begin(), vData.begin() + ((int)vData.size() - m_nMaxPoints));
+	}
+	GetAbsPlotData(nIndex)->bForceUpdate = true;
+	pT->SetRangeSet(false);
+
+	MyUnlock();
+
+	return dataID;
+}
+
 Declare_Namespace_End
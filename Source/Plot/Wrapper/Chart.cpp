@@ -411,6 +411,9 @@ struct CChart::stChartPara
 	// ûԶ
 	void				*pUser;
 	bool				bUser;
+
+	// GetDrawStatsJsonصַ
+	tstring				strDrawStats;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -1724,6 +1727,59 @@ RECT	CChart::GetZoomedRect(RECT destRect)
 	return rt;
 }
 
+void	*CChart::GetDrawStatsRecorder(int nPlotIndex)
+{
+	if(!m_pPara)return 0;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return 0;
+
+	if(!CheckSubPlotIndex(nPlotIndex))return 0;
+
+	if(IsSingleLayer(m_pPara->nType))return SuffixT_S(->GetDrawStats());
+	else if(IsMultiLayer(m_pPara->nType))return SuffixT_M(->GetSubPlot(nPlotIndex)->GetDrawStats());
+	else return 0;
+}
+
+bool	CChart::GetDrawStats(DrawStats &stats, int nPlotIndex)
+{
+	memset(&stats, 0, sizeof(DrawStats));
+	CDrawStats *pStats = (CDrawStats *)GetDrawStatsRecorder(nPlotIndex);
+	if(!pStats)return false;
+
+	stats.nFrames = pStats->GetFrames();
+	stats.fTotalMs = pStats->GetLastTime(kDrawPhaseTotal);
+	stats.fPlotRangeMs = pStats->GetLastTime(kDrawPhasePlotRange);
+	stats.fAxesMs = pStats->GetLastTime(kDrawPhaseAxes);
+	stats.fScreenPointsMs = pStats->GetLastTime(kDrawPhaseScreenPoints);
+	stats.fCurvesMs = pStats->GetLastTime(kDrawPhaseCurves);
+	stats.fMarkersMs = pStats->GetLastTime(kDrawPhaseMarkers);
+	stats.fLegendMs = pStats->GetLastTime(kDrawPhaseLegend);
+	stats.fBlitMs = pStats->GetLastTime(kDrawPhaseBlit);
+	stats.nPoints = pStats->GetLastCount(kDrawCountPoints);
+	stats.nScreenHits = (int)pStats->GetLastCount(kDrawCountScreenHits);
+	stats.nScreenExtends = (int)pStats->GetLastCount(kDrawCountScreenExtends);
+	stats.nScreenMisses = (int)pStats->GetLastCount(kDrawCountScreenMisses);
+	stats.nRangeHits = (int)pStats->GetLastCount(kDrawCountRangeHits);
+	stats.nRangeMisses = (int)pStats->GetLastCount(kDrawCountRangeMisses);
+	stats.nAllocations = (int)pStats->GetLastCount(kDrawCountAllocations);
+	return true;
+}
+
+const TCHAR	*CChart::GetDrawStatsJson(int nPlotIndex)
+{
+	CDrawStats *pStats = (CDrawStats *)GetDrawStatsRecorder(nPlotIndex);
+	if(!pStats)return _TEXT("{}");
+
+	m_pPara->strDrawStats = pStats->ToJson();
+	return m_pPara->strDrawStats.c_str();
+}
+
+void	CChart::ResetDrawStats(int nPlotIndex)
+{
+	CDrawStats *pStats = (CDrawStats *)GetDrawStatsRecorder(nPlotIndex);
+	if(pStats)pStats->Reset();
+}
+
 int		CChart::AddCurve(double *pX, double *pY, int nLen, int nPlotIndex)
 {
 	if(!m_pPara)return -1;
@@ -1773,13 +1829,10 @@ int		CChart::AddCurve(TCHAR **pStrTime, TCHAR *fmt, double *pY, int nLen, int nP
 		return -1;
 
 	double *pX = new double[nLen];
-	for(int i=0; i<nLen; i++)
+	if(MyStr2TimeBatch(pStrTime, nLen, fmt, pX) < nLen)
 	{
-		if(!MyStr2Time(pStrTime[i], fmt, pX[i]))
-		{
-			delete []pX;
-			return -1;
-		}
+		delete []pX;
+		return -1;
 	}
 	int dataID = AddCurve(pX, pY, nLen, nPlotIndex);
 	delete []pX;
@@ -2047,6 +2100,121 @@ int			CChart::AddCurve(double *pX, double *pY, double *pZ, int nLen)
 	return -1;
 }
 
+int		CChart::AppendPoints(int nDataID, double *pX, double *pY, int nLen, int nPlotIndex)
+{
+	if(!m_pPara)return -1;
+	if(!pX || !pY || nLen <=0)
+		return -1;
+	if(m_pPara->nType<0 || m_pPara->nType>=kType2DCount || !m_pPara->pPlot)
+		return -1;
+
+	if(!CheckSubPlotIndex(nPlotIndex))return -1;
+
+	int dataID = -1;
+
+	if(m_pPara->nType == kTypeXY || m_pPara->nType == kTypeStem || m_pPara->nType == kTypeOscillo)
+		dataID = SuffixT_S_NF_N3D(->AppendPoints(nDataID, pX, pY, nLen));
+	else if(IsMultiLayer(m_pPara->nType))
+		dataID = SuffixT_M(->GetSubPlot(nPlotIndex)->AppendPoints(nDataID, pX, pY, nLen));
+	else
+		dataID = -1;
+	return dataID;
+}
+
+int		CChart::AppendPoints(int nDataID, TCHAR **pStrTime, TCHAR *fmt, double *pY, int nLen, int nPlotIndex/* =0 */)
+{
+	if(!m_pPara)return -1;
+	if(!pStrTime || !pY || nLen <=0)
+		return -1;
+	if(m_pPara->nType<0 || m_pPara->nType>=kType2DCount || !m_pPara->pPlot)
+		return -1;
+
+	double *pX = new double[nLen];
+	if(MyStr2TimeBatch(pStrTime, nLen, fmt, pX) < nLen)
+	{
+		delete []pX;
+		return -1;
+	}
+	int dataID = AppendPoints(nDataID, pX, pY, nLen, nPlotIndex);
+	delete []pX;
+
+	return dataID;
+}
+
+int		CChart::AppendPoints(int nDataID, double *pX, double *pY, double *pZ, int nLen)
+{
+	if(!m_pPara)return -1;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return -1;
+	
+	switch(m_pPara->nType)
+	{
+	case kType3DLine:
+		return ((CTDLinePlotImpl *)m_pPara->pPlot)->AppendPoints(nDataID, pX, pY, pZ, nLen);
+	case kTypeXY3D:
+		return ((CXY3DPlotImpl *)m_pPara->pPlot)->AppendPoints(nDataID, pX, pY, pZ, nLen);
+	}
+	return -1;
+}
+
+void	*CChart::OpenIngestQueue(int nDataID, int nCapacity, int nPlotIndex)
+{
+	if(!m_pPara)return 0;
+	if(m_pPara->nType<0 || m_pPara->nType>=kType2DCount || !m_pPara->pPlot)
+		return 0;
+	
+	if(!CheckSubPlotIndex(nPlotIndex))return 0;
+	
+	CIngestQueue<DataPoint2D> *pQueue = 0;
+	if(m_pPara->nType == kTypeXY || m_pPara->nType == kTypeStem || m_pPara->nType == kTypeOscillo)
+		pQueue = SuffixT_S_NF_N3D(->OpenIngestQueue(nDataID, nCapacity));
+	else if(IsMultiLayer(m_pPara->nType))
+		pQueue = SuffixT_M(->GetSubPlot(nPlotIndex)->OpenIngestQueue(nDataID, nCapacity));
+	return pQueue;
+}
+
+void	CChart::CloseIngestQueue(int nDataID, int nPlotIndex)
+{
+	if(!m_pPara)return;
+	if(m_pPara->nType<0 || m_pPara->nType>=kType2DCount || !m_pPara->pPlot)
+		return;
+	
+	if(!CheckSubPlotIndex(nPlotIndex))return;
+	
+	if(m_pPara->nType == kTypeXY || m_pPara->nType == kTypeStem || m_pPara->nType == kTypeOscillo)
+		SuffixT_S_NF_N3D(->CloseIngestQueue(nDataID));
+	else if(IsMultiLayer(m_pPara->nType))
+		SuffixT_M(->GetSubPlot(nPlotIndex)->CloseIngestQueue(nDataID));
+}
+
+int		CChart::PushIngestPoints(void *hQueue, double *pX, double *pY, int nLen)
+{
+	if(!hQueue || !pX || !pY || nLen<=0)return 0;
+	
+	CIngestQueue<DataPoint2D> *pQueue = (CIngestQueue<DataPoint2D> *)hQueue;
+	const int nBatch = 256;
+	DataPoint2D pBuff[nBatch];
+	int i, nPart, nPushed = 0;
+	for(int nPos=0; nPos<nLen; nPos+=nPart)
+	{
+		nPart = min(nBatch, nLen - nPos);
+		for(i=0; i<nPart; i++)
+		{
+			pBuff[i].val[0] = pX[nPos + i];
+			pBuff[i].val[1] = pY[nPos + i];
+		}
+		// the queue counts what does not fit as dropped
+		nPushed += pQueue->Push(pBuff, nPart);
+	}
+	return nPushed;
+}
+
+int		CChart::GetIngestDropped(void *hQueue)
+{
+	if(!hQueue)return 0;
+	return (int)((CIngestQueue<DataPoint2D> *)hQueue)->GetDropped();
+}
+
 void		CChart::ClrAllData()
 {
 	if(!m_pPara)return;
@@ -2149,11 +2317,11 @@ int		CChart::GetDataPointsCount(int nDataIndex, int nPlotIndex)
 		return 0;
 
 	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType))
-		return (int)SuffixT_S_NF(->GetAbsData(nDataIndex).size());
+		return (int)SuffixT_S_NF(->GetAbsPlotData(nDataIndex)->GetDataCount());
 	else if(IsMultiLayer(m_pPara->nType))
-		return (int)SuffixT_M(->GetSubPlot(nPlotIndex)->GetAbsData(nDataIndex).size());
+		return (int)SuffixT_M(->GetSubPlot(nPlotIndex)->GetAbsPlotData(nDataIndex)->GetDataCount());
 	else if(m_pPara->nType == kType3DLine)
-		return (int)SuffixT_R3D_L(->GetAbsData(nDataIndex).size());
+		return (int)SuffixT_R3D_L(->GetAbsPlotData(nDataIndex)->GetDataCount());
 	else
 		return 0;
 }
@@ -2172,9 +2340,9 @@ double		CChart::GetDataPointX(int nPointIndex, int nDataIndex, int nPlotIndex)
 	if(nPointIndex<0 || nPointIndex>=GetDataPointsCount(nDataIndex, nPlotIndex))return 0.0;
 
 	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType))
-		return SuffixT_S_NF(->GetAbsData(nDataIndex)[nPointIndex].val[0]);
+		return SuffixT_S_NF(->GetAbsPlotData(nDataIndex)->GetDataAt(nPointIndex).val[0]);
 	else if(IsMultiLayer(m_pPara->nType))
-		return SuffixT_M(->GetSubPlot(nPlotIndex)->GetAbsData(nDataIndex)[nPointIndex].val[0]);
+		return SuffixT_M(->GetSubPlot(nPlotIndex)->GetAbsPlotData(nDataIndex)->GetDataAt(nPointIndex).val[0]);
 	else
 		return 0.0;
 }
@@ -2193,9 +2361,9 @@ double		CChart::GetDataPointY(int nPointIndex, int nDataIndex, int nPlotIndex)
 	if(nPointIndex<0 || nPointIndex>=GetDataPointsCount(nDataIndex, nPlotIndex))return 0.0;
 	
 	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType))
-		return SuffixT_S_NF(->GetAbsData(nDataIndex)[nPointIndex].val[1]);
+		return SuffixT_S_NF(->GetAbsPlotData(nDataIndex)->GetDataAt(nPointIndex).val[1]);
 	else if(IsMultiLayer(m_pPara->nType))
-		return SuffixT_M(->GetSubPlot(nPlotIndex)->GetAbsData(nDataIndex)[nPointIndex].val[1]);
+		return SuffixT_M(->GetSubPlot(nPlotIndex)->GetAbsPlotData(nDataIndex)->GetDataAt(nPointIndex).val[1]);
 	else
 		return 0.0;
 }
@@ -2214,9 +2382,9 @@ bool		CChart::GetDataPoint(double data[2], int nPointIndex, int nDataIndex, int
 	if(nPointIndex<0 || nPointIndex>=GetDataPointsCount(nDataIndex, nPlotIndex))return false;
 
 	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType))
-		memcpy(data, SuffixT_S_NF(->GetAbsData(nDataIndex)[nPointIndex].val), 2*sizeof(double) );
+		memcpy(data, SuffixT_S_NF(->GetAbsPlotData(nDataIndex)->GetDataAt(nPointIndex).val), 2*sizeof(double) );
 	else if(IsMultiLayer(m_pPara->nType))
-		memcpy(data, SuffixT_M(->GetSubPlot(nPlotIndex)->GetAbsData(nDataIndex)[nPointIndex].val), 2*sizeof(double) );
+		memcpy(data, SuffixT_M(->GetSubPlot(nPlotIndex)->GetAbsPlotData(nDataIndex)->GetDataAt(nPointIndex).val), 2*sizeof(double) );
 	else
 		return false;
 
@@ -2737,6 +2905,28 @@ int		CChart::GetTop()
 		return -1;
 }
 
+int		CChart::GetDrawThreads()
+{
+	if(!m_pPara)return 0;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return 0;
+
+	if(m_pPara->nType==kTypeSplit)
+		return ((CSplitPlotImplI<CXYPlotImplI>*)m_pPara->pPlot)->GetDrawThreads();
+	else
+		return 0;
+}
+
+void	CChart::SetDrawThreads(int nThreads)
+{
+	if(!m_pPara)return;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return;
+
+	if(m_pPara->nType==kTypeSplit)
+		((CSplitPlotImplI<CXYPlotImplI>*)m_pPara->pPlot)->SetDrawThreads(nThreads);
+}
+
 void	CChart::SetUniteLayerColor(bool bUnite)
 {
 	if(!m_pPara)return;
@@ -3604,6 +3794,22 @@ void	CChart::SetDataCompactDraw(bool bCompact, int nDataIndex, int nPlotIndex)
 		SuffixT_M(->GetSubPlot(nPlotIndex)->GetPlotData(dataID)->SetCompactDraw(bCompact));
 }
 
+void	CChart::SetDataCompactMode(int nMode, int nDataIndex, int nPlotIndex)
+{
+	if(!m_pPara)return;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return;
+	if(!CheckSubPlotIndex(nPlotIndex))return;
+	int dataID = GetDataID(nDataIndex, nPlotIndex);
+	if(dataID<0)
+		return;
+
+	if(IsSingleLineLayer(m_pPara->nType))
+		SuffixT_S_L(->GetPlotData(dataID)->SetCompactMode(nMode));
+	else if(IsMultiLayer(m_pPara->nType))
+		SuffixT_M(->GetSubPlot(nPlotIndex)->GetPlotData(dataID)->SetCompactMode(nMode));
+}
+
 void	CChart::SetDataHistro(bool bHistro, int nDataIndex, int nPlotIndex)
 {
 	if(!m_pPara)return;
@@ -6202,6 +6408,32 @@ void	CChart::SetYStartTime(TCHAR *strTime, TCHAR *fmt, int nPlotIndex)
 		SuffixT_M(->GetSubPlot(nPlotIndex)->SetYStartTime(tmt));
 }
 
+void	CChart::SetXTimeOrigin(__int64 nOrigin, int nPlotIndex)
+{
+	if(!m_pPara)return;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return;
+	if(!CheckSubPlotIndex(nPlotIndex))return;
+	
+	if(IsSingleLineLayer(m_pPara->nType))
+		SuffixT_S_L(->SetXTimeOrigin(nOrigin));
+	else if(IsMultiLayer(m_pPara->nType))
+		SuffixT_M(->GetSubPlot(nPlotIndex)->SetXTimeOrigin(nOrigin));
+}
+
+void	CChart::SetYTimeOrigin(__int64 nOrigin, int nPlotIndex)
+{
+	if(!m_pPara)return;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return;
+	if(!CheckSubPlotIndex(nPlotIndex))return;
+	
+	if(IsSingleLineLayer(m_pPara->nType))
+		SuffixT_S_L(->SetYTimeOrigin(nOrigin));
+	else if(IsMultiLayer(m_pPara->nType))
+		SuffixT_M(->GetSubPlot(nPlotIndex)->SetYTimeOrigin(nOrigin));
+}
+
 void	CChart::SetGridBindLayer(int nPlotIndex)
 {
 	if(!m_pPara)return;
@@ -7073,6 +7305,130 @@ bool		CChart::WriteOneToFile(TCHAR *pathName, int nDataIndex, int nPlotIndex)
 		return false;
 }
 
+bool		CChart::WriteToBinaryFile(TCHAR *pathName, int nPlotIndex)
+{
+	if(!m_pPara)return false;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return false;
+	if(!CheckSubPlotIndex(nPlotIndex))
+		return false;
+
+	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType))
+		return SuffixT_S_NF(->WriteToBinaryFile(pathName));
+	else if(IsMultiLayer(m_pPara->nType))
+		return SuffixT_M(->GetSubPlot(nPlotIndex)->WriteToBinaryFile(pathName));
+	else
+		return false;
+}
+
+bool		CChart::WriteToSink(FcnTextSink fcnSink, void *pPara, int nPlotIndex)
+{
+	if(!m_pPara)return false;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return false;
+	if(!CheckSubPlotIndex(nPlotIndex))
+		return false;
+
+	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType))
+		return SuffixT_S_NF(->WriteToSink(fcnSink, pPara));
+	else if(IsMultiLayer(m_pPara->nType))
+		return SuffixT_M(->GetSubPlot(nPlotIndex)->WriteToSink(fcnSink, pPara));
+	else
+		return false;
+}
+
+void		CChart::SetTextPrecision(int nPrecision, int nPlotIndex)
+{
+	if(!m_pPara)return;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return;
+	if(!CheckSubPlotIndex(nPlotIndex))
+		return;
+
+	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType))
+		SuffixT_S_NF(->SetTextPrecision(nPrecision));
+	else if(IsMultiLayer(m_pPara->nType))
+		SuffixT_M(->GetSubPlot(nPlotIndex)->SetTextPrecision(nPrecision));
+}
+
+bool		CChart::ReadFromFile(TCHAR *pathName, int nPlotIndex)
+{
+	if(!m_pPara)return false;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return false;
+	if(!CheckSubPlotIndex(nPlotIndex))
+		return false;
+
+	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType))
+		return SuffixT_S_NF(->ReadFromFile(pathName));
+	else if(IsMultiLayer(m_pPara->nType))
+		return SuffixT_M(->GetSubPlot(nPlotIndex)->ReadFromFile(pathName));
+	else
+		return false;
+}
+
+bool		CChart::LoadFromFile(TCHAR *pathName, FcnLoadProgress fcnProgress, void *pPara, int nPlotIndex)
+{
+	if(!m_pPara)return false;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return false;
+	if(!CheckSubPlotIndex(nPlotIndex))
+		return false;
+
+	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType) && m_pPara->nType!=kTypeXY3D)
+		return SuffixT_S_NF_N3D(->LoadFromFile(pathName, fcnProgress, pPara));
+	else if(IsMultiLayer(m_pPara->nType))
+		return SuffixT_M(->GetSubPlot(nPlotIndex)->LoadFromFile(pathName, fcnProgress, pPara));
+	else
+		return false;
+}
+
+bool		CChart::StartLoadFromFile(TCHAR *pathName, FcnLoadProgress fcnProgress, void *pPara, int nPlotIndex)
+{
+	if(!m_pPara)return false;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return false;
+	if(!CheckSubPlotIndex(nPlotIndex))
+		return false;
+
+	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType) && m_pPara->nType!=kTypeXY3D)
+		return SuffixT_S_NF_N3D(->StartLoadFromFile(pathName, fcnProgress, pPara));
+	else if(IsMultiLayer(m_pPara->nType))
+		return SuffixT_M(->GetSubPlot(nPlotIndex)->StartLoadFromFile(pathName, fcnProgress, pPara));
+	else
+		return false;
+}
+
+bool		CChart::IsLoadingFile(int nPlotIndex)
+{
+	if(!m_pPara)return false;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return false;
+	if(!CheckSubPlotIndex(nPlotIndex))
+		return false;
+
+	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType) && m_pPara->nType!=kTypeXY3D)
+		return SuffixT_S_NF_N3D(->IsLoading());
+	else if(IsMultiLayer(m_pPara->nType))
+		return SuffixT_M(->GetSubPlot(nPlotIndex)->IsLoading());
+	else
+		return false;
+}
+
+void		CChart::CancelLoadFromFile(int nPlotIndex)
+{
+	if(!m_pPara)return;
+	if(m_pPara->nType<0 || m_pPara->nType>=kTypeCount || !m_pPara->pPlot)
+		return;
+	if(!CheckSubPlotIndex(nPlotIndex))
+		return;
+
+	if(IsSingleLayer(m_pPara->nType) && !IsFieldChart(m_pPara->nType) && m_pPara->nType!=kTypeXY3D)
+		SuffixT_S_NF_N3D(->CancelLoad());
+	else if(IsMultiLayer(m_pPara->nType))
+		SuffixT_M(->GetSubPlot(nPlotIndex)->CancelLoad());
+}
+
 void	*CChart::GetUserPointer()
 {
 	if(!m_pPara)return 0;
@@ -7267,6 +7623,31 @@ void	CChartWnd::ReDraw(CChart *chart)
 	m_pPara->pPlotWnd->ReDraw(chart);
 }
 
+void	CChartWnd::SetMaxFrameRate(double fMaxFps)
+{
+	m_pPara->pPlotWnd->SetMaxFrameRate(fMaxFps);
+}
+
+double	CChartWnd::GetMaxFrameRate()
+{
+	return m_pPara->pPlotWnd->GetMaxFrameRate();
+}
+
+unsigned int	CChartWnd::GetRequestedFrames()
+{
+	return m_pPara->pPlotWnd->GetRequestedFrames();
+}
+
+unsigned int	CChartWnd::GetRenderedFrames()
+{
+	return m_pPara->pPlotWnd->GetRenderedFrames();
+}
+
+void	CChartWnd::ResetFrameCounters()
+{
+	m_pPara->pPlotWnd->ResetFrameCounters();
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -7499,9 +7880,14 @@ HWND	CreateSubChartWnd(HWND hWndParent, int nChartType, TCHAR *wndTitle/*=_TEXT(
 
 double StringToTime(TCHAR *str, TCHAR *fmt)
 {
-	time_t ttime;
-	MyStr2Time(str, fmt, ttime);
-	return (double)ttime;
+	double ftime = 0.0;
+	MyStr2Time(str, fmt?fmt:_TEXT(""), ftime);
+	return ftime;
+}
+
+int StringsToTimes(TCHAR **pStrTime, int nCount, TCHAR *fmt, double *pTime)
+{
+	return MyStr2TimeBatch(pStrTime, nCount, fmt?fmt:_TEXT(""), pTime);
 }
 
 
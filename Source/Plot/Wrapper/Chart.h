@@ -112,6 +112,16 @@ enum
 	kPlotTypeCount
 };
 
+// ѹʾѹ
+enum
+{
+	kCompactM4 = 0,			//0 ÿбһ㡢С㡢һ
+	kCompactLTTB = 1,		//1 Ͱ㷨
+	kCompactAverage = 2,	//2 ÿȡƽֵ
+	
+	kCompactModeCount
+};
+
  // ߶ɫģʽɫڵ뷽ʽAddSegColorһĺ壩
  enum
  {
@@ -261,6 +271,32 @@ enum
 };
 */
 
+// ͼʱͳƣʱ䵥λΪ룬ʱNO_DRAW_STATSȫΪ0
+typedef struct stDrawStats
+{
+	int		nFrames;			// ͳƵ֡
+	double	fTotalMs;			// ֡ʱ
+	double	fPlotRangeMs;		// 귶Χ
+	double	fAxesMs;			// ͼ֡Ϳ̶ȱǩ
+	double	fScreenPointsMs;	// Ļ
+	double	fCurvesMs;			// 
+	double	fMarkersMs;			// ݵ
+	double	fLegendMs;			// ͼ
+	double	fBlitMs;			// ڴDCĿDC
+	__int64	nPoints;			// ɼߵݵ
+	int		nScreenHits;		// ֱʹûĻ
+	int		nScreenExtends;		// ֻ任׷ӵ
+	int		nScreenMisses;		// ¼ȫĻ
+	int		nRangeHits;			// ݷΧд
+	int		nRangeMisses;		// ݷΧδд
+	int		nAllocations;		// Ļ㻺ڴDCķ
+}DrawStats;
+
+// ݰıʱıĺfalseֹͣ
+typedef bool	(*FcnTextSink)(const TCHAR *pText, int nLen, void *pPara);
+// ȡļʱȵĺfDoneΪѶ0~1falseȡȡ
+typedef bool	(*FcnLoadProgress)(double fDone, void *pPara);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -519,6 +555,17 @@ protected:
 	// ڲú
 	RECT		GetZoomedRect(RECT destRect);
 
+public:
+	// һ֡׶εĻͼʱͼnPlotIndexڶͼ
+	bool		GetDrawStats(DrawStats &stats, int nPlotIndex=0);
+	// JSONַһ֡("last")ۼ("sum")ͳ
+	const TCHAR	*GetDrawStatsJson(int nPlotIndex=0);
+	// ͳ
+	void		ResetDrawStats(int nPlotIndex=0);
+private:
+	// ڲú
+	void		*GetDrawStatsRecorder(int nPlotIndex);
+
 public:	
 	// ߣǰ
 	// ĸҪڷͼֲͼXͼʾͼšͬ
@@ -562,6 +609,26 @@ public:
 	// һά
 	int			AddCurve(double *pX, double *pY, double *pZ, int nLen);	
 
+	// ׷ݵ㣬nDataIDΪߵID
+	// ֻһΣüͻˢҲֻһΣʺϸٲɼʱ
+	int			AppendPoints(int nDataID, double *pX, double *pY, int nLen, int nPlotIndex=0);
+	// ׷ݵ㣬XΪʱ䣬ַʽ
+	// ַʽfmtȷοC⺯strftime
+	int			AppendPoints(int nDataID, TCHAR **pStrTime, TCHAR *fmt, double *pY, int nLen, int nPlotIndex=0);
+	// ά׷ݵ
+	int			AppendPoints(int nDataID, double *pX, double *pY, double *pZ, int nLen);
+
+	// ΪάߴɼУضоʧܷ0
+	// ÿֻһ߳ݣͲеĵ´λͼʼʱ
+	// ԭеļ׷Ӻճãɾǰȹرն
+	void		*OpenIngestQueue(int nDataID, int nCapacity=65536, int nPlotIndex=0);
+	// رղɼУʣĵȲ
+	void		CloseIngestQueue(int nDataID, int nPlotIndex=0);
+	// ɼݵ㣬̵߳ãʱĵ㣬ͳɹĵ
+	static	int	PushIngestPoints(void *hQueue, double *pX, double *pY, int nLen);
+	// ʱĵ
+	static	int	GetIngestDropped(void *hQueue);
+
 	// 
 	void		ClrAllData();
 	// ͼȫ
@@ -678,6 +745,11 @@ public:
 	// ͼʱõǰͼ
 	int			GetTop();
 
+	// ÷ͼͼ߳
+	int			GetDrawThreads();
+	// ÷ͼͼ߳01λƣÿһ̣߳ʱͼûͼЩ߳е
+	void		SetDrawThreads(int nThreads);
+
 	// öͼͼǷɫһ
 	void		SetUniteLayerColor(bool bUnite);
 	// öͼͼɫһʱǷ
@@ -776,8 +848,11 @@ public:
 	//Ƿɼ
 	void		SetDataVisible(bool bVis, int nDataIndex, int nPlotIndex=0);
 	// ѹʾģʽҪڴʱʾ
-	// ѹʾģʽУݵĻʾʱXͬѹһݵ㣬ֵȡƽ
+	// ѹʾģʽУĻXͬݵ㽫ѹѹSetDataCompactMode
 	void		SetDataCompactDraw(bool bCompact, int nDataIndex, int nPlotIndex=0);
+	// ѹʾѹżļʼע͵enum
+	// ĬΪM4ÿбһ㡢С㡢һ㣬岻ᶪʧʾ벻ѹͬ
+	void		SetDataCompactMode(int nMode, int nDataIndex, int nPlotIndex=0);
 	// ݰֱͼģʽʾ
 	void		SetDataHistro(bool bHistro, int nDataIndex, int nPlotIndex=0);
 
@@ -1210,6 +1285,10 @@ public:
 	void		SetXStartTime(TCHAR *strTime, TCHAR *fmt, int nPlotIndex = 0);
 	// Yʱ󣬶ԻYݷΧʱȥһֵԱݹ
 	void		SetYStartTime(TCHAR *strTime, TCHAR *fmt, int nPlotIndex = 0);
+	// Xʱԭ㣬Ϊ1970ֵǾԭ΢뼶ĿҲ
+	void		SetXTimeOrigin(__int64 nOrigin, int nPlotIndex = 0);
+	// Yʱԭ㣬Ϊ1970ֵǾԭ
+	void		SetYTimeOrigin(__int64 nOrigin, int nPlotIndex = 0);
 
 public:
 	// ñһͼ󶨣ڹXͼ
@@ -1356,6 +1435,22 @@ public:
 	bool		WriteToFile(TCHAR *pathName, int nPlotIndex=0);
 	// ͼĳݵļ
 	bool		WriteOneToFile(TCHAR *pathName, int nDataIndex, int nPlotIndex=0);
+	// ͼݵļдţȡʱڴӳ
+	bool		WriteToBinaryFile(TCHAR *pathName, int nPlotIndex=0);
+	// ԱļʱıʽֿͼݣռļСڴ
+	bool		WriteToSink(FcnTextSink fcnSink, void *pPara, int nPlotIndex=0);
+	// ñıļʱֵЧλĬ60Ϊܶԭֵλ
+	void		SetTextPrecision(int nPrecision, int nPlotIndex=0);
+	// ļȡͼݣԶʶıļ
+	bool		ReadFromFile(TCHAR *pathName, int nPlotIndex=0);
+	// ֿȡͼļÿ꼴ߣɱȺȡȡʱѶݲfalse
+	bool		LoadFromFile(TCHAR *pathName, FcnLoadProgress fcnProgress, void *pPara, int nPlotIndex=0);
+	// ں̨߳зֿȡͼļֻ߳ݣѶÿλͼʱߣȺڸ߳е
+	bool		StartLoadFromFile(TCHAR *pathName, FcnLoadProgress fcnProgress, void *pPara, int nPlotIndex=0);
+	// ̨߳ѶĲּߣ߳Ƿڶȡļ
+	bool		IsLoadingFile(int nPlotIndex=0);
+	// ȡ̨ȡȴ߳̽ڽȺе
+	void		CancelLoadFromFile(int nPlotIndex=0);
 
 public:
 	// ڲָ룬ָһûãֻĳЩ´ݲ̺߳
@@ -1434,6 +1529,17 @@ public:
 	void	ReDraw(HWND hWnd);
 	void	ReDraw(int nChartIndex);
 	void	ReDraw(CChart *chart);
+
+	// ֡ʣػϲ󰴴֡ʻƣ0ʾÿ
+	void	SetMaxFrameRate(double fMaxFps);
+	// ֡
+	double	GetMaxFrameRate();
+	// ػ
+	unsigned int	GetRequestedFrames();
+	// ʵʻ֡
+	unsigned int	GetRenderedFrames();
+	// 
+	void	ResetFrameCounters();
 		
 };
 
@@ -1461,8 +1567,10 @@ CChart_API	HWND	CreateSubChartWnd(HWND hWndParent, int nChartType, TCHAR *wndTit
 ///////////////////////////////////////////////////////////////////////////////////////////
 // ʵú
 
-// ڽʱ䴮ַתΪtime_t
+// ڽʱ䴮ַתΪtime_tС֡fmtΪմʱISO-8601
 CChart_API	double StringToTime(TCHAR *str, TCHAR *fmt);
+// תʱ䴮صһʧ֮ǰתĸ
+CChart_API	int		StringsToTimes(TCHAR **pStrTime, int nCount, TCHAR *fmt, double *pTime);
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -328,6 +328,37 @@ namespace Classless
 	//{
 	//	pGlobalChartWnd->ReDraw(chart);
 	//}
+	// ֡
+	void	SetMaxFrameRate(double fMaxFps)
+	{
+		pGlobalChartWnd->SetMaxFrameRate(fMaxFps);
+	}
+	// ֡
+	double	GetMaxFrameRate()
+	{
+		return pGlobalChartWnd->GetMaxFrameRate();
+	}
+	// ػ
+	unsigned int	GetRequestedFrames()
+	{
+		return pGlobalChartWnd->GetRequestedFrames();
+	}
+	// ʵʻ֡
+	unsigned int	GetRenderedFrames()
+	{
+		return pGlobalChartWnd->GetRenderedFrames();
+	}
+	// 
+	void	ResetFrameCounters()
+	{
+		pGlobalChartWnd->ResetFrameCounters();
+	}
+	// һ֡׶εĻͼʱͼ
+	DeclareFunc_2P_Ret(bool, GetDrawStats, DrawStats &, stats, int, nPlotIndex);
+	// JSONַػͼͳ
+	DeclareFunc_1P_Ret(const TCHAR *, GetDrawStatsJson, int, nPlotIndex);
+	// ͼͳ
+	DeclareFunc_1P_Noret(void, ResetDrawStats, int, nPlotIndex);
 	
 	/////////////////////////////////////////////////////////////////////////////
 	//CChart_API  ºCChart
@@ -587,6 +618,30 @@ namespace Classless
 	// һά
 	DeclareFunc_4P_Ret(int, AddCurve, double *, pX, double *, pY, double *, pZ, int, nLen);	
 
+	// ׷ݵ㣬nDataIDΪߵID
+	// ֻһΣüͻˢҲֻһΣʺϸٲɼʱ
+	DeclareFunc_5P_Ret(int, AppendPoints, int, nDataID, double *, pX, double *, pY, int, nLen, int, nPlotIndex);
+	// ׷ݵ㣬XΪʱ䣬ַʽ
+	// ַʽfmtȷοC⺯strftime
+	DeclareFunc_6P_Ret(int, AppendPoints, int, nDataID, TCHAR **, pStrTime, TCHAR *, fmt, double *, pY, int, nLen, int, nPlotIndex);
+	// ά׷ݵ
+	DeclareFunc_5P_Ret(int, AppendPoints, int, nDataID, double *, pX, double *, pY, double *, pZ, int, nLen);
+
+	// Ϊάߴɼ
+	DeclareFunc_3P_Ret(void *, OpenIngestQueue, int, nDataID, int, nCapacity, int, nPlotIndex);
+	// رղɼ
+	DeclareFunc_2P_Noret(void, CloseIngestQueue, int, nDataID, int, nPlotIndex);
+	// ɼݵ㣬ȫִ
+	int		PushIngestPoints(void *hQueue, double *pX, double *pY, int nLen)
+	{
+		return CChart::PushIngestPoints(hQueue, pX, pY, nLen);
+	}
+	// ʱĵ
+	int		GetIngestDropped(void *hQueue)
+	{
+		return CChart::GetIngestDropped(hQueue);
+	}
+
 	// 
 	DeclareFunc_0P_Noret(void, ClrAllData);
 	// ͼȫ
@@ -696,6 +751,11 @@ namespace Classless
 	// ͼʱõǰͼ
 	DeclareFunc_0P_Ret(int, GetTop);
 
+	// ÷ͼͼ߳
+	DeclareFunc_0P_Ret(int, GetDrawThreads);
+	// ÷ͼͼ߳01λƣÿһ̣߳ʱͼûͼЩ߳е
+	DeclareFunc_1P_Noret(void, SetDrawThreads, int, nThreads);
+
 	// öͼͼǷɫһ
 	DeclareFunc_1P_Noret(void, SetUniteLayerColor, bool, bUnite);
 	// öͼͼɫһʱǷ
@@ -794,8 +854,11 @@ namespace Classless
 	//Ƿɼ
 	DeclareFunc_3P_Noret(void, SetDataVisible, bool, bVis, int, nDataIndex, int, nPlotIndex);
 	// ѹʾģʽҪڴʱʾ
-	// ѹʾģʽУݵĻʾʱXͬѹһݵ㣬ֵȡƽ
+	// ѹʾģʽУĻXͬݵ㽫ѹѹSetDataCompactMode
 	DeclareFunc_3P_Noret(void, SetDataCompactDraw, bool, bCompact, int, nDataIndex, int, nPlotIndex);
+	// ѹʾѹżChart.hʼע͵enum
+	// ĬΪM4ÿбһ㡢С㡢һ㣬岻ᶪʧʾ벻ѹͬ
+	DeclareFunc_3P_Noret(void, SetDataCompactMode, int, nMode, int, nDataIndex, int, nPlotIndex);
 	// ݰֱͼģʽʾ
 	DeclareFunc_3P_Noret(void, SetDataHistro, bool, bHistro, int, nDataIndex, int, nPlotIndex);
 
@@ -1219,6 +1282,8 @@ namespace Classless
 	DeclareFunc_3P_Noret(void, SetXStartTime, TCHAR *, strTime, TCHAR *, fmt, int, nPlotIndex);
 	// Yʱ󣬶ԻYݷΧʱȥһֵԱݹ
 	DeclareFunc_3P_Noret(void, SetYStartTime, TCHAR *, strTime, TCHAR *, fmt, int, nPlotIndex);
+	DeclareFunc_2P_Noret(void, SetXTimeOrigin, __int64, nOrigin, int, nPlotIndex);
+	DeclareFunc_2P_Noret(void, SetYTimeOrigin, __int64, nOrigin, int, nPlotIndex);
 
 	// ñһͼ󶨣ڹXͼ
 	DeclareFunc_1P_Noret(void, SetGridBindLayer, int, nPlotIndex);
@@ -1355,6 +1420,16 @@ namespace Classless
 	DeclareFunc_2P_Ret(bool, WriteToFile, TCHAR *, pathName, int, nPlotIndex);
 	// ͼĳݵļ
 	DeclareFunc_3P_Ret(bool, WriteOneToFile, TCHAR *, pathName, int, nDataIndex, int, nPlotIndex);
+	// ͼݵļдţȡʱڴӳ
+	DeclareFunc_2P_Ret(bool, WriteToBinaryFile, TCHAR *, pathName, int, nPlotIndex);
+	DeclareFunc_3P_Ret(bool, WriteToSink, NsCChart::FcnTextSink, fcnSink, void *, pPara, int, nPlotIndex);
+	DeclareFunc_2P_Noret(void, SetTextPrecision, int, nPrecision, int, nPlotIndex);
+	// ļȡͼݣԶʶıļ
+	DeclareFunc_2P_Ret(bool, ReadFromFile, TCHAR *, pathName, int, nPlotIndex);
+	DeclareFunc_4P_Ret(bool, LoadFromFile, TCHAR *, pathName, NsCChart::FcnLoadProgress, fcnProgress, void *, pPara, int, nPlotIndex);
+	DeclareFunc_4P_Ret(bool, StartLoadFromFile, TCHAR *, pathName, NsCChart::FcnLoadProgress, fcnProgress, void *, pPara, int, nPlotIndex);
+	DeclareFunc_1P_Ret(bool, IsLoadingFile, int, nPlotIndex);
+	DeclareFunc_1P_Noret(void, CancelLoadFromFile, int, nPlotIndex);
 	
 		
 	// ڲָ룬ָһûãֻĳЩ´ݲ̺߳
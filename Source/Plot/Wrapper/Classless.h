@@ -72,6 +72,22 @@ namespace Classless
 	CChart_API void	ReDraw(HWND hWnd);
 	CChart_API void	ReDraw(int nChartIndex);
 	//CChart_API void	ReDraw(CChart *chart);
+	// ֡ʣػϲ󰴴֡ʻƣ0ʾÿ
+	CChart_API void	SetMaxFrameRate(double fMaxFps);
+	// ֡
+	CChart_API double	GetMaxFrameRate();
+	// ػ
+	CChart_API unsigned int	GetRequestedFrames();
+	// ʵʻ֡
+	CChart_API unsigned int	GetRenderedFrames();
+	// 
+	CChart_API void	ResetFrameCounters();
+	// һ֡׶εĻͼʱͼ
+	CChart_API bool	GetDrawStats(NsCChart::DrawStats &stats, int nPlotIndex=0);
+	// JSONַػͼͳ
+	CChart_API const TCHAR	*GetDrawStatsJson(int nPlotIndex=0);
+	// ͼͳ
+	CChart_API void	ResetDrawStats(int nPlotIndex=0);
 
 /////////////////////////////////////////////////////////////////////////////
 //CChart_API  ºCChart
@@ -331,6 +347,25 @@ namespace Classless
 	// һά
 	CChart_API int			AddCurve(double *pX, double *pY, double *pZ, int nLen);	
 
+	// ׷ݵ㣬nDataIDΪߵID
+	// ֻһΣüͻˢҲֻһΣʺϸٲɼʱ
+	CChart_API int			AppendPoints(int nDataID, double *pX, double *pY, int nLen, int nPlotIndex=0);
+	// ׷ݵ㣬XΪʱ䣬ַʽ
+	// ַʽfmtȷοC⺯strftime
+	CChart_API int			AppendPoints(int nDataID, TCHAR **pStrTime, TCHAR *fmt, double *pY, int nLen, int nPlotIndex=0);
+	// ά׷ݵ
+	CChart_API int			AppendPoints(int nDataID, double *pX, double *pY, double *pZ, int nLen);
+
+	// ΪάߴɼУضоʧܷ0
+	// ÿֻһ߳ݣͲеĵ´λͼʼʱ
+	CChart_API void			*OpenIngestQueue(int nDataID, int nCapacity=65536, int nPlotIndex=0);
+	// رղɼУʣĵȲ
+	CChart_API void			CloseIngestQueue(int nDataID, int nPlotIndex=0);
+	// ɼݵ㣬ʱĵ㣬ͳɹĵ
+	CChart_API int			PushIngestPoints(void *hQueue, double *pX, double *pY, int nLen);
+	// ʱĵ
+	CChart_API int			GetIngestDropped(void *hQueue);
+
 	// 
 	CChart_API void		ClrAllData();
 	// ͼȫ
@@ -439,6 +474,11 @@ namespace Classless
 	// ͼʱõǰͼ
 	CChart_API int			GetTop();
 
+	// ÷ͼͼ߳
+	CChart_API int			GetDrawThreads();
+	// ÷ͼͼ߳01λƣÿһ̣߳ʱͼûͼЩ߳е
+	CChart_API void		SetDrawThreads(int nThreads);
+
 	// öͼͼǷɫһ
 	CChart_API void		SetUniteLayerColor(bool bUnite);
 	// öͼͼɫһʱǷ
@@ -537,8 +577,11 @@ namespace Classless
 	//Ƿɼ
 	CChart_API void		SetDataVisible(bool bVis, int nDataIndex, int nPlotIndex=0);
 	// ѹʾģʽҪڴʱʾ
-	// ѹʾģʽУݵĻʾʱXͬѹһݵ㣬ֵȡƽ
+	// ѹʾģʽУĻXͬݵ㽫ѹѹSetDataCompactMode
 	CChart_API void		SetDataCompactDraw(bool bCompact, int nDataIndex, int nPlotIndex=0);
+	// ѹʾѹżChart.hʼע͵enum
+	// ĬΪM4ÿбһ㡢С㡢һ㣬岻ᶪʧʾ벻ѹͬ
+	CChart_API void		SetDataCompactMode(int nMode, int nDataIndex, int nPlotIndex=0);
 	// ݰֱͼģʽʾ
 	CChart_API void		SetDataHistro(bool bHistro, int nDataIndex, int nPlotIndex=0);
 
@@ -965,6 +1008,10 @@ namespace Classless
 	CChart_API void		SetXStartTime(TCHAR *strTime, TCHAR *fmt, int nPlotIndex = 0);
 	// Yʱ󣬶ԻYݷΧʱȥһֵԱݹ
 	CChart_API void		SetYStartTime(TCHAR *strTime, TCHAR *fmt, int nPlotIndex = 0);
+	// Xʱԭ㣬Ϊ1970ֵǾԭ΢뼶ĿҲ
+	CChart_API void		SetXTimeOrigin(__int64 nOrigin, int nPlotIndex = 0);
+	// Yʱԭ㣬Ϊ1970ֵǾԭ
+	CChart_API void		SetYTimeOrigin(__int64 nOrigin, int nPlotIndex = 0);
 
 	// ñһͼ󶨣ڹXͼ
 	CChart_API void		SetGridBindLayer(int nPlotIndex);
@@ -1101,6 +1148,22 @@ namespace Classless
 	CChart_API bool		WriteToFile(TCHAR *pathName, int nPlotIndex=0);
 	// ͼĳݵļ
 	CChart_API bool		WriteOneToFile(TCHAR *pathName, int nDataIndex, int nPlotIndex=0);
+	// ͼݵļдţȡʱڴӳ
+	CChart_API bool		WriteToBinaryFile(TCHAR *pathName, int nPlotIndex=0);
+	// ԱļʱıʽֿͼݣռļСڴ
+	CChart_API bool		WriteToSink(NsCChart::FcnTextSink fcnSink, void *pPara, int nPlotIndex=0);
+	// ñıļʱֵЧλĬ60Ϊܶԭֵλ
+	CChart_API void		SetTextPrecision(int nPrecision, int nPlotIndex=0);
+	// ļȡͼݣԶʶıļ
+	CChart_API bool		ReadFromFile(TCHAR *pathName, int nPlotIndex=0);
+	// ֿȡͼļÿ꼴ߣɱȺȡȡʱѶݲfalse
+	CChart_API bool		LoadFromFile(TCHAR *pathName, NsCChart::FcnLoadProgress fcnProgress, void *pPara, int nPlotIndex=0);
+	// ں̨߳зֿȡͼļֻ߳ݣѶÿλͼʱߣȺڸ߳е
+	CChart_API bool		StartLoadFromFile(TCHAR *pathName, NsCChart::FcnLoadProgress fcnProgress, void *pPara, int nPlotIndex=0);
+	// ̨߳ѶĲּߣ߳Ƿڶȡļ
+	CChart_API bool		IsLoadingFile(int nPlotIndex=0);
+	// ȡ̨ȡȴ߳̽ڽȺе
+	CChart_API void		CancelLoadFromFile(int nPlotIndex=0);
 
 	
 	// ڲָ룬ָһûãֻĳЩ´ݲ̺߳